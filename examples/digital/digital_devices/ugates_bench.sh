@@ -0,0 +1,46 @@
+#!/bin/bash
+# Write the U device translation benchmark ugates_bench.cir, a chain of
+# N gates (default 10000) in one subcircuit, and run it with
+#   ngspice -b ugates_bench.cir
+# The run time of the translation of the PSpice U devices and of the
+# setup of the event driven netlist should grow linearly with N.
+
+N=${1:-10000}
+OUT=${2:-ugates_bench.cir}
+
+awk -v n="$N" 'BEGIN {
+    split("and(2) or(2) nand(2) nor(2) xor inv", gate, " ")
+    print "U device translation benchmark, " n " gates in one subcircuit"
+    print "* Tests the run time of the translation of PSpice U devices and of the"
+    print "* setup of a large event driven netlist, which should grow linearly"
+    print "* with the number of gates.  Requires \x27set ngbehavior=ltpsa\x27 (see"
+    print "* .spiceinit in this directory)."
+    print ""
+    print ".subckt ugates a y"
+    print "+ optional: dpwr=$G_DPWR dgnd=$G_DGND"
+    for (i = 0; i < n; i++) {
+        g = gate[i % 6 + 1]
+        inp = (i == 0) ? "a" : "n" (i - 1)
+        out = (i == n - 1) ? "y" : "n" i
+        if (g == "inv")
+            pins = inp
+        else
+            pins = inp " a"
+        print "u" i " " g " dpwr dgnd " pins " " out " dly_" (i % 50) " io_std"
+    }
+    for (i = 0; i < 50; i++)
+        print ".model dly_" i " ugate (tplhty=" 100 + i "ps tphlty=" 110 + i "ps)"
+    print ".ends ugates"
+    print ""
+    print "vin ain 0 pulse(0 3.3 10n 1n 1n 50n 100n)"
+    print "aadc [ain] [a] adc1"
+    print ".model adc1 adc_bridge(in_low=0.5 in_high=2.5)"
+    print "x1 a y ugates"
+    print ""
+    print ".control"
+    print "tran 1n 20n"
+    print "rusage time"
+    print "eprint y"
+    print ".endc"
+    print ".end"
+}' > "$OUT"
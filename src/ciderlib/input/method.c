@@ -27,7 +27,8 @@ IFparm METHpTable[] = {
   IP("frequency",METH_OMEGA,	IF_REAL,    "AC default frequency"),
   IP("nomobderiv",METH_NOMOBDERIV,IF_FLAG,  "Ignore mobility derivatives"),
   IP("itlim",	METH_ITLIM,	IF_INTEGER, "Iteration limit"),
-  IP("voltpred",METH_VOLTPRED,	IF_FLAG,    "Perform DC voltage prediction")
+  IP("voltpred",METH_VOLTPRED,	IF_FLAG,    "Perform DC voltage prediction"),
+  IP("jacreuse",METH_JACREUSE,	IF_FLAG,    "Reuse the factored Jacobian while converging")
 };
 
 IFcardInfo METHinfo = {
@@ -106,6 +107,10 @@ METHparam(int param, IFvalue *value, GENcard *inCard)
 	    card->METHvoltPred = value->iValue;
 	    card->METHvoltPredGiven = TRUE;
 	    break;
+	case METH_JACREUSE:
+	    card->METHjacReuse = value->iValue;
+	    card->METHjacReuseGiven = TRUE;
+	    break;
 	default:
 	    return(E_BADPARM);
 	    break;
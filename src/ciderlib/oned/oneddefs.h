@@ -21,6 +21,8 @@ extern BOOLEAN ONEjacDebug;
 #define LEVEL_ALPHA_SI 3.1e-8	/* From de Graaf & Klaasen, pg. 12 */
 #define MIN_DELV 1e-3
 #define NORM_RED_MAXITERS 10
+#define JAC_REUSE_RATE 0.1 /* required rhs norm reduction to reuse a Jacobian */
+#define JAC_REUSE_NORM 1e-1 /* rhs norm below which a Jacobian may be reused */
 
 
 
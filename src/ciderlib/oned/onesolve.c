@@ -49,6 +49,9 @@ ONEdcSolve(ONEdevice *pDevice, int iterationLimit, BOOLEAN newSolver,
   double startTime, totalStartTime;
   double totalTime, loadTime, factorTime, solveTime, updateTime, checkTime;
   double orderTime = 0.0;
+  double lastNorm = 0.0;
+  BOOLEAN haveFactor = FALSE;
+  BOOLEAN reuseJac = FALSE;
 
   quitLoop = FALSE;
   debug =   (!tranAnalysis && ONEdcDebug) 
@@ -76,30 +79,63 @@ ONEdcSolve(ONEdevice *pDevice, int iterationLimit, BOOLEAN newSolver,
     if ((!pDevice->poissonOnly) && (iterationLimit > 0)
 	&&(!tranAnalysis)) {
       ONEjacCheck(pDevice, tranAnalysis, info);
+      /* the check loads the matrix over the factored Jacobian */
+      if (ONEjacDebug) {
+	haveFactor = FALSE;
+      }
     }
     /* LOAD */
     startTime = SPfrontEnd->IFseconds();
-    if (pDevice->poissonOnly) {
-      ONEQsysLoad(pDevice);
-    } else {
-      ONE_sysLoad(pDevice, tranAnalysis, info);
+    /*
+     * As in TWOdcSolve, keep solving with the factored Jacobian of an
+     * earlier iteration as long as the residual still contracts quickly.
+     */
+    reuseJac = pDevice->jacReuse && haveFactor && (lastNorm <= JAC_REUSE_NORM);
+    if (reuseJac) {
+      if (pDevice->poissonOnly) {
+	ONEQrhsLoad(pDevice);
+      } else {
+	ONE_rhsLoad(pDevice, tranAnalysis, info);
+      }
+      reuseJac = (maxNorm(rhs, size) <= JAC_REUSE_RATE * lastNorm);
+    }
+    if (!reuseJac) {
+      if (pDevice->poissonOnly) {
+	ONEQsysLoad(pDevice);
+      } else {
+	ONE_sysLoad(pDevice, tranAnalysis, info);
+      }
     }
     pDevice->rhsNorm = maxNorm(rhs, size);
+    lastNorm = pDevice->rhsNorm;
     loadTime += SPfrontEnd->IFseconds() - startTime;
     if (debug) {
-      fprintf(stdout, "%7d   %11.4e%s\n",
+      fprintf(stdout, "%7d   %11.4e%s%s\n",
 	  pDevice->iterationNumber - 1, pDevice->rhsNorm,
-	  negConc ? "   negative conc encountered" : "");
+	  negConc ? "   negative conc encountered" : "",
+	  reuseJac ? "   jacobian reused" : "");
       negConc = FALSE;
     }
     /* FACTOR */
     startTime = SPfrontEnd->IFseconds();
 
+    if (reuseJac) {
+      error = OK;
+    } else {
 #ifdef KLU
-    error = SMPreorderKLUforCIDER (pDevice->matrix) ;
+      /* Keep the pivot sequence of the first factorization if allowed. */
+      error = E_SINGULAR;
+      if (pDevice->jacReuse && haveFactor) {
+	error = SMPluFacKLUforCIDER (pDevice->matrix) ;
+      }
+      if (error) {
+	error = SMPreorderKLUforCIDER (pDevice->matrix) ;
+      }
 #else
-    error = SMPluFacForCIDER (pDevice->matrix) ;
+      error = SMPluFacForCIDER (pDevice->matrix) ;
 #endif
+      haveFactor = !foundError(error);
+    }
 
     factorTime += SPfrontEnd->IFseconds() - startTime;
     if (newSolver) {
@@ -141,10 +177,10 @@ ONEdcSolve(ONEdevice *pDevice, int iterationLimit, BOOLEAN newSolver,
     /*
      * Use norm reducing Newton method only for DC bias solutions. Since norm
      * reducing can get trapped by numerical errors, turn it off when we are
-     * somewhat close to the solution.
+     * somewhat close to the solution, and for steps with a reused Jacobian.
      */
     if ((!pDevice->poissonOnly) && (iterationLimit > 0)
-	&& (!tranAnalysis) && (pDevice->rhsNorm > 1e-6)) {
+	&& (!tranAnalysis) && (pDevice->rhsNorm > 1e-6) && !reuseJac) {
       error = ONEnewDelta(pDevice, tranAnalysis, info);
       if (error) {
 	pDevice->converged = FALSE;
@@ -53,5 +53,7 @@ struct mosAdmittances {
 
 #define MIN_DELV 1e-3
 #define NORM_RED_MAXITERS 10
+#define JAC_REUSE_RATE 0.1 /* required rhs norm reduction to reuse a Jacobian */
+#define JAC_REUSE_NORM 1e-1 /* rhs norm below which a Jacobian may be reused */
 
 #endif
@@ -47,6 +47,9 @@ TWOdcSolve(TWOdevice *pDevice, int iterationLimit, BOOLEAN newSolver,
   double startTime, totalStartTime;
   double totalTime, loadTime, factorTime, solveTime, updateTime, checkTime;
   double orderTime = 0.0;
+  double lastNorm = 0.0;
+  BOOLEAN haveFactor = FALSE;
+  BOOLEAN reuseJac = FALSE;
 
   totalTime = loadTime = factorTime = solveTime = updateTime = checkTime = 0.0;
   totalStartTime = SPfrontEnd->IFseconds();
@@ -71,36 +74,74 @@ TWOdcSolve(TWOdevice *pDevice, int iterationLimit, BOOLEAN newSolver,
     if ((!pDevice->poissonOnly) && (iterationLimit > 0)
 	&&(!tranAnalysis)) {
       TWOjacCheck(pDevice, tranAnalysis, info);
+      /* the check loads the matrix over the factored Jacobian */
+      if (TWOjacDebug) {
+	haveFactor = FALSE;
+      }
     }
 
     /* LOAD */
     startTime = SPfrontEnd->IFseconds();
-    if (pDevice->poissonOnly) {
-      TWOQsysLoad(pDevice);
-    } else if (!OneCarrier) {
-      TWO_sysLoad(pDevice, tranAnalysis, info);
-    } else if (OneCarrier == N_TYPE) {
-      TWONsysLoad(pDevice, tranAnalysis, info);
-    } else if (OneCarrier == P_TYPE) {
-      TWOPsysLoad(pDevice, tranAnalysis, info);
+    /*
+     * Once the full Newton steps converge, keep solving with the factored
+     * Jacobian of an earlier iteration as long as the residual still
+     * contracts quickly.  Only the rhs has to be loaded then.
+     */
+    reuseJac = pDevice->jacReuse && haveFactor && (lastNorm <= JAC_REUSE_NORM);
+    if (reuseJac) {
+      if (pDevice->poissonOnly) {
+	TWOQrhsLoad(pDevice);
+      } else if (!OneCarrier) {
+	TWO_rhsLoad(pDevice, tranAnalysis, info);
+      } else if (OneCarrier == N_TYPE) {
+	TWONrhsLoad(pDevice, tranAnalysis, info);
+      } else if (OneCarrier == P_TYPE) {
+	TWOPrhsLoad(pDevice, tranAnalysis, info);
+      }
+      reuseJac = (maxNorm(rhs, size) <= JAC_REUSE_RATE * lastNorm);
+    }
+    if (!reuseJac) {
+      if (pDevice->poissonOnly) {
+	TWOQsysLoad(pDevice);
+      } else if (!OneCarrier) {
+	TWO_sysLoad(pDevice, tranAnalysis, info);
+      } else if (OneCarrier == N_TYPE) {
+	TWONsysLoad(pDevice, tranAnalysis, info);
+      } else if (OneCarrier == P_TYPE) {
+	TWOPsysLoad(pDevice, tranAnalysis, info);
+      }
     }
     pDevice->rhsNorm = maxNorm(rhs, size);
+    lastNorm = pDevice->rhsNorm;
     loadTime += SPfrontEnd->IFseconds() - startTime;
     if (debug) {
-      fprintf(stdout, "%7d   %11.4e%s\n",
+      fprintf(stdout, "%7d   %11.4e%s%s\n",
 	  pDevice->iterationNumber - 1, pDevice->rhsNorm,
-	  negConc ? "   negative conc encountered" : "");
+	  negConc ? "   negative conc encountered" : "",
+	  reuseJac ? "   jacobian reused" : "");
       negConc = FALSE;
     }
 
     /* FACTOR */
     startTime = SPfrontEnd->IFseconds();
 
+    if (reuseJac) {
+      error = OK;
+    } else {
 #ifdef KLU
-    error = SMPreorderKLUforCIDER (pDevice->matrix) ;
+      /* Keep the pivot sequence of the first factorization if allowed. */
+      error = E_SINGULAR;
+      if (pDevice->jacReuse && haveFactor) {
+	error = SMPluFacKLUforCIDER (pDevice->matrix) ;
+      }
+      if (error) {
+	error = SMPreorderKLUforCIDER (pDevice->matrix) ;
+      }
 #else
-    error = SMPluFacForCIDER (pDevice->matrix) ;
+      error = SMPluFacForCIDER (pDevice->matrix) ;
 #endif
+      haveFactor = !foundError(error);
+    }
 
     factorTime += SPfrontEnd->IFseconds() - startTime;
     if (newSolver) {
@@ -17,6 +17,7 @@ Author: 1985 Wayne A. Christopher, U. C. Berkeley CAD Group
 #include "runcoms2.h"
 
 #include "completion.h"
+#include "plotting/graf.h"
 
 
 static bool satisfied(struct dbcomm *d, struct plot *plot);
@@ -225,10 +226,11 @@ com_iplot(wordlist *wl)
     struct dbcomm *d, *td, *currentdb = NULL;
     double         window = 0.0;
     int            initial_steps = IPOINTMIN;
-    char          *s;
+    char          *s, *file = NULL;
 
     /* Look for "-w window-size" at the front, indicating a windowed iplot
      * or "-d steps" to set the initial delay before the window appears.
+     * "-o file" writes the plot to a hardcopy file at the end of the run.
      */
 
     while (wl && wl->wl_word[0] == '-') {
@@ -250,6 +252,12 @@ com_iplot(wordlist *wl)
             wl = wl->wl_next;
             if (wl)
                 initial_steps = atoi(wl->wl_word);
+        } else if (wl->wl_word[1] == 'o' && !wl->wl_word[2]) {
+            wl = wl->wl_next;
+            if (wl) {
+                tfree(file);
+                file = cp_unquote(wl->wl_word);
+            }
         } else {
             break;
         }
@@ -267,6 +275,7 @@ com_iplot(wordlist *wl)
         d->db_number = debugnumber++;
         d->db_op = initial_steps; // Field re-use
         d->db_value1 = window;    // Field re-use
+        d->db_file = file ? copy(file) : NULL;
         if (eq(s, "all")) {
             d->db_type = DB_IPLOTALL;
         } else {
@@ -278,6 +287,7 @@ com_iplot(wordlist *wl)
         currentdb = d;
         wl = wl->wl_next;
     }
+    tfree(file);
 
     if (dbs) {
         for (td = dbs; td->db_next; td = td->db_next)
@@ -385,6 +395,8 @@ dbfree1(struct dbcomm *d)
 {
     tfree(d->db_nodename1);
     tfree(d->db_nodename2);
+    tfree(d->db_file);
+    gr_iplot_free(d);
     if (d->db_also)
         dbfree(d->db_also);
     tfree(d);
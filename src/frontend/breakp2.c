@@ -12,6 +12,7 @@ Author: 1985 Wayne A. Christopher, U. C. Berkeley CAD Group
 #include "ngspice/ftedefs.h"
 #include "ngspice/dvec.h"
 #include "ngspice/ftedebug.h"
+#include "ngspice/hash.h"
 #include "breakp2.h"
 
 
@@ -49,6 +50,7 @@ void
 settrace(wordlist *wl, int what, char *name)
 {
     struct dbcomm *d, *last, *dbcheck;
+    NGHASHPTR saved = NULL;         /* node names of DB_SAVE entries */
 
     if (!ft_curckt) {
         fprintf(cp_err, "Error: no circuit loaded\n");
@@ -94,11 +96,15 @@ settrace(wordlist *wl, int what, char *name)
 
         /* Don't save a nodename more than once */
         if (db_type == DB_SAVE) {
-            for (dbcheck = dbs; dbcheck; dbcheck = dbcheck->db_next) {
-                if (dbcheck->db_type == DB_SAVE && eq(dbcheck->db_nodename1, db_nodename1)) {
-                    tfree(db_nodename1);
-                    goto loopend;
-                }
+            if (!saved) {
+                saved = nghash_init(NGHASH_MIN_SIZE);
+                for (dbcheck = dbs; dbcheck; dbcheck = dbcheck->db_next)
+                    if (dbcheck->db_type == DB_SAVE)
+                        nghash_insert(saved, dbcheck->db_nodename1, dbcheck);
+            }
+            if (nghash_insert(saved, db_nodename1, db_nodename1)) {
+                tfree(db_nodename1);
+                goto loopend;
             }
         }
 
@@ -117,6 +123,9 @@ settrace(wordlist *wl, int what, char *name)
 
     loopend:;
     }
+
+    if (saved)
+        nghash_free(saved, NULL, NULL);
 }
 
 
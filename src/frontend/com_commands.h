@@ -6,6 +6,8 @@ void com_show(wordlist *wl);
 void com_alter(wordlist *wl);
 void com_altermod(wordlist *wl);
 void com_alterparam(wordlist *wl);
+void com_alterbulk(wordlist *wl);
+void com_altermodbulk(wordlist *wl);
 void com_meas(wordlist *wl);
 void com_sysinfo(wordlist *wl);
 void com_check_ifparm(wordlist *wl);
@@ -23,6 +23,114 @@ Author:   2008 Holger Vogt
 #endif
 
 
+/* Workspace for the transform of one vector or segment of it.  The
+   commands transform many vectors of equal length, each thread gets
+   its own copy of the buffers, the fftw plan is shared. */
+
+struct fft_work {
+    int length;         /* number of data points */
+    int fpts;           /* number of frequency points */
+    double *in;
+#ifdef HAVE_LIBFFTW3
+    fftw_complex *out;
+    fftw_plan plan;
+#else
+    int N, M;           /* size and log2 of the zero padded transform */
+#endif
+};
+
+
+static void
+fft_work_init(struct fft_work *w, int length)
+{
+    w->length = length;
+#ifdef HAVE_LIBFFTW3
+    w->fpts = length/2 + 1;
+    w->in = fftw_malloc(sizeof(double) * (unsigned int) length);
+    w->out = fftw_malloc(sizeof(fftw_complex) * (unsigned int) w->fpts);
+    w->plan = NULL;
+#else
+    /* size of fft input vector is power of two and larger or equal than spice vector */
+    w->N = 1;
+    w->M = 0;
+    while (w->N < length) {
+        w->N <<= 1;
+        w->M++;
+    }
+    w->fpts = w->N/2 + 1;
+    w->in = TMALLOC(double, w->N);
+#endif
+}
+
+
+/* another workspace of the same size, sharing the plan of w */
+static void
+fft_work_clone(struct fft_work *dst, const struct fft_work *w)
+{
+    fft_work_init(dst, w->length);
+#ifdef HAVE_LIBFFTW3
+    dst->plan = w->plan;
+#endif
+}
+
+
+static void
+fft_work_free(struct fft_work *w)
+{
+#ifdef HAVE_LIBFFTW3
+    fftw_free(w->in);
+    fftw_free(w->out);
+#else
+    tfree(w->in);
+#endif
+}
+
+
+/* Transform data[] weighted with win[], the unscaled spectrum is
+   returned in res[0 .. fpts-1].  The imaginary parts of the dc and
+   (for Green's FFT) the Nyquist frequency components are zero. */
+
+static void
+fft_transform(struct fft_work *w, const double *data, const double *win,
+              ngcomplex_t *res)
+{
+    int j;
+
+    for (j = 0; j < w->length; j++)
+        w->in[j] = data[j]*win[j];
+
+#ifdef HAVE_LIBFFTW3
+
+    fftw_execute_dft_r2c(w->plan, w->in, w->out);
+
+    res[0].cx_real = w->out[0][0];
+    res[0].cx_imag = 0.0;
+    for (j = 1; j < w->fpts; j++) {
+        res[j].cx_real = w->out[j][0];
+        res[j].cx_imag = w->out[j][1];
+    }
+
+#else /* Green's FFT */
+
+    for (j = w->length; j < w->N; j++)
+        w->in[j] = 0.0;
+
+    rffts(w->in, w->M, 1);
+
+    /* Re(x[0]), Re(x[N/2]), Re(x[1]), Im(x[1]), Re(x[2]), Im(x[2]), ... Re(x[N/2-1]), Im(x[N/2-1]). */
+    res[0].cx_real = w->in[0];
+    res[0].cx_imag = 0.0;
+    for (j = 1; j < w->fpts-1; j++) {
+        res[j].cx_real = w->in[2*j];
+        res[j].cx_imag = w->in[2*j+1];
+    }
+    res[w->fpts-1].cx_real = w->in[1];
+    res[w->fpts-1].cx_imag = 0.0;
+
+#endif
+}
+
+
 void
 com_fft(wordlist *wl)
 {
@@ -30,23 +138,18 @@ com_fft(wordlist *wl)
     double  **tdvec = NULL;
     double  *freq, *win = NULL, *time;
     double  span;
-    int     fpts, i, j, length, ngood;
+    int     fpts, i, length, ngood;
     struct dvec  *f, *vlist, *lv = NULL, *vec;
     struct pnode *pn, *names = NULL;
     char   window[BSIZE_SP];
     double maxt;
-    double *in = NULL;
-
-#ifdef HAVE_LIBFFTW3
-    fftw_complex *out = NULL;
-    fftw_plan plan_forward = NULL;
-#else
-    int N, M;
-#endif
+    struct fft_work work;
 
     int order;
     double scale;
 
+    work.in = NULL;
+
     if (!plot_cur || !plot_cur->pl_scale) {
         fprintf(cp_err, "Error: no vectors loaded.\n");
         goto done;
@@ -61,19 +164,6 @@ com_fft(wordlist *wl)
     time = (plot_cur->pl_scale)->v_realdata;
     span = time[length-1] - time[0];
 
-#ifdef HAVE_LIBFFTW3
-    fpts = length/2 + 1;
-#else
-    /* size of fft input vector is power of two and larger or equal than spice vector */
-    N = 1;
-    M = 0;
-    while (N < length) {
-        N <<= 1;
-        M++;
-    }
-    fpts = N/2 + 1;
-#endif
-
     win = TMALLOC(double, length);
     maxt = time[length-1];
     if (!cp_getvar("specwindow", CP_STRING, window, sizeof(window)))
@@ -121,6 +211,9 @@ com_fft(wordlist *wl)
     if (!ngood)
         goto done;
 
+    fft_work_init(&work, length);
+    fpts = work.fpts;
+
     plot_cur = plot_alloc("spectrum");
     plot_cur->pl_next = plot_list;
     plot_list = plot_cur;
@@ -139,7 +232,7 @@ com_fft(wordlist *wl)
 #ifdef HAVE_LIBFFTW3
         freq[i] = i*1.0/span;
 #else
-        freq[i] = i*1.0/span*length/N;
+        freq[i] = i*1.0/span*length/work.N;
 #endif
 
     tdvec = TMALLOC(double  *, ngood);
@@ -156,80 +249,55 @@ com_fft(wordlist *wl)
     }
 
 #ifdef HAVE_LIBFFTW3
-
     printf("FFT: Time span: %g s, input length: %d\n", span, length);
     printf("FFT: Frequency resolution: %g Hz, output length: %d\n", 1.0/span, fpts);
 
-    in = fftw_malloc(sizeof(double) * (unsigned int) length);
-    out = fftw_malloc(sizeof(fftw_complex) * (unsigned int) fpts);
-
-    for (j = 0; j < length; j++)
-        in[j] = tdvec[0][j]*win[j];
-
     /* data have same type and length - so we need only one plan */
-    plan_forward = fftw_plan_dft_r2c_1d(length, in, out, FFTW_ESTIMATE); 
-
-    for (i = 0; i<ngood; i++) {
-
-        if (i > 0) {
-            for (j = 0; j < length; j++)
-                in[j] = tdvec[i][j]*win[j];
-        }
-
-        fftw_execute(plan_forward);
-
-        scale = (double) fpts - 1.0;
-        fdvec[i][0].cx_real = out[0][0]/scale/2.0;
-        fdvec[i][0].cx_imag = 0.0;
-        for (j = 1; j < fpts; j++) {
-            fdvec[i][j].cx_real = out[j][0]/scale;
-            fdvec[i][j].cx_imag = out[j][1]/scale;
-        }
-
-    }
-
-    fftw_destroy_plan(plan_forward);
+    work.plan = fftw_plan_dft_r2c_1d(length, work.in, work.out, FFTW_ESTIMATE);
+#else
+    printf("FFT: Time span: %g s, input length: %d, zero padding: %d\n", span, length, work.N-length);
+    printf("FFT: Frequency resolution: %g Hz, output length: %d\n", 1.0/span, fpts);
 
-    fftw_free(in);
-    fftw_free(out);
+    fftInit(work.M);
+#endif
 
-#else /* Green's FFT */
+    scale = (double) fpts - 1.0;
 
-    printf("FFT: Time span: %g s, input length: %d, zero padding: %d\n", span, length, N-length);
-    printf("FFT: Frequency resolution: %g Hz, output length: %d\n", 1.0/span, fpts);
+    /* the vectors are transformed independently, in parallel if possible */
+#ifdef USE_OMP
+#pragma omp parallel if (ngood > 1)
+#endif
+    {
+        struct fft_work w;
+        int j;
 
-    for (i = 0; i<ngood; i++) {
+        fft_work_clone(&w, &work);
 
-        in = TMALLOC(double, N);
-        for (j = 0; j < length; j++) {
-            in[j] = tdvec[i][j]*win[j];
-        }
-        for (j = length; j < N; j++) {
-            in[j] = 0.0;
-        }
+#ifdef USE_OMP
+#pragma omp for schedule(dynamic)
+#endif
+        for (i = 0; i < ngood; i++) {
+            fft_transform(&w, tdvec[i], win, fdvec[i]);
 
-        fftInit(M);
-        rffts(in, M, 1);
-        fftFree();
-
-        scale = (double) fpts - 1.0;
-        /* Re(x[0]), Re(x[N/2]), Re(x[1]), Im(x[1]), Re(x[2]), Im(x[2]), ... Re(x[N/2-1]), Im(x[N/2-1]). */
-        fdvec[i][0].cx_real = in[0]/scale/2.0;
-        fdvec[i][0].cx_imag = 0.0;
-        for (j = 1; j < fpts-1; j++) {
-            fdvec[i][j].cx_real = in[2*j]/scale;
-            fdvec[i][j].cx_imag = in[2*j+1]/scale;
+            fdvec[i][0].cx_real = fdvec[i][0].cx_real/scale/2.0;
+            for (j = 1; j < fpts; j++) {
+                fdvec[i][j].cx_real = fdvec[i][j].cx_real/scale;
+                fdvec[i][j].cx_imag = fdvec[i][j].cx_imag/scale;
+            }
         }
-        fdvec[i][fpts-1].cx_real = in[1]/scale;
-        fdvec[i][fpts-1].cx_imag = 0.0;
-
-        tfree(in);
 
+        fft_work_free(&w);
     }
 
+#ifdef HAVE_LIBFFTW3
+    fftw_destroy_plan(work.plan);
+#else
+    fftFree();
 #endif
 
 done:
+    if (work.in)
+        fft_work_free(&work);
     tfree(tdvec);
     tfree(fdvec);
     tfree(win);
@@ -238,32 +306,31 @@ done:
 }
 
 
+/* psd smooth vector ...
+   The power spectral density is averaged over "psdsegments" segments
+   of the vectors, overlapping by one half (Welch's method).  The default
+   is a single segment covering the whole time span. */
+
 void
 com_psd(wordlist *wl)
 {
     ngcomplex_t **fdvec = NULL;
     double  **tdvec = NULL;
     double  *freq, *win = NULL, *time;
-    double  span, noipower;
-    int ngood, fpts, i, j, jj, length, smooth, hsmooth;
+    double  span, *noipower = NULL;
+    int ngood, fpts, i, length, smooth, hsmooth;
+    int nseg, seglen, hop;
     char    *s;
     struct dvec  *f, *vlist, *lv = NULL, *vec;
     struct pnode *pn, *names = NULL;
     char   window[BSIZE_SP];
     double maxt, intres;
+    struct fft_work work;
 
-#ifdef HAVE_LIBFFTW3
-    double *in = NULL;
-    fftw_complex *out = NULL;
-    fftw_plan plan_forward = NULL;
-#else
-    int N, M;
-#endif
-
-    double *reald = NULL;
-    double sum;
     int order;
 
+    work.in = NULL;
+
     if (!plot_cur || !plot_cur->pl_scale) {
         fprintf(cp_err, "Error: no vectors loaded.\n");
         goto done;
@@ -276,7 +343,6 @@ com_psd(wordlist *wl)
 
     length = (plot_cur->pl_scale)->v_length;
     time = (plot_cur->pl_scale)->v_realdata;
-    span = time[length-1] - time[0];
 
     // get filter length from parameter input
     s = wl->wl_word;
@@ -293,21 +359,26 @@ com_psd(wordlist *wl)
 
     wl = wl->wl_next;
 
-#ifdef HAVE_LIBFFTW3
-    fpts = length/2 + 1;
-#else
-    /* size of fft input vector is power of two and larger or equal than spice vector */
-    N = 1;
-    M = 0;
-    while (N < length) {
-        N <<= 1;
-        M++;
+    // number of segments for Welch averaging
+    if (!cp_getvar("psdsegments", CP_NUM, &nseg, 0) || nseg < 1)
+        nseg = 1;
+    if (nseg > 1) {
+        seglen = 2 * length / (nseg + 1);
+        if (seglen < 4) {
+            fprintf(cp_err, "Error: too many psd segments for %d data points\n", length);
+            goto done;
+        }
+        hop = seglen / 2;
+    }
+    else {
+        seglen = length;
+        hop = 0;
     }
-    fpts = N/2 + 1;
-#endif
 
-    win = TMALLOC(double, length);
-    maxt = time[length-1];
+    /* the window is the same for all segments of the (equidistant) data */
+    span = time[seglen-1] - time[0];
+    win = TMALLOC(double, seglen);
+    maxt = time[seglen-1];
     if (!cp_getvar("specwindow", CP_STRING, window, sizeof(window)))
         strcpy(window, "hanning");
     if (!cp_getvar("specwindoworder", CP_NUM, &order, 0))
@@ -315,7 +386,7 @@ com_psd(wordlist *wl)
     if (order < 2)
         order = 2;
 
-    if (fft_windows(window, win, time, length, maxt, span, order) == 0)
+    if (fft_windows(window, win, time, seglen, maxt, span, order) == 0)
         goto done;
 
     names = ft_getpnames_quotes(wl, TRUE);
@@ -353,6 +424,9 @@ com_psd(wordlist *wl)
     if (!ngood)
         goto done;
 
+    fft_work_init(&work, seglen);
+    fpts = work.fpts;
+
     plot_cur = plot_alloc("spectrum");
     plot_cur->pl_next = plot_list;
     plot_list = plot_cur;
@@ -371,7 +445,7 @@ com_psd(wordlist *wl)
 #ifdef HAVE_LIBFFTW3
         freq[i] = i*1./span;
 #else
-        freq[i] = i*1./span*length/N;
+        freq[i] = i*1./span*seglen/work.N;
 #endif
 
     tdvec = TMALLOC(double*, ngood);
@@ -388,126 +462,121 @@ com_psd(wordlist *wl)
     }
 
 #ifdef HAVE_LIBFFTW3
-
-    printf("PSD: Time span: %g s, input length: %d\n", span, length);
+    printf("PSD: Time span: %g s, input length: %d\n", span, seglen);
     printf("PSD: Frequency resolution: %g Hz, output length: %d\n", 1.0/span, fpts);
 
-    reald = TMALLOC(double, fpts);
+    intres = (double)seglen * (double)seglen;
 
-    in = fftw_malloc(sizeof(double) * (unsigned int) length);
-    out = fftw_malloc(sizeof(fftw_complex) * (unsigned int) fpts);
+    /* data have same type and length - so we need only one plan */
+    work.plan = fftw_plan_dft_r2c_1d(seglen, work.in, work.out, FFTW_ESTIMATE);
+#else
+    printf("PSD: Time span: %g s, input length: %d, zero padding: %d\n", span, seglen, work.N-seglen);
+    printf("PSD: Frequency resolution: %g Hz, output length: %d\n", 1.0/span, fpts);
 
-    for (j = 0; j < length; j++)
-        in[j] = tdvec[0][j]*win[j];
+    intres = (double)work.N * (double)work.N;
 
-    /* data have same type and length - so we need only one plan */
-    plan_forward = fftw_plan_dft_r2c_1d(length, in, out, FFTW_ESTIMATE);
+    fftInit(work.M);
+#endif
+    if (nseg > 1)
+        printf("PSD: Averaged over %d segments overlapping by %d points\n", nseg, seglen - hop);
 
-    for (i = 0; i<ngood; i++) {
+    noipower = TMALLOC(double, ngood);
+    hsmooth = smooth>>1;
 
-        if (i > 0) {
-            for (j = 0; j < length; j++)
-                in[j] = tdvec[i][j]*win[j];
-        }
+    /* the vectors are processed independently, in parallel if possible */
+#ifdef USE_OMP
+#pragma omp parallel if (ngood > 1)
+#endif
+    {
+        struct fft_work w;
+        ngcomplex_t *spec = TMALLOC(ngcomplex_t, fpts);
+        double *reald = TMALLOC(double, fpts);
+        double sum;
+        int j, jj, k;
 
-        fftw_execute(plan_forward);
-
-        intres = (double)length * (double)length;
-        fdvec[i][0].cx_real = out[0][0]*out[0][0]/intres;
-        fdvec[i][0].cx_imag = 0;
-        noipower = fdvec[i][0].cx_real;
-        for (j = 1; j < fpts-1; j++) {
-            fdvec[i][j].cx_real = 2.* (out[j][0]*out[j][0] + out[j][1]*out[j][1])/intres;
-            fdvec[i][j].cx_imag = 0;
-            noipower += fdvec[i][j].cx_real;
-            if (!finite(noipower))
-                break;
-        }
-        fdvec[i][fpts-1].cx_real = out[fpts-1][0]*out[fpts-1][0]/intres;
-        fdvec[i][fpts-1].cx_imag = 0;
-        noipower += fdvec[i][fpts-1].cx_real;
+        fft_work_clone(&w, &work);
 
-#else /* Green's FFT */
+#ifdef USE_OMP
+#pragma omp for schedule(dynamic)
+#endif
+        for (i = 0; i < ngood; i++) {
 
-    printf("PSD: Time span: %g s, input length: %d, zero padding: %d\n", span, length, N-length);
-    printf("PSD: Frequency resolution: %g Hz, output length: %d\n", 1.0/span, fpts);
+            for (j = 0; j < fpts; j++) {
+                fdvec[i][j].cx_real = 0.0;
+                fdvec[i][j].cx_imag = 0.0;
+            }
 
-    reald = TMALLOC(double, N);
+            /* one sided periodogram, summed over the segments */
+            for (k = 0; k < nseg; k++) {
+                fft_transform(&w, tdvec[i] + k * hop, win, spec);
 
-    for (i = 0; i<ngood; i++) {
+                fdvec[i][0].cx_real += spec[0].cx_real*spec[0].cx_real/intres;
+                for (j = 1; j < fpts-1; j++)
+                    fdvec[i][j].cx_real += 2.* (spec[j].cx_real*spec[j].cx_real + spec[j].cx_imag*spec[j].cx_imag)/intres;
+                fdvec[i][fpts-1].cx_real += spec[fpts-1].cx_real*spec[fpts-1].cx_real/intres;
+            }
 
-        for (j = 0; j < length; j++) {
-            reald[j] = (tdvec[i][j]*win[j]);
-        }
-        for (j = length; j < N; j++) {
-            reald[j] = 0.;
-        }
+            if (nseg > 1)
+                for (j = 0; j < fpts; j++)
+                    fdvec[i][j].cx_real /= nseg;
 
-        fftInit(M);
-        rffts(reald, M, 1);
-        fftFree();
-
-        /* Re(x[0]), Re(x[N/2]), Re(x[1]), Im(x[1]), Re(x[2]), Im(x[2]), ... Re(x[N/2-1]), Im(x[N/2-1]). */
-        intres = (double)N * (double)N;
-        fdvec[i][0].cx_real = reald[0]*reald[0]/intres;
-        fdvec[i][0].cx_imag = 0;
-        noipower = fdvec[i][0].cx_real;
-        for (j = 1; j < fpts-1; j++) {
-            jj = j<<1;
-            fdvec[i][j].cx_real = 2.* (reald[jj]*reald[jj] + reald[jj + 1]*reald[jj + 1])/intres;
-            fdvec[i][j].cx_imag = 0;
-            noipower += fdvec[i][j].cx_real;
-            if (!finite(noipower))
-                break;
+            noipower[i] = fdvec[i][0].cx_real;
+            for (j = 1; j < fpts-1; j++) {
+                noipower[i] += fdvec[i][j].cx_real;
+                if (!finite(noipower[i]))
+                    break;
+            }
+            noipower[i] += fdvec[i][fpts-1].cx_real;
+
+            /* smoothing with rectangular window of width "smooth",
+               plotting V^2/Hz or I^2/Hz */
+            for (j = 0; j < hsmooth; j++) {
+                sum = 0.;
+                for (jj = 0; jj < hsmooth + j; jj++)
+                    sum += fdvec[i][jj].cx_real;
+                sum /= (double) (hsmooth + j);
+                reald[j] = sum;
+            }
+            for (j = hsmooth; j < fpts-hsmooth; j++) {
+                sum = 0.;
+                for (jj = 0; jj < smooth; jj++)
+                    sum += fdvec[i][j-hsmooth+jj].cx_real;
+                sum /= (double) smooth;
+                reald[j] = sum;
+            }
+            for (j = fpts-hsmooth; j < fpts; j++) {
+                sum = 0.;
+                for (jj = 0; jj < fpts+hsmooth-j-1; jj++)
+                    sum += fdvec[i][j-hsmooth+jj+1].cx_real;
+                sum /= (double) (fpts+hsmooth-j-1);
+                reald[j] = sum;
+            }
+            for (j = 0; j < fpts; j++)
+                fdvec[i][j].cx_real = reald[j] * (double)fpts / freq[fpts - 1];
         }
-        fdvec[i][fpts-1].cx_real = reald[1]*reald[1]/intres;
-        fdvec[i][fpts-1].cx_imag = 0;
-        noipower += fdvec[i][fpts-1].cx_real;
 
-#endif
+        fft_work_free(&w);
+        tfree(spec);
+        tfree(reald);
+    }
 
+    for (i = 0; i < ngood; i++)
         printf("Total noise power up to Nyquist frequency %5.3e Hz: %e V^2 (or A^2), \nNoise voltage or current: %e V (or A)\n",
-               freq[fpts-1], noipower, sqrt(noipower));
-
-        /* smoothing with rectangular window of width "smooth",
-           plotting V^2/Hz or I^2/Hz */
-        hsmooth = smooth>>1;
-        for (j = 0; j < hsmooth; j++) {
-            sum = 0.;
-            for (jj = 0; jj < hsmooth + j; jj++)
-                sum += fdvec[i][jj].cx_real;
-            sum /= (double) (hsmooth + j);
-            reald[j] = sum;
-        }
-        for (j = hsmooth; j < fpts-hsmooth; j++) {
-            sum = 0.;
-            for (jj = 0; jj < smooth; jj++)
-                sum += fdvec[i][j-hsmooth+jj].cx_real;
-            sum /= (double) smooth;
-            reald[j] = sum;
-        }
-        for (j = fpts-hsmooth; j < fpts; j++) {
-            sum = 0.;
-            for (jj = 0; jj < fpts+hsmooth-j-1; jj++)
-                sum += fdvec[i][j-hsmooth+jj+1].cx_real;
-            sum /= (double) (fpts+hsmooth-j-1);
-            reald[j] = sum;
-        }
-        for (j = 0; j < fpts; j++)
-            fdvec[i][j].cx_real = reald[j] * (double)fpts / freq[fpts - 1];
-    }
+               freq[fpts-1], noipower[i], sqrt(noipower[i]));
 
 #ifdef HAVE_LIBFFTW3
-    fftw_destroy_plan(plan_forward);
-    fftw_free(in);
-    fftw_free(out);
+    fftw_destroy_plan(work.plan);
+#else
+    fftFree();
 #endif
+
 done:
+    if (work.in)
+        fft_work_free(&work);
     tfree(tdvec);
     tfree(fdvec);
     tfree(win);
-
-    tfree(reald);
+    tfree(noipower);
 
     free_pnode(names);
 }
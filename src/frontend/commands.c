@@ -401,6 +401,14 @@ struct comm spcp_coms[] = {
       { 040, 040, 040, 040 }, E_DEFHMASK, 0, LOTS,
       NULL,
       "devspecs : parmname value : Alter model parameters." } ,
+    { "alterbulk", com_alterbulk, TRUE, FALSE,
+      { 040, 040, 040, 040 }, E_DEFHMASK, 1, LOTS,
+      NULL,
+      "pattern parmname = values : Alter a parameter of many devices." } ,
+    { "altermodbulk", com_altermodbulk, TRUE, FALSE,
+      { 040, 040, 040, 040 }, E_DEFHMASK, 1, LOTS,
+      NULL,
+      "pattern parmname = values : Alter a parameter of many models." } ,
     { "alterparam", com_alterparam, TRUE, FALSE,
       { 040, 040, 040, 040 }, E_DEFHMASK, 1, LOTS,
       NULL,
@@ -428,7 +436,7 @@ struct comm spcp_coms[] = {
     { "iplot", com_iplot, TRUE, TRUE,
       { 0200, 0200, 0200, 0200 }, E_DEFHMASK, 0, LOTS,
       NULL,
-      "[-w width] [-s initial_steps] [all] [node ...] : Incrementally plot nodes." } ,
+      "[-w width] [-s initial_steps] [-o file] [all] [node ...] : Incrementally plot nodes." } ,
     { "status", com_sttus, TRUE, FALSE,
       { 0, 0, 0, 0 }, E_DEFHMASK, 0, 0,
       NULL,
@@ -877,6 +885,14 @@ struct comm nutcp_coms[] = {
       { 040, 040, 040, 040 }, E_DEFHMASK, 3, LOTS,
       NULL,
       "devspecs : parmname value : Alter model parameters." } ,
+    { "alterbulk", NULL, TRUE, FALSE,
+      { 040, 040, 040, 040 }, E_DEFHMASK, 1, LOTS,
+      NULL,
+      "pattern parmname = values : Alter a parameter of many devices." } ,
+    { "altermodbulk", NULL, TRUE, FALSE,
+      { 040, 040, 040, 040 }, E_DEFHMASK, 1, LOTS,
+      NULL,
+      "pattern parmname = values : Alter a parameter of many models." } ,
     { "resume", NULL, TRUE, FALSE,
       { 0, 0, 0, 0 }, E_DEFHMASK, 0, 0,
       NULL,
@@ -144,6 +144,10 @@ ft_cpinit(void)
         cp_addkword(CT_RUSEARGS, "solvetime");
         cp_addkword(CT_RUSEARGS, "transolvetime");
         cp_addkword(CT_RUSEARGS, "loadtime");
+        cp_addkword(CT_RUSEARGS, "reorders");
+        cp_addkword(CT_RUSEARGS, "reusedorders");
+        cp_addkword(CT_RUSEARGS, "memolookups");
+        cp_addkword(CT_RUSEARGS, "memohits");
         cp_addkword(CT_RUSEARGS, "all");
 
         cp_addkword(CT_VECTOR, "all");
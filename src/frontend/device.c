@@ -1458,6 +1458,176 @@ com_alter_common(wordlist *wl, int do_model)
 }
 
 
+/*
+ * Alter a parameter of many devices or models in one go:
+ *   alterbulk pattern parameter = expr
+ *   altermodbulk pattern parameter = expr
+ * pattern may contain the wildcards '*' and '?'.  expr is either a
+ * single value, set for all devices (models) matching pattern, or a
+ * vector with one element per match, assigned in the alphabetic order
+ * of the names.
+ */
+
+static void com_alterbulk_common(wordlist *wl, int do_model);
+
+void
+com_alterbulk(wordlist *wl)
+{
+    com_alterbulk_common(wl, 0);
+}
+
+
+void
+com_altermodbulk(wordlist *wl)
+{
+    com_alterbulk_common(wl, 1);
+}
+
+
+static bool
+alterbulk_match(const char *pattern, const char *name)
+{
+    for (; *pattern; pattern++, name++) {
+        if (*pattern == '*') {
+            do
+                if (alterbulk_match(pattern + 1, name))
+                    return TRUE;
+            while (*name++);
+            return FALSE;
+        }
+        if (!*name || (*pattern != '?' && *pattern != *name))
+            return FALSE;
+    }
+
+    return (*name == '\0');
+}
+
+
+static int
+alterbulk_cmp_inst(const void *a, const void *b)
+{
+    return strcmp((*(GENinstance * const *) a)->GENname,
+                  (*(GENinstance * const *) b)->GENname);
+}
+
+
+static int
+alterbulk_cmp_mod(const void *a, const void *b)
+{
+    return strcmp((*(GENmodel * const *) a)->GENmodName,
+                  (*(GENmodel * const *) b)->GENmodName);
+}
+
+
+static void
+com_alterbulk_common(wordlist *wl, int do_model)
+{
+    CKTcircuit *ckt;
+    GENmodel *mod;
+    GENinstance *inst;
+    struct pnode *names;
+    struct dvec *dv = NULL;
+    char *line, *expr, *rest, *pattern = NULL, *param = NULL;
+    GENinstance **insts = NULL;
+    GENmodel **mods = NULL;
+    char **params = NULL;
+    double *values = NULL;
+    int i, n = 0, size = 0;
+
+    if (!ft_curckt || !ft_curckt->ci_ckt) {
+        fprintf(cp_err, "Error: no circuit loaded\n");
+        return;
+    }
+    ckt = ft_curckt->ci_ckt;
+
+    line = wl_flatten(wl);
+    expr = strchr(line, '=');
+    if (!expr || !expr[1]) {
+        fprintf(cp_err, "Error: no assignment found.\n");
+        fprintf(cp_err, "Cannot alter parameters.\n");
+        tfree(line);
+        return;
+    }
+    *expr++ = '\0';
+
+    rest = line;
+    pattern = gettok(&rest);
+    param = gettok(&rest);
+    if (!param || *rest) {
+        fprintf(cp_err, "usage: %s pattern parameter = expression\n",
+                do_model ? "altermodbulk" : "alterbulk");
+        goto done;
+    }
+    strtolower(pattern);
+    strtolower(param);
+
+    /* collect the matching devices or models, they are resolved only here */
+    for (i = 0; i < ft_sim->numDevices; i++)
+        for (mod = ckt->CKThead[i]; mod; mod = mod->GENnextModel) {
+            if (do_model) {
+                if (alterbulk_match(pattern, mod->GENmodName)) {
+                    if (n == size)
+                        mods = TREALLOC(GENmodel *, mods, size = 2 * size + 16);
+                    mods[n++] = mod;
+                }
+                continue;
+            }
+            for (inst = mod->GENinstances; inst; inst = inst->GENnextInstance)
+                if (alterbulk_match(pattern, inst->GENname)) {
+                    if (n == size)
+                        insts = TREALLOC(GENinstance *, insts, size = 2 * size + 16);
+                    insts[n++] = inst;
+                }
+        }
+
+    if (n == 0) {
+        fprintf(cp_err, "Error: no %s matches %s\n",
+                do_model ? "model" : "device", pattern);
+        goto done;
+    }
+    if (do_model) {
+        qsort(mods, (size_t) n, sizeof(GENmodel *), alterbulk_cmp_mod);
+        insts = TMALLOC(GENinstance *, n);
+    } else {
+        qsort(insts, (size_t) n, sizeof(GENinstance *), alterbulk_cmp_inst);
+        mods = TMALLOC(GENmodel *, n);
+    }
+
+    names = ft_getpnames_from_string(expr, TRUE);
+    if (names)
+        dv = ft_evaluate(names);
+    if (!dv || (dv->v_length != 1 && dv->v_length != n) || !isreal(dv)) {
+        if (dv && dv->v_length != 1 && dv->v_length != n)
+            fprintf(cp_err, "Error: %d values given for %d %s.\n",
+                    dv->v_length, n, do_model ? "models" : "devices");
+        else
+            fprintf(cp_err, "Error: cannot evaluate new parameter value.\n");
+    } else {
+        params = TMALLOC(char *, n);
+        values = TMALLOC(double, n);
+        for (i = 0; i < n; i++) {
+            params[i] = param;
+            values[i] = dv->v_realdata[dv->v_length == 1 ? 0 : i];
+        }
+        if_setparam_list(ckt, n, insts, mods, params, values);
+        tfree(params);
+        tfree(values);
+    }
+
+    /* as in com_alter_common() */
+    if (names && !names->pn_value && dv)
+        vec_free(dv);
+    free_pnode(names);
+
+ done:
+    tfree(insts);
+    tfree(mods);
+    tfree(pattern);
+    tfree(param);
+    tfree(line);
+}
+
+
 /* Given a device name, possibly with wildcards, return the matches. */
 
 static wordlist *
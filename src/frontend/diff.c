@@ -19,9 +19,21 @@ Patched: 2010/2012 by Bill Swartz (hash table for vectors)
 #include "diff.h"
 #include "variable.h"
 
+/* Comparison of a vector pair */
+struct diff_res {
+    struct dvec *v1, *v2;
+    double *d2;         /* v2 resampled to the scale of v1, or NULL */
+    int len2;           /* length of v2 or d2 */
+    int first;          /* index of first point out of tolerance, or -1 */
+    int nfail;          /* number of points out of tolerance */
+    double maxerr;      /* largest difference */
+};
+
 static bool nameeq(const char *n1, const char *n2);
 static char *canonical_name(const char *name, DSTRINGPTR dbuf_p,
         bool make_i_name_lower);
+static void diff_resample(struct diff_res *r, struct plot *p1, struct plot *p2);
+static void diff_vectors(struct diff_res *r, double tol, double reltol, bool stop);
 
 
 
@@ -107,6 +119,102 @@ nameeq(const char *n1, const char *n2)
 
 
 
+/* If the plots have different real scales, interpolate r->v2 onto the
+ * scale of p1, so the vectors can be compared point by point. */
+static void
+diff_resample(struct diff_res *r, struct plot *p1, struct plot *p2)
+{
+    struct dvec *s1 = p1->pl_scale, *s2 = p2->pl_scale;
+    int i;
+
+    r->len2 = r->v2->v_length;
+
+    if (!s1 || !s2 || !isreal(s1) || !isreal(s2) || !isreal(r->v1) ||
+        r->v1->v_length != s1->v_length ||
+        r->v2->v_length != s2->v_length || s2->v_length < 2)
+        return;
+
+    if (s1->v_length == s2->v_length) {
+        for (i = 0; i < s1->v_length; i++)
+            if (s1->v_realdata[i] != s2->v_realdata[i])
+                break;
+        if (i == s1->v_length)
+            return;
+    }
+
+    /* the scale itself is resampled onto the first scale */
+    r->d2 = TMALLOC(double, s1->v_length);
+    if (r->v1 == s1) {
+        memcpy(r->d2, s1->v_realdata, (size_t) s1->v_length * sizeof(double));
+    } else if (!ft_interpolate(r->v2->v_realdata, r->d2, s2->v_realdata,
+                        s2->v_length, s1->v_realdata, s1->v_length, 1)) {
+        fprintf(cp_err, "Warning: can't interpolate %s, compared by index\n",
+                r->v2->v_name);
+        tfree(r->d2);
+        return;
+    }
+    r->len2 = s1->v_length;
+}
+
+
+/* Compare the vectors of r up to the shorter length.  With stop set,
+ * return at the first point out of tolerance. */
+static void
+diff_vectors(struct diff_res *r, double tol, double reltol, bool stop)
+{
+    struct dvec *v1 = r->v1, *v2 = r->v2;
+    int i, n = MIN(v1->v_length, r->len2);
+
+    r->first = -1;
+    r->nfail = 0;
+    r->maxerr = 0.0;
+
+    if (isreal(v1)) {
+        double *d1 = v1->v_realdata;
+        double *d2 = r->d2 ? r->d2 : v2->v_realdata;
+        for (i = 0; i < n; i++) {
+            double err = fabs(d1[i] - d2[i]);
+            if (err > r->maxerr)
+                r->maxerr = err;
+            if (MAX(fabs(d1[i]), fabs(d2[i])) * reltol + tol < err) {
+                if (r->first < 0)
+                    r->first = i;
+                r->nfail++;
+                if (stop)
+                    return;
+            }
+        }
+    } else {
+        ngcomplex_t *c1 = v1->v_compdata;
+        ngcomplex_t *c2 = v2->v_compdata;
+        for (i = 0; i < n; i++) {
+            ngcomplex_t c3;
+            double err;
+            realpart(c3) = realpart(c1[i]) - realpart(c2[i]);
+            imagpart(c3) = imagpart(c1[i]) - imagpart(c2[i]);
+            err = cmag(c3);
+            if (err > r->maxerr)
+                r->maxerr = err;
+            if (MAX(cmag(c1[i]), cmag(c2[i])) * reltol + tol < err) {
+                if (r->first < 0)
+                    r->first = i;
+                r->nfail++;
+                if (stop)
+                    return;
+            }
+        }
+    }
+}
+
+
+/* diff plot1 plot2 [vector ...]
+ * diff_summary: print one line per vector with the number of points out
+ *     of tolerance, the largest difference and the scale value of the
+ *     first failing point
+ * diff_stop: stop at the first difference
+ * diff_interpolate: compare plots with different scales after linear
+ *     interpolation of the second plot to the scale of the first
+ */
 void
 com_diff(wordlist *wl)
 {
@@ -115,7 +223,9 @@ com_diff(wordlist *wl)
     struct dvec *v1, *v2;
     double d1, d2;
     ngcomplex_t c1, c2, c3;
-    int i, j;
+    int i, j, k, n, lowest;
+    struct diff_res *res;
+    bool summary, stop, interpolate;
     char *v1_name;          /* canonical v1 name */
     char *v2_name;          /* canonical v2 name */
     NGHASHPTR crossref_p;   /* cross reference hash table */
@@ -128,6 +238,9 @@ com_diff(wordlist *wl)
         abstol = 1.0e-12;
     if (!cp_getvar("diff_reltol", CP_REAL, &reltol, 0))
         reltol = 0.001;
+    summary = cp_getvar("diff_summary", CP_BOOL, NULL, 0);
+    stop = cp_getvar("diff_stop", CP_BOOL, NULL, 0);
+    interpolate = cp_getvar("diff_interpolate", CP_BOOL, NULL, 0);
 
     /* Let's try to be clever about defaults. This code is ugly. */
     if (!wl || !wl->wl_next) {
@@ -253,35 +366,102 @@ com_diff(wordlist *wl)
             }
     }
 
-    /* Now we have all the vectors linked to their twins.  Travel
-     * down each one and print values that differ enough.
+    /* Now we have all the vectors linked to their twins.  Compare
+     * them, in parallel if possible, then print values that differ
+     * enough, or a summary per vector.
      */
-    for (v1 = p1->pl_dvecs; v1; v1 = v1->v_next) {
+    n = 0;
+    for (v1 = p1->pl_dvecs; v1; v1 = v1->v_next)
+        if (v1->v_link2)
+            n++;
+    if (n == 0)
+        return;
+
+    res = TMALLOC(struct diff_res, n);
+    for (i = 0, v1 = p1->pl_dvecs; v1; v1 = v1->v_next) {
         if (!v1->v_link2)
             continue;
-        v2 = v1->v_link2;
-        if (v1->v_type == SV_VOLTAGE)
-            tol = vntol;
-        else
-            tol = abstol;
-        j = MAX(v1->v_length, v2->v_length);
-        for (i = 0; i < j; i++) {
-            if (v1->v_length <= i) {
-                fprintf(cp_out,
-                        ">>> %s is %d long in %s and %d long in %s\n",
-                        v1->v_name, v1->v_length,
-                        p1->pl_typename, v2->v_length, p2->pl_typename);
-                break;
-            } else if (v2->v_length <= i) {
-                fprintf(cp_out,
-                        ">>> %s is %d long in %s and %d long in %s\n",
-                        v2->v_name, v2->v_length,
-                        p2->pl_typename, v1->v_length, p1->pl_typename);
-                break;
-            } else {
+        res[i].v1 = v1;
+        res[i].v2 = v1->v_link2;
+        res[i].d2 = NULL;
+        res[i].len2 = res[i].v2->v_length;
+        if (interpolate)
+            diff_resample(&res[i], p1, p2);
+        i++;
+    }
+
+    /* With diff_stop, the output ends at the lowest index of a vector
+     * out of tolerance.  Vectors behind a failure already found need
+     * no comparison, all others are compared whatever the thread
+     * timing is, so the same failure is reported in every run.
+     */
+    lowest = n;
+
+#ifdef USE_OMP
+#pragma omp parallel for schedule(dynamic) if (n > 1)
+#endif
+    for (i = 0; i < n; i++) {
+        int low;
+#ifdef USE_OMP
+#pragma omp atomic read
+#endif
+        low = lowest;
+        if (stop && i > low) {
+            res[i].first = -1;
+            res[i].nfail = 0;
+            res[i].maxerr = 0.0;
+            continue;
+        }
+        diff_vectors(&res[i], (res[i].v1->v_type == SV_VOLTAGE) ? vntol : abstol,
+                     reltol, stop);
+        if (stop && res[i].first >= 0) {
+#ifdef USE_OMP
+#pragma omp critical (diff_lowest)
+#endif
+            {
+#ifdef USE_OMP
+#pragma omp atomic read
+#endif
+                low = lowest;
+                if (i < low) {
+#ifdef USE_OMP
+#pragma omp atomic write
+#endif
+                    lowest = i;
+                }
+            }
+        }
+    }
+
+    if (summary)
+        fprintf(cp_out, "vector\tfailed\tmaxerror\tfirst\n");
+
+    for (k = 0; k < n; k++) {
+        v1 = res[k].v1;
+        v2 = res[k].v2;
+
+        if (summary) {
+            fprintf(cp_out, "%s\t%d\t%e\t", v1->v_name, res[k].nfail,
+                    res[k].maxerr);
+            if (res[k].first < 0)
+                fprintf(cp_out, "-\n");
+            else if (p1->pl_scale && isreal(p1->pl_scale) &&
+                     res[k].first < p1->pl_scale->v_length)
+                fprintf(cp_out, "%e\n",
+                        p1->pl_scale->v_realdata[res[k].first]);
+            else
+                fprintf(cp_out, "%d\n", res[k].first);
+        }
+        else if (res[k].first >= 0) {
+            if (v1->v_type == SV_VOLTAGE)
+                tol = vntol;
+            else
+                tol = abstol;
+            j = MIN(v1->v_length, res[k].len2);
+            for (i = res[k].first; i < j; i++) {
                 if (isreal(v1)) {
                     d1 = v1->v_realdata[i];
-                    d2 = v2->v_realdata[i];
+                    d2 = res[k].d2 ? res[k].d2[i] : v2->v_realdata[i];
                     if (MAX(fabs(d1), fabs(d2)) * reltol +
                         tol < fabs(d1 - d2)) {
                         printnum(numbuf, d1);
@@ -292,6 +472,8 @@ com_diff(wordlist *wl)
                         fprintf(cp_out,
                                 "%s.%s[%d] = %s\n",
                                 p2->pl_typename, v2->v_name, i, numbuf);
+                        if (stop)
+                            break;
                     }
                 } else {
                     c1 = v1->v_compdata[i];
@@ -317,10 +499,31 @@ com_diff(wordlist *wl)
                                 p2->pl_typename, v2->v_name, i,
                                 numbuf3,
                                 numbuf4);
+                        if (stop)
+                            break;
                     }
                 }
             }
         }
+
+        if (v1->v_length < res[k].len2)
+            fprintf(cp_out,
+                    ">>> %s is %d long in %s and %d long in %s\n",
+                    v1->v_name, v1->v_length,
+                    p1->pl_typename, v2->v_length, p2->pl_typename);
+        else if (res[k].len2 < v1->v_length)
+            fprintf(cp_out,
+                    ">>> %s is %d long in %s and %d long in %s\n",
+                    v2->v_name, v2->v_length,
+                    p2->pl_typename, v1->v_length, p1->pl_typename);
+
+        tfree(res[k].d2);
+
+        if (stop && res[k].first >= 0)
+            break;
     }
-}
 
+    for (; k < n; k++)
+        tfree(res[k].d2);
+    tfree(res);
+}
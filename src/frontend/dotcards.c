@@ -57,7 +57,7 @@ setcplot(char *name)
 void
 ft_dotsaves(void)
 {
-    wordlist *iline, *wl = NULL;
+    wordlist *iline, *wl = NULL, *last = NULL;
     char *s;
 
     if (!ft_curckt) /* Shouldn't happen. */
@@ -68,7 +68,12 @@ ft_dotsaves(void)
             s = iline->wl_word;
             /* skip .save */
             s = nexttok(s);
-            wl = wl_append(wl, gettoks(s));
+            /* append at the tail, there may be many .save lines */
+            last = wl_append(last, gettoks(s));
+            if (!wl)
+                wl = last;
+            while (last && last->wl_next)
+                last = last->wl_next;
         }
 
     com_save(wl);
@@ -12,6 +12,8 @@
 #include "ngspice/wordlist.h"
 #include "ngspice/stringskip.h"
 
+#include "inpcache.h"
+
 void inp_probe(struct card* card);
 void modprobenames(INPtables* tab);
 
@@ -95,7 +97,7 @@ void inp_probe(struct card* deck)
     }
 
     /* set a variable if .probe command is given */
-    cp_vset("probe_is_given", CP_BOOL, &t);
+    inp_cache_setvar("probe_is_given", CP_BOOL, &t);
 
     /* Assemble all .probe parameters in a wordlist 'probeparams' */
     for (wltmp = probes; wltmp; wltmp = wltmp->wl_next) {
@@ -0,0 +1,680 @@
+/**********
+Copyright 2024 The ngspice team.  All rights reserved.
+License: Three-clause BSD
+**********/
+
+/*
+  Cache of pre-processed input decks
+
+  inp_readall() spends most of its time on reading the input files,
+  .lib and .include handling and the many compatibility
+  transformations of the netlist.  If the variable 'inpcache' is set
+  to a directory, the deck returned by inp_readall() is stored there
+  in a compact binary form.  The entry is keyed by the input file name,
+  the working directory, the compatibility mode and the variables which
+  influence the pre-processing.  It records every file read together
+  with its size and a hash of its contents.  A later inp_readall() of
+  the same input restores the deck from the entry, if none of these
+  files has changed.
+
+  The pre-processing also leaves some results outside the deck: it
+  sets command variables (probe_is_given, auto_bridge, ...) and expands
+  environment variables in .include and .lib paths.  These go through
+  inp_cache_setvar(), inp_cache_remvar() and inp_cache_getenv(), which
+  record them in the entry.  The variables are set again when the deck
+  is restored, the entry is only used if the environment variables
+  still have the recorded values.
+*/
+
+#include "ngspice/ngspice.h"
+
+#include "ngspice/compatmode.h"
+#include "ngspice/cpdefs.h"
+#include "ngspice/ftedefs.h"
+#include "ngspice/fteinp.h"
+#include "ngspice/wordlist.h"
+
+#if !defined(__MINGW32__) && !defined(_MSC_VER)
+#include <unistd.h>
+#endif
+
+#include "inp.h"
+#include "inpcache.h"
+#include "inpcom.h"
+#include "variable.h"
+
+extern wordlist *sourceinfo;
+
+#define INPCACHE_MAGIC "ngdeck2\n"
+
+#define FNV_OFFSET 14695981039346656037ULL
+#define FNV_PRIME  1099511628211ULL
+
+/* A file read while the deck is assembled */
+struct cache_dep {
+    char *path;
+    bool libfile;       /* added to 'sourcepath' by inp_read() */
+};
+
+/* An environment variable read, or a command variable set or removed
+   while the deck is assembled */
+struct cache_var {
+    char *name;
+    int type;           /* CP_BOOL, CP_NUM, CP_STRING, or -1: removed,
+                           -2: environment variable */
+    int num;
+    char *str;          /* NULL for an unset environment variable */
+};
+
+static struct cache_dep *deps;
+static int ndeps, maxdeps;
+static struct cache_var *vars;
+static int nvars, maxvars;
+static bool recording;
+
+/* Variables read by the pre-processing, including the pspice
+   translation of U devices, and by the subcircuit expansion */
+static const char *key_vars[] = {
+    "addcontrol", "enable_noisy_r", "mingwpath", "no_auto_gnd",
+    "probe_alli_nox", "rawfile", "sourcepath", "wnflag",
+    "ps_global_hash_table", "ps_global_tmodels", "ps_ports_and_pins",
+    "ps_scan_gates_optimize", "ps_tpz_delays", "ps_udevice_exit",
+    "ps_udevice_msgs", "ps_use_mntymx", "ps_with_inverters",
+    "ps_with_tri_inverters",
+    "modelcard", "modelline", "scale", "subend", "subinvoke", "substart"
+};
+
+struct cache_io {
+    FILE *fp;
+    bool err;
+};
+
+
+static unsigned long long
+hash_bytes(unsigned long long h, const void *p, size_t n)
+{
+    const unsigned char *s = (const unsigned char *) p;
+
+    while (n--) {
+        h ^= *s++;
+        h *= FNV_PRIME;
+    }
+    return h;
+}
+
+
+static unsigned long long
+hash_str(unsigned long long h, const char *s)
+{
+    return hash_bytes(h, s ? s : "", s ? strlen(s) + 1 : 1);
+}
+
+
+/* Hash the value of variable 'name' of any type, or its absence */
+static unsigned long long
+hash_var(unsigned long long h, const char *name)
+{
+    char buf[BSIZE_SP];
+    wordlist *wl, *w, *prev;
+    bool set;
+
+    /* $?name, cp_getvar() would fail for a type other than asked for */
+    snprintf(buf, sizeof(buf), "?%s", name);
+    wl = vareval(buf);
+    set = wl && eq(wl->wl_word, "1");
+    wl_free(wl);
+    if (!set)
+        return hash_str(h, "");
+
+    strncpy(buf, name, sizeof(buf) - 1);
+    buf[sizeof(buf) - 1] = '\0';
+    wl = vareval(buf);
+    h = hash_str(h, name);
+    /* each load adds its directory to 'sourcepath' again, repeated
+       words of a list do not change the result */
+    for (w = wl; w; w = w->wl_next) {
+        for (prev = wl; prev != w; prev = prev->wl_next)
+            if (eq(prev->wl_word, w->wl_word))
+                break;
+        if (prev == w)
+            h = hash_str(h, w->wl_word);
+    }
+    wl_free(wl);
+    return h;
+}
+
+
+static bool
+hash_file(const char *path, long long *size, unsigned long long *h)
+{
+    char buf[65536];
+    size_t n;
+    FILE *fp = fopen(path, "rb");
+
+    if (!fp)
+        return FALSE;
+
+    *size = 0;
+    *h = FNV_OFFSET;
+    while ((n = fread(buf, 1, sizeof(buf), fp)) > 0) {
+        *h = hash_bytes(*h, buf, n);
+        *size += (long long) n;
+    }
+    fclose(fp);
+    return TRUE;
+}
+
+
+static void
+free_deps(void)
+{
+    int i;
+
+    for (i = 0; i < ndeps; i++)
+        tfree(deps[i].path);
+    tfree(deps);
+    ndeps = maxdeps = 0;
+
+    for (i = 0; i < nvars; i++) {
+        tfree(vars[i].name);
+        tfree(vars[i].str);
+    }
+    tfree(vars);
+    nvars = maxvars = 0;
+}
+
+
+static void
+add_var(const char *name, int type, int num, const char *str)
+{
+    if (nvars == maxvars) {
+        maxvars = maxvars ? 2 * maxvars : 8;
+        vars = TREALLOC(struct cache_var, vars, maxvars);
+    }
+    vars[nvars].name = copy(name);
+    vars[nvars].type = type;
+    vars[nvars].num = num;
+    vars[nvars].str = str ? copy(str) : NULL;
+    nvars++;
+}
+
+
+/* Has environment variable 'name' another value than 'value', or
+   NULL for unset? */
+static bool
+env_changed(const char *name, const char *value)
+{
+    const char *s = getenv(name);
+
+    if (!s || !value)
+        return s != value;
+    return strcmp(s, value) != 0;
+}
+
+
+/* Set the recorded command variables as the pre-processing did */
+static void
+replay_vars(void)
+{
+    int i;
+
+    for (i = 0; i < nvars; i++) {
+        struct cache_var *v = &vars[i];
+        bool b = (v->num != 0);
+        switch (v->type) {
+        case CP_BOOL:
+            cp_vset(v->name, CP_BOOL, &b);
+            break;
+        case CP_NUM:
+            cp_vset(v->name, CP_NUM, &v->num);
+            break;
+        case CP_STRING:
+            cp_vset(v->name, CP_STRING, v->str);
+            break;
+        case -1:
+            cp_remvar(v->name);
+            break;
+        default:
+            break;
+        }
+    }
+}
+
+
+static char *
+cache_path(unsigned long long key)
+{
+    char dir[BSIZE_SP];
+
+    if (!cp_getvar("inpcache", CP_STRING, dir, sizeof(dir)) || !*dir)
+        return NULL;
+    return tprintf("%s/%016llx.ngc", dir, key);
+}
+
+
+static void
+put_bytes(struct cache_io *io, const void *p, size_t n)
+{
+    if (!io->err && fwrite(p, 1, n, io->fp) != n)
+        io->err = TRUE;
+}
+
+
+static void
+get_bytes(struct cache_io *io, void *p, size_t n)
+{
+    if (io->err || fread(p, 1, n, io->fp) != n) {
+        io->err = TRUE;
+        memset(p, 0, n);
+    }
+}
+
+
+static void
+put_int(struct cache_io *io, int i)
+{
+    put_bytes(io, &i, sizeof(i));
+}
+
+
+static int
+get_int(struct cache_io *io)
+{
+    int i;
+    get_bytes(io, &i, sizeof(i));
+    return i;
+}
+
+
+static void
+put_str(struct cache_io *io, const char *s)
+{
+    int len = s ? (int) strlen(s) : -1;
+
+    put_int(io, len);
+    if (len > 0)
+        put_bytes(io, s, (size_t) len);
+}
+
+
+static char *
+get_str(struct cache_io *io)
+{
+    int len = get_int(io);
+    char *s;
+
+    if (io->err || len < 0)
+        return NULL;
+
+    s = TMALLOC(char, len + 1);
+    get_bytes(io, s, (size_t) len);
+    s[len] = '\0';
+    return s;
+}
+
+
+/* Start recording the files of a new deck, return the key of its cache
+ * entry, or 0 if 'inpcache' is not set. */
+unsigned long long
+inp_cache_key(const char *file_name)
+{
+    unsigned long long h = FNV_OFFSET;
+    char cwd[4096];
+    char *path;
+    size_t i;
+
+    free_deps();
+    recording = FALSE;
+
+    if (!file_name || (path = cache_path(0)) == NULL)
+        return 0;
+    tfree(path);
+
+    if (!getcwd(cwd, sizeof(cwd)))
+        cwd[0] = '\0';
+
+    h = hash_str(h, INPCACHE_MAGIC);
+    h = hash_str(h, PACKAGE_VERSION);
+    h = hash_str(h, file_name);
+    h = hash_str(h, cwd);
+    h = hash_bytes(h, &newcompat, sizeof(newcompat));
+    for (i = 0; i < NUMELEMS(key_vars); i++)
+        h = hash_var(h, key_vars[i]);
+    if (!h)
+        h = 1;
+
+    recording = TRUE;
+    inp_cache_depend(file_name, TRUE);
+
+    return h;
+}
+
+
+/* Note a file read for the deck currently assembled */
+void
+inp_cache_depend(const char *path, bool libfile)
+{
+    int i;
+
+    if (!recording || !path)
+        return;
+
+    for (i = 0; i < ndeps; i++)
+        if (strcmp(deps[i].path, path) == 0)
+            return;
+
+    if (ndeps == maxdeps) {
+        maxdeps = maxdeps ? 2 * maxdeps : 16;
+        deps = TREALLOC(struct cache_dep, deps, maxdeps);
+    }
+    deps[ndeps].path = copy(path);
+    deps[ndeps].libfile = libfile;
+    ndeps++;
+}
+
+
+/* cp_vset() for the pre-processing, noted for the deck currently
+ * assembled.  Only CP_BOOL, CP_NUM and CP_STRING are recorded. */
+void
+inp_cache_setvar(const char *name, enum cp_types type, const void *value)
+{
+    cp_vset(name, type, value);
+
+    if (!recording)
+        return;
+
+    switch (type) {
+    case CP_BOOL:
+        add_var(name, CP_BOOL, *(const bool *) value, NULL);
+        break;
+    case CP_NUM:
+        add_var(name, CP_NUM, *(const int *) value, NULL);
+        break;
+    case CP_STRING:
+        add_var(name, CP_STRING, 0, (const char *) value);
+        break;
+    default:
+        recording = FALSE;      /* cannot be restored, no entry */
+        break;
+    }
+}
+
+
+/* cp_remvar() for the pre-processing */
+void
+inp_cache_remvar(const char *name)
+{
+    cp_remvar((char *) name);
+    if (recording)
+        add_var(name, -1, 0, NULL);
+}
+
+
+/* getenv() for the pre-processing, the value is part of the entry */
+char *
+inp_cache_getenv(const char *name)
+{
+    char *s = getenv(name);
+    int i;
+
+    if (!recording)
+        return s;
+
+    for (i = 0; i < nvars; i++)
+        if (vars[i].type == -2 && strcmp(vars[i].name, name) == 0)
+            return s;
+    add_var(name, -2, 0, s);
+    return s;
+}
+
+
+/* Restore the deck of entry 'key', if all of its files are unchanged */
+struct card *
+inp_cache_load(unsigned long long key, const char *file_name,
+               bool *expr_w_temper_p)
+{
+    struct cache_io io;
+    struct card *cc = NULL, *end = NULL;
+    char magic[sizeof(INPCACHE_MAGIC) - 1];
+    char **srcs = NULL, *path;
+    int i, n, nsrcs = 0, ncards, expr_w_temper;
+
+    if (!key || (path = cache_path(key)) == NULL)
+        return NULL;
+
+    io.fp = fopen(path, "rb");
+    io.err = FALSE;
+    tfree(path);
+    if (!io.fp)
+        return NULL;
+
+    get_bytes(&io, magic, sizeof(magic));
+    if (io.err || memcmp(magic, INPCACHE_MAGIC, sizeof(magic)) != 0)
+        goto fail;
+
+    expr_w_temper = get_int(&io);
+
+    /* check the files the deck has been made of */
+    n = get_int(&io);
+    for (i = 0; i < n && !io.err; i++) {
+        char *dep = get_str(&io);
+        int libfile = get_int(&io);
+        long long size, cursize;
+        unsigned long long h, curh;
+        get_bytes(&io, &size, sizeof(size));
+        get_bytes(&io, &h, sizeof(h));
+        if (!dep || io.err || !hash_file(dep, &cursize, &curh) ||
+            cursize != size || curh != h) {
+            tfree(dep);
+            goto fail;
+        }
+        inp_cache_depend(dep, libfile != 0);
+        tfree(dep);
+    }
+
+    /* environment variables read and command variables set */
+    n = get_int(&io);
+    for (i = 0; i < n && !io.err; i++) {
+        char *name = get_str(&io);
+        int type = get_int(&io);
+        int num = get_int(&io);
+        char *str = get_str(&io);
+        if (!name || io.err || (type == -2 && env_changed(name, str))) {
+            tfree(name);
+            tfree(str);
+            goto fail;
+        }
+        if (type != -2)
+            add_var(name, type, num, str);
+        tfree(name);
+        tfree(str);
+    }
+
+    nsrcs = get_int(&io);
+    if (io.err || nsrcs < 0)
+        goto fail;
+    srcs = TMALLOC(char *, nsrcs + 1);
+    for (i = 0; i < nsrcs; i++)
+        srcs[i] = get_str(&io);
+
+    ncards = get_int(&io);
+    for (i = 0; i < ncards && !io.err; i++) {
+        int linenum = get_int(&io);
+        int linenum_orig = get_int(&io);
+        int src = get_int(&io);
+        float wln[3];
+        char *line;
+        get_bytes(&io, wln, sizeof(wln));
+        line = get_str(&io);
+        if (io.err || !line || src < -1 || src >= nsrcs) {
+            tfree(line);
+            io.err = TRUE;
+            break;
+        }
+        end = insert_new_line(end, line, linenum, linenum_orig,
+                              (src < 0) ? NULL : srcs[src]);
+        end->w = wln[0];
+        end->l = wln[1];
+        end->nf = wln[2];
+        if (!cc)
+            cc = end;
+    }
+    if (io.err || !cc)
+        goto fail;
+
+    fclose(io.fp);
+
+    /* the line sources are owned by 'sourceinfo', as in inp_read() */
+    for (i = 0; i < nsrcs; i++)
+        if (srcs[i])
+            sourceinfo = wl_cons(srcs[i], sourceinfo);
+    tfree(srcs);
+
+    for (i = 0; i < ndeps; i++)
+        if (deps[i].libfile)
+            add_to_sourcepath(deps[i].path, NULL);
+    recording = FALSE;
+    replay_vars();
+    free_deps();
+
+    if (cp_getvar("addcontrol", CP_BOOL, NULL, 0))
+        cp_remvar("addcontrol");
+
+    if (expr_w_temper_p)
+        *expr_w_temper_p = (expr_w_temper != 0);
+
+    if (ft_ngdebug)
+        fprintf(stdout, "Input deck %s restored from cache\n", file_name);
+
+    return cc;
+
+fail:
+    fclose(io.fp);
+    line_free_x(cc, TRUE);
+    if (srcs) {
+        for (i = 0; i < nsrcs; i++)
+            tfree(srcs[i]);
+        tfree(srcs);
+    }
+    /* keep the top level file, the deck is read anew */
+    inp_cache_key(file_name);
+    return NULL;
+}
+
+
+/* Store the pre-processed deck as entry 'key' */
+void
+inp_cache_save(unsigned long long key, struct card *deck, bool expr_w_temper)
+{
+    struct cache_io io;
+    const char **srcs = NULL;
+    const char *lastsrc = NULL;
+    char *path, *tmppath;
+    struct card *c;
+    int i, nsrcs = 0, maxsrcs = 0, lastidx = -1, ncards = 0;
+
+    if (!key || !recording || (path = cache_path(key)) == NULL) {
+        free_deps();
+        recording = FALSE;
+        return;
+    }
+    recording = FALSE;
+
+    tmppath = tprintf("%s.%d", path, (int) getpid());
+    io.fp = fopen(tmppath, "wb");
+    io.err = FALSE;
+    if (!io.fp) {
+        fprintf(cp_err, "Warning: cannot write input cache file %s\n",
+                tmppath);
+        tfree(tmppath);
+        tfree(path);
+        free_deps();
+        return;
+    }
+
+    put_bytes(&io, INPCACHE_MAGIC, sizeof(INPCACHE_MAGIC) - 1);
+    put_int(&io, expr_w_temper);
+
+    put_int(&io, ndeps);
+    for (i = 0; i < ndeps; i++) {
+        long long size;
+        unsigned long long h;
+        if (!hash_file(deps[i].path, &size, &h)) {
+            io.err = TRUE;
+            break;
+        }
+        put_str(&io, deps[i].path);
+        put_int(&io, deps[i].libfile);
+        put_bytes(&io, &size, sizeof(size));
+        put_bytes(&io, &h, sizeof(h));
+    }
+
+    put_int(&io, nvars);
+    for (i = 0; i < nvars; i++) {
+        put_str(&io, vars[i].name);
+        put_int(&io, vars[i].type);
+        put_int(&io, vars[i].num);
+        put_str(&io, vars[i].str);
+    }
+
+    /* table of the line sources, consecutive cards mostly share them */
+    for (c = deck; c; c = c->nextcard) {
+        ncards++;
+        if (!c->linesource || c->linesource == lastsrc)
+            continue;
+        for (i = 0; i < nsrcs; i++)
+            if (strcmp(srcs[i], c->linesource) == 0)
+                break;
+        if (i == nsrcs) {
+            if (nsrcs == maxsrcs) {
+                maxsrcs = maxsrcs ? 2 * maxsrcs : 16;
+                srcs = TREALLOC(const char *, srcs, maxsrcs);
+            }
+            srcs[nsrcs++] = c->linesource;
+        }
+        lastsrc = c->linesource;
+    }
+    put_int(&io, nsrcs);
+    for (i = 0; i < nsrcs; i++)
+        put_str(&io, srcs[i]);
+
+    put_int(&io, ncards);
+    lastsrc = NULL;
+    for (c = deck; c; c = c->nextcard) {
+        float wln[3];
+        if (!c->linesource) {
+            lastidx = -1;
+        } else if (c->linesource != lastsrc) {
+            for (lastidx = 0; lastidx < nsrcs; lastidx++)
+                if (strcmp(srcs[lastidx], c->linesource) == 0)
+                    break;
+        }
+        lastsrc = c->linesource;
+        wln[0] = c->w;
+        wln[1] = c->l;
+        wln[2] = c->nf;
+        put_int(&io, c->linenum);
+        put_int(&io, c->linenum_orig);
+        put_int(&io, lastidx);
+        put_bytes(&io, wln, sizeof(wln));
+        put_str(&io, c->line);
+    }
+
+    if (fclose(io.fp) != 0)
+        io.err = TRUE;
+
+    if (io.err) {
+        remove(tmppath);
+    } else {
+#ifdef _WIN32
+        remove(path);
+#endif
+        if (rename(tmppath, path) != 0)
+            remove(tmppath);
+    }
+
+    tfree(srcs);
+    tfree(tmppath);
+    tfree(path);
+    free_deps();
+}
@@ -0,0 +1,18 @@
+/*************
+ * Header file for inpcache.c
+ ************/
+
+#ifndef ngspice_INPCACHE_H
+#define ngspice_INPCACHE_H
+
+unsigned long long inp_cache_key(const char *file_name);
+void inp_cache_depend(const char *path, bool libfile);
+void inp_cache_setvar(const char *name, enum cp_types type, const void *value);
+void inp_cache_remvar(const char *name);
+char *inp_cache_getenv(const char *name);
+struct card *inp_cache_load(unsigned long long key, const char *file_name,
+                            bool *expr_w_temper_p);
+void inp_cache_save(unsigned long long key, struct card *deck,
+                    bool expr_w_temper);
+
+#endif
@@ -26,6 +26,8 @@ Author: 1985 Wayne A. Christopher
 #include "ngspice/ftedefs.h"
 #include "ngspice/fteext.h"
 #include "ngspice/fteinp.h"
+#include "ngspice/hash.h"
+#include "ngspice/inpptree.h"
 #include "numparam/general.h"
 
 #include "com_set.h"
@@ -41,6 +43,8 @@ Author: 1985 Wayne A. Christopher
 #endif
 
 #include "../misc/util.h" /* ngdirname() */
+#include "../misc/zfile.h"
+#include "inpcache.h"
 #include "inpcom.h"
 #include "ngspice/stringskip.h"
 #include "ngspice/stringutil.h"
@@ -96,6 +100,8 @@ struct function_env
         char *params[N_PARAMS];
         int num_parameters;
         const char *accept;
+        bool callable;          /* kept as a call in B sources */
+        struct card *card;
     } *functions;
 };
 
@@ -134,8 +140,8 @@ static void inp_grab_func(struct function_env *, struct card *deck);
 static void inp_fix_inst_calls_for_numparam(
         struct names *subckt_w_params, struct card *deck);
 static void inp_expand_macros_in_func(struct function_env *);
-static struct card *inp_expand_macros_in_deck(
-        struct function_env *, struct card *deck);
+static struct card *inp_expand_macros_in_deck(struct function_env *,
+        struct card *deck, bool keep_callable, struct card **func_cards);
 static void inp_fix_param_values(struct card *deck);
 static void inp_reorder_params(
         struct names *subckt_w_params, struct card *list_head);
@@ -195,8 +201,6 @@ extern void inp_probe(struct card* card);
 static void utf8_syntax_check(struct card *deck);
 #endif
 
-int add_to_sourcepath(const char* filepath, const char* path);
-
 struct inp_read_t {
     struct card *cc;
     int line_number;
@@ -572,7 +576,7 @@ static struct library *read_a_lib(const char *y, const char *dir_name)
 
     if (!lib) {
 
-        FILE *newfp = fopen(y_resolved, "r");
+        FILE *newfp = ngzfopen(y_resolved, "r");
 
         if (!newfp) {
             fprintf(cp_err, "Error: Could not open library file %s\n", y);
@@ -583,6 +587,8 @@ static struct library *read_a_lib(const char *y, const char *dir_name)
          * libraries[N_LIBRARIES] */
         lib = new_lib();
 
+        inp_cache_depend(yy, TRUE);
+
         lib->realpath = copy(yy);
         lib->habitat = ngdirname(yy);
 
@@ -1042,11 +1048,26 @@ struct card *inp_readall(FILE *fp, const char *dir_name, const char* file_name,
 {
     struct card *cc;
     struct inp_read_t rv;
+    unsigned long long cache_key = 0;
 
     num_libraries = 0;
     /* set the members of the compatibility structure */
     set_compat_mode();
 
+    /* restore the pre-processed deck from the input cache */
+    if (!comfile && !intfile && file_name) {
+        cache_key = inp_cache_key(file_name);
+        cc = inp_cache_load(cache_key, file_name, expr_w_temper_p);
+        if (cc) {
+            struct card *dd;
+            print_compat_mode();
+            dynmaxline = 0;
+            for (dd = cc; dd; dd = dd->nextcard)
+                dynmaxline++;
+            return cc;
+        }
+    }
+
     rv = inp_read(fp, 0, dir_name, file_name, comfile, intfile);
     cc = rv.cc;
 
@@ -1133,7 +1154,8 @@ struct card *inp_readall(FILE *fp, const char *dir_name, const char* file_name,
 
         inp_fix_temper_in_param(working);
 
-        inp_expand_macros_in_deck(NULL, working);
+        struct card *func_cards = NULL;
+        inp_expand_macros_in_deck(NULL, working, !newcompat.s3, &func_cards);
         inp_fix_param_values(working);
 
         inp_reorder_params(subckt_w_params, cc);
@@ -1190,6 +1212,15 @@ struct card *inp_readall(FILE *fp, const char *dir_name, const char* file_name,
 
         inp_add_series_resistor(working);
 
+        /* .func cards for the B source parser, in front of the circuit */
+        if (func_cards) {
+            struct card *last = func_cards;
+            while (last->nextcard)
+                last = last->nextcard;
+            last->nextcard = cc->nextcard;
+            cc->nextcard = func_cards;
+        }
+
         /* get max. line length and number of lines in input deck,
            and renumber the lines,
            count the number of '{' per line as an upper estimate of the number
@@ -1252,6 +1283,9 @@ struct card *inp_readall(FILE *fp, const char *dir_name, const char* file_name,
                         "debug info\n");
         }
         inp_rem_levels(root);
+
+        if (cache_key)
+            inp_cache_save(cache_key, cc, expr_w_temper);
     }
 
     return cc;
@@ -1456,7 +1490,7 @@ static struct inp_read_t inp_read(FILE* fp, int call_depth, const char* dir_name
                     }
                 }
 
-                newfp = fopen(y_resolved, "r");
+                newfp = ngzfopen(y_resolved, "r");
 
                 if (!newfp) {
                     fprintf(cp_err, "Error: .include statement failed.\n"
@@ -1465,6 +1499,8 @@ static struct inp_read_t inp_read(FILE* fp, int call_depth, const char* dir_name
                     controlled_exit(EXIT_FAILURE);
                 }
 
+                inp_cache_depend(y_resolved, FALSE);
+
                 y_dir_name = ngdirname(y_resolved);
 
                 newcard = inp_read(
@@ -1845,7 +1881,7 @@ FILE *inp_pathopen(const char *name, const char *mode)
     char * const path = inp_pathresolve(name);
 
     if (path) {
-        FILE *fp = fopen(path, mode);
+        FILE *fp = ngzfopen(path, mode);
         txfree(path);
         return fp;
     }
@@ -1997,9 +2033,9 @@ static char *inp_pathresolve_at(const char *name, const char *dir)
             secenv = TRUE;
         }
         if (envvar && !secenv) {
-            s = getenv(envvar + 1);
+            s = inp_cache_getenv(envvar + 1);
             if (s) {
-                cp_vset(s, CP_STRING, envvar + 1);
+                inp_cache_setvar(s, CP_STRING, envvar + 1);
                 char* newname = tprintf("%s%s", s, tmpcurr);
                 char* const r = inp_pathresolve(newname);
                 tfree(newname);
@@ -2010,8 +2046,8 @@ static char *inp_pathresolve_at(const char *name, const char *dir)
             controlled_exit(EXIT_BAD);
         }
         else if (envvar && envvar2) {
-            s = getenv(envvar + 1);
-            s1 = getenv(envvar2 + 1);
+            s = inp_cache_getenv(envvar + 1);
+            s1 = inp_cache_getenv(envvar2 + 1);
             if (s && s1) {
                 char* newname = tprintf("%s/%s%s", s, s1, tmpcurr2);
                 char* const r = inp_pathresolve(newname);
@@ -2027,9 +2063,9 @@ static char *inp_pathresolve_at(const char *name, const char *dir)
             controlled_exit(EXIT_BAD);
         }
         else if (envvar && !envvar2 && secenv) {
-            s = getenv(envvar + 1);/* skip "$" */
+            s = inp_cache_getenv(envvar + 1);/* skip "$" */
             envvar2 = copy(tmpcurr);
-            s1 = getenv(envvar2 + 2);/* skip "$/" */
+            s1 = inp_cache_getenv(envvar2 + 2);/* skip "$/" */
             if (s && s1) {
                 char* newname = tprintf("%s/%s", s, s1);
                 char* const r = inp_pathresolve(newname);
@@ -2047,9 +2083,9 @@ static char *inp_pathresolve_at(const char *name, const char *dir)
 
         /* no directory separator found, just use the env entry (must include file name) */
         envvar = tmpnam;
-        s = getenv(envvar + 1);/* skip '$' */
+        s = inp_cache_getenv(envvar + 1);/* skip '$' */
         if (s) {
-            cp_vset(s, CP_STRING, envvar + 1);
+            inp_cache_setvar(s, CP_STRING, envvar + 1);
             char* const r = inp_pathresolve(s);
             tfree(envvar);
             return r;
@@ -2131,6 +2167,7 @@ static char *inp_pathresolve_at(const char *name, const char *dir)
  *  This routine reads a line (of arbitrary length), up to a '\n' or 'EOF' *
  *  and returns a pointer to the resulting null terminated string.         *
  *  The '\n' if found, is included in the returned string.                 *
+ *  Leading spaces and tabs and all '\r' are removed.                      *
  *  From: jason@ucbopal.BERKELEY.EDU (Jason Venner)                        *
  *  Newsgroups: net.sources                                                *
  *-------------------------------------------------------------------------*/
@@ -2139,44 +2176,42 @@ static char *inp_pathresolve_at(const char *name, const char *dir)
 
 static char *readline(FILE *fd)
 {
-    int c;
-    int memlen;
+    size_t memlen, len, i, j;
     char *strptr;
-    int strlen;
 
-    strlen = 0;
     memlen = STRGROW;
     strptr = TMALLOC(char, memlen);
-    memlen -= 1; /* Save constant -1's in while loop */
-
-    while ((c = getc(fd)) != EOF) {
-
-        if (strlen == 0 && (c == '\t' || c == ' ')) /* Leading spaces away */
-            continue;
-
-        if (c == '\r')
-            continue;
-        strptr[strlen++] = (char) c;
+    len = 0;
 
-        if (strlen >= memlen) {
-            memlen += STRGROW;
-            if ((strptr = TREALLOC(char, strptr, memlen + 1)) == NULL)
-                return (NULL);
+    /* Read whole blocks with fgets(), doubling the buffer, so that
+       very long lines cost linear time. */
+    while (fgets(strptr + len, (int) MIN(memlen - len, INT_MAX), fd)) {
+        len += strlen(strptr + len);
+        if (len > 0 && strptr[len - 1] == '\n')
+            break;
+        if (len + 1 >= memlen) {
+            memlen *= 2;
+            strptr = TREALLOC(char, strptr, memlen);
         }
+    }
 
-        if (c == '\n')
-            break;
+    /* Leading spaces away, and all carriage returns */
+    for (i = j = 0; i < len; i++) {
+        char c = strptr[i];
+        if (c == '\r' || (j == 0 && (c == ' ' || c == '\t')))
+            continue;
+        strptr[j++] = c;
     }
+    len = j;
 
-    if (!strlen) {
+    if (!len) {
         tfree(strptr);
         return (NULL);
     }
 
-    // strptr[strlen] = '\0';
     /* Trim the string */
-    strptr = TREALLOC(char, strptr, strlen + 1);
-    strptr[strlen] = '\0';
+    strptr = TREALLOC(char, strptr, len + 1);
+    strptr[len] = '\0';
 
     return (strptr);
 }
@@ -4342,6 +4377,7 @@ static void inp_grab_func(struct function_env *env, struct card *c)
 
         if (ciprefix(".func", c->line)) {
             inp_get_func_from_line(env, c->line);
+            env->functions->card = c;
             *c->line = '*';
         }
     }
@@ -4453,7 +4489,10 @@ static char *inp_do_macro_param_replace(struct function *fcn, char *params[])
 }
 
 
-static char *inp_expand_macro_in_str(struct function_env *env, char *str)
+/* Expand the calls of the functions in env found in str.  Calls of
+   callable functions are left alone if keep_callable is set. */
+static char *inp_expand_macro_in_str(
+        struct function_env *env, char *str, bool keep_callable)
 {
     struct function *function;
     char *open_paren_ptr, *close_paren_ptr, *fcn_name, *params[FCN_PARAMS];
@@ -4491,7 +4530,7 @@ static char *inp_expand_macro_in_str(struct function_env *env, char *str)
 
         *open_paren_ptr = '(';
 
-        if (!function)
+        if (!function || (keep_callable && function->callable))
             continue;
 
         /* find the closing paren */
@@ -4552,8 +4591,8 @@ static char *inp_expand_macro_in_str(struct function_env *env, char *str)
                         FCN_PARAMS);
                 controlled_exit(EXIT_FAILURE);
             }
-            params[num_params++] = inp_expand_macro_in_str(
-                    env, copy_substring(beg_parameter, curr_ptr));
+            params[num_params++] = inp_expand_macro_in_str(env,
+                    copy_substring(beg_parameter, curr_ptr), keep_callable);
         }
 
         if (function->num_parameters != num_params) {
@@ -4565,7 +4604,7 @@ static char *inp_expand_macro_in_str(struct function_env *env, char *str)
         }
 
         macro_str = inp_do_macro_param_replace(function, params);
-        macro_str = inp_expand_macro_in_str(env, macro_str);
+        macro_str = inp_expand_macro_in_str(env, macro_str, keep_callable);
         keep = *fcn_name;
         *fcn_name = '\0';
         {
@@ -4603,12 +4642,126 @@ static char *inp_expand_macro_in_str(struct function_env *env, char *str)
 }
 
 
+/* The bodies of callable functions only call callable functions, which
+   are expanded, if need be, after the parameters have been replaced. */
 static void inp_expand_macros_in_func(struct function_env *env)
 {
     struct function *f;
 
     for (f = env->functions; f; f = f->next)
-        f->body = inp_expand_macro_in_str(env, f->body);
+        if (!f->callable)
+            f->body = inp_expand_macro_in_str(env, f->body, FALSE);
+}
+
+
+/* A function name the B source parser accepts, which the subcircuit
+   expansion does not mistake for v(...) or i(...) */
+static bool inp_callable_name(const char *name)
+{
+    size_t len = strlen(name);
+    const char *s;
+
+    if (!isalpha_c(*name))
+        return FALSE;
+
+    for (s = name; *s; s++)
+        if (!isalnum_c(*s) && *s != '_')
+            return FALSE;
+
+    return !strchr("vi", name[len - 1]) ||
+        (len > 1 && isalpha_c(name[len - 2]));
+}
+
+
+/* Body of function f as it is handed over to the B source parser, or NULL
+   if f has to be expanded textually.  Only the parameters of f, time,
+   hertz, pi, e, built-in functions of the B source parser and other
+   callable functions may occur in the body.  Names of parameters and
+   constants are put into parentheses to separate them from any following
+   operator. */
+static char *inp_get_callable_body(
+        struct function_env *env, struct function *f)
+{
+    DS_CREATE(ds, 200);
+    char *s = f->body, *body;
+    bool ok = TRUE;
+
+    while (*s && ok) {
+        if (isalpha_c(*s) || *s == '_') {
+            char *beg = s, *name;
+            int i;
+
+            while (isalnum_c(*s) || *s == '_')
+                s++;
+            if ((*s && strchr("$%#@.[]", *s)) || (*s == '!' && s[1] != '=')) {
+                ok = FALSE;
+                break;
+            }
+
+            name = copy_substring(beg, s);
+            if (*skip_ws(s) == '(') {
+                struct function *g = find_function(env, name);
+                ok = g ? (g != f && g->callable) : INPfunctionBuiltin(name);
+                ds_cat_str(&ds, name);
+            }
+            else {
+                ok = eq(name, "time") || eq(name, "hertz") ||
+                        eq(name, "pi") || eq(name, "e");
+                for (i = 0; i < f->num_parameters && !ok; i++)
+                    ok = eq(name, f->params[i]);
+                ds_cat_printf(&ds, "(%s)", name);
+            }
+            tfree(name);
+        }
+        else if (isdigit_c(*s) || (*s == '.' && isdigit_c(s[1]))) {
+            /* number with exponent or scale factor */
+            char *beg = s++;
+            while (isalnum_c(*s) || *s == '.' ||
+                    ((*s == '+' || *s == '-') && strchr("eE", s[-1]) &&
+                            isdigit_c(s[1])))
+                s++;
+            ds_cat_mem(&ds, beg, (size_t) (s - beg));
+        }
+        else if (strchr("+-*/^(),<>=!&|?: \t", *s)) {
+            ds_cat_char(&ds, *s++);
+        }
+        else {
+            ok = FALSE;
+        }
+    }
+
+    body = ok ? copy(ds_get_buf(&ds)) : NULL;
+    ds_free(&ds);
+
+    return body;
+}
+
+
+/* Mark the functions which are left to the B source parser as callable,
+   instead of being expanded textually in the B source lines.  Their
+   bodies are parsed only once, and nested calls do not blow up the
+   expressions. */
+static void inp_mark_callable_funcs(struct function_env *env)
+{
+    struct function *f;
+    bool changed;
+
+    do {
+        changed = FALSE;
+        for (f = env->functions; f; f = f->next) {
+            char *body;
+            if (f->callable || f->num_parameters < 1 ||
+                    f->num_parameters > PT_MAXARGS ||
+                    !inp_callable_name(f->name))
+                continue;
+            body = inp_get_callable_body(env, f);
+            if (body) {
+                f->callable = TRUE;
+                changed = TRUE;
+                tfree(body);
+            }
+        }
+    } while (changed);
 }
 
 
@@ -4641,13 +4794,22 @@ static struct function_env *delete_function_env(struct function_env *env)
 }
 
 
-static struct card *inp_expand_macros_in_deck(
-        struct function_env *env, struct card *c)
+/* Expand the calls of .func functions in the deck.  With keep_callable,
+   the calls of callable (top level) functions in B source lines are kept,
+   and a .func card is returned in func_cards for each of these functions,
+   to be read by the circuit parser. */
+static struct card *inp_expand_macros_in_deck(struct function_env *env,
+        struct card *c, bool keep_callable, struct card **func_cards)
 {
+    int skip_control = 0;
+
     env = new_function_env(env);
 
     inp_grab_func(env, c);
 
+    if (keep_callable && func_cards)
+        inp_mark_callable_funcs(env);
+
     inp_expand_macros_in_func(env);
 
     for (; c; c = c->nextcard) {
@@ -4655,9 +4817,15 @@ static struct card *inp_expand_macros_in_deck(
         if (*c->line == '*')
             continue;
 
+        if (ciprefix(".control", c->line))
+            skip_control++;
+        else if (ciprefix(".endc", c->line))
+            skip_control--;
+
         if (ciprefix(".subckt", c->line)) {
             struct card *subckt = c;
-            c = inp_expand_macros_in_deck(env, c->nextcard);
+            c = inp_expand_macros_in_deck(
+                    env, c->nextcard, keep_callable, NULL);
             if (c)
                 continue;
 
@@ -4670,7 +4838,36 @@ static struct card *inp_expand_macros_in_deck(
         if (ciprefix(".ends", c->line))
             break;
 
-        c->line = inp_expand_macro_in_str(env, c->line);
+        /* pwl B sources are handled by numparam */
+        c->line = inp_expand_macro_in_str(env, c->line,
+                keep_callable && *c->line == 'b' && skip_control == 0 &&
+                !strstr(c->line, "pwl"));
+    }
+
+    if (keep_callable && func_cards) {
+        struct function *f;
+        struct card *last = NULL;
+        for (f = env->functions; f; f = f->next) {
+            char *body, *params;
+            int i;
+            if (!f->callable)
+                continue;
+            body = inp_get_callable_body(env, f);
+            params = copy(f->params[0]);
+            for (i = 1; i < f->num_parameters; i++) {
+                char *p = tprintf("%s,%s", params, f->params[i]);
+                tfree(params);
+                params = p;
+            }
+            last = insert_new_line(last,
+                    tprintf(".func %s(%s) %s", f->name, params, body),
+                    f->card->linenum, f->card->linenum_orig,
+                    f->card->linesource);
+            if (!*func_cards)
+                *func_cards = last;
+            tfree(params);
+            tfree(body);
+        }
     }
 
     env = delete_function_env(env);
@@ -8687,14 +8884,14 @@ static void inp_check_syntax(struct card *deck)
     }
 
     /* When '.probe alli' is set, disable auto bridging and set a flag */
-    cp_remvar("probe_alli_given");
+    inp_cache_remvar("probe_alli_given");
     for (card = deck; card; card = card->nextcard) {
         char* cut_line = card->line;
         if (ciprefix(".probe", cut_line) && search_plain_identifier(cut_line, "alli")) {
             int i = 0;
             bool bi = TRUE;
-            cp_vset("auto_bridge", CP_NUM, &i);
-            cp_vset("probe_alli_given", CP_BOOL, &bi);
+            inp_cache_setvar("auto_bridge", CP_NUM, &i);
+            inp_cache_setvar("probe_alli_given", CP_BOOL, &bi);
             break;
         }
     }
@@ -9052,18 +9249,92 @@ struct modellist {
     char *modelname;
     bool used;
     char elemb;
+    int seq;                        /* position in the deck */
     struct modellist *next;
+    struct modellist *next_base;    /* next model with the same base name */
 };
 
 
+/* Length of the model name without a binning suffix '.<digits>' */
+static size_t model_base_len(const char *name)
+{
+    const char *dot = strrchr(name, '.');
+    const char *p;
+
+    if (!dot || dot[1] == '\0')
+        return strlen(name);
+    for (p = dot + 1; *p; p++)
+        if (!isdigit_c(*p))
+            return strlen(name);
+    return (size_t) (dot - name);
+}
+
+
+/* Enter a .model into the table of its scope. Models are chained by
+ * their base name, so that a model token finds itself and all of its
+ * binned variants without scanning all models of the scope. */
+static void inp_add_model_table(struct nscope *scope, struct modellist *m)
+{
+    char *key = copy_substring(m->modelname,
+            m->modelname + model_base_len(m->modelname));
+    struct modellist *head;
+
+    if (!scope->model_table)
+        scope->model_table = nghash_init(NGHASH_MIN_SIZE);
+
+    head = (struct modellist *) nghash_find(scope->model_table, key);
+    if (head) {
+        m->next_base = head->next_base;
+        head->next_base = m;
+    }
+    else {
+        m->next_base = NULL;
+        nghash_insert(scope->model_table, key, m);
+    }
+    tfree(key);
+}
+
+
+/* Find the models of this scope matching model token 'name', either
+ * exactly or as a binned variant 'name.<digits>'. They are found under
+ * the key 'name' and, if 'name' itself ends in '.<digits>', under its
+ * base name. If 'mark' is set, all of them are marked as used.
+ * Returns the one the linear scan of scope->models would have found
+ * first, i.e. the one defined last in the deck. */
+static struct modellist *inp_find_model_table(
+        struct nscope *scope, const char *name, bool mark)
+{
+    struct modellist *found = NULL;
+    size_t len = model_base_len(name);
+    int i;
+
+    if (!scope->model_table)
+        return NULL;
+
+    for (i = 0; i < 2; i++) {
+        struct modellist *p;
+        char *key;
+        if (i && name[len] == '\0')
+            break;
+        key = i ? copy_substring(name, name + len) : copy(name);
+        p = (struct modellist *) nghash_find(scope->model_table, key);
+        for (; p; p = p->next_base)
+            if (model_name_match(name, p->modelname)) {
+                if (mark)
+                    p->used = TRUE;
+                if (!found || p->seq > found->seq)
+                    found = p;
+            }
+        tfree(key);
+    }
+    return found;
+}
+
+
 static struct modellist *inp_find_model_1(
         struct nscope *scope, const char *name)
 {
-    struct modellist *p = scope->models;
-    for (; p; p = p->next)
-        if (model_name_match(name, p->modelname))
-            break;
-    return p;
+    return inp_find_model_table(scope, name, FALSE);
 }
 
 
@@ -9089,6 +9360,7 @@ struct nscope *inp_add_levels(struct card *deck)
     root->next = NULL;
     root->subckts = NULL;
     root->models = NULL;
+    root->model_table = NULL;
 
     struct nscope *lvl = root;
 
@@ -9117,6 +9389,7 @@ struct nscope *inp_add_levels(struct card *deck)
                 scope->next = lvl;
                 scope->subckts = NULL;
                 scope->models = NULL;
+                scope->model_table = NULL;
                 lvl = card->level = scope;
             }
             else if (ciprefix(".ends", curr_line)) {
@@ -9168,6 +9441,10 @@ static void rem_unused_xxx(struct nscope *level)
         m = next_m;
     }
     level->models = NULL;
+    if (level->model_table) {
+        nghash_free(level->model_table, NULL, NULL);
+        level->model_table = NULL;
+    }
 
     struct card_assoc *p = level->subckts;
     for (; p; p = p->next)
@@ -9177,11 +9454,7 @@ static void rem_unused_xxx(struct nscope *level)
 
 static void mark_all_binned(struct nscope *scope, char *name)
 {
-    struct modellist *p = scope->models;
-
-    for (; p; p = p->next)
-        if (model_name_match(name, p->modelname))
-            p->used = TRUE;
+    inp_find_model_table(scope, name, TRUE);
 }
 
 
@@ -9189,6 +9462,7 @@ void inp_rem_unused_models(struct nscope *root, struct card *deck)
 {
     struct card *card;
     int skip_control = 0;
+    int seq = 0;
 
     /* create a list of .model */
     for (card = deck; card; card = card->nextcard) {
@@ -9227,8 +9501,10 @@ void inp_rem_unused_models(struct nscope *root, struct card *deck)
             modl_new->modelname = get_subckt_model_name(curr_line);
             modl_new->model = card;
             modl_new->used = FALSE;
+            modl_new->seq = seq++;
             modl_new->next = card->level->models;
             card->level->models = modl_new;
+            inp_add_model_table(card->level, modl_new);
             tfree(model_type);
         }
     }
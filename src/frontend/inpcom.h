@@ -9,6 +9,7 @@
 struct card *insert_new_line(struct card *card, char *line,
                              int linenum, int linenum_orig, char *linesource);
 char *inp_pathresolve(const char *name);
+int add_to_sourcepath(const char *filepath, const char *path);
 
 extern char* inp_remove_ws(char* s);
 extern char* search_plain_identifier(char* str, const char* identifier);
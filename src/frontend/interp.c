@@ -14,21 +14,22 @@ Author: 1985 Wayne A. Christopher, U. C. Berkeley CAD Group
 #include "interp.h"
 
 
-void
-lincopy(struct dvec *ov, double *newscale, int newlen, struct dvec *oldscale)
+/* Check that ov can be interpolated from oldscale, print a warning if not */
+static bool
+lincheck(struct dvec *ov, struct dvec *oldscale)
 {
     if (!isreal(ov)) {
         fprintf(cp_err, "Warning: vector %s is a complex vector - "
                 "complex vectors cannot be interpolated\n",
                 ov->v_name);
-        return;
+        return FALSE;
     }
 
     if (ov->v_length == 1) {
         fprintf(cp_err, "Warning: %s is a scalar - "
                 "interpolation is not possible\n",
                 ov->v_name);
-        return;
+        return FALSE;
     }
 
     if (ov->v_length < oldscale->v_length) {
@@ -36,26 +37,66 @@ lincopy(struct dvec *ov, double *newscale, int newlen, struct dvec *oldscale)
                 "interpolation is not performed unless there are "
                 "at least as many points as the scale vector (%d)\n",
                 ov->v_name, ov->v_length, oldscale->v_length);
-        return;
+        return FALSE;
     }
 
-    /* Allocate the vector to receive the linearized data */
-    struct dvec * const v = dvec_alloc(copy(ov->v_name),
-                   ov->v_type,
-                   ov->v_flags | VF_PERMANENT,
-                   newlen, NULL);
-
-    /* Do interpolation and then add the vector to the current plot. If
-     * interpolation fails, the vector must be freed. */
-    if (!ft_interpolate(ov->v_realdata, v->v_realdata, oldscale->v_realdata,
-            oldscale->v_length, newscale, newlen, 1)) {
-        fprintf(cp_err, "Error: can't interpolate %s\n", ov->v_name);
-        dvec_free(v);
-        return;
-    }
+    return TRUE;
+}
+
 
-    vec_new(v);
+void
+lincopy(struct dvec *ov, double *newscale, int newlen, struct dvec *oldscale)
+{
+    lincopy_vecs(&ov, 1, newscale, newlen, oldscale);
 } /* end of function lincopy */
 
 
+/* Interpolate the n vectors ov[] onto newscale and add them to the
+ * current plot in the given order.  The vectors are independent, so
+ * they are interpolated in parallel if possible. */
+void
+lincopy_vecs(struct dvec **ov, int n, double *newscale, int newlen,
+             struct dvec *oldscale)
+{
+    struct dvec **nv;
+    bool *ok;
+    int i;
+
+    if (n < 1)
+        return;
+
+    /* Allocate the vectors to receive the linearized data */
+    nv = TMALLOC(struct dvec *, n);
+    ok = TMALLOC(bool, n);
+    for (i = 0; i < n; i++)
+        if (lincheck(ov[i], oldscale))
+            nv[i] = dvec_alloc(copy(ov[i]->v_name),
+                               ov[i]->v_type,
+                               ov[i]->v_flags | VF_PERMANENT,
+                               newlen, NULL);
+
+#ifdef USE_OMP
+#pragma omp parallel for schedule(dynamic) if (n > 1)
+#endif
+    for (i = 0; i < n; i++)
+        if (nv[i])
+            ok[i] = ft_interpolate(ov[i]->v_realdata, nv[i]->v_realdata,
+                                   oldscale->v_realdata, oldscale->v_length,
+                                   newscale, newlen, 1);
+
+    /* Add the vectors to the current plot.  If interpolation failed,
+     * the vector must be freed. */
+    for (i = 0; i < n; i++) {
+        if (!nv[i])
+            continue;
+        if (!ok[i]) {
+            fprintf(cp_err, "Error: can't interpolate %s\n", ov[i]->v_name);
+            dvec_free(nv[i]);
+            continue;
+        }
+        vec_new(nv[i]);
+    }
 
+    tfree(nv);
+    tfree(ok);
+} /* end of function lincopy_vecs */
@@ -7,6 +7,7 @@
 #define ngspice_INTERP_H
 
 void lincopy(struct dvec *ov, double *newscale, int newlen, struct dvec *oldscale);
+void lincopy_vecs(struct dvec **ov, int n, double *newscale, int newlen, struct dvec *oldscale);
 
 
 #endif
@@ -25,10 +25,10 @@ com_linearize(wordlist *wl)
 {
     double tstart, tstop, tstep, d;
     struct plot *new, *old;
-    struct dvec *newtime, *v;
+    struct dvec *newtime, *v, **vecs;
     struct dvec *oldtime;
     struct dvec *lin;
-    int len, i;
+    int len, i, n;
 
     if (!plot_cur || !plot_cur->pl_typename || !ciprefix("tran", plot_cur->pl_typename)) {
         fprintf(cp_err, "Error: plot must be a transient analysis\n");
@@ -109,7 +109,10 @@ com_linearize(wordlist *wl)
         newtime->v_realdata[i] = d;
     new->pl_scale = new->pl_dvecs = newtime;
 
+    /* collect the vectors, they are interpolated all at once */
+    n = 0;
     if (wl) {
+        vecs = TMALLOC(struct dvec *, wl_length(wl));
         while (wl) {
             v = vec_fromplot(wl->wl_word, old);
             if (!v) {
@@ -118,16 +121,22 @@ com_linearize(wordlist *wl)
                 wl = wl->wl_next;
                 continue;
             }
-            lincopy(v, newtime->v_realdata, len, oldtime);
+            vecs[n++] = v;
             wl = wl->wl_next;
         }
     } else {
+        for (v = old->pl_dvecs; v; v = v->v_next)
+            n++;
+        vecs = TMALLOC(struct dvec *, n);
+        n = 0;
         for (v = old->pl_dvecs; v; v = v->v_next) {
             if (v == old->pl_scale)
                 continue;
-            lincopy(v, newtime->v_realdata, len, oldtime);
+            vecs[n++] = v;
         }
     }
+    lincopy_vecs(vecs, n, newtime->v_realdata, len, oldtime);
+    tfree(vecs);
 }
 
 
@@ -46,7 +46,10 @@ char *ft_setkwords[] = {
     "defw",
     "device",
     "diff_abstol",
+    "diff_interpolate",
     "diff_reltol",
+    "diff_stop",
+    "diff_summary",
     "diff_vntol",
     "display",
     "dontplot",
@@ -66,7 +69,9 @@ char *ft_setkwords[] = {
     "height",
     "history",
     "ignoreeof",
+    "inpcache",
     "interactive",
+    "iplotinterval",
     "itl1",
     "itl2",
     "itl3",
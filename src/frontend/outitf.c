@@ -21,6 +21,7 @@ Modified: 2000 AlansFixes, 2013/2015 patch by Krzysztof Blaszkowski
 #include "ngspice/ifsim.h"
 #include "ngspice/jobdefs.h"
 #include "ngspice/iferrmsg.h"
+#include "ngspice/hash.h"
 #include "circuits.h"
 #include "outitf.h"
 #include "variable.h"
@@ -57,6 +58,10 @@ static void plotAddComplexValue(dataDesc *desc, IFcomplex value);
 static void plotEnd(runDesc *run);
 static bool parseSpecial(char *name, char *dev, char *param, char *ind);
 static bool name_eq(char *n1, char *n2);
+static char *name_key(char *name, char *buf);
+static bool name_is_pattern(char *name);
+static bool name_is_internal(char *name);
+static bool name_match(char *pattern, char *name);
 static bool getSpecial(dataDesc *desc, runDesc *run, IFvalue *val);
 static void freeRun(runDesc *run);
 static int InterpFileAdd(runDesc *plotPtr, IFvalue *refValue, IFvalue *valuePtr);
@@ -256,38 +261,70 @@ beginPlot(JOB *analysisPtr, CKTcircuit *circuitPtr, char *cktName, char *analNam
 
         /* Pass 1. */
         if (numsaves && !saveall && !savenosub) {
+            /* Look up the data names by the part compared by name_eq(),
+               the first of equal names is taken. */
+            NGHASHPTR name_table = nghash_init(numNames);
+            bool *dataused = TMALLOC(bool, numNames);
+            char *key;
+            void *found;
+
+            for (j = 0; j < numNames; j++)
+                if ((key = name_key(dataNames[j], namebuf)) != NULL)
+                    nghash_insert(name_table, key, (void *) (intptr_t) (j + 1));
+
             for (i = 0; i < numsaves; i++) {
-                if (!savesused[i]) {
-                    for (j = 0; j < numNames; j++) {
-                        if (name_eq(saves[i].name, dataNames[j])) {
+                if (savesused[i])
+                    continue;
+                if (name_is_pattern(saves[i].name)) {
+                    /* i() patterns end in #branch, v() patterns select
+                       the nodes 'save all' would save */
+                    bool branch = (strstr(saves[i].name, "#branch") != NULL);
+                    int matches = 0;
+                    for (j = 0; j < numNames; j++)
+                        if (!dataused[j] &&
+                            (branch ? strstr(dataNames[j], "#branch") != NULL
+                                    : !strstr(dataNames[j], "#branch") &&
+                                      !name_is_internal(dataNames[j])) &&
+                            name_match(saves[i].name, dataNames[j])) {
                             addDataDesc(run, dataNames[j], dataType, j, initmem);
-                            savesused[i] = TRUE;
-                            saves[i].used = 1;
-                            break;
-                        }
-                        /* generate a vector of real time information */
-                        else if (ft_ngdebug && refName && eq(refName, "time") && eq(saves[i].name, "speedcheck")) {
-                            addDataDesc(run, "speedcheck", IF_REAL, j, initmem);
-                            savesused[i] = TRUE;
-                            saves[i].used = 1;
-                            break;
+                            dataused[j] = TRUE;
+                            matches++;
                         }
-                    }
+                    if (!matches)
+                        fprintf(cp_err, "Warning: no node matches '%s'\n",
+                                saves[i].name);
+                    savesused[i] = TRUE;
+                    saves[i].used = 1;
+                    continue;
+                }
+                /* generate a vector of real time information */
+                if (ft_ngdebug && refName && eq(refName, "time") &&
+                    eq(saves[i].name, "speedcheck") && numNames > 0 &&
+                    !name_eq(saves[i].name, dataNames[0])) {
+                    addDataDesc(run, "speedcheck", IF_REAL, 0, initmem);
+                    savesused[i] = TRUE;
+                    saves[i].used = 1;
+                    continue;
+                }
+                if ((key = name_key(saves[i].name, namebuf)) != NULL &&
+                    (found = nghash_find(name_table, key)) != NULL) {
+                    j = (int) ((intptr_t) found - 1);
+                    if (!dataused[j])
+                        addDataDesc(run, dataNames[j], dataType, j, initmem);
+                    dataused[j] = TRUE;
+                    savesused[i] = TRUE;
+                    saves[i].used = 1;
                 }
             }
+
+            nghash_free(name_table, NULL, NULL);
+            tfree(dataused);
         } else {
             for (i = 0; i < numNames; i++)
                 if (!refName || !name_eq(dataNames[i], refName))
                     /*  Save the node as long as it's not an internal device node  */
                     if (!(savenosub && strchr(dataNames[i], '.')) && /* don't save subckt nodes */
-                        !strstr(dataNames[i], "#internal") &&
-                        !strstr(dataNames[i], "#source") &&
-                        !strstr(dataNames[i], "#drain") &&
-                        !strstr(dataNames[i], "#collector") &&
-                        !strstr(dataNames[i], "#collCX") &&
-                        !strstr(dataNames[i], "#emitter") &&
-                        !strstr(dataNames[i], "probe_int_") && /* created by .probe */
-                        !strstr(dataNames[i], "#base"))
+                        !name_is_internal(dataNames[i]))
                     {
                         addDataDesc(run, dataNames[i], dataType, i, initmem);
                     }
@@ -1326,25 +1363,95 @@ parseSpecial(char *name, char *dev, char *param, char *ind)
 static bool
 name_eq(char *n1, char *n2)
 {
-    char buf1[BSIZE_SP], buf2[BSIZE_SP], *s;
+    char buf1[BSIZE_SP], buf2[BSIZE_SP];
 
-    if ((s = strchr(n1, '(')) != NULL) {
-        strcpy(buf1, s);
-        if ((s = strchr(buf1, ')')) == NULL)
-            return FALSE;
-        *s = '\0';
-        n1 = buf1;
-    }
+    n1 = name_key(n1, buf1);
+    n2 = name_key(n2, buf2);
 
-    if ((s = strchr(n2, '(')) != NULL) {
-        strcpy(buf2, s);
-        if ((s = strchr(buf2, ')')) == NULL)
+    return (n1 && n2 && eq(n1, n2));
+}
+
+
+/* The part of name compared by name_eq(): a name with a V() around it
+ * is reduced to "(name", using buf of size BSIZE_SP.  NULL if the
+ * closing parenthesis is missing.
+ */
+
+static char *
+name_key(char *name, char *buf)
+{
+    char *s, *e;
+
+    if ((s = strchr(name, '(')) == NULL)
+        return name;
+
+    if ((e = strchr(s, ')')) == NULL)
+        return NULL;
+
+    if (e - s >= BSIZE_SP)
+        e = s + BSIZE_SP - 1;
+    memcpy(buf, s, (size_t) (e - s));
+    buf[e - s] = '\0';
+
+    return buf;
+}
+
+
+/* Internal device nodes, and nodes created by .probe, are left out by
+ * 'save all' and by v() save patterns.
+ */
+
+static bool
+name_is_internal(char *name)
+{
+    return (strstr(name, "#internal") ||
+            strstr(name, "#source") ||
+            strstr(name, "#drain") ||
+            strstr(name, "#collector") ||
+            strstr(name, "#collCX") ||
+            strstr(name, "#emitter") ||
+            strstr(name, "probe_int_") ||
+            strstr(name, "#base"));
+}
+
+
+/* Save names with wildcards select all nodes and branches they match */
+
+static bool
+name_is_pattern(char *name)
+{
+    return (*name != '@' && strpbrk(name, "*?") != NULL);
+}
+
+
+/* Glob style match of a hierarchical node name like x1.x2.out.
+ * '*' matches any characters within one level of the hierarchy, '**'
+ * matches across levels and '?' matches a single character other
+ * than the '.' separator.  So "x1.*" selects the nodes of x1 only,
+ * "x1.**" those of all subcircuits within x1 as well.
+ */
+
+static bool
+name_match(char *pattern, char *name)
+{
+    for (; *pattern; pattern++, name++) {
+        if (*pattern == '*') {
+            bool deep = (pattern[1] == '*');
+            if (deep)
+                pattern++;
+            for (;;) {
+                if (name_match(pattern + 1, name))
+                    return TRUE;
+                if (!*name || (!deep && *name == '.'))
+                    return FALSE;
+                name++;
+            }
+        }
+        if (!*name || (*pattern == '?' ? *name == '.' : *pattern != *name))
             return FALSE;
-        *s = '\0';
-        n2 = buf2;
     }
 
-    return (strcmp(n1, n2) ? FALSE : TRUE);
+    return (*name == '\0');
 }
 
 
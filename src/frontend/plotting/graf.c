@@ -32,6 +32,7 @@ Author: 1988 Jeffrey M. Hsu
 
 
 static void gr_start_internal(struct dvec *dv, bool copyvec);
+static void gr_resize_keyed(GRAPH *graph);
 static void set(struct plot *plot, struct dbcomm *db, bool value, short mode);
 static char *getitright(char *buf, double num);
 
@@ -55,6 +56,8 @@ static char *ticlist = ticbuf;
 
 #define XFACTOR 1       /* How much to expand the X scale during iplot. */
 #define YFACTOR 0.2     /* How much to expand the Y scale during iplot. */
+#define IPLOT_INTERVAL 0.05 /* Default minimum time between iplot refreshes. */
+#define IPLOT_FILECOLS 1024 /* History columns of an iplot to a file. */
 
 
 /*
@@ -711,6 +714,27 @@ void gr_clean(void)
 
 /* call this routine after viewport size changes */
 void gr_resize(GRAPH *graph)
+{
+    gr_resize_keyed(graph);
+
+    /* X also generates an expose after a resize.
+
+       This is handled in X10 by not redrawing on resizes and waiting
+       for the expose event to redraw.  In X11, the expose routine
+       tries to be clever and only redraws the region specified in an
+       expose event, which does not cover the entire region of the
+       plot if the resize was from a small window to a larger window.
+       So in order to keep the clever X11 expose event handling, we
+       have the X11 resize routine pull out expose events for that
+       window, and we redraw on resize also.  */
+#ifdef X_DISPLAY_MISSING
+    gr_redraw(graph);
+#endif
+}
+
+
+/* resize without redrawing, moving keyed text along */
+static void gr_resize_keyed(GRAPH *graph)
 {
     double oldxratio, oldyratio;
     double scalex, scaley;
@@ -732,20 +756,6 @@ void gr_resize(GRAPH *graph)
         k->x = (int)((k->x - graph->viewportxoff) * scalex + graph->viewportxoff);
         k->y = (int)((k->y - graph->viewportyoff) * scaley + graph->viewportyoff);
     }
-
-    /* X also generates an expose after a resize.
-
-       This is handled in X10 by not redrawing on resizes and waiting
-       for the expose event to redraw.  In X11, the expose routine
-       tries to be clever and only redraws the region specified in an
-       expose event, which does not cover the entire region of the
-       plot if the resize was from a small window to a larger window.
-       So in order to keep the clever X11 expose event handling, we
-       have the X11 resize routine pull out expose events for that
-       window, and we redraw on resize also.  */
-#ifdef X_DISPLAY_MISSING
-    gr_redraw(graph);
-#endif
 }
 
 
@@ -825,6 +835,388 @@ void gr_restoretext(GRAPH *graph)
 }
 
 
+/* An incremental plot keeps a min/max decimated history of the plotted
+ * vectors: for every column of the plot the extremes and the first and
+ * last value of each vector.  After a rescale the plot is redrawn from
+ * the columns, so the cost of a redraw does not grow with the length of
+ * the run, and the screen is refreshed at most every 'iplotinterval'
+ * seconds.  The history is rebuilt from the vectors only if the x range
+ * changes, which happens in geometric steps or, for a windowed iplot,
+ * once per third of the window. */
+struct iplot_hist {
+    struct plot *pl;            /* The plot being run */
+    struct dvec **vecs;         /* The plotted vectors */
+    int nvecs;
+    int ncols;                  /* Columns, the viewport width */
+    double *ymin, *ymax;        /* Per vector and column, nvecs * ncols */
+    double *yfirst, *ylast;
+    double xlo, xhi, ylo, yhi;  /* The data window */
+    int len;                    /* Points of the scale entered so far */
+    int lo, hi;                 /* Columns changed since the last refresh */
+    double interval;            /* Minimum time between refreshes */
+    clock_t last;               /* Time of the last refresh */
+    int checked, stride;        /* Look at the clock every stride points */
+};
+
+
+static double iplot_value(struct dvec *v, int i)
+{
+    return isreal(v) ? v->v_realdata[i] : realpart(v->v_compdata[i]);
+}
+
+
+/* Column of x, or -1 if outside of the data window */
+static int iplot_column(struct iplot_hist *h, double x)
+{
+    double c;
+
+    if (h->xhi <= h->xlo)
+        return (x == h->xlo) ? 0 : -1;
+
+    c = (x - h->xlo) / (h->xhi - h->xlo) * h->ncols;
+    if (!(c >= 0.0 && c <= h->ncols))
+        return -1;
+
+    return (c >= h->ncols) ? h->ncols - 1 : (int) c;
+}
+
+
+/* Enter the points [from, to) into the history */
+static void iplot_enter(struct iplot_hist *h, struct dvec *xs, int from, int to)
+{
+    int i, j;
+
+    for (i = from; i < to; i++) {
+        int c = iplot_column(h, iplot_value(xs, i));
+        if (c < 0)
+            continue;
+        for (j = 0; j < h->nvecs; j++) {
+            double y = iplot_value(h->vecs[j], i);
+            int k = j * h->ncols + c;
+            if (h->ymin[k] > h->ymax[k]) {
+                h->ymin[k] = h->ymax[k] = h->yfirst[k] = y;
+            } else if (y < h->ymin[k]) {
+                h->ymin[k] = y;
+            } else if (y > h->ymax[k]) {
+                h->ymax[k] = y;
+            }
+            h->ylast[k] = y;
+        }
+        if (c < h->lo)
+            h->lo = c;
+        if (c > h->hi)
+            h->hi = c;
+    }
+}
+
+
+/* Rebuild the history with ncols columns for the current data window */
+static void iplot_rebuild(struct iplot_hist *h, int ncols)
+{
+    struct dvec *xs = h->pl->pl_scale;
+    int k, first = 0;
+
+    if (ncols < 1)
+        ncols = 1;
+
+    if (ncols != h->ncols) {
+        int n = h->nvecs * ncols;
+        h->ncols = ncols;
+        h->ymin = TREALLOC(double, h->ymin, n);
+        h->ymax = TREALLOC(double, h->ymax, n);
+        h->yfirst = TREALLOC(double, h->yfirst, n);
+        h->ylast = TREALLOC(double, h->ylast, n);
+    }
+
+    for (k = 0; k < h->nvecs * h->ncols; k++) {
+        h->ymin[k] = HUGE;
+        h->ymax[k] = -HUGE;
+    }
+    h->lo = h->ncols;
+    h->hi = -1;
+
+    /* the transient scale is increasing, skip what is left of the window */
+    if (isreal(xs) && ciprefix("tran", h->pl->pl_typename)) {
+        int top = h->len;
+        while (first < top) {
+            int mid = first + (top - first) / 2;
+            if (xs->v_realdata[mid] < h->xlo)
+                first = mid + 1;
+            else
+                top = mid;
+        }
+    }
+
+    iplot_enter(h, xs, first, h->len);
+}
+
+
+/* Draw the columns lo ... hi of the history */
+static void iplot_draw(struct iplot_hist *h, int lo, int hi)
+{
+    double dx = (h->xhi - h->xlo) / h->ncols;
+    int c, j;
+
+    for (j = 0; j < h->nvecs; j++) {
+        struct dvec *v = h->vecs[j];
+        double *ymin = h->ymin + j * h->ncols;
+        double *ymax = h->ymax + j * h->ncols;
+        int p;
+
+        /* connect to the last filled column on the left */
+        for (p = lo - 1; p >= 0 && ymin[p] > ymax[p]; p--)
+            ;
+
+        for (c = lo; c <= hi; c++) {
+            double x = h->xlo + (c + 0.5) * dx;
+            if (ymin[c] > ymax[c])
+                continue;
+            if (p >= 0)
+                gr_point(v, x, h->yfirst[j * h->ncols + c],
+                         h->xlo + (p + 0.5) * dx, h->ylast[j * h->ncols + p],
+                         1);
+            gr_point(v, x, ymax[c], x, ymin[c], 1);
+            p = c;
+        }
+        LC_flush();
+#ifdef LINE_COMPRESSION_CHECKS
+        LC.dv = NULL;
+#endif
+    }
+}
+
+
+/* Redraw the graph from the history */
+static void iplot_redraw(GRAPH *graph, struct iplot_hist *h)
+{
+    struct dveclist *link;
+
+    DevClear();
+    gr_redrawgrid(graph);
+
+    cur.plotno = 0;
+    if (!graph->nolegend)
+        for (link = graph->plotdata; link; link = link->next)
+            drawlegend(graph, cur.plotno++, link->vector);
+
+    iplot_draw(h, 0, h->ncols - 1);
+
+    gr_restoretext(graph);
+}
+
+
+static struct iplot_hist *iplot_hist_new(struct plot *pl, double *xlims,
+                                         double *ylims)
+{
+    struct iplot_hist *h = TMALLOC(struct iplot_hist, 1);
+    struct dvec *v;
+
+    h->pl = pl;
+    for (v = pl->pl_dvecs; v; v = v->v_next)
+        if (v->v_flags & VF_PLOT)
+            h->nvecs++;
+    h->vecs = TMALLOC(struct dvec *, h->nvecs);
+    h->nvecs = 0;
+    for (v = pl->pl_dvecs; v; v = v->v_next)
+        if (v->v_flags & VF_PLOT)
+            h->vecs[h->nvecs++] = v;
+
+    h->xlo = xlims[0];
+    h->xhi = xlims[1];
+    h->ylo = ylims[0];
+    h->yhi = ylims[1];
+    h->len = pl->pl_scale->v_length;
+
+    if (!cp_getvar("iplotinterval", CP_REAL, &h->interval, 0))
+        h->interval = IPLOT_INTERVAL;
+    h->checked = h->len;
+    h->stride = 1;
+
+    return h;
+}
+
+
+/* Bring the history up to date with the points computed since the last
+ * refresh, rescale if needed and draw the graph if 'screen' is set. */
+static void iplot_refresh(struct iplot_hist *h, double window, bool screen)
+{
+    struct dvec *xs = h->pl->pl_scale;
+    int          len = xs->v_length;
+    double       xmin = HUGE, xmax = -HUGE, ymin = HUGE, ymax = -HUGE;
+    double       start, stop, step;
+    bool         xchanged = FALSE, ychanged = FALSE;
+    int          i, j;
+
+    /* extremes of the new points */
+    for (i = h->len; i < len; i++) {
+        double x = iplot_value(xs, i);
+        if (x < xmin)
+            xmin = x;
+        if (x > xmax)
+            xmax = x;
+        for (j = 0; j < h->nvecs; j++) {
+            double y = iplot_value(h->vecs[j], i);
+            if (y < ymin)
+                ymin = y;
+            if (y > ymax)
+                ymax = y;
+        }
+    }
+
+    if (ft_grdb) {
+        fprintf(cp_err, "x = %G ... %G\n", xmin, xmax);
+    }
+    if (!if_tranparams(ft_curckt, &start, &stop, &step) ||
+        !ciprefix("tran", h->pl->pl_typename)) {
+        stop = HUGE;
+        start = - stop;
+    }
+
+    /* checking for x lo */
+
+    if (xmin < h->xlo) {
+        xchanged = TRUE;
+        if (ft_grdb) {
+            fprintf(cp_err, "resize: xlo %G -> %G\n", h->xlo,
+                    h->xlo - (h->xhi - h->xlo) * XFACTOR);
+        }
+
+        /* set the new x lo value */
+
+        if (window) {
+            h->xlo = xmin - (window / 3.0);
+        } else {
+            h->xlo -= (h->xhi - h->xlo) * XFACTOR;
+        }
+        if (h->xlo < start)
+            h->xlo = start;
+    }
+
+    /* checking for x hi */
+
+    if (window && xchanged) {
+        h->xhi = h->xlo + window;
+    } else if (xmax > h->xhi) {
+        xchanged = TRUE;
+        if (ft_grdb) {
+            fprintf(cp_err, "resize: xhi %G -> %G\n", h->xhi,
+                    h->xhi + (h->xhi - h->xlo) * XFACTOR);
+        }
+
+        /* set the new x hi value */
+
+        if (window) {
+            h->xhi = xmax + (window / 3.0);
+            h->xlo = h->xhi - window;
+        } else {
+            h->xhi += (h->xhi - h->xlo) * XFACTOR;
+        }
+        if (h->xhi > stop)
+            h->xhi = stop;
+    }
+
+    if (h->xhi < h->xlo)
+        h->xhi = h->xlo;
+
+    /* checking for all y values, expanding the range in steps of
+       YFACTOR, a geometric growth with a bounded number of redraws */
+
+    while (ymin < h->ylo && h->yhi > h->ylo) {
+        ychanged = TRUE;
+        if (ft_grdb) {
+            fprintf(cp_err, "resize: ylo %G -> %G\n", h->ylo,
+                    h->ylo - (h->yhi - h->ylo) * YFACTOR);
+        }
+        h->ylo -= (h->yhi - h->ylo) * YFACTOR;
+    }
+
+    while (ymax > h->yhi && h->yhi > h->ylo) {
+        ychanged = TRUE;
+        if (ft_grdb) {
+            fprintf(cp_err, "resize: yhi %G -> %G\n", h->yhi,
+                    h->yhi + (h->yhi - h->ylo) * YFACTOR);
+        }
+        h->yhi += (h->yhi - h->ylo) * YFACTOR;
+    }
+
+    if (h->yhi < h->ylo)
+        h->yhi = h->ylo;
+
+    if (screen && (xchanged || ychanged)) {
+        gr_pmsg("Resizing screen");
+        currentgraph->data.xmin = h->xlo;
+        currentgraph->data.xmax = h->xhi;
+        currentgraph->data.ymin = h->ylo;
+        currentgraph->data.ymax = h->yhi;
+        currentgraph->grid.xsized = 0;
+        currentgraph->grid.ysized = 0;
+        gr_resize_keyed(currentgraph);
+    }
+
+    if (xchanged || (screen && currentgraph->viewport.width != h->ncols)) {
+        h->len = len;
+        iplot_rebuild(h, screen ? currentgraph->viewport.width : h->ncols);
+    } else {
+        iplot_enter(h, xs, h->len, len);
+        h->len = len;
+    }
+
+    if (screen) {
+        if (xchanged || ychanged)
+            iplot_redraw(currentgraph, h);
+        else if (h->lo <= h->hi)
+            iplot_draw(h, h->lo, h->hi);
+        DevUpdate();
+    }
+
+    h->lo = h->ncols;
+    h->hi = -1;
+    h->last = clock();
+}
+
+
+/* Write the plot of an 'iplot -o file' with the hardcopy device */
+static void iplot_write(struct dbcomm *db)
+{
+    struct iplot_hist *h = db->db_hist;
+    struct dvec       *xs = h->pl->pl_scale;
+    char               buf[BSIZE_SP], *devtype;
+    double             xlims[2], ylims[2];
+    int                j, yt;
+
+    if (!cp_getvar("hcopydevtype", CP_STRING, buf, sizeof(buf)))
+        devtype = "postscript";
+    else
+        devtype = buf;
+
+    if (DevSwitch(devtype))
+        return;
+
+    xlims[0] = h->xlo;
+    xlims[1] = h->xhi;
+    ylims[0] = h->ylo;
+    ylims[1] = h->yhi;
+
+    yt = h->nvecs ? (int) h->vecs[0]->v_type : SV_NOTYPE;
+    for (j = 1; j < h->nvecs; j++)
+        if ((int) h->vecs[j]->v_type != yt) {
+            yt = SV_NOTYPE;
+            break;
+        }
+
+    if (gr_init(xlims, ylims, xs->v_name, h->pl->pl_title, db->db_file,
+                h->nvecs, 0.0, 0.0, GRID_LIN, PLOT_LIN, xs->v_name, "V",
+                xs->v_type, yt, h->pl->pl_typename, NULL, 0)) {
+        for (j = 0; j < h->nvecs; j++)
+            gr_start_internal(h->vecs[j], FALSE);
+        iplot_draw(h, 0, h->ncols - 1);
+        DevFinalize();
+    }
+
+    DevSwitch(NULL);
+}
+
+
 /* Do some incremental plotting. There are 3 cases:
  *
  * First, if length < IPOINTMIN, don't do anything.
@@ -832,8 +1224,12 @@ void gr_restoretext(GRAPH *graph)
  * Second, if length = IPOINTMIN, plot what we have so far. This step
  * is essentially the initializaiton for the graph.
  *
- * Third, if length > IPOINTMIN, plot the last points and resize if
- * needed.
+ * Third, if length > IPOINTMIN, enter the last points into the history,
+ * and, at most every 'iplotinterval' seconds, resize if needed and plot
+ * them.
+ *
+ * With 'iplot -o file' nothing is drawn during the run, the history
+ * is written to the file by gr_end_iplot().
  *
  * Note we don't check for pole / zero because they are of length 1.
  *
@@ -860,31 +1256,29 @@ static int iplot(struct plot *pl, struct dbcomm *db)
     }
 
     struct dvec   *v, *xs = pl->pl_scale;
-    double        *lims, dy;
-    double         start, stop, step;
-    bool           changed = FALSE;
-    int            id, yt;
+    struct iplot_hist *h = db->db_hist;
+    double        *lims;
+    int            yt;
     double         xlims[2], ylims[2];
     static REQUEST reqst = { checkup_option, NULL };
     int            inited = 0;
     int            n_vec_plot = 0;
 
-    /* Exit if nothing is being plotted */
-    for (v = pl->pl_dvecs; v; v = v->v_next) {
-        if (v->v_flags & VF_PLOT) {
-            ++n_vec_plot;
-        }
-    }
-
-    if (n_vec_plot == 0) {
-        return 0;
-    }
-
-    id = db->db_graphid;
-    if (!id) { /* Do initialization */
+    if (!h) { /* Do initialization */
         unsigned int  index, node_len;
         char          commandline[4196];
 
+        /* Exit if nothing is being plotted */
+        for (v = pl->pl_dvecs; v; v = v->v_next) {
+            if (v->v_flags & VF_PLOT) {
+                ++n_vec_plot;
+            }
+        }
+
+        if (n_vec_plot == 0) {
+            return 0;
+        }
+
         strcpy(commandline, "plot ");
         index = 5;
         resumption = FALSE;
@@ -933,6 +1327,14 @@ static int iplot(struct plot *pl, struct dbcomm *db)
                     xlims[0], xlims[1], ylims[0], ylims[1]);
         }
 
+        h = db->db_hist = iplot_hist_new(pl, xlims, ylims);
+
+        if (db->db_file) {
+            iplot_rebuild(h, IPLOT_FILECOLS);
+            h->last = clock();
+            return 0;
+        }
+
         for (yt = pl->pl_dvecs->v_type, v = pl->pl_dvecs->v_next; v;
                 v = v->v_next) {
             if ((v->v_flags & VF_PLOT) && ((int) v->v_type != yt)) {
@@ -941,190 +1343,86 @@ static int iplot(struct plot *pl, struct dbcomm *db)
             }
         }
 
-        (void) gr_init(xlims, ylims, xs->v_name,
+        if (!gr_init(xlims, ylims, xs->v_name,
                 pl->pl_title, NULL, n_vec_plot, 0.0, 0.0,
                 GRID_LIN, PLOT_LIN, xs->v_name, "V", xs->v_type, yt,
-                plot_cur->pl_typename, commandline, 0);
+                plot_cur->pl_typename, commandline, 0)) {
+            return 0;   /* keep the history, don't retry */
+        }
 
         for (v = pl->pl_dvecs; v; v = v->v_next) {
             if (v->v_flags & VF_PLOT) {
                 gr_start_internal(v, FALSE);
-                ft_graf(v, xs, TRUE);
             }
         }
+        iplot_rebuild(h, currentgraph->viewport.width);
+        iplot_draw(h, 0, h->ncols - 1);
+        h->lo = h->ncols;
+        h->hi = -1;
+        h->last = clock();
         inited = 1;
 
     } else {
-        /* plot the last points and resize if needed */
-
-        Input(&reqst, NULL);
+        /* enter the last points, plot them and resize if needed */
 
-        /* Window was closed? */
-
-        if (!currentgraph)
+        if (len <= h->len)
             return 0;
 
-        /* First see if we have to make the screen bigger */
-
-        dy = (isreal(xs) ? xs->v_realdata[len - 1] :
-              realpart(xs->v_compdata[len - 1]));
-        if (ft_grdb) {
-            fprintf(cp_err, "x = %G\n", dy);
-        }
-        if (!if_tranparams(ft_curckt, &start, &stop, &step) ||
-            !ciprefix("tran", pl->pl_typename)) {
-            stop = HUGE;
-            start = - stop;
-        }
-
-        /* checking for x lo */
-
-        if (dy < currentgraph->data.xmin) {
-            changed = TRUE;
-            if (ft_grdb) {
-                fprintf(cp_err, "resize: xlo %G -> %G\n",
-                        currentgraph->data.xmin,
-                        currentgraph->data.xmin -
-                        (currentgraph->data.xmax - currentgraph->data.xmin)
-                        * XFACTOR);
+        /* clock() is a system call, so it is asked only every stride
+           points, stride doubling until the refresh is due */
+        if (h->interval > 0) {
+            if (len - h->checked < h->stride)
+                return 0;
+            h->checked = len;
+            if ((double) (clock() - h->last) < h->interval * CLOCKS_PER_SEC) {
+                if (h->stride < 4096)
+                    h->stride *= 2;
+                return 0;
             }
-
-            /* set the new x lo value */
-
-            if (window) {
-                currentgraph->data.xmin = dy - (window / 3.0);
-            } else {
-                currentgraph->data.xmin -=
-                    (currentgraph->data.xmax - currentgraph->data.xmin) *
-                        XFACTOR;
-            }
-            if (currentgraph->data.xmin < start)
-                currentgraph->data.xmin = start;
+            h->stride = (len - h->len) / 16;
+            if (h->stride < 1)
+                h->stride = 1;
         }
 
-        /* checking for x hi */
-
-        if (window && changed) {
-            currentgraph->data.xmax = currentgraph->data.xmin + window;
-        } else if (dy > currentgraph->data.xmax) {
-            changed = TRUE;
-            if (ft_grdb) {
-                fprintf(cp_err, "resize: xhi %G -> %G\n",
-                        currentgraph->data.xmax,
-                        currentgraph->data.xmax +
-                        (currentgraph->data.xmax - currentgraph->data.xmin)
-                        * XFACTOR);
-            }
-
-            /* set the new x hi value */
-
-            if (window) {
-                currentgraph->data.xmax = dy + (window / 3.0);
-                currentgraph->data.xmin = currentgraph->data.xmax - window;
-            } else {
-                currentgraph->data.xmax +=
-                    (currentgraph->data.xmax - currentgraph->data.xmin) *
-                        XFACTOR;
-            }
-            if (currentgraph->data.xmax > stop)
-                currentgraph->data.xmax = stop;
+        if (db->db_file) {
+            iplot_refresh(h, window, FALSE);
+            return 0;
         }
 
-        if (currentgraph->data.xmax < currentgraph->data.xmin)
-            currentgraph->data.xmax = currentgraph->data.xmin;
-
-        /* checking for all y values */
-
-        for (v = pl->pl_dvecs; v; v = v->v_next) {
-            if (!(v->v_flags & VF_PLOT)) {
-                continue;
-            }
-            dy = (isreal(v) ? v->v_realdata[len - 1] :
-                  realpart(v->v_compdata[len - 1]));
-            if (ft_grdb) {
-                fprintf(cp_err, "y = %G\n", dy);
-            }
-            /* checking for y lo */
-            while (dy < currentgraph->data.ymin) {
-                changed = TRUE;
-                if (ft_grdb) {
-                    fprintf(cp_err, "resize: ylo %G -> %G\n",
-                            currentgraph->data.ymin,
-                            currentgraph->data.ymin -
-                            (currentgraph->data.ymax - currentgraph->data.ymin)
-                            * YFACTOR);
-                }
-                /* set the new y lo value */
-                currentgraph->data.ymin -=
-                    (currentgraph->data.ymax - currentgraph->data.ymin)
-                    * YFACTOR;
-                /* currentgraph->data.ymin +=
-                  (dy - currentgraph->data.ymin) * YFACTOR;*/
-                /* currentgraph->data.ymin = dy;
-                  currentgraph->data.ymin *= (1 + YFACTOR); */
-            }
+        if (!db->db_graphid)
+            return 0;
 
-            /* checking for y hi */
+        Input(&reqst, NULL);
 
-            while (dy > currentgraph->data.ymax) {
-                changed = TRUE;
-                if (ft_grdb) {
-                    fprintf(cp_err, "resize: yhi %G -> %G\n",
-                            currentgraph->data.ymax,
-                            currentgraph->data.ymax +
-                            (currentgraph->data.ymax - currentgraph->data.ymin)
-                            * YFACTOR);
-                }
-                /* set the new y hi value */
-                currentgraph->data.ymax +=
-                    (currentgraph->data.ymax - currentgraph->data.ymin) *
-                        YFACTOR;
-                /* currentgraph->data.ymax +=
-                  (dy - currentgraph->data.ymax) * YFACTOR;*/
-                /* currentgraph->data.ymax = dy;
-                  currentgraph->data.ymax *= (1 + YFACTOR); */
-            }
-        }
+        /* Window was closed? */
 
-        if (currentgraph->data.ymax < currentgraph->data.ymin)
-            currentgraph->data.ymax = currentgraph->data.ymin;
+        if (!currentgraph)
+            return 0;
 
-        if (changed) {
-            /* Redraw everything. */
-            gr_pmsg("Resizing screen");
-            gr_resize(currentgraph);
-#ifndef X_DISPLAY_MISSING
-            gr_redraw(currentgraph);
-#endif
-        }
-        else {
-            /* Just connect the last two points. This won't be done
-             * with curve interpolation, so it might look funny.  */
-            for (v = pl->pl_dvecs; v; v = v->v_next) {
-                if (v->v_flags & VF_PLOT) {
-                    gr_point(v,
-                             (isreal(xs) ? xs->v_realdata[len - 1] :
-                              realpart(xs->v_compdata[len - 1])),
-                             (isreal(v) ? v->v_realdata[len - 1] :
-                              realpart(v->v_compdata[len - 1])),
-                             (isreal(xs) ? xs->v_realdata[len - 2] :
-                              realpart(xs->v_compdata[len - 2])),
-                             (isreal(v) ? v->v_realdata[len - 2] :
-                              realpart(v->v_compdata[len - 2])),
-                             len - 1);
-                    LC_flush();    // Disable line compression here ..
-#ifdef LINE_COMPRESSION_CHECKS
-                    LC.dv = NULL;  // ... and suppress warnings.
-#endif
-                }
-            }
-        }
+        iplot_refresh(h, window, TRUE);
     }
     DevUpdate();
     return inited;
 }
 
 
+void gr_iplot_free(struct dbcomm *db)
+{
+    struct iplot_hist *h = db->db_hist;
+
+    if (!h)
+        return;
+
+    tfree(h->vecs);
+    tfree(h->ymin);
+    tfree(h->ymax);
+    tfree(h->yfirst);
+    tfree(h->ylast);
+    tfree(h);
+    db->db_hist = NULL;
+}
+
+
 static void set(struct plot *plot, struct dbcomm *db, bool value, short mode)
 {
     struct dvec *v;
@@ -1193,6 +1491,7 @@ void gr_iplot(struct plot *plot)
 {
     struct dbcomm *db;
     int dontpop;        /* So we don't pop w/o push. */
+    bool flagged;
     char buf[30];
 
     hit = 0;
@@ -1207,9 +1506,12 @@ void gr_iplot(struct plot *plot)
                 PushGraphContext(gr);
             }
 
-            /* Temporarily set plot flag on matching vector. */
+            /* Temporarily set plot flag on matching vector.  Once
+               initialized, the iplot history knows its vectors. */
 
-            set(plot, db, TRUE, VF_PLOT);
+            flagged = !db->db_hist;
+            if (flagged)
+                set(plot, db, TRUE, VF_PLOT);
 
             dontpop = 0;
             if (iplot(plot, db)) {
@@ -1218,7 +1520,8 @@ void gr_iplot(struct plot *plot)
                 dontpop = 1;
             }
 
-            set(plot, db, FALSE, VF_PLOT);
+            if (flagged)
+                set(plot, db, FALSE, VF_PLOT);
 
             if (!dontpop && db->db_graphid)
                 PopGraphContext();
@@ -1318,11 +1621,18 @@ void gr_end_iplot(void)
             }
         }
         else if (db->db_type == DB_IPLOT || db->db_type == DB_IPLOTALL) {
+            struct iplot_hist *h = db->db_hist;
             if (db->db_graphid) {
 
-                /* get private copy of dvecs */
+                /* draw the points left from rate limiting */
                 graph = FindGraph(db->db_graphid);
+                if (graph && h && h->len < h->pl->pl_scale->v_length) {
+                    PushGraphContext(graph);
+                    iplot_refresh(h, db->db_value1, TRUE);
+                    PopGraphContext();
+                }
 
+                /* get private copy of dvecs */
                 link = graph->plotdata;
 
                 while (link) {
@@ -1336,11 +1646,16 @@ void gr_end_iplot(void)
                 }
 
                 db->db_graphid = 0;
+            } else if (db->db_file && h) {
+                if (h->len < h->pl->pl_scale->v_length)
+                    iplot_refresh(h, db->db_value1, FALSE);
+                iplot_write(db);
             } else {
                 /* warn that this wasn't plotted */
                 fprintf(cp_err, "Warning: iplot %d was not executed.\n",
                         db->db_number);
             }
+            gr_iplot_free(db);
         }
     }
 }
@@ -7,6 +7,7 @@
 #define ngspice_GRAF_H
 
 #include "ngspice/graph.h"
+#include "ngspice/ftedebug.h"
 
 int gr_init(double *xlims, double *ylims,
         const char *xname,
@@ -37,6 +38,7 @@ void gr_restoretext(GRAPH *graph);
 void reset_trace(void);
 void gr_iplot(struct plot *plot);
 void gr_end_iplot(void);
+void gr_iplot_free(struct dbcomm *db);
 double *readtics(char *string);
 
 #endif
@@ -88,6 +88,8 @@ static IFvalue *doask(CKTcircuit *ckt, int typecode, GENinstance *dev, GENmodel
 static int doset(CKTcircuit *ckt, int typecode, GENinstance *dev, GENmodel *mod,
                  IFparm *opt, struct dvec *val);
 static int finddev(CKTcircuit *ckt, char *name, GENinstance **devptr, GENmodel **modptr);
+static int setmodel(CKTcircuit *ckt, int typecode, GENinstance *dev, char *val);
+static int setbinnedmodel(CKTcircuit *ckt, int typecode, GENinstance *dev, char *param, double value);
 
 /* espice fix integration */
 static int finddev_special(CKTcircuit *ckt, char *name, GENinstance **devptr, GENmodel **modptr, int *device_or_model);
@@ -840,14 +842,8 @@ void
 if_setparam_model(CKTcircuit *ckt, char **name, char *val)
 {
     GENinstance *dev     = NULL;
-    GENinstance *prevDev = NULL;
     GENmodel    *curMod  = NULL;
-    GENmodel    *newMod  = NULL;
-    INPmodel    *inpmod  = NULL;
-    GENinstance *iter;
-    GENmodel    *mods, *prevMod;
     int         typecode;
-    char        *modname;
 
     /* retrieve device name from symbol table */
     INPretrieve(name, ft_curckt->ci_symtab);
@@ -857,6 +853,24 @@ if_setparam_model(CKTcircuit *ckt, char **name, char *val)
         fprintf(cp_err, "Error: no such device name %s\n", *name);
         return;
     }
+    setmodel(ckt, typecode, dev, val);
+}
+
+
+/* Move device dev to the model selected by val, which may be a model
+ * bin chosen by the 'w' and 'l' given in val.  Returns 1 on error.
+ */
+static int
+setmodel(CKTcircuit *ckt, int typecode, GENinstance *dev, char *val)
+{
+    GENinstance *prevDev = NULL;
+    GENmodel    *curMod  = NULL;
+    GENmodel    *newMod  = NULL;
+    INPmodel    *inpmod  = NULL;
+    GENinstance *iter;
+    GENmodel    *mods, *prevMod;
+    char        *modname;
+
     curMod = dev->GENmodPtr;
     modname = copy(dev->GENmodPtr->GENmodName);
     modname = strtok(modname, "."); /* want only have the parent model name */
@@ -871,7 +885,7 @@ if_setparam_model(CKTcircuit *ckt, char **name, char *val)
     tfree(modname);
     if (inpmod == NULL) {
         fprintf(cp_err, "Error: no model available for %s.\n", val);
-        return;
+        return 1;
     }
     newMod = inpmod->INPmodfast;
 
@@ -880,7 +894,7 @@ if_setparam_model(CKTcircuit *ckt, char **name, char *val)
         printf("Notice: model has changed from %s to %s.\n", curMod->GENmodName, newMod->GENmodName);
     if (newMod->GENmodType != curMod->GENmodType) {
         fprintf(cp_err, "Error: new model %s must be same type as current model.\n", val);
-        return;
+        return 1;
     }
 
     /* fix current model linked list */
@@ -925,6 +939,8 @@ if_setparam_model(CKTcircuit *ckt, char **name, char *val)
             prevMod = mods;
         }
     }
+
+    return 0;
 }
 
 
@@ -975,6 +991,166 @@ if_setparam(CKTcircuit *ckt, char **name, char *param, struct dvec *val, int do_
     }
 }
 
+/* Set parameter params[i] of device or model names[i] to values[i] for
+ * all i < n, see if_setparam_list().  A device is looked up only when it
+ * differs from that of the previous change.  Returns the number of
+ * changes not done.
+ */
+int
+if_setparam_bulk(CKTcircuit *ckt, int n, char **names, char **params,
+                 double *values, int do_model)
+{
+    GENinstance **devs, *dev = NULL;
+    GENmodel **mods, *mod = NULL;
+    char *name, *prevname = NULL;
+    int i, failed;
+
+    devs = TMALLOC(GENinstance *, n);
+    mods = TMALLOC(GENmodel *, n);
+
+    for (i = 0; i < n; i++) {
+        if (!prevname || !eq(names[i], prevname)) {
+            prevname = names[i];
+            name = names[i];
+            INPretrieve(&name, ft_curckt->ci_symtab);
+            dev = NULL;
+            mod = NULL;
+            if (finddev(ckt, name, &dev, &mod) == -1)
+                fprintf(cp_err, "Error: no such device or model name %s\n", names[i]);
+            else if (do_model && !mod)
+                mod = dev->GENmodPtr;
+            if (mod)
+                dev = NULL;
+        }
+        devs[i] = dev;
+        mods[i] = mod;
+    }
+
+    failed = if_setparam_list(ckt, n, devs, mods, params, values);
+
+    tfree(devs);
+    tfree(mods);
+    return failed;
+}
+
+/* Set parameter params[i] of device devs[i], or of model mods[i] if
+ * devs[i] is NULL, to values[i] for all i < n.  Both NULL marks a device
+ * the caller could not find.  A parameter descriptor is looked up only
+ * when it differs from that of the previous change.  Like 'alter', a new
+ * width or length of a MOS device first moves it to the model bin that
+ * fits.  A single CKTtemp() pass follows all changes.  Returns the number
+ * of changes not done.
+ */
+int
+if_setparam_list(CKTcircuit *ckt, int n, GENinstance **devs, GENmodel **mods,
+                 char **params, double *values)
+{
+    struct dvec *val;
+    IFparm *opt = NULL;
+    GENmodel *mod;
+    GENinstance *dev;
+    char *prevparam = NULL;
+    int typecode, prevtype = -1;
+    bool prevmodel = FALSE;
+    int i, failed = 0;
+
+    val = dvec_alloc(copy("bulk value"), SV_NOTYPE, VF_REAL, 1, NULL);
+
+    for (i = 0; i < n; i++) {
+        dev = devs[i];
+        mod = dev ? NULL : mods[i];
+        if (!dev && !mod) {
+            failed++;
+            continue;
+        }
+        typecode = dev ? dev->GENmodPtr->GENmodType : mod->GENmodType;
+
+        if (typecode != prevtype || prevmodel != !dev ||
+            !prevparam || !cieq(params[i], prevparam)) {
+            opt = parmlookup(ft_sim->devices[typecode], &dev, params[i],
+                             !dev, 1);
+            prevtype = typecode;
+            prevmodel = !dev;
+            prevparam = params[i];
+        }
+        if (!opt) {
+            fprintf(cp_err, "Error: no such parameter %s.\n", params[i]);
+            failed++;
+            continue;
+        }
+
+        /* see com_alter_common() */
+        if (dev && dev->GENname[0] == 'm' &&
+            (eq(params[i], "w") || eq(params[i], "l")) &&
+            setbinnedmodel(ckt, typecode, dev, params[i], values[i])) {
+            failed++;
+            continue;
+        }
+
+        val->v_realdata[0] = values[i];
+        if (doset(ckt, typecode, dev, mod, opt, val) != OK)
+            failed++;
+    }
+
+    vec_free(val);
+
+    /* bring the derived parameters of the instances up to date,
+       see if_setparam() */
+    if (n > 0 && ckt->CKTtime > 0) {
+        int error = CKTtemp(ckt);
+        if (error) {
+            fprintf(stderr, "Error during changing a device parameter!\n");
+            controlled_exit(1);
+        }
+    }
+
+    return failed;
+}
+
+/* Move the MOS device dev to the model bin that fits its width and
+ * length once parameter param, "w" or "l", is set to value.  This is
+ * if_set_binned_model() of device.c without the name lookups.  Returns 1
+ * on error.
+ */
+static int
+setbinnedmodel(CKTcircuit *ckt, int typecode, GENinstance *dev, char *param,
+               double value)
+{
+    IFdevice *device = ft_sim->devices[typecode];
+    IFparm *opt;
+    IFvalue *pv;
+    double w, l;
+    char *width_length;
+    int error;
+
+    opt = parmlookup(device, &dev, "w", 0, 0);
+    pv = opt ? doask(ckt, typecode, dev, NULL, opt, 0) : NULL;
+    if (!pv) {
+        fprintf(cp_err, "Error: Can't access width instance parameter.\n");
+        return 1;
+    }
+    w = pv->rValue;
+
+    opt = parmlookup(device, &dev, "l", 0, 0);
+    pv = opt ? doask(ckt, typecode, dev, NULL, opt, 0) : NULL;
+    if (!pv) {
+        fprintf(cp_err, "Error: Can't access length instance parameter.\n");
+        return 1;
+    }
+    l = pv->rValue;
+
+    if (param[0] == 'w')
+        w = value;
+    else
+        l = value;
+
+    width_length = tprintf("w=%15.7e l=%15.7e", w, l);
+    error = setmodel(ckt, typecode, dev, width_length);
+    tfree(width_length);
+
+    return error;
+}
+
 /* Make a linked list where the first node is a CP_LIST variable
  * pointing to the different values of the vector variables.
  *
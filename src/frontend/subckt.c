@@ -100,7 +100,7 @@ static char *gettrans(const char *name, const char *name_end, bool *isglobal);
 static int numnodes(const char *line, struct subs *subs, wordlist const *modnames);
 static int  numdevs(char *s);
 static wordlist *modtranslate(struct card *deck, char *subname, wordlist *new_modnames);
-static void devmodtranslate(struct card *deck, char *subname, wordlist * const orig_modnames);
+static void devmodtranslate(struct card *deck, char *subname, wordlist * const orig_modnames, NGHASHPTR orig_modtab);
 static int inp_numnodes(char c);
 
 /* hash table to store the global nodes
@@ -1825,6 +1825,7 @@ static wordlist *
 modtranslate(struct card *c, char *subname, wordlist *new_modnames)
 {
     wordlist *orig_modnames = NULL;
+    NGHASHPTR orig_modtab = NULL;
     struct card *lcc = c;
 
     for (; c; c = c->nextcard)
@@ -1847,6 +1848,9 @@ modtranslate(struct card *c, char *subname, wordlist *new_modnames)
             /* remember the translation */
             orig_modnames = wl_cons(model_name, orig_modnames);
             new_modnames = wl_cons(new_model_name, new_modnames);
+            if (!orig_modtab)
+                orig_modtab = nghash_init(NGHASH_MIN_SIZE);
+            nghash_insert(orig_modtab, model_name, orig_modnames);
 
             /* perform the actual translation of this .model line */
             t = tprintf(".model %s %s", new_model_name, t);
@@ -1862,7 +1866,8 @@ modtranslate(struct card *c, char *subname, wordlist *new_modnames)
         }
 
     if (orig_modnames) {
-        devmodtranslate(lcc, subname, orig_modnames);
+        devmodtranslate(lcc, subname, orig_modnames, orig_modtab);
+        nghash_free(orig_modtab, NULL, NULL);
         wl_free(orig_modnames);
     }
 
@@ -1879,15 +1884,13 @@ modtranslate(struct card *c, char *subname, wordlist *new_modnames)
  *-------------------------------------------------------------------*/
 
 static void
-translate_mod_name(struct bxx_buffer *buffer, char *modname, char *subname, struct wordlist *orig_modnames)
+translate_mod_name(struct bxx_buffer *buffer, char *modname, char *subname, NGHASHPTR orig_modtab)
 {
     /*
-     *  Note that we compare against orig_modnames,
-     *    which is the list of untranslated names of models.
+     *  Note that we compare against orig_modtab,
+     *    which holds the untranslated names of models.
      */
-    wordlist *wlsub = wl_find(modname, orig_modnames);
-
-    if (!wlsub)
+    if (!modname || !nghash_find(orig_modtab, modname))
         bxx_printf(buffer, "%s", modname);
     else
         bxx_printf(buffer, "%s:%s", subname, modname);
@@ -1895,7 +1898,7 @@ translate_mod_name(struct bxx_buffer *buffer, char *modname, char *subname, stru
 
 
 static void
-devmodtranslate(struct card *s, char *subname, wordlist * const orig_modnames)
+devmodtranslate(struct card *s, char *subname, wordlist * const orig_modnames, NGHASHPTR orig_modtab)
 {
     int found;
 
@@ -1961,7 +1964,7 @@ devmodtranslate(struct card *s, char *subname, wordlist * const orig_modnames)
                 }
             }  /* while  */
 
-            translate_mod_name(&buffer, name, subname, orig_modnames);
+            translate_mod_name(&buffer, name, subname, orig_modtab);
             tfree(name);
             bxx_putc(&buffer, ' ');
 
@@ -1992,14 +1995,14 @@ devmodtranslate(struct card *s, char *subname, wordlist * const orig_modnames)
 
             if (*t) {    /* if there is a model, process it. . . . */
                 name = gettok(&t);
-                translate_mod_name(&buffer, name, subname, orig_modnames);
+                translate_mod_name(&buffer, name, subname, orig_modtab);
                 tfree(name);
                 bxx_putc(&buffer, ' ');
             }
 
             if (*t) {
                 name = gettok(&t);
-                translate_mod_name(&buffer, name, subname, orig_modnames);
+                translate_mod_name(&buffer, name, subname, orig_modtab);
                 tfree(name);
                 bxx_putc(&buffer, ' ');
             }
@@ -2025,8 +2028,7 @@ devmodtranslate(struct card *s, char *subname, wordlist * const orig_modnames)
                 name = copy(""); /* allow 'tfree' */
             } else {
                 for (;;) {
-                    wlsub = wl_find(name, orig_modnames);
-                    if (wlsub) {
+                    if (nghash_find(orig_modtab, name)) {
                         break;
                     } else {
                         bxx_printf(&buffer, "%s ", name);
@@ -2040,7 +2042,7 @@ devmodtranslate(struct card *s, char *subname, wordlist * const orig_modnames)
                 }  /* while  */
             }
 
-            translate_mod_name(&buffer, name, subname, orig_modnames);
+            translate_mod_name(&buffer, name, subname, orig_modtab);
 
             tfree(name);
             bxx_putc(&buffer, ' ');
@@ -2064,8 +2066,7 @@ devmodtranslate(struct card *s, char *subname, wordlist * const orig_modnames)
             }
             else {
                 for (;;) {
-                    wlsub = wl_find(name, orig_modnames);
-                    if (wlsub) {
+                    if (nghash_find(orig_modtab, name)) {
                         break;
                     }
                     else {
@@ -2080,7 +2081,7 @@ devmodtranslate(struct card *s, char *subname, wordlist * const orig_modnames)
                 }  /* while  */
             }
 
-            translate_mod_name(&buffer, name, subname, orig_modnames);
+            translate_mod_name(&buffer, name, subname, orig_modtab);
 
             tfree(name);
             bxx_putc(&buffer, ' ');
@@ -2108,7 +2109,7 @@ devmodtranslate(struct card *s, char *subname, wordlist * const orig_modnames)
             tfree(name);
             name = gettok(&t);
 
-            translate_mod_name(&buffer, name, subname, orig_modnames);
+            translate_mod_name(&buffer, name, subname, orig_modtab);
             tfree(name);
             bxx_putc(&buffer, ' ');
             bxx_put_cstring(&buffer, t);
@@ -2141,7 +2142,7 @@ devmodtranslate(struct card *s, char *subname, wordlist * const orig_modnames)
             tfree(name);
             name = gettok(&t);
 
-            translate_mod_name(&buffer, name, subname, orig_modnames);
+            translate_mod_name(&buffer, name, subname, orig_modtab);
             bxx_putc(&buffer, ' ');
             bxx_put_cstring(&buffer, t);
             tfree(s->line);
@@ -2220,8 +2221,7 @@ devmodtranslate(struct card *s, char *subname, wordlist * const orig_modnames)
                 name = copy(""); /* allow 'tfree' */
             } else {
                 for (;;) {
-                    wlsub = wl_find(name, orig_modnames);
-                    if (wlsub) {
+                    if (nghash_find(orig_modtab, name)) {
                         break;
                     } else {
                         bxx_printf(&buffer, "%s ", name);
@@ -2235,7 +2235,7 @@ devmodtranslate(struct card *s, char *subname, wordlist * const orig_modnames)
                 }  /* while  */
             }
 
-            translate_mod_name(&buffer, name, subname, orig_modnames);
+            translate_mod_name(&buffer, name, subname, orig_modtab);
             tfree(name);
             bxx_putc(&buffer, ' ');
 
@@ -2266,7 +2266,7 @@ devmodtranslate(struct card *s, char *subname, wordlist * const orig_modnames)
                 }
             }  /* while  */
 
-            translate_mod_name(&buffer, name, subname, orig_modnames);
+            translate_mod_name(&buffer, name, subname, orig_modtab);
             tfree(name);
             bxx_putc(&buffer, ' ');
 
@@ -208,6 +208,13 @@ struct name_entry {
     NAME_ENTRY next;
 };
 
+/* A list of names in insertion order, hashed for lookup */
+typedef struct name_list {
+    NAME_ENTRY head;
+    NAME_ENTRY tail;
+    NGHASHPTR table;
+} NAME_LIST;
+
 static char *get_zero_rise_fall(void);
 static char *get_name_hilo(char *tok_str);
 static char *get_current_tmodel(void);
@@ -222,50 +229,49 @@ static NAME_ENTRY new_name_entry(char *name)
     return newp;
 }
 
-static NAME_ENTRY add_name_entry(char *name, NAME_ENTRY nelist)
+static NAME_ENTRY find_name_entry(char *name, NAME_LIST *nelist)
 {
-    NAME_ENTRY newlist = NULL, x = NULL, last = NULL;
-
-    if (nelist == NULL) {
-        newlist = new_name_entry(name);
-        return newlist;
-    }
-    for (x = nelist; x; x = x->next) {
-        /* No duplicates */
-        if (eq(x->name, name)) {
-            return nelist;
-        }
-        last = x;
+    if (!nelist->table) {
+        return NULL;
     }
-    x = new_name_entry(name);
-    last->next = x;
-    return nelist;
+    return (NAME_ENTRY) nghash_find(nelist->table, name);
 }
 
-static NAME_ENTRY find_name_entry(char *name, NAME_ENTRY nelist)
+static void add_name_entry(char *name, NAME_LIST *nelist)
 {
     NAME_ENTRY x = NULL;
-    if (!nelist) {
-        return NULL;
+
+    /* No duplicates */
+    if (find_name_entry(name, nelist)) {
+        return;
     }
-    for (x = nelist; x; x = x->next) {
-        /* No duplicates */
-        if (eq(x->name, name)) {
-            return x;
-        }
+    if (!nelist->table) {
+        nelist->table = nghash_init(nghash_table_size(101));
     }
-    return NULL;
+    x = new_name_entry(name);
+    if (nelist->tail) {
+        nelist->tail->next = x;
+    } else {
+        nelist->head = x;
+    }
+    nelist->tail = x;
+    (void) nghash_insert(nelist->table, x->name, x);
 }
 
-static void clear_name_list(NAME_ENTRY nelist)
+static void clear_name_list(NAME_LIST *nelist)
 {
     NAME_ENTRY x = NULL, next = NULL;
-    if (!nelist) { return; }
-    for (x = nelist; x; x = next) {
+    for (x = nelist->head; x; x = next) {
         next = x->next;
         if (x->name) { tfree(x->name); }
         tfree(x);
     }
+    if (nelist->table) {
+        nghash_free(nelist->table, NULL, NULL);
+    }
+    nelist->head = NULL;
+    nelist->tail = NULL;
+    nelist->table = NULL;
 }
 
 /*
@@ -288,11 +294,11 @@ static int ps_with_tri_inverters = 0;  // For inv3/inv3a data inputs
 static int ps_use_mntymx = 0;
 static struct udevices_info mntymx_shorter = {0, FALSE};
 
-static NAME_ENTRY new_names_list = NULL;
-static NAME_ENTRY input_names_list = NULL;
-static NAME_ENTRY output_names_list = NULL;
-static NAME_ENTRY tristate_names_list = NULL;
-static NAME_ENTRY port_names_list = NULL;
+static NAME_LIST new_names_list = {NULL, NULL, NULL};
+static NAME_LIST input_names_list = {NULL, NULL, NULL};
+static NAME_LIST output_names_list = {NULL, NULL, NULL};
+static NAME_LIST tristate_names_list = {NULL, NULL, NULL};
+static NAME_LIST port_names_list = {NULL, NULL, NULL};
 static unsigned int num_name_collisions = 0;
 /* .model d_zero_inv99 d_inverter just once per subckt */
 static BOOL add_zero_delay_inverter_model = FALSE;
@@ -342,21 +348,16 @@ struct udevices_info u_get_udevices_info(void)
 
 static void check_name_unused(char *name)
 {
-    if (find_name_entry(name, new_names_list)) {
+    if (find_name_entry(name, &new_names_list)) {
         fprintf(stderr, "ERROR udevice name %s already used\n", name);
         num_name_collisions++;
     } else {
-        if (!new_names_list) {
-            new_names_list = add_name_entry(name, new_names_list);
-        } else {
-            (void) add_name_entry(name, new_names_list);
-        }
+        add_name_entry(name, &new_names_list);
     }
 }
 
-static void find_collision(char *name, NAME_ENTRY nelist)
+static void find_collision(char *name, NAME_LIST *nelist)
 {
-    if (!nelist) { return; }
     if (find_name_entry(name, nelist)) {
         fprintf(stderr, "ERROR name collision: internal node %s "
             "collides with a pin or port\n", name);
@@ -366,14 +367,12 @@ static void find_collision(char *name, NAME_ENTRY nelist)
 
 static BOOL there_are_name_collisions(void)
 {
-    if (new_names_list) {
-        NAME_ENTRY x = NULL;
-        for (x = new_names_list; x; x = x->next) {
-            find_collision(x->name, input_names_list);
-            find_collision(x->name, output_names_list);
-            find_collision(x->name, tristate_names_list);
-            find_collision(x->name, port_names_list);
-        }
+    NAME_ENTRY x = NULL;
+    for (x = new_names_list.head; x; x = x->next) {
+        find_collision(x->name, &input_names_list);
+        find_collision(x->name, &output_names_list);
+        find_collision(x->name, &tristate_names_list);
+        find_collision(x->name, &port_names_list);
     }
 //#define IGNORE_COLLISIONS
 #ifdef IGNORE_COLLISIONS
@@ -384,14 +383,10 @@ static BOOL there_are_name_collisions(void)
 }
 
 
-static void add_pin_name(char *name, NAME_ENTRY *nelistp)
+static void add_pin_name(char *name, NAME_LIST *nelistp)
 {
     if (strncmp(name, "$d_", 3) != 0) {
-        if (!(*nelistp)) {
-            *nelistp = add_name_entry(name, *nelistp);
-        } else {
-            (void) add_name_entry(name, *nelistp);
-        }
+        add_name_entry(name, nelistp);
     }
 }
 
@@ -744,6 +739,8 @@ static Xlatorp append_xlator(Xlatorp dest, Xlatorp src)
 
 /* static Xlatorp for collecting subckt timing model delays */
 static Xlatorp model_xlatorp = NULL;
+/* subckt model hash table */
+static NGHASHPTR model_hash_table = NULL;
 
 /* static Xlatorp for collecting global timing model delays */
 static Xlatorp global_model_xlatorp = NULL;
@@ -936,11 +933,11 @@ void initialize_udevice(char *subckt_line)
         }
         return;
     }
-    new_names_list = NULL;
-    input_names_list = NULL;
-    output_names_list = NULL;
-    tristate_names_list = NULL;
-    port_names_list = NULL;
+    clear_name_list(&new_names_list);
+    clear_name_list(&input_names_list);
+    clear_name_list(&output_names_list);
+    clear_name_list(&tristate_names_list);
+    clear_name_list(&port_names_list);
     num_name_collisions = 0;
     /*
       Variable ps_ports_and_pins != 0 to turn on pins and ports.
@@ -986,6 +983,7 @@ void initialize_udevice(char *subckt_line)
 
     create_translated_xlator();
     model_xlatorp = create_xlator();
+    model_hash_table = nghash_init(nghash_table_size(101));
     default_models = create_xlator();
     /*  .model d0_gate ugate ()  */
     xdata = create_xlate("", "(inertial_delay=true rise_delay=1.0e-12 fall_delay=1.0e-12)",
@@ -1030,20 +1028,19 @@ void cleanup_udevice(BOOL global)
     cleanup_translated_xlator();
     delete_xlator(model_xlatorp);
     model_xlatorp = NULL;
+    if (model_hash_table) {
+        nghash_free(model_hash_table, NULL, NULL);
+    }
+    model_hash_table = NULL;
     delete_xlator(default_models);
     default_models = NULL;
     add_zero_delay_inverter_model = FALSE;
     add_drive_hilo = FALSE;
-    clear_name_list(input_names_list);
-    input_names_list = NULL;
-    clear_name_list(output_names_list);
-    output_names_list = NULL;
-    clear_name_list(tristate_names_list);
-    tristate_names_list = NULL;
-    clear_name_list(port_names_list);
-    port_names_list = NULL;
-    clear_name_list(new_names_list);
-    new_names_list = NULL;
+    clear_name_list(&input_names_list);
+    clear_name_list(&output_names_list);
+    clear_name_list(&tristate_names_list);
+    clear_name_list(&port_names_list);
+    clear_name_list(&new_names_list);
     if (current_subckt) {
         tfree(current_subckt);
         current_subckt = NULL;
@@ -1118,6 +1115,35 @@ static void *insert_global_model_in_table(Xlate_datap x)
     return inserted;
 }
 
+/* The subckt models are looked up by tmodel, utype and xspice,
+   as in find_tmodel_in_xlator() */
+static void model_table_key(DSTRINGPTR ds_key, Xlate_datap x)
+{
+    ds_cat_printf(ds_key, "%s___%s___%s", x->tmodel, x->utype, x->xspice);
+}
+
+static Xlate_datap find_model_from_table(Xlate_datap x)
+{
+    Xlate_datap xfound = NULL;
+    DS_CREATE(ds_key, 32);
+
+    model_table_key(&ds_key, x);
+    xfound = (Xlate_datap) nghash_find(model_hash_table, ds_get_buf(&ds_key));
+    ds_free(&ds_key);
+    return xfound;
+}
+
+static void insert_model_in_table(Xlate_datap x)
+{
+    DS_CREATE(ds_key, 32);
+
+    model_table_key(&ds_key, x);
+    if (!nghash_find(model_hash_table, ds_get_buf(&ds_key))) {
+        (void) nghash_insert(model_hash_table, ds_get_buf(&ds_key), x);
+    }
+    ds_free(&ds_key);
+}
+
 static Xlate_datap find_in_model_xlator(Xlate_datap x, BOOL global)
 {
     Xlate_datap x1 = NULL;
@@ -1139,7 +1165,10 @@ static Xlate_datap find_in_model_xlator(Xlate_datap x, BOOL global)
         }
         return NULL;
     } else {
-        if (model_xlatorp) {
+        if (model_hash_table) {
+            x1 = find_model_from_table(x);
+            if (x1) { return x1; }
+        } else if (model_xlatorp) {
             x1 = find_tmodel_in_xlator(x, model_xlatorp);
             if (x1) { return x1; }
         }
@@ -1176,6 +1205,8 @@ static void add_delays_to_model_xlator(char *delays,
     (void) add_xlator(xlp, x);
     if (global && ps_global_hash_table) {
         (void) insert_global_model_in_table(x);
+    } else if (!global && model_hash_table) {
+        insert_model_in_table(x);
     }
 }
 
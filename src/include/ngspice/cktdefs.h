@@ -148,6 +148,7 @@ struct CKTcircuit {
 #define NIACUNINITIALIZED    0x40
 #define NIDIDPREORDER       0x100
 #define NIPZSHOULDREORDER   0x200
+#define NIMUSTREORDER       0x400   /* do not reuse the pivot order */
 
     int CKTmaxEqNum;            /* And this ? */
     int CKTcurrentAnalysis;     /* the analysis in progress (if any) */
@@ -272,6 +273,9 @@ struct CKTcircuit {
     unsigned int CKTkeepOpInfo:1; /* flag for small signal analyses */
     unsigned int CKTcopyNodesets:1; /* NodesetFIX */
     unsigned int CKTnodeDamping:1; /* flag for node damping fix */
+    unsigned int CKTreuseOrder:1; /* keep the pivot order across analyses */
+    unsigned int CKTbiasMemo:1; /* evaluate identically biased devices once */
+    unsigned int CKTfastMath:1; /* fast exp/log/pow in device models */
     double CKTabsDv;            /* abs limit for iter-iter voltage change */
     double CKTrelDv;            /* rel limit for iter-iter voltage change */
     int CKTtroubleNode;         /* Non-convergent node number */
@@ -494,6 +498,7 @@ extern int NIpzSym2(PZtrial **, PZtrial *);
 extern int NIreinit(CKTcircuit *);
 extern int NIsenReinit(CKTcircuit *);
 extern int NIdIter (CKTcircuit *);
+extern int NIdSolve (CKTcircuit *);
 extern void NInzIter(CKTcircuit *, int, int);
 #ifdef RFSPICE
 extern int NIspPreload(CKTcircuit*);
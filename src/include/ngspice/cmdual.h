@@ -0,0 +1,331 @@
+#ifndef ngspice_CMDUAL_H
+#define ngspice_CMDUAL_H
+
+/* ===========================================================================
+FILE    CMDUAL.h
+
+MEMBER OF process XSPICE
+
+Public Domain
+
+AUTHORS
+
+    ngspice team
+
+SUMMARY
+
+    Forward-mode dual numbers for code model evaluation.
+
+    A Cm_Dual_t carries a value together with its partial derivatives
+    with respect to every analog input port of the calling instance.
+    Inputs are seeded with INPUT_DUAL(port), the model body is written
+    with the cm_dual_...() operators below, and the results are stored
+    with OUTPUT_DUAL(port, value).  The output value and all partials
+    are then available after a single call of the model, so MIFload()
+    does not need to call MIFauto_partial() to compute them by divided
+    differences.
+
+    Derivatives are kept for at most CM_DUAL_MAX analog input ports.
+    Instances with more inputs request automatic (finite difference)
+    partials instead.
+
+INTERFACES
+
+    cm_dual_const(), cm_dual_input(), cm_dual_output()
+    cm_dual_add(), cm_dual_sub(), cm_dual_mul(), cm_dual_div(), ...
+
+REFERENCED FILES
+
+    None.
+
+NON-STANDARD FEATURES
+
+    None.
+
+=========================================================================== */
+
+#include <math.h>
+
+#include "ngspice/cmtypes.h"
+#include "ngspice/mifcmdat.h"
+#include "ngspice/cmproto.h"
+
+#define CM_DUAL_MAX 16
+
+typedef struct {
+    double  val;                /* The value                                  */
+    int     n;                  /* Number of valid entries in d[]             */
+    double  d[CM_DUAL_MAX];     /* Partials wrt the analog input ports        */
+} Cm_Dual_t;
+
+
+/* Partial k of a, entries beyond a->n are zero */
+static inline double
+cm_dual_deriv(const Cm_Dual_t *a, int k)
+{
+    return (k < a->n) ? a->d[k] : 0.0;
+}
+
+
+/* True if the port carries an analog value that may have partials */
+static inline int
+cm_dual_is_analog(const Mif_Port_Data_t *port)
+{
+    return !port->is_null &&
+        port->type != MIF_DIGITAL && port->type != MIF_USER_DEFINED;
+}
+
+
+/* Number of analog input ports of the instance */
+static inline int
+cm_dual_num_inputs(const Mif_Private_t *mif_private)
+{
+    int i, j, n = 0;
+
+    for (i = 0; i < mif_private->num_conn; i++) {
+        Mif_Conn_Data_t *conn = mif_private->conn[i];
+        if (conn->is_null || !conn->is_input)
+            continue;
+        for (j = 0; j < conn->size; j++)
+            if (cm_dual_is_analog(conn->port[j]))
+                n++;
+    }
+
+    return n;
+}
+
+
+/* Index of input port [conn_index][port_index] among the analog input ports */
+static inline int
+cm_dual_index(const Mif_Private_t *mif_private, int conn_index, int port_index)
+{
+    int i, j, n = 0;
+
+    for (i = 0; i <= conn_index; i++) {
+        Mif_Conn_Data_t *conn = mif_private->conn[i];
+        int size = (i == conn_index) ? port_index : conn->size;
+        if (conn->is_null || !conn->is_input)
+            continue;
+        for (j = 0; j < size; j++)
+            if (cm_dual_is_analog(conn->port[j]))
+                n++;
+    }
+
+    return n;
+}
+
+
+static inline Cm_Dual_t
+cm_dual_const(double val)
+{
+    Cm_Dual_t r;
+    r.val = val;
+    r.n = 0;
+    return r;
+}
+
+
+/* The value of an input port, seeded with a unit partial wrt itself */
+static inline Cm_Dual_t
+cm_dual_input(const Mif_Private_t *mif_private, int conn_index, int port_index)
+{
+    Mif_Port_Data_t *port = mif_private->conn[conn_index]->port[port_index];
+    Cm_Dual_t r;
+    int k, idx;
+
+    r.val = port->input.rvalue;
+    r.n = cm_dual_num_inputs(mif_private);
+    if (r.n > CM_DUAL_MAX)
+        r.n = CM_DUAL_MAX;
+
+    for (k = 0; k < r.n; k++)
+        r.d[k] = 0.0;
+
+    idx = cm_dual_index(mif_private, conn_index, port_index);
+    if (idx < r.n)
+        r.d[idx] = 1.0;
+
+    return r;
+}
+
+
+/* Store value and partials of an output port.  Falls back to
+ * automatic partials if the instance has too many analog inputs. */
+static inline void
+cm_dual_output(Mif_Private_t *mif_private, int conn_index, int port_index,
+               Cm_Dual_t y)
+{
+    Mif_Port_Data_t *out = mif_private->conn[conn_index]->port[port_index];
+    int i, j, k = 0;
+
+    out->output.rvalue = y.val;
+
+    if (cm_dual_num_inputs(mif_private) > CM_DUAL_MAX) {
+        cm_analog_auto_partial();
+        return;
+    }
+
+    for (i = 0; i < mif_private->num_conn; i++) {
+        Mif_Conn_Data_t *conn = mif_private->conn[i];
+        if (conn->is_null || !conn->is_input)
+            continue;
+        for (j = 0; j < conn->size; j++)
+            if (cm_dual_is_analog(conn->port[j]))
+                out->partial[i].port[j] = cm_dual_deriv(&y, k++);
+    }
+
+    mif_private->dual_partial = MIF_TRUE;
+}
+
+
+/* Apply a scalar function with value f and slope df to a */
+static inline Cm_Dual_t
+cm_dual_chain(const Cm_Dual_t *a, double f, double df)
+{
+    Cm_Dual_t r;
+    int k;
+
+    r.val = f;
+    r.n = a->n;
+    for (k = 0; k < r.n; k++)
+        r.d[k] = df * a->d[k];
+
+    return r;
+}
+
+
+static inline Cm_Dual_t
+cm_dual_add(Cm_Dual_t a, Cm_Dual_t b)
+{
+    Cm_Dual_t r;
+    int k;
+
+    r.val = a.val + b.val;
+    r.n = (a.n > b.n) ? a.n : b.n;
+    for (k = 0; k < r.n; k++)
+        r.d[k] = cm_dual_deriv(&a, k) + cm_dual_deriv(&b, k);
+
+    return r;
+}
+
+
+static inline Cm_Dual_t
+cm_dual_sub(Cm_Dual_t a, Cm_Dual_t b)
+{
+    Cm_Dual_t r;
+    int k;
+
+    r.val = a.val - b.val;
+    r.n = (a.n > b.n) ? a.n : b.n;
+    for (k = 0; k < r.n; k++)
+        r.d[k] = cm_dual_deriv(&a, k) - cm_dual_deriv(&b, k);
+
+    return r;
+}
+
+
+static inline Cm_Dual_t
+cm_dual_mul(Cm_Dual_t a, Cm_Dual_t b)
+{
+    Cm_Dual_t r;
+    int k;
+
+    r.val = a.val * b.val;
+    r.n = (a.n > b.n) ? a.n : b.n;
+    for (k = 0; k < r.n; k++)
+        r.d[k] = cm_dual_deriv(&a, k) * b.val + a.val * cm_dual_deriv(&b, k);
+
+    return r;
+}
+
+
+static inline Cm_Dual_t
+cm_dual_div(Cm_Dual_t a, Cm_Dual_t b)
+{
+    Cm_Dual_t r;
+    double inv = 1.0 / b.val;
+    int k;
+
+    r.val = a.val * inv;
+    r.n = (a.n > b.n) ? a.n : b.n;
+    for (k = 0; k < r.n; k++)
+        r.d[k] = (cm_dual_deriv(&a, k) - r.val * cm_dual_deriv(&b, k)) * inv;
+
+    return r;
+}
+
+
+static inline Cm_Dual_t
+cm_dual_scale(Cm_Dual_t a, double s)
+{
+    return cm_dual_chain(&a, s * a.val, s);
+}
+
+
+static inline Cm_Dual_t
+cm_dual_offset(Cm_Dual_t a, double s)
+{
+    return cm_dual_chain(&a, a.val + s, 1.0);
+}
+
+
+static inline Cm_Dual_t
+cm_dual_exp(Cm_Dual_t a)
+{
+    double e = exp(a.val);
+    return cm_dual_chain(&a, e, e);
+}
+
+
+static inline Cm_Dual_t
+cm_dual_log(Cm_Dual_t a)
+{
+    return cm_dual_chain(&a, log(a.val), 1.0 / a.val);
+}
+
+
+static inline Cm_Dual_t
+cm_dual_sqrt(Cm_Dual_t a)
+{
+    double s = sqrt(a.val);
+    return cm_dual_chain(&a, s, 0.5 / s);
+}
+
+
+static inline Cm_Dual_t
+cm_dual_pow(Cm_Dual_t a, double p)
+{
+    double f = pow(a.val, p);
+    return cm_dual_chain(&a, f, p * pow(a.val, p - 1.0));
+}
+
+
+static inline Cm_Dual_t
+cm_dual_sin(Cm_Dual_t a)
+{
+    return cm_dual_chain(&a, sin(a.val), cos(a.val));
+}
+
+
+static inline Cm_Dual_t
+cm_dual_cos(Cm_Dual_t a)
+{
+    return cm_dual_chain(&a, cos(a.val), -sin(a.val));
+}
+
+
+static inline Cm_Dual_t
+cm_dual_tanh(Cm_Dual_t a)
+{
+    double t = tanh(a.val);
+    return cm_dual_chain(&a, t, 1.0 - t * t);
+}
+
+
+static inline Cm_Dual_t
+cm_dual_fabs(Cm_Dual_t a)
+{
+    return cm_dual_chain(&a, fabs(a.val), (a.val < 0.0) ? -1.0 : 1.0);
+}
+
+#endif
@@ -25,6 +25,15 @@ void DevCapVDMOS(double, double, double, double, double,
                  double*, double*);
 double DEVpred(CKTcircuit*,int);
 
+/* bias memoization of identically biased instances (devsup.c) */
+unsigned int DEVmemoHash(const double *, int, unsigned int);
+int DEVmemoStatesEqual(CKTcircuit *, int, int, int);
+void DEVmemoCopyStates(CKTcircuit *, int, int, int);
+
+/* bytes from member first up to and including member last of *p */
+#define DEVmemoSpan(p, first, last) \
+    ((size_t) ((char *) (&(p)->last + 1) - (char *) &(p)->first))
+
 /* Cider integration */
 double limitResistorVoltage( double, double, int * );
 double limitJunctionVoltage( double, double, int * );
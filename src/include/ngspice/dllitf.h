@@ -91,6 +91,9 @@ struct coreInfo_t {
         int ((*dllitf_MIFbindCSCComplex) (GENmodel *, CKTcircuit *)) ;
         int ((*dllitf_MIFbindCSCComplexToReal) (GENmodel *, CKTcircuit *)) ;
 #endif
+  /* New entries at the end, code models built against an older header
+     find the entries they know at the same place */
+	FILE *    ((*dllitf_fopen)(const char *, const char *));
 };
 
 #endif
@@ -47,6 +47,7 @@ NON-STANDARD FEATURES
 #include "ngspice/mifcmdat.h"
 #include "ngspice/miftypes.h"
 #include "ngspice/evttypes.h"
+#include "ngspice/hash.h"
 
 
 
@@ -81,6 +82,7 @@ struct Evt_Inst_Index {
 struct Evt_Node_Info {
     Evt_Node_Info_t   *next;           /* the next in the linked list */
     char              *name;           /* Name of node in deck */
+    int               index;           /* Position in the linked list */
     int               udn_index;       /* Index of the node type */
     Mif_Boolean_t     invert;          /* True if need to make inverted copy */
     Mif_Boolean_t     save;            /* Save data for this node */
@@ -88,6 +90,7 @@ struct Evt_Node_Info {
     int               num_outputs;     /* Number of outputs connected to this node */
     int               num_insts;       /* The number of insts receiving node as input */
     Evt_Inst_Index_t  *inst_list;      /* Linked list of indexes of these instances */
+    Evt_Inst_Index_t  *inst_last;      /* Last entry of inst_list */
 };
 
 struct Evt_Inst_Info {
@@ -105,6 +108,11 @@ struct Evt_Info {
     Evt_Node_Info_t    **node_table;    /* vector of pointers to elements in node_list */
     Evt_Port_Info_t    **port_table;    /* vector of pointers to elements in port_list */
     Evt_Output_Info_t  **output_table;  /* vector of pointers to elements in output_list */
+    NGHASHPTR          node_hash;       /* node_list entries by name */
+    Evt_Inst_Info_t    *inst_last;      /* last entries of the lists while parsing */
+    Evt_Node_Info_t    *node_last;
+    Evt_Port_Info_t    *port_last;
+    Evt_Output_Info_t  *output_last;
 };
 
 
@@ -206,11 +214,26 @@ struct Evt_Node {
     void             *inverted_value; /* Inverted copy of node_value */
 };
 
+/* Node structs on the lists in Evt_Node_Data_t are carved out of */
+/* slabs of EVT_NODE_SLAB_SIZE, aligned to EVT_NODE_ALIGN bytes.    */
+/* The output_value array and, for digital nodes, the values follow */
+/* each struct in the same record.                                  */
+
+#define EVT_NODE_SLAB_SIZE  32
+#define EVT_NODE_ALIGN      64
+
+struct Evt_Node_Slab {
+    Evt_Node_Slab_t  *next;           /* pointer to next slab */
+};
+
 struct Evt_Node_Data {
     Evt_Node_t     **head;          /* Beginning of linked lists */
     Evt_Node_t     ***tail;         /* Location of last item added to list */
     Evt_Node_t     ***last_step;    /* 'tail' at last accepted timepoint */
     Evt_Node_t     **free;          /* Linked lists of items freed by backups */
+    Evt_Node_Slab_t *slabs;         /* Memory of all items on the lists */
+    size_t         *value_size;     /* Size of values kept in the items, */
+                                    /* 0 if created by the udn */
     int            num_modified;    /* Number modified since last accepted timepoint */
     int            *modified_index; /* Indexes of modified nodes */
     Mif_Boolean_t  *modified;       /* Flags used to prevent multiple entries */
@@ -226,7 +249,8 @@ struct Evt_State {
     Evt_State_t          *next;        /* Pointer to next state */
     Evt_State_t          *prev;        /* Pointer to previous state */
     double               step;         /* Time at which state was assigned (0 for DC) */
-    void                 *block;       /* Block of memory holding all states on inst */
+    void                 **data;       /* Memory of each tag, shared with prev until written */
+    void                 **own;        /* Memory of each tag owned by this state */
 };
 
 
@@ -234,7 +258,7 @@ struct Evt_State_Desc {
     Evt_State_Desc_t        *next;   /* Pointer to next description */
     int                     tag;     /* Tag for this state */
     int                     size;    /* Size of this state */
-    int                     offset;  /* Offset of this state into the state block */
+    int                     index;   /* Position in data[] and own[] of Evt_State_t */
 };
 
 
@@ -246,8 +270,10 @@ struct Evt_State_Data {
     int            num_modified;        /* Number modified since last accepted timepoint */
     int            *modified_index;     /* List of indexes modified */
     Mif_Boolean_t  *modified;           /* Flags used to prevent multiple entries */
-    int            *total_size;         /* Total bytes for all states allocated */
     Evt_State_Desc_t **desc;            /* Lists of description structures */
+    Evt_State_Desc_t ***desc_table;     /* Descriptions indexed by tag */
+    int            *num_desc_table;     /* Size of desc_table per instance */
+    int            *num_desc;           /* Number of descriptions per instance */
 };
 
 
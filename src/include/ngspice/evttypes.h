@@ -16,6 +16,7 @@ typedef struct Evt_Output_Queue Evt_Output_Queue_t;
 typedef struct Evt_Queue Evt_Queue_t;
 typedef struct Evt_Node Evt_Node_t;
 typedef struct Evt_Node_Data Evt_Node_Data_t;
+typedef struct Evt_Node_Slab Evt_Node_Slab_t;
 typedef struct Evt_State Evt_State_t;
 typedef struct Evt_State_Desc Evt_State_Desc_t;
 typedef struct Evt_State_Data Evt_State_Data_t;
@@ -0,0 +1,120 @@
+/*************
+ * Fast transcendental functions for device model evaluation.
+ *
+ * ng_fast_exp() and ng_fast_log() are short table driven straight-line
+ * code, which the compiler may inline and vectorize.  Arguments with
+ * results outside the range of normal numbers, and special values, are
+ * handed to libm.  Accuracy, checked by src/maths/misc/test_fastmath.c
+ * against libm:
+ *
+ *   ng_fast_exp(x)     at most 1 ULP
+ *   ng_fast_log(x)     at most 2 ULP
+ *   ng_fast_pow(x, y)  at most 4 (1 + |y * log(x)|) ULP
+ *
+ * sqrt() is left to libm, it is a single correctly rounded instruction.
+ *
+ * The device models call DEVexp(), DEVlog() and DEVpow(), which use
+ * these functions if the option 'fastmath' is set, libm otherwise.
+ ************/
+
+#ifndef ngspice_FASTMATH_H
+#define ngspice_FASTMATH_H
+
+#include <float.h>
+#include <math.h>
+#include <stdint.h>
+#include <string.h>
+
+#define DEVexp(ckt, x)     ((ckt)->CKTfastMath ? ng_fast_exp(x) : exp(x))
+#define DEVlog(ckt, x)     ((ckt)->CKTfastMath ? ng_fast_log(x) : log(x))
+#define DEVpow(ckt, x, y)  ((ckt)->CKTfastMath ? ng_fast_pow(x, y) : pow(x, y))
+
+
+/* ln(2)/128 split into a part exactly multipliable by integers < 2^21,
+   and the rest */
+#define NG_LN2_128_HI  (6.93147180369123816490e-01 / 128)
+#define NG_LN2_128_LO  (1.90821492927058770002e-10 / 128)
+#define NG_LN2_HI      6.93147180369123816490e-01
+#define NG_LN2_LO      1.90821492927058770002e-10
+
+/* Tables in fastmath.c: 2^(j/128), and for 128 intervals of
+   [0.6875, 1.375) a 17 bit approximation of 1 / center and -log() of it */
+extern const double ng_exp_table[128];
+extern const double ng_log_table[128][2];
+
+
+static inline double
+ng_fast_exp(double x)
+{
+    const double shift = 6755399441055744.0;    /* 1.5 * 2^52 */
+    double n, r, r2, p, scale;
+    int64_t ni;
+    uint64_t bits;
+
+    /* overflow, underflow and subnormal results */
+    if (!(x >= -707.0 && x <= 709.0))
+        return exp(x);
+
+    /* x = (128 k + j) ln2 / 128 + r, |r| <= ln2 / 256,
+       exp(x) = 2^k * 2^(j/128) * exp(r) */
+    n = (x * 184.6649652337873 + shift) - shift;
+    r = (x - n * NG_LN2_128_HI) - n * NG_LN2_128_LO;
+    ni = (int64_t) n;
+
+    memcpy(&bits, &ng_exp_table[ni & 127], sizeof bits);
+    bits += (uint64_t) ((ni - (ni & 127)) / 128) << 52;
+    memcpy(&scale, &bits, sizeof scale);
+
+    /* Taylor series of exp(r) - 1, the remainder is below 0.01 ULP */
+    r2 = r * r;
+    p = (r + r2 * (0.5 + r * (1.0 / 6))) +
+        (r2 * r2) * (1.0 / 24 + r * (1.0 / 120));
+
+    return scale + scale * p;
+}
+
+
+static inline double
+ng_fast_log(double x)
+{
+    double z, zh, r, r2, p, k;
+    const double *t;
+    uint64_t ix, tmp;
+
+    /* zero, negative, subnormal, infinite and NaN arguments */
+    if (!(x >= DBL_MIN && x <= DBL_MAX))
+        return log(x);
+
+    /* x = 2^k * z, 0.6875 <= z < 1.375, in interval i */
+    memcpy(&ix, &x, sizeof ix);
+    tmp = ix - 0x3fe6000000000000ULL;
+    t = ng_log_table[(tmp >> 45) & 127];
+    k = (double) ((int64_t) tmp >> 52);
+    ix -= tmp & 0xfff0000000000000ULL;
+    memcpy(&z, &ix, sizeof z);
+
+    /* r = z/c - 1, with the short 1/c and the upper 21 bits of z only
+       the product with the lower bits of z is rounded */
+    ix &= 0xffffffff00000000ULL;
+    memcpy(&zh, &ix, sizeof zh);
+    r = (zh * t[0] - 1.0) + (z - zh) * t[0];
+
+    /* Taylor series of log(1+r) - r, |r| < 1/128, the remainder is
+       below 1 ULP */
+    r2 = r * r;
+    p = r2 * (-0.5 + r * (1.0 / 3)) +
+        (r2 * r2) * ((-0.25 + r * 0.2) + r2 * (-1.0 / 6 + r * (1.0 / 7)));
+
+    return (k * NG_LN2_HI + t[1]) + (r + (p + k * NG_LN2_LO));
+}
+
+
+static inline double
+ng_fast_pow(double x, double y)
+{
+    if (x > 0.0 && x <= DBL_MAX)
+        return ng_fast_exp(y * ng_fast_log(x));
+    return pow(x, y);
+}
+
+#endif
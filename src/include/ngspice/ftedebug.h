@@ -47,6 +47,8 @@ struct dbcomm {
     double db_value1;   /* If this is DB_STOPWHEN. */
     double db_value2;   /* If this is DB_STOPWHEN. */
     int db_graphid; /* If iplot, id of graph. */
+    char *db_file;  /* If iplot -o, the hardcopy file. */
+    struct iplot_hist *db_hist; /* If iplot, decimated history, see graf.c */
     struct dbcomm *db_also; /* Link for conjunctions. */
     struct dbcomm *db_next; /* List of active debugging commands. */
 } ;
@@ -332,6 +332,8 @@ extern struct variable *spif_getparam_special(CKTcircuit *ckt, char **name, char
 extern void if_setndnames(char *line);
 extern void if_setparam_model(CKTcircuit *ckt, char **name, char *val );
 extern void if_setparam(CKTcircuit *ckt, char **name, char *param, struct dvec *val, int do_model);
+extern int if_setparam_bulk(CKTcircuit *ckt, int n, char **names, char **params, double *values, int do_model);
+extern int if_setparam_list(CKTcircuit *ckt, int n, GENinstance **devs, GENmodel **mods, char **params, double *values);
 extern struct variable *if_getstat(CKTcircuit *ckt, char *name);
 extern int ft_find_analysis(char *name);
 extern IFparm *ft_find_analysis_parm(int which, char *name);
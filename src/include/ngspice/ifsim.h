@@ -12,6 +12,7 @@ Author: 1986 Thomas L. Quarles
 /* gtri - add - wbk - 10/11/90 - for structs referenced in IFdevice */
 #ifdef XSPICE
 #include  "ngspice/miftypes.h"
+#include <stddef.h>
 #endif
 /* gtri - end - wbk - 10/11/90 */
 
@@ -296,6 +297,8 @@ struct IFdevice {
     int num_inst_var;              /* number of instance vars = numInstanceParms */
     Mif_Inst_Var_Info_t *inst_var; /* array of instance var info for mif parser */
 /* gtri - end - wbk - 10/11/90 */
+
+    size_t (*cm_resolve) (Mif_Private_t *, void *); /* fills the data read by the accessor macros */
 #endif
 
     int flags;          /* DEV_ */
@@ -12,6 +12,7 @@ Modified: 2000 AlansFixes
 #include "ngspice/gendefs.h"
 #include "ngspice/ifsim.h"
 #include "ngspice/inpptree.h"
+#include "ngspice/hash.h"
 
 typedef struct INPtables INPtables;
 typedef struct INPmodel INPmodel;
@@ -57,6 +58,7 @@ struct INPtables {
     GENmodel *defWmod;
     GENmodel *defYmod;
     GENmodel *defZmod;
+    struct INPfunction *INPfunctions;   /* .func kept for the B sources */
 };
 
 /* Linked list of scoping information for each netlist line entry */
@@ -64,6 +66,7 @@ struct nscope {
     struct nscope *next;
     struct card_assoc *subckts;
     struct modellist *models;
+    NGHASHPTR model_table;      /* models by base name, see inpcom.c */
 };
 
 /* A linked list of netlist line entries, associated for a specific reason */
@@ -114,6 +117,8 @@ void INPcaseFix(char *);
 char *INPdevParse(char **, CKTcircuit *, int, GENinstance *, double *, int *,
         INPtables *);
 char *INPdomodel(CKTcircuit *, struct card *, INPtables *);
+char *INPdefineFunction(CKTcircuit *, char *, INPtables *);
+void INPfreeFunctions(INPtables *);
 void INPdoOpts(CKTcircuit *, JOB *, struct card *, INPtables *);
 char *INPerrCat(char *, char *);
 char *INPstrCat(char *, char, char *);
@@ -10,6 +10,7 @@ Author: 1987 Wayne A. Christopher, U. C. Berkeley CAD Group
  * The first four are the elements of IFparseTree, defined in IFsim.h.
  */
 
+#include "ngspice/bool.h"
 #include "ngspice/ifsim.h"
 
 #ifndef ngspice_INPPTREE_H
@@ -55,9 +56,35 @@ typedef struct INPparseNode {
     int usecnt;
 } INPparseNode;
 
+/* A function defined by .func, which the front end has left as a call in
+ * the B source expressions instead of expanding it textually.  The body is
+ * parsed once, on the first call, with PT_ARG nodes for the parameters.
+ * A call is a PT_CALL node with the function in `data' and the arguments
+ * in `left'.  The derivatives of the body with respect to each parameter
+ * are functions again, built when first needed by PTdifferentiate().
+ */
+
+typedef struct INPfunction {
+    struct INPfunction *next;   /* Next in INPtables, */
+    char *name;
+    int numParams;
+    char **params;
+    char *body;                 /* ... text of the body, */
+    CKTcircuit *ckt;
+    INPparseNode *tree;         /* ... and its parse tree. */
+    struct INPfunction **derivs;    /* d body / d param, if any. */
+    int busy;                   /* Set while parsing the body. */
+    int usecnt;
+} INPfunction;
+
+#define PT_MAXARGS  32          /* Max. number of params of an INPfunction */
+
 /* A debugging function */
 void INPptPrint(char *str, IFparseTree * ptree);
 
+/* TRUE if a built-in function may be used in the body of an INPfunction */
+bool INPfunctionBuiltin(const char *name);
+
 /* FIXME, less public
  *   and replace with static inline functions for better type check
  */
@@ -88,6 +115,8 @@ void INPptPrint(char *str, IFparseTree * ptree);
 #define PT_TIME     12
 #define PT_TEMPERATURE   13
 #define PT_FREQUENCY   14
+#define PT_ARG      15          /* Parameter in the body of a .func */
+#define PT_CALL     16          /* Call of a .func */
 
 /* These are the functions that we support. */
 
@@ -986,6 +986,7 @@ typedef struct sKLUmatrix {
     double *KLUmatrixTrashCOO ;                     /* KLU COO Trash Pointer for Ground Node not Stored in the Matrix */
     double **KLUmatrixDiag ;                        /* KLU pointer to diagonal element to perform Gmin */
     unsigned int KLUloadDiagGmin:1 ;                /* KLU flag to load Diag Gmin */
+    unsigned int KLUmatrixNumericIsReal:1 ;         /* KLU flag for a real factorization in KLUmatrixNumeric */
 
 #ifdef CIDER
     int *KLUmatrixColCOOforCIDER ;             /* KLU Col Index for COO storage (for CIDER) */
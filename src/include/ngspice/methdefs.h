@@ -22,6 +22,7 @@ typedef struct sMETHcard {
     int METHmobDeriv;
     int METHitLim;
     int METHvoltPred;
+    int METHjacReuse;
     unsigned int METHdabstolGiven : 1;
     unsigned int METHdreltolGiven : 1;
     unsigned int METHomegaGiven : 1;
@@ -30,6 +31,7 @@ typedef struct sMETHcard {
     unsigned int METHmobDerivGiven : 1;
     unsigned int METHitLimGiven : 1;
     unsigned int METHvoltPredGiven : 1;
+    unsigned int METHjacReuseGiven : 1;
 } METHcard;
 
 /* METH parameters */
@@ -42,6 +44,7 @@ enum {
     METH_NOMOBDERIV,
     METH_ITLIM,
     METH_VOLTPRED,
+    METH_JACREUSE,
 };
 
 #endif
@@ -74,6 +74,7 @@ typedef struct {
    char               *errmsg;    /* An error msg from a cm_... function */
    Mif_Bkpt_Info_t    breakpoint; /* Data used by dynamic breakpoints */
    Mif_Auto_Partial_t auto_partial; /* Flags to enable auto partial computations */
+   Mif_Boolean_t      parallel;   /* Set by .option to evaluate models on several threads */
 } Mif_Info_t;
 
 
@@ -84,4 +85,21 @@ extern int MIFmSize;
 
 extern Mif_Info_t  g_mif_info;
 
+/* The cm_... functions reach the context of the calling instance */
+/* through MIF_INFO.  While MIFload() evaluates code models on    */
+/* several threads, each thread points g_mif_info_local to its    */
+/* own copy of g_mif_info.  Only the context is made private: a   */
+/* code model run with .option cmparallel must keep its state in  */
+/* the storage of the instance (cm_analog_alloc(), STATIC_VAR),   */
+/* file or function scope static variables are shared by all      */
+/* threads and are not safe.                                      */
+
+#ifdef USE_OMP
+extern Mif_Info_t  *g_mif_info_local;
+#pragma omp threadprivate(g_mif_info_local)
+#define MIF_INFO  (g_mif_info_local ? g_mif_info_local : &g_mif_info)
+#else
+#define MIF_INFO  (&g_mif_info)
+#endif
+
 #endif
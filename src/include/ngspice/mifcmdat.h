@@ -405,6 +405,8 @@ struct Mif_Private {
     int                    num_inst_var;  /* Number of instance variables         */
     Mif_Inst_Var_Data_t    **inst_var;    /* Information about each inst variable */
     Mif_Callback_t         *callback;     /* Callback function */
+    Mif_Boolean_t          dual_partial;  /* Partials set by cm_dual_output()     */
+    void                   *resolved;     /* Parameters and ports, see MIFresolve */
 
 };
 
@@ -69,6 +69,8 @@ struct MIFinstance {
 
     int                 num_state;        /* Number of state tags used for this inst */
     Mif_State_t         *state;           /* Info about states */
+    int                 num_state_offset; /* Size of state_offset */
+    int                 *state_offset;    /* State index by tag, -1 if none */
 
     int                 num_intgr;        /* Number of integrals */
     Mif_Intgr_t         *intgr;           /* Info for integrals */
@@ -77,6 +79,7 @@ struct MIFinstance {
     Mif_Conv_t          *conv;            /* Info for convergence things */
 
     Mif_Boolean_t       initialized;      /* True if model called once already */
+    Mif_Boolean_t       evaluated;        /* True if called in the parallel phase of MIFload */
 
     Mif_Boolean_t       analog;           /* true if this inst is analog or hybrid type */
     Mif_Boolean_t       event_driven;     /* true if this inst is event-driven or hybrid type */
@@ -84,8 +87,12 @@ struct MIFinstance {
 
     int                 inst_index;       /* Index into inst_table in evt struct in ckt */
     Mif_Callback_t      callback;         /* instance callback function */
+    void                *resolved;        /* Parameters and ports, see MIFresolve */
 };
 
+/* State tags below this are found through a table indexed by the tag */
+#define MIF_TAG_TABLE_MAX 256
+
 
 
 /* The per model data structure */
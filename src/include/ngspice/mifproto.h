@@ -86,6 +86,10 @@ extern int MIFunsetup(
     CKTcircuit    *ckt
 );
 
+extern void MIFresolve(
+    MIFinstance *here
+);
+
 extern int MIFload(
     GENmodel      *inModel,
     CKTcircuit    *ckt 
@@ -53,6 +53,8 @@ typedef struct {
     runDesc *NplotPtr; /* the plot pointer */
     IFuid *namelist;       /* list of plot names */
     unsigned squared : 1;
+    unsigned biasValid : 1;  /* bias dependent noise parameters kept by the */
+                             /* devices are valid for the operating point */
 } Ndata;
 
 
@@ -49,6 +49,7 @@ typedef struct sONEdevice
     double rhsNorm;                    /* norm of rhs vector */
     double abstol;                     /* absolute tolerance for device */
     double reltol;                     /* relative tolerance for device */
+    int jacReuse;                      /* flag to reuse factored Jacobian */
     char *name;                        /* name of device */
 } ONEdevice;
 
@@ -28,6 +28,15 @@ typedef struct {
 
     int STATtotalDev;   /* PN: number of total devices in the netlist */
 
+    int STATreorders;       /* number of matrix reorderings */
+    int STATreusedOrders;   /* number of reorderings avoided by keeping */
+                            /* the pivot order */
+
+    int STATmemoLookups;    /* device evaluations looked up in the bias */
+                            /* memoization table */
+    int STATmemoHits;       /* device evaluations copied from an */
+                            /* identically biased instance */
+
     double STATtotAnalTime;     /* total time for all analysis */
     double STATloadTime;        /* total time spent in device loading */
     double STATdecompTime;      /* total time spent in LU decomposition */
@@ -121,6 +130,13 @@ enum {
     OPT_INDVERBOSITY,
     OPT_EPSMIN,
     OPT_CSHUNT,
+    OPT_REUSEORDER,
+    OPT_REORDERS,
+    OPT_REUSEDORDERS,
+    OPT_BIASMEMO,
+    OPT_MEMOLOOKUPS,
+    OPT_MEMOHITS,
+    OPT_FASTMATH,
 
 #ifdef KLU
     OPT_SPARSE,
@@ -142,6 +158,7 @@ enum {
     OPT_ENH_CONV_STEP,
     OPT_MIF_AUTO_PARTIAL,
     OPT_ENH_RSHUNT,
+    OPT_MIF_PARALLEL,
 };
 
 /* gtri - end   - wbk - add new options */
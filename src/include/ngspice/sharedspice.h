@@ -458,6 +458,13 @@ NG_BOOL ngSpice_running(void);
 IMPEXP
 NG_BOOL ngSpice_SetBkpt(double time);
 
+/* Alter many device (or, if model is true, model) parameters in one go:
+   parameter params[i] of devs[i] is set to values[i] for i = 0 .. n-1.
+   Returns the number of changes that could not be done, -1 if no
+   circuit is loaded. To be called while no simulation is running. */
+IMPEXP
+int ngSpice_AlterBulk(int n, char** devs, char** params, double* values, NG_BOOL model);
+
 /* Set variable no_spinit, if reading 'spinit' is not wanted. */
 IMPEXP
 int ngSpice_nospinit(void);
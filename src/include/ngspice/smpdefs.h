@@ -65,6 +65,7 @@ int SMPcLUfac( SMPmatrix *, double );
 int SMPluFac( SMPmatrix *, double , double );
 int SMPcReorder( SMPmatrix * , double , double , int *);
 int SMPreorder( SMPmatrix * , double , double , double );
+int SMPreuseOrder( SMPmatrix * , double , double , double );
 void SMPcaSolve(SMPmatrix *Matrix, double RHS[], double iRHS[],
 		double Spare[], double iSpare[]);
 void SMPcSolve( SMPmatrix *, double [], double [], double [], double []);
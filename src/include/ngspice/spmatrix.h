@@ -241,6 +241,7 @@ struct  spTemplate
 
 
 typedef struct MatrixFrame *MatrixPtr;
+typedef struct SymbolicFrame *SymbolicPtr;
 
 
 /*
@@ -259,9 +260,12 @@ extern  void     spDestroy( MatrixPtr);
 extern  int      spElementCount( MatrixPtr );
 extern  int      spError( MatrixPtr );
 extern  int      spFactor( MatrixPtr );
+extern  int      spFactorKeepOrder( MatrixPtr, spREAL );
+extern  int      spFactorSharedOrder( MatrixPtr );
 extern  int      spFileMatrix( MatrixPtr, char *, char *, int, int, int );
 extern  int      spFileStats( MatrixPtr, char *, char * );
 extern  int      spFillinCount( MatrixPtr );
+extern  void     spFreeSymbolic( SymbolicPtr );
 extern  int      spGetAdmittance( MatrixPtr, int, int, struct spTemplate* );
 extern  spREAL  *spFindElement(MatrixPtr Matrix, int Row, int Col );
 extern  spREAL  *spGetElement(MatrixPtr, int, int );
@@ -269,12 +273,14 @@ extern  void    *spGetInitInfo( spREAL* );
 extern  int      spGetOnes( MatrixPtr, int, int, int, struct spTemplate* );
 extern  int      spGetQuad( MatrixPtr, int, int, int, int, struct spTemplate* );
 extern  int      spGetSize( MatrixPtr, int );
+extern  SymbolicPtr spGetSymbolic( MatrixPtr );
 extern  int      spInitialize(MatrixPtr, int (*pInit)(spREAL*, void *InitInfo, int, int Col));
 extern  void     spInstallInitInfo( spREAL*, void * );
 extern  spREAL   spLargestElement( MatrixPtr );
 extern  void     spMNA_Preorder( MatrixPtr );
 extern  spREAL   spNorm( MatrixPtr );
 extern  int      spOrderAndFactor(MatrixPtr, spREAL*, spREAL, spREAL, int );
+extern  int      spOrderAndFactorGiven( MatrixPtr, SymbolicPtr );
 extern  int      spOriginalCount( MatrixPtr);
 extern  void     spPartition( MatrixPtr, int );
 extern  void     spPrint(MatrixPtr, int, int, int );
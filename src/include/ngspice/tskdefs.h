@@ -69,6 +69,9 @@ struct TSKtask {
     unsigned int TSKkeepOpInfo:1; /* flag for small signal analyses */
     unsigned int TSKcopyNodesets:1; /* flag for nodeset copy */
     unsigned int TSKnodeDamping:1;  /* flag for node damping */
+    unsigned int TSKreuseOrder:1;   /* flag for pivot order reuse */
+    unsigned int TSKbiasMemo:1;     /* flag for device bias memoization */
+    unsigned int TSKfastMath:1;     /* flag for fast device model math */
     unsigned int TSKnoopac:1; /* flag for no OP calculation before AC */
     double TSKabsDv;                 /* abs limit for iter-iter voltage change */
     double TSKrelDv;                 /* rel limit for iter-iter voltage change */
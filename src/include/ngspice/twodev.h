@@ -55,6 +55,7 @@ typedef struct sTWOdevice
     double rhsNorm;                    /* norm of rhs vector */
     double abstol;                     /* absolute tolerance for device */
     double reltol;                     /* relative tolerance for device */
+    int jacReuse;                      /* flag to reuse factored Jacobian */
     char *name;	                       /* name of device */
 } TWOdevice;
 
@@ -42,6 +42,7 @@ extern int rl_catch_signals;        /* missing from editline/readline.h */
 #include "misc/ivars.h"
 #include "misc/misc_time.h"
 #include "misc/util.h"
+#include "misc/zfile.h"
 
 #if defined(HAS_WINGUI) || defined(_MSC_VER) || defined(__MINGW32__)
 # include "misc/mktemp.h"
@@ -1033,7 +1034,7 @@ int main(int argc, char **argv)
 
         case 'c':       /* Circuit file */
             if (optarg) {
-                if ((circuit_file = fopen(optarg, "r")) == NULL) {
+                if ((circuit_file = ngzfopen(optarg, "r")) == NULL) {
                     perror(optarg);
                     sp_shutdown(EXIT_BAD);
                 }
@@ -1398,13 +1399,13 @@ int main(int argc, char **argv)
                 arg = cp_unquote(arg);
 #endif
                 /* Copy all the arguments into the temporary file */
-                tp = fopen(arg, "r");
+                tp = ngzfopen(arg, "r");
                 if (!tp) {
                     char *lbuffer = getenv("NGSPICE_INPUT_DIR");
                     if (lbuffer && *lbuffer) {
                         char *p = tprintf("%s" DIR_PATHSEP "%s",
                                 lbuffer, arg);
-                        tp = fopen(p, "r");
+                        tp = ngzfopen(p, "r");
                         tfree(p);
                     }
 
@@ -1433,10 +1434,11 @@ int main(int argc, char **argv)
 
                 if (!gotone) {
                     char line[256];
+                    bool haveline = (fgets(line, sizeof line, tp) != NULL);
 
                     /* Check for "*ng_script_with_params" as first line. */
 
-                    if (fgets(line, sizeof line, tp) &&
+                    if (haveline &&
                         ciprefix("*ng_script_with_params", line)) {
                         /* Special script file: remaining arguments are
                          * script parameters.
@@ -1447,7 +1449,9 @@ int main(int argc, char **argv)
                         Copy_of_argv = argv;
                         break;
                     } else {
-                        fseek(tp, 0L, SEEK_SET);
+                        /* keep the line, tp may be a pipe */
+                        if (haveline)
+                            fputs(line, tempfile);
                         gotone = TRUE;
                     }
                 }
@@ -711,6 +711,7 @@ SMPcReorder (SMPmatrix *Matrix, double PivTol, double PivRel, int *NumSwaps)
         Matrix->SMPkluMatrix->KLUmatrixNumeric = klu_z_factor (Matrix->SMPkluMatrix->KLUmatrixAp, Matrix->SMPkluMatrix->KLUmatrixAi,
                                                                Matrix->SMPkluMatrix->KLUmatrixAxComplex, Matrix->SMPkluMatrix->KLUmatrixSymbolic,
                                                                Matrix->SMPkluMatrix->KLUmatrixCommon) ;
+        Matrix->SMPkluMatrix->KLUmatrixNumericIsReal = 0 ;
 
         if (Matrix->SMPkluMatrix->KLUmatrixNumeric == NULL)
         {
@@ -771,6 +772,7 @@ SMPreorder (SMPmatrix *Matrix, double PivTol, double PivRel, double Gmin)
         Matrix->SMPkluMatrix->KLUmatrixNumeric = klu_factor (Matrix->SMPkluMatrix->KLUmatrixAp, Matrix->SMPkluMatrix->KLUmatrixAi,
                                                              Matrix->SMPkluMatrix->KLUmatrixAx, Matrix->SMPkluMatrix->KLUmatrixSymbolic,
                                                              Matrix->SMPkluMatrix->KLUmatrixCommon) ;
+        Matrix->SMPkluMatrix->KLUmatrixNumericIsReal = 1 ;
 
         if (Matrix->SMPkluMatrix->KLUmatrixNumeric == NULL)
         {
@@ -805,6 +807,69 @@ SMPreorder (SMPmatrix *Matrix, double PivTol, double PivRel, double Gmin)
     }
 }
 
+/*
+ * SMPreuseOrder()
+ *
+ * Refactor the matrix with the pivot order of the last real factorization.
+ * The result is accepted only if the reciprocal pivot growth is at least
+ * PivRel, otherwise E_BADMATRIX is returned and the caller has to reorder.
+ * KLUmatrixAx is left unchanged in that case, Gmin has already been added.
+ * Without KLU, see the Sparse version in spsmp.c: E_SINGULAR means the
+ * matrix has to be loaded again.
+ */
+
+int
+SMPreuseOrder (SMPmatrix *Matrix, double PivTol, double PivRel, double Gmin)
+{
+    int ret ;
+
+    if (Matrix->CKTkluMODE)
+    {
+        NG_IGNORE (PivTol) ;
+
+        if (CircuitIsDigital() && Matrix->SMPkluMatrix->KLUmatrixN == 0) {
+          // XSPICE pure digital circuits produce empty KLU matrix
+          return 0 ;
+        }
+
+        if ((Matrix->SMPkluMatrix->KLUmatrixNumeric == NULL) || !Matrix->SMPkluMatrix->KLUmatrixNumericIsReal) {
+            return E_BADMATRIX ;
+        }
+
+        if (Matrix->SMPkluMatrix->KLUloadDiagGmin) {
+            LoadGmin_CSC (Matrix->SMPkluMatrix->KLUmatrixDiag, Matrix->SMPkluMatrix->KLUmatrixN, Gmin) ;
+            Matrix->SMPkluMatrix->KLUloadDiagGmin = 0 ;
+        }
+
+        ret = klu_refactor (Matrix->SMPkluMatrix->KLUmatrixAp, Matrix->SMPkluMatrix->KLUmatrixAi, Matrix->SMPkluMatrix->KLUmatrixAx,
+                            Matrix->SMPkluMatrix->KLUmatrixSymbolic, Matrix->SMPkluMatrix->KLUmatrixNumeric, Matrix->SMPkluMatrix->KLUmatrixCommon) ;
+
+        if (ret) {
+            ret = klu_rgrowth (Matrix->SMPkluMatrix->KLUmatrixAp, Matrix->SMPkluMatrix->KLUmatrixAi, Matrix->SMPkluMatrix->KLUmatrixAx,
+                               Matrix->SMPkluMatrix->KLUmatrixSymbolic, Matrix->SMPkluMatrix->KLUmatrixNumeric, Matrix->SMPkluMatrix->KLUmatrixCommon) ;
+        }
+
+        if (!ret || (Matrix->SMPkluMatrix->KLUmatrixCommon->status != KLU_OK) ||
+            (Matrix->SMPkluMatrix->KLUmatrixCommon->rgrowth < PivRel)) {
+            if (ft_ngdebug) {
+                fprintf (stderr, "Warning (ReuseOrder): pivot order rejected, reciprocal pivot growth %g\n",
+                         Matrix->SMPkluMatrix->KLUmatrixCommon->rgrowth) ;
+            }
+            return E_BADMATRIX ;
+        }
+
+        return 0 ;
+    } else {
+        if (Matrix->SPmatrix->NeedsOrdering) {
+            return E_BADMATRIX ;
+        }
+
+        spSetReal (Matrix->SPmatrix) ;
+        LoadGmin (Matrix, Gmin) ;
+        return spFactorKeepOrder (Matrix->SPmatrix, (spREAL)PivRel) ;
+    }
+}
+
 #ifdef CIDER
 int
 SMPreorderKLUforCIDER (SMPmatrix *Matrix)
@@ -871,7 +936,7 @@ SMPreorderKLUforCIDER (SMPmatrix *Matrix)
             return 0 ;
         }
     } else {
-        return spFactor (Matrix->SPmatrix) ;
+        return spFactorSharedOrder (Matrix->SPmatrix) ;
     }
 }
 #endif
@@ -1092,6 +1157,7 @@ SMPnewMatrix (SMPmatrix *Matrix, int size)
         Matrix->SMPkluMatrix->KLUmatrixCommon = (klu_common *) malloc (sizeof (klu_common)) ; ;
         Matrix->SMPkluMatrix->KLUmatrixSymbolic = NULL ;
         Matrix->SMPkluMatrix->KLUmatrixNumeric = NULL ;
+        Matrix->SMPkluMatrix->KLUmatrixNumericIsReal = 0 ;
         Matrix->SMPkluMatrix->KLUmatrixAp = NULL ;
         Matrix->SMPkluMatrix->KLUmatrixAi = NULL ;
         Matrix->SMPkluMatrix->KLUmatrixAx = NULL ;
@@ -1135,6 +1201,7 @@ SMPnewMatrixKLUforCIDER (SMPmatrix *Matrix, int size, unsigned int KLUmatrixIsCo
         Matrix->SMPkluMatrix->KLUmatrixCommon = (klu_common *) malloc (sizeof (klu_common)) ; ;
         Matrix->SMPkluMatrix->KLUmatrixSymbolic = NULL ;
         Matrix->SMPkluMatrix->KLUmatrixNumeric = NULL ;
+        Matrix->SMPkluMatrix->KLUmatrixNumericIsReal = 0 ;
         Matrix->SMPkluMatrix->KLUmatrixAp = NULL ;
         Matrix->SMPkluMatrix->KLUmatrixAi = NULL ;
         Matrix->SMPkluMatrix->KLUmatrixAxComplex = NULL ;
@@ -1845,8 +1912,7 @@ SMPfindElt (SMPmatrix *eMatrix, int Row, int Col, int CreateIfMissing)
         assert (IS_SPARSE (Matrix)) ;
         Row = Matrix->ExtToIntRowMap [Row] ;
         Col = Matrix->ExtToIntColMap [Col] ;
-        Element = Matrix->FirstInCol [Col] ;
-        Element = spcFindElementInCol (Matrix, &Element, Row, Col, CreateIfMissing) ;
+        Element = spcFindElementInCol (Matrix, &Matrix->FirstInCol [Col], Row, Col, CreateIfMissing) ;
         return (SMPelement *)Element ;
     }
 }
@@ -1894,6 +1960,8 @@ SMPcAddCol (SMPmatrix *eMatrix, int Accum_Col, int Addend_Col)
     Accum_Col = Matrix->ExtToIntColMap [Accum_Col] ;
     Addend_Col = Matrix->ExtToIntColMap [Addend_Col] ;
 
+    spcSortColumns (Matrix) ;
+
     Addend = Matrix->FirstInCol [Addend_Col] ;
     Prev = &Matrix->FirstInCol [Accum_Col] ;
     Accum = *Prev;
@@ -0,0 +1,189 @@
+/*************
+ * Tables of the fast math functions in ngspice/fastmath.h
+ ************/
+
+#include "ngspice/fastmath.h"
+
+
+/* 2^(j/128) */
+const double ng_exp_table[128] = {
+    1.0, 1.0054299011128027, 1.0108892860517005,
+    1.016378314910953, 1.0218971486541166, 1.0274459491187637,
+    1.0330248790212284, 1.0386341019613787, 1.0442737824274138,
+    1.0499440858006872, 1.0556451783605572, 1.061377227289262,
+    1.0671404006768237, 1.0729348675259756, 1.0787607977571199,
+    1.0846183622133092, 1.0905077326652577, 1.0964290818163769,
+    1.102382583307841, 1.1083684117236787, 1.1143867425958924,
+    1.1204377524096067, 1.1265216186082418, 1.1326385195987192,
+    1.1387886347566916, 1.1449721444318042, 1.1511892299529827,
+    1.1574400736337511, 1.1637248587775775, 1.1700437696832502,
+    1.1763969916502812, 1.182784710984341, 1.189207115002721,
+    1.1956643920398273, 1.202156731452703, 1.2086843236265816,
+    1.215247359980469, 1.2218460329727576, 1.22848053610687,
+    1.2351510639369334, 1.241857812073484, 1.2486009771892048,
+    1.255380757024691, 1.2621973503942507, 1.2690509571917332,
+    1.275941778396392, 1.2828700160787783, 1.2898358734066657,
+    1.2968395546510096, 1.3038812651919358, 1.3109612115247644,
+    1.318079601266064, 1.3252366431597413, 1.3324325470831615,
+    1.339667524053303, 1.3469417862329458, 1.3542555469368927,
+    1.3616090206382248, 1.3690024229745905, 1.3764359707545302,
+    1.383909881963832, 1.3914243757719262, 1.3989796725383112,
+    1.4065759938190154, 1.4142135623730951, 1.4218926021691656,
+    1.42961333839197, 1.4373759974489824, 1.4451808069770467,
+    1.4530279958490526, 1.460917794180647, 1.4688504333369818,
+    1.4768261459394993, 1.4848451658727524, 1.4929077282912648,
+    1.5010140696264256, 1.5091644275934228, 1.5173590411982147,
+    1.5255981507445384, 1.533881997840956, 1.5422108254079407,
+    1.550584877685, 1.559004400237837, 1.567469639965553,
+    1.5759808451078865, 1.5845382652524937, 1.593142151342267,
+    1.6017927556826934, 1.6104903319492543, 1.6192351351948637,
+    1.6280274218573478, 1.6368674497669644, 1.645755478153965,
+    1.6546917676561943, 1.6636765803267364, 1.6727101796415966,
+    1.681792830507429, 1.6909247992693053, 1.7001063537185235,
+    1.709337763100463, 1.718619298122478, 1.7279512309618377,
+    1.7373338352737062, 1.746767386199169, 1.7562521603732995,
+    1.7657884359332727, 1.7753764925265212, 1.785016611318935,
+    1.7947090750031072, 1.804454167806624, 1.8142521755003989,
+    1.8241033854070534, 1.8340080864093424, 1.843966568958626,
+    1.8539791250833855, 1.864046048397789, 1.8741676341103,
+    1.8843441790323345, 1.8945759815869656, 1.9048633418176741,
+    1.9152065613971474, 1.925605943636125, 1.9360617934922943,
+    1.9465744175792332, 1.9571441241754002, 1.9677712232331759,
+    1.978456026387951, 1.9891988469672663
+};
+
+
+/* Interval i of [0.6875, 1.375) is [0.6875 + i/256, 0.6875 + (i+1)/256)
+   for i < 80, [1 + (i-80)/128, 1 + (i-79)/128) above.  1/c and -log(1/c),
+   c the center of the interval, 1 for the two intervals next to 1, where
+   log() must not lose accuracy. */
+const double ng_log_table[128][2] = {
+    { 1.4504241943359375, -0.3718560614666021 },
+    { 1.4422607421875, -0.36621184234171916 },
+    { 1.434173583984375, -0.3605887836552222 },
+    { 1.426177978515625, -0.35499812382228213 },
+    { 1.4182891845703125, -0.3494513456602954 },
+    { 1.41046142578125, -0.34391690318184115 },
+    { 1.402740478515625, -0.3384278078986754 },
+    { 1.3950958251953125, -0.33296310481043007 },
+    { 1.3875274658203125, -0.3275233616283412 },
+    { 1.3800506591796875, -0.32212020804583247 },
+    { 1.372650146484375, -0.31674328476383323 },
+    { 1.365325927734375, -0.3113931750317123 },
+    { 1.35809326171875, -0.30608170256543343 },
+    { 1.350921630859375, -0.3007870490493119 },
+    { 1.3438262939453125, -0.2955209881716242 },
+    { 1.3368072509765625, -0.2902841224140211 },
+    { 1.329864501953125, -0.2850770588129899 },
+    { 1.322998046875, -0.2799004088467705 },
+    { 1.316192626953125, -0.2747431952563183 },
+    { 1.3094635009765625, -0.2696175120888779 },
+    { 1.30279541015625, -0.2645122713528281 },
+    { 1.29620361328125, -0.2594396946030646 },
+    { 1.2896728515625, -0.25438858277086807 },
+    { 1.283203125, -0.24935939344510272 },
+    { 1.2768096923828125, -0.24436453883654677 },
+    { 1.270477294921875, -0.23939265263994053 },
+    { 1.264190673828125, -0.234432133895584 },
+    { 1.2579803466796875, -0.22950753548505898 },
+    { 1.2518310546875, -0.22460732322719196 },
+    { 1.2457427978515625, -0.21973197678723821 },
+    { 1.239715576171875, -0.21488197925175412 },
+    { 1.233734130859375, -0.210045449157502 },
+    { 1.227813720703125, -0.2052351249798702 },
+    { 1.221954345703125, -0.20045149974308152 },
+    { 1.216156005859375, -0.19569506960721555 },
+    { 1.2104034423828125, -0.19095372749227135 },
+    { 1.2047119140625, -0.18624046289271814 },
+    { 1.199066162109375, -0.18154305559833298 },
+    { 1.1934661865234375, -0.1768618350367457 },
+    { 1.1879425048828125, -0.1722228232060126 },
+    { 1.1824493408203125, -0.16758799972233832 },
+    { 1.1770172119140625, -0.16298345171757392 },
+    { 1.171630859375, -0.15839667513890182 },
+    { 1.166290283203125, -0.1538280133787169 },
+    { 1.1609954833984375, -0.14927781243983032 },
+    { 1.15576171875, -0.14475962335458553 },
+    { 1.1505584716796875, -0.14024745204381753 },
+    { 1.145416259765625, -0.13576811658633006 },
+    { 1.1403045654296875, -0.13129538938243696 },
+    { 1.13525390625, -0.12685633186205827 },
+    { 1.1302490234375, -0.12243798316875808 },
+    { 1.125274658203125, -0.11802714648391081 },
+    { 1.1203460693359375, -0.11363762805779225 },
+    { 1.1154632568359375, -0.10926979560832326 },
+    { 1.110626220703125, -0.10492401903984944 },
+    { 1.1058349609375, -0.10060067038999877 },
+    { 1.10107421875, -0.09628626577738032 },
+    { 1.0963592529296875, -0.09199492033567473 },
+    { 1.0916900634765625, -0.08772701238171039 },
+    { 1.0870513916015625, -0.08346888540378711 },
+    { 1.08245849609375, -0.07923483936848788 },
+    { 1.0778961181640625, -0.07501110250390812 },
+    { 1.0733795166015625, -0.07081209785218866 },
+    { 1.0688934326171875, -0.0666239382216214 },
+    { 1.064453125, -0.06246116962373629 },
+    { 1.0600433349609375, -0.058309789326948296 },
+    { 1.0556640625, -0.05417001203975518 },
+    { 1.05133056640625, -0.05005656804262499 },
+    { 1.047027587890625, -0.04595528100699416 },
+    { 1.0427703857421875, -0.041881003884339456 },
+    { 1.038543701171875, -0.037819444500043584 },
+    { 1.0343475341796875, -0.033770826171839574 },
+    { 1.030181884765625, -0.029735373802960933 },
+    { 1.0260467529296875, -0.025713313867970992 },
+    { 1.0219573974609375, -0.021719805453684536 },
+    { 1.0178985595703125, -0.017740266375747753 },
+    { 1.01385498046875, -0.013759877651842538 },
+    { 1.009857177734375, -0.009808912670301087 },
+    { 1.005889892578125, -0.005872614969811004 },
+    { 1.0, 0.0 },
+    { 1.0, 0.0 },
+    { 0.9884185791015625, 0.011649007895861301 },
+    { 0.9808502197265625, 0.019335512290289448 },
+    { 0.973388671875, 0.026971819337988694 },
+    { 0.966033935546875, 0.03455631542095274 },
+    { 0.95880126953125, 0.04207145233929458 },
+    { 0.9516754150390625, 0.04953125291685886 },
+    { 0.9446563720703125, 0.05693404505570542 },
+    { 0.9377288818359375, 0.0642944103100438 },
+    { 0.930908203125, 0.07159460686177997 },
+    { 0.9241943359375, 0.07883290917598239 },
+    { 0.9175567626953125, 0.08604083426918865 },
+    { 0.9110260009765625, 0.09318384099163994 },
+    { 0.9045867919921875, 0.10027702298221262 },
+    { 0.8982391357421875, 0.10731894797711364 },
+    { 0.8919830322265625, 0.11430816875058222 },
+    { 0.8858184814453125, 0.12124322358186791 },
+    { 0.879730224609375, 0.12813998145380212 },
+    { 0.87371826171875, 0.13499731030701892 },
+    { 0.8677978515625, 0.1417964813498059 },
+    { 0.8619537353515625, 0.14855368104468933 },
+    { 0.8561859130859375, 0.15526773823782786 },
+    { 0.850494384765625, 0.16193746944241313 },
+    { 0.844879150390625, 0.1685616791421121 },
+    { 0.8393402099609375, 0.17513916011573066 },
+    { 0.8338775634765625, 0.1816686937835207 },
+    { 0.8284759521484375, 0.18816746830812411 },
+    { 0.823150634765625, 0.19461606374629706 },
+    { 0.8178863525390625, 0.20103188535784805 },
+    { 0.8126983642578125, 0.20739525395071715 },
+    { 0.8075714111328125, 0.21372379295605903 },
+    { 0.8025054931640625, 0.22001657893714113 },
+    { 0.7975006103515625, 0.22627267899231743 },
+    { 0.792572021484375, 0.23247189851529618 },
+    { 0.787689208984375, 0.23865167176446803 },
+    { 0.782867431640625, 0.24479190557511465 },
+    { 0.7781219482421875, 0.2508720212745064 },
+    { 0.773406982421875, 0.256949871634185 },
+    { 0.768768310546875, 0.26296564154750673 },
+    { 0.7641754150390625, 0.2689579153333855 },
+    { 0.7596435546875, 0.2749059627100711 },
+    { 0.755157470703125, 0.2808289810131932 },
+    { 0.750732421875, 0.28670598647872547 },
+    { 0.7463531494140625, 0.29255640015690104 },
+    { 0.742034912109375, 0.2983589855612935 },
+    { 0.7377471923828125, 0.30415407081483875 },
+    { 0.7335205078125, 0.30989972294536106 },
+    { 0.729339599609375, 0.31561581235912095 }
+};
@@ -0,0 +1,96 @@
+/*
+ * Check the accuracy bounds of the fast math functions in
+ * ngspice/fastmath.h against libm.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "ngspice/fastmath.h"
+
+
+/* distance of a and b in units in the last place */
+static double
+ulps(double a, double b)
+{
+    int64_t ia, ib;
+
+    if (a == b)
+        return 0.0;
+    if ((a < 0) != (b < 0) || isnan(a) || isnan(b) || isinf(a) || isinf(b))
+        return HUGE_VAL;
+    memcpy(&ia, &a, sizeof ia);
+    memcpy(&ib, &b, sizeof ib);
+    return (double) llabs(ia - ib);
+}
+
+
+/* uniform in [lo, hi] */
+static double
+uniform(double lo, double hi)
+{
+    return lo + (hi - lo) * ((double) rand() / RAND_MAX);
+}
+
+
+static int
+check(const char *what, double x, double y, double got, double want, double bound)
+{
+    double d = ulps(got, want);
+
+    if (d <= bound || (isnan(got) && isnan(want)))
+        return 0;
+    fprintf(stderr, "%s(%.17g, %.17g) = %.17g, libm %.17g, %g ULP\n",
+            what, x, y, got, want, d);
+    return 1;
+}
+
+
+int
+main(void)
+{
+    static const double special[] = {
+        0.0, -0.0, 1.0, -1.0, 0.5, 2.0, 700.0, 709.0, 709.78, 710.0,
+        -707.0, -708.0, -745.0, -746.0, 1e-300, 4.9e-324, DBL_MIN, DBL_MAX,
+        HUGE_VAL, -HUGE_VAL, NAN
+    };
+    int i, errors = 0;
+
+    srand(1);
+
+    for (i = 0; i < 1000000; i++) {
+        double x = uniform(-745.0, 709.7);
+        errors += check("exp", x, 0, ng_fast_exp(x), exp(x), 1.0);
+        x = uniform(-40.0, 40.0);
+        errors += check("exp", x, 0, ng_fast_exp(x), exp(x), 1.0);
+    }
+
+    for (i = 0; i < 1000000; i++) {
+        double x = pow(10.0, uniform(-320.0, 308.0));
+        errors += check("log", x, 0, ng_fast_log(x), log(x), 2.0);
+        x = uniform(0.5, 2.0);
+        errors += check("log", x, 0, ng_fast_log(x), log(x), 2.0);
+        x = uniform(0.97, 1.03);
+        errors += check("log", x, 0, ng_fast_log(x), log(x), 2.0);
+    }
+
+    for (i = 0; i < 1000000; i++) {
+        double x = pow(10.0, uniform(-20.0, 20.0));
+        double y = uniform(-5.0, 5.0);
+        errors += check("pow", x, y, ng_fast_pow(x, y), pow(x, y),
+                        4.0 * (1.0 + fabs(y * log(x))));
+    }
+
+    for (i = 0; i < (int) (sizeof special / sizeof special[0]); i++) {
+        double x = special[i];
+        errors += check("exp", x, 0, ng_fast_exp(x), exp(x), 1.0);
+        errors += check("log", x, 0, ng_fast_log(x), log(x), 2.0);
+    }
+
+    if (ng_fast_pow(-2.0, 3.0) != -8.0 || ng_fast_pow(0.0, 2.0) != 0.0)
+        errors++;
+
+    if (errors)
+        fprintf(stderr, "%d errors\n", errors);
+    return errors ? 1 : 0;
+}
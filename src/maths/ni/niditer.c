@@ -65,6 +65,21 @@ skip:
             return(error); /* can't handle E_BADMATRIX, so let caller */
         }
     } 
+    return NIdSolve(ckt);
+}
+
+
+    /*
+     * NIdSolve(ckt)
+     *
+     * Solve for the RHS vector with the LU factorization left in the
+     * matrix by the last NIdIter at the same frequency.
+     *
+     */
+
+int
+NIdSolve(CKTcircuit *ckt)
+{
     SMPcSolve(ckt->CKTmatrix,ckt->CKTrhs, 
             ckt->CKTirhs, ckt->CKTrhsSpare,
             ckt->CKTirhsSpare);
@@ -119,10 +119,36 @@ NIiter(CKTcircuit *ckt, int maxIter)
                 }
 #endif
 
-                error = SMPreorder(ckt->CKTmatrix, ckt->CKTpivotAbsTol,
-                                   ckt->CKTpivotRelTol, ckt->CKTdiagGmin);
-                ckt->CKTstat->STATreorderTime +=
-                    SPfrontEnd->IFseconds() - startTime;
+                /* With .option reuseorder, try the pivot order of the last
+                 * factorization first and reorder only if it is no longer
+                 * numerically acceptable.  E_SINGULAR means the rejected
+                 * factorization has overwritten the matrix, so it is
+                 * loaded again before the reordering.
+                 */
+                error = E_BADMATRIX;
+                if (ckt->CKTreuseOrder && !(ckt->CKTniState & NIMUSTREORDER)) {
+                    error = SMPreuseOrder(ckt->CKTmatrix, ckt->CKTpivotAbsTol,
+                                          ckt->CKTpivotRelTol, ckt->CKTdiagGmin);
+                    if (error == E_SINGULAR) {
+                        ckt->CKTstat->STATreorderTime +=
+                            SPfrontEnd->IFseconds() - startTime;
+                        ckt->CKTniState |= NISHOULDREORDER | NIMUSTREORDER;
+                        continue;
+                    }
+                    if (error != E_BADMATRIX) {
+                        ckt->CKTstat->STATdecompTime +=
+                            SPfrontEnd->IFseconds() - startTime;
+                        ckt->CKTstat->STATreusedOrders++;
+                    }
+                }
+                if (error == E_BADMATRIX) {
+                    error = SMPreorder(ckt->CKTmatrix, ckt->CKTpivotAbsTol,
+                                       ckt->CKTpivotRelTol, ckt->CKTdiagGmin);
+                    ckt->CKTstat->STATreorderTime +=
+                        SPfrontEnd->IFseconds() - startTime;
+                    ckt->CKTstat->STATreorders++;
+                    ckt->CKTniState &= ~NIMUSTREORDER;
+                }
                 if (error) {
                     /* new feature - we can now find out something about what is
                      * wrong - so we ask for the troublesome entry
@@ -172,6 +198,7 @@ NIiter(CKTcircuit *ckt, int maxIter)
                     ckt->CKTmatrix->SMPkluMatrix->KLUloadDiagGmin = 0 ;
                     error = SMPreorder(ckt->CKTmatrix, ckt->CKTpivotAbsTol, ckt->CKTpivotRelTol, ckt->CKTdiagGmin);
                     ckt->CKTstat->STATreorderTime += SPfrontEnd->IFseconds() - startTime;
+                    ckt->CKTstat->STATreorders++;
                     if (error) {
                         SMPgetError(ckt->CKTmatrix, &i, &j);
                         if (ft_ngdebug || msgcount < 6) {
@@ -201,7 +228,7 @@ NIiter(CKTcircuit *ckt, int maxIter)
                          * This is the original SPICE3F5 code and uses SPARSE.
                          */
 
-                        ckt->CKTniState |= NISHOULDREORDER;
+                        ckt->CKTniState |= NISHOULDREORDER | NIMUSTREORDER;
                         DEBUGMSG(" forced reordering....\n");
                         continue;
                     }
@@ -224,7 +251,7 @@ NIiter(CKTcircuit *ckt, int maxIter)
                          * This is the original SPICE3F5 code and uses SPARSE.
                          */
 
-                        ckt->CKTniState |= NISHOULDREORDER;
+                        ckt->CKTniState |= NISHOULDREORDER | NIMUSTREORDER;
                         DEBUGMSG(" forced reordering....\n");
                         continue;
                     }
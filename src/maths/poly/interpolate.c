@@ -27,6 +27,40 @@ putinterval(double *poly, int degree, double *nvec,
 }
 
 
+/* Linear interpolation from oscale to nscale.  Both scales are monotonic
+ * in the same direction, so a cursor into the old scale only moves
+ * forward.  Output points before the first old point are extrapolated
+ * from the first interval, output points past the last one take the last
+ * value.  At a vertical edge (two equal old scale values) the output
+ * takes the value after the edge.
+ */
+static void
+lin_interpolate(double *data, double *ndata, double *oscale, int olen,
+                double *nscale, int nlen, int sign)
+{
+    int i, k = 0;
+
+    for (i = 0; i < nlen; i++) {
+        double x = nscale[i];
+        double dx;
+
+        while (k < olen - 2 && oscale[k + 1] * sign <= x * sign)
+            k++;
+
+        if (oscale[k + 1] * sign < x * sign) {
+            ndata[i] = data[olen - 1];
+            continue;
+        }
+
+        dx = oscale[k + 1] - oscale[k];
+        if (dx == 0.0)
+            ndata[i] = data[k + 1];
+        else
+            ndata[i] = data[k] + (x - oscale[k]) * (data[k + 1] - data[k]) / dx;
+    }
+}
+
+
 /* Interpolate data from oscale to nscale. data is assumed to be olen long,
  * ndata will be nlen long. Returns FALSE if the scales are too strange
  * to deal with.  Note that we are guaranteed that either both scales are
@@ -66,6 +100,11 @@ ft_interpolate(double *data, double *ndata, double *oscale, int olen,
         return FALSE;
     }
 
+    if (degree == 1) {
+        lin_interpolate(data, ndata, oscale, olen, nscale, nlen, sign);
+        return (TRUE);
+    }
+
     scratch = TMALLOC(double, (degree + 1) * (degree + 2));
     result = TMALLOC(double, degree + 1);
     xdata = TMALLOC(double, degree + 1);
@@ -160,6 +160,10 @@ spCreate(int Size, int Complex, int *pError)
     /* Initialize matrix */
     Matrix->ID = SPARSE_ID;
     Matrix->Complex = Complex;
+    Matrix->ColumnsUnsorted = NO;
+    Matrix->ElementTable = NULL;
+    Matrix->ElementTableCount = 0;
+    Matrix->ElementTableSize = 0;
     Matrix->PreviousMatrixWasComplex = Complex;
     Matrix->Factored = NO;
     Matrix->Elements = 0;
@@ -170,6 +174,7 @@ spCreate(int Size, int Complex, int *pError)
     Matrix->NeedsOrdering = YES;
     Matrix->NumberOfInterchangesIsOdd = NO;
     Matrix->Partitioned = NO;
+    Matrix->SupernodesFound = NO;
     Matrix->RowsLinked = NO;
     Matrix->InternalVectorsAllocated = NO;
     Matrix->SingularCol = 0;
@@ -189,6 +194,13 @@ spCreate(int Size, int Complex, int *pError)
     Matrix->DoCmplxDirect = NULL;
     Matrix->DoRealDirect = NULL;
     Matrix->Intermediate = NULL;
+    Matrix->SupernodeStart = NULL;
+    Matrix->SupernodeEnd = NULL;
+    Matrix->SupernodeMults = NULL;
+    Matrix->SupernodeRowStart = NULL;
+    Matrix->SupernodeRows = NULL;
+    Matrix->SupernodeValueStart = NULL;
+    Matrix->SupernodeValues = NULL;
     Matrix->RelThreshold = DEFAULT_THRESHOLD;
     Matrix->AbsThreshold = 0.0;
 
@@ -669,12 +681,20 @@ spDestroy(MatrixPtr Matrix)
     SP_FREE( Matrix->Diag );
     SP_FREE( Matrix->FirstInRow );
     SP_FREE( Matrix->FirstInCol );
+    SP_FREE( Matrix->ElementTable );
     SP_FREE( Matrix->MarkowitzRow );
     SP_FREE( Matrix->MarkowitzCol );
     SP_FREE( Matrix->MarkowitzProd );
     SP_FREE( Matrix->DoCmplxDirect );
     SP_FREE( Matrix->DoRealDirect );
     SP_FREE( Matrix->Intermediate );
+    SP_FREE( Matrix->SupernodeStart );
+    SP_FREE( Matrix->SupernodeEnd );
+    SP_FREE( Matrix->SupernodeMults );
+    SP_FREE( Matrix->SupernodeRowStart );
+    SP_FREE( Matrix->SupernodeRows );
+    SP_FREE( Matrix->SupernodeValueStart );
+    SP_FREE( Matrix->SupernodeValues );
 
     /* Sequentially step through the list of allocated pointers
      * freeing pointers along the way. */
@@ -23,6 +23,8 @@
  *  spcFindElementInCol
  *  Translate
  *  spcCreateElement
+ *  spcSortColumns
+ *  spcFreeElementTable
  *  spcLinkRows
  *  EnlargeMatrix
  *  ExpandTranslationArrays
@@ -58,6 +60,7 @@
  *     Matrix type and macro definitions for the sparse matrix routines.
  */
 #include <assert.h>
+#include <stdlib.h>
 
 #define spINSIDE_SPARSE
 #include "spconfig.h"
@@ -74,6 +77,9 @@
 static void Translate( MatrixPtr, int*, int* );
 static void EnlargeMatrix( MatrixPtr, int );
 static void ExpandTranslationArrays( MatrixPtr, int );
+static ElementPtr *ElementTableSlot( MatrixPtr, int, int );
+static int ResizeElementTable( MatrixPtr, int );
+static ElementPtr GetElementByTable( MatrixPtr, int, int );
 
 
 
@@ -306,11 +312,15 @@ spGetElement(MatrixPtr Matrix, int Row, int Col)
     if ((Row != Col) || ((pElement = Matrix->Diag[Row]) == NULL))
     {
 	/* Element does not exist or does not reside along diagonal.
-	 * Search column for element.  As in the if statement above,
-	 * the pointer to the element which is returned by
-	 * spcFindElementInCol is cast into a pointer to Real, a
-	 * RealNumber.  */
-	pElement = spcFindElementInCol( Matrix,
+	 * While the matrix is built, look it up in the element table,
+	 * else search column for element.  As in the if statement
+	 * above, the pointer to the element which is returned is cast
+	 * into a pointer to Real, a RealNumber.  */
+	pElement = NULL;
+	if (!Matrix->RowsLinked)
+	    pElement = GetElementByTable( Matrix, Row, Col );
+	if (pElement == NULL)
+	    pElement = spcFindElementInCol( Matrix,
 						     &(Matrix->FirstInCol[Col]),
 						     Row, Col, YES );
     }
@@ -319,6 +329,120 @@ spGetElement(MatrixPtr Matrix, int Row, int Col)
 
 
 
+/*
+ *  ELEMENT TABLE
+ *
+ *  While the matrix is built and the rows are not yet linked,
+ *  spGetElement() finds elements through a hash table keyed by row and
+ *  column, and prepends new elements to their column.  Adding an
+ *  element then costs O(1) instead of a search through its column,
+ *  which keeps the setup near linear for the very long columns of
+ *  supply and ground like nodes.  The columns are put back into row
+ *  order by spcSortColumns() before any other routine uses them.
+ *
+ *  ElementTableSlot() returns the slot of element [Row,Col], or the
+ *  empty slot where it would be stored.  ResizeElementTable() builds a
+ *  table of NewSize slots from the current table, or from the columns
+ *  if there is none yet.  It returns NO if memory is exhausted, the
+ *  table is freed then and spGetElement() falls back to column search.
+ */
+
+static ElementPtr *
+ElementTableSlot(MatrixPtr Matrix, int Row, int Col)
+{
+    unsigned int Mask = (unsigned int) Matrix->ElementTableSize - 1;
+    unsigned int I;
+    ElementPtr  *pSlot;
+
+    /* Begin `ElementTableSlot'. */
+    I = (unsigned int) Row * 2654435761U + (unsigned int) Col * 40503U;
+    I = (I ^ (I >> 15)) & Mask;
+    while ((pSlot = &Matrix->ElementTable[I], *pSlot != NULL) &&
+	   ((*pSlot)->Row != Row || (*pSlot)->Col != Col))
+	I = (I + 1) & Mask;
+    return pSlot;
+}
+
+
+static int
+ResizeElementTable(MatrixPtr Matrix, int NewSize)
+{
+    ElementPtr  *OldTable = Matrix->ElementTable;
+    ElementPtr  pElement;
+    int  I, OldSize = Matrix->ElementTableSize;
+
+    /* Begin `ResizeElementTable'. */
+    SP_CALLOC( Matrix->ElementTable, ElementPtr, NewSize );
+    if (Matrix->ElementTable == NULL)
+    {
+	Matrix->ElementTable = OldTable;
+	spcFreeElementTable( Matrix );
+	return NO;
+    }
+    Matrix->ElementTableSize = NewSize;
+    Matrix->ElementTableCount = 0;
+
+    if (OldTable == NULL)
+    {
+	/* Enter the elements present, Col is set only by spcLinkRows(). */
+	for (I = 1; I <= Matrix->Size; I++)
+	    for (pElement = Matrix->FirstInCol[I]; pElement != NULL;
+		 pElement = pElement->NextInCol)
+	    {
+		pElement->Col = I;
+		*ElementTableSlot( Matrix, pElement->Row, I ) = pElement;
+		Matrix->ElementTableCount++;
+	    }
+    }
+    else
+    {
+	for (I = 0; I < OldSize; I++)
+	    if ((pElement = OldTable[I]) != NULL)
+	    {
+		*ElementTableSlot( Matrix, pElement->Row, pElement->Col ) =
+		    pElement;
+		Matrix->ElementTableCount++;
+	    }
+	SP_FREE( OldTable );
+    }
+    return YES;
+}
+
+
+/*
+ *  Finds or creates element [Row,Col] through the element table.
+ *  Returns NULL if the table cannot be used.
+ */
+
+static ElementPtr
+GetElementByTable(MatrixPtr Matrix, int Row, int Col)
+{
+    ElementPtr  *pSlot, pElement;
+    int  Size;
+
+    /* Begin `GetElementByTable'. */
+    if (2 * (Matrix->Elements + 1) > Matrix->ElementTableSize)
+    {
+	for (Size = 1024; Size < 4 * (Matrix->Elements + 1); Size *= 2)
+	    ;
+	if (!ResizeElementTable( Matrix, Size ))
+	    return NULL;
+    }
+
+    pSlot = ElementTableSlot( Matrix, Row, Col );
+    if (*pSlot != NULL)
+	return *pSlot;
+
+    pElement = spcCreateElement( Matrix, Row, Col,
+				 &(Matrix->FirstInCol[Col]), NO );
+    if (pElement != NULL && pElement->NextInCol != NULL &&
+	pElement->NextInCol->Row < Row)
+	Matrix->ColumnsUnsorted = YES;
+    return pElement;
+}
+
+
+
 
 
 
@@ -366,6 +490,14 @@ spcFindElementInCol(MatrixPtr Matrix, ElementPtr *LastAddr,
     ElementPtr  pElement;
 
     /* Begin `spcFindElementInCol'. */
+    if (Matrix->ColumnsUnsorted)
+    {
+	/* LastAddr may point into a column which is about to be reordered. */
+	int FromTop = (LastAddr == &Matrix->FirstInCol[Col]);
+	spcSortColumns( Matrix );
+	if (FromTop)
+	    LastAddr = &Matrix->FirstInCol[Col];
+    }
     pElement = *LastAddr;
 
     /* Search for element. */
@@ -853,9 +985,7 @@ spcCreateElement(MatrixPtr Matrix, int  Row, int  Col,
 	/* Initialize Element. */
         pCreatedElement = pElement;
         pElement->Row = Row;
-#if DEBUG
         pElement->Col = Col;
-#endif
         pElement->Real = 0.0;
         pElement->Imag = 0.0;
 #if INITIALIZE
@@ -865,6 +995,13 @@ spcCreateElement(MatrixPtr Matrix, int  Row, int  Col,
 	/* Splice element into column. */
         pElement->NextInCol = *LastAddr;
         *LastAddr = pElement;
+
+	/* Enter element into the table used by spGetElement(). */
+	if (Matrix->ElementTable != NULL)
+	{
+	    *ElementTableSlot( Matrix, Row, Col ) = pElement;
+	    Matrix->ElementTableCount++;
+	}
     }
 
     Matrix->Elements++;
@@ -878,6 +1015,116 @@ spcCreateElement(MatrixPtr Matrix, int  Row, int  Col,
 
 
 
+/*
+ *
+ *  SORT COLUMNS
+ *
+ *  Puts the elements of every column back into row order after
+ *  spGetElement() has prepended elements to the columns.  Columns are
+ *  sorted by a bottom up merge sort of their linked lists.
+ *
+ *  >>> Arguments:
+ *  Matrix  <input>  (MatrixPtr)
+ *      Pointer to the matrix.
+ *
+ *  >>> Local variables:
+ *  pList  (ElementPtr)
+ *      The column being sorted.
+ *  pTail  (ElementPtr)
+ *      Last element of the column merged so far.
+ *  pA, pB  (ElementPtr)
+ *      The heads of the two runs being merged.
+ *  Width  (int)
+ *      Length of the runs, which are in row order already.
+ */
+
+void
+spcSortColumns(MatrixPtr Matrix)
+{
+    ElementPtr  pList, pTail, pA, pB, pNext;
+    int  Col, Width, LenA, LenB, Merges;
+
+    /* Begin `spcSortColumns'. */
+    if (!Matrix->ColumnsUnsorted)
+	return;
+
+    for (Col = 1; Col <= Matrix->Size; Col++)
+    {
+	/* Skip columns which are in order. */
+	for (pA = Matrix->FirstInCol[Col];
+	     pA != NULL && pA->NextInCol != NULL; pA = pA->NextInCol)
+	    if (pA->NextInCol->Row < pA->Row)
+		break;
+	if (pA == NULL || pA->NextInCol == NULL)
+	    continue;
+
+	pList = Matrix->FirstInCol[Col];
+	Width = 1;
+	do
+	{
+	    /* Merge pairs of adjacent runs of Width elements. */
+	    pA = pList;
+	    pList = pTail = NULL;
+	    Merges = 0;
+	    while (pA != NULL)
+	    {
+		Merges++;
+		for (pB = pA, LenA = 0; pB != NULL && LenA < Width; LenA++)
+		    pB = pB->NextInCol;
+		LenB = Width;
+		while (LenA > 0 || (LenB > 0 && pB != NULL))
+		{
+		    if (LenA > 0 &&
+			(LenB == 0 || pB == NULL || pA->Row < pB->Row))
+		    {
+			pNext = pA;
+			pA = pA->NextInCol;
+			LenA--;
+		    }
+		    else
+		    {
+			pNext = pB;
+			pB = pB->NextInCol;
+			LenB--;
+		    }
+		    if (pTail != NULL)
+			pTail->NextInCol = pNext;
+		    else
+			pList = pNext;
+		    pTail = pNext;
+		}
+		pA = pB;
+	    }
+	    pTail->NextInCol = NULL;
+	    Width *= 2;
+	}
+	while (Merges > 1);
+
+	Matrix->FirstInCol[Col] = pList;
+    }
+
+    Matrix->ColumnsUnsorted = NO;
+}
+
+
+
+/*
+ *  Frees the element table of spGetElement().  Needed when the rows are
+ *  linked, or columns are exchanged, since the table is keyed by the
+ *  column numbers at the time the elements were entered.
+ */
+
+void
+spcFreeElementTable(MatrixPtr Matrix)
+{
+    /* Begin `spcFreeElementTable'. */
+    SP_FREE( Matrix->ElementTable );
+    Matrix->ElementTableSize = 0;
+    Matrix->ElementTableCount = 0;
+}
+
+
+
 /*
  *
  *  LINK ROWS
@@ -912,6 +1159,9 @@ spcLinkRows(MatrixPtr Matrix)
      int  Col;
 
     /* Begin `spcLinkRows'. */
+    spcSortColumns( Matrix );
+    spcFreeElementTable( Matrix );
+
     FirstInRowArray = Matrix->FirstInRow;
     for (Col = Matrix->Size; Col >= 1; Col--)
     {
@@ -325,6 +325,11 @@
  *              a row-by-row basis, carries a large overhead, but speeds up
  *              both dense and sparse matrices, best if there is a large
  *              number of matrices that can use the same ordering.
+ *  SUPERNODE_MIN_SIZE
+ *      The smallest number of consecutive columns of L with the same
+ *      structure that spFactor() handles as a dense block.  Narrower runs
+ *      are eliminated element by element.  Set to a value larger than
+ *      any matrix size to disable the dense blocks. [2]
  */
 
 /* Begin constants. */
@@ -338,6 +343,7 @@
 #define  MAX_MARKOWITZ_TIES             100
 #define  TIES_MULTIPLIER                5
 #define  DEFAULT_PARTITION              spAUTO_PARTITION
+#define  SUPERNODE_MIN_SIZE             2
 
 
 
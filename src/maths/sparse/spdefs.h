@@ -585,8 +585,20 @@ struct ElementListNodeStruct
  *      then corresponding column in a real matrix should be eliminated
  *      in spFactor() using direct addressing (rather than indirect
  *      addressing).
+ *  ColumnsUnsorted  (int)
+ *      Flag that indicates that elements have been prepended to their
+ *      columns by spGetElement() and the columns are not yet ordered by
+ *      row.  They are sorted in spcSortColumns().
  *  Elements  (int)
  *	The total number of elements present in matrix.
+ *  ElementTable  (ElementPtr *)
+ *      Hash table of the elements keyed by row and column.  It is used by
+ *      spGetElement() while the matrix is built and the rows are not yet
+ *      linked, and freed when the rows are linked or columns exchanged.
+ *  ElementTableCount  (int)
+ *      Number of elements in ElementTable.
+ *  ElementTableSize  (int)
+ *      Number of slots in ElementTable, a power of two.
  *  Error  (int)
  *      The error status of the sparse matrix package.
  *  ExtSize  (int)
@@ -694,6 +706,32 @@ struct ElementListNodeStruct
  *  Size  (int)
  *      Number of rows and columns in the matrix.  Does not change as matrix
  *      is factored.
+ *  SupernodeEnd  (int [])
+ *      The last step of the supernode each step belongs to.  A supernode is
+ *      a run of consecutive steps whose columns of L have the same
+ *      structure below the run, so together they form a dense block.
+ *      Steps that are not part of a supernode of at least
+ *      SUPERNODE_MIN_SIZE columns are their own supernode.
+ *  SupernodeMults  (RealVector)
+ *      Scratch vector, as long as the widest supernode, that holds the
+ *      multipliers of a column while it is updated from a supernode.
+ *  SupernodeRows  (int [])
+ *      The rows below each supernode, indexed through SupernodeRowStart.
+ *  SupernodeRowStart  (int [])
+ *      Index into SupernodeRows of the rows below the supernode of each
+ *      step.  The rows of the supernode starting at First and ending at
+ *      Last run up to SupernodeRowStart[Last+1].
+ *  SupernodesFound  (int)
+ *      Flag that indicates that the supernodes of the current ordering have
+ *      been found.  It is cleared when the matrix is reordered.
+ *  SupernodeStart  (int [])
+ *      The first step of the supernode each step belongs to.
+ *  SupernodeValues  (RealVector)
+ *      Dense copies of the columns of L of each supernode, filled in by
+ *      spFactor() and indexed through SupernodeValueStart.
+ *  SupernodeValueStart  (long [])
+ *      Index into SupernodeValues of the block of each supernode, indexed
+ *      by the first step of the supernode.
  *  TrashCan  (MatrixElement)
  *      This is a dummy MatrixElement that is used to by the user to stuff
  *      data related to the zero row or column.  In other words, when the user
@@ -738,12 +776,16 @@ struct  MatrixFrame
     RealNumber                   AbsThreshold;
     int                          AllocatedSize;
     int                          AllocatedExtSize;
+    int                      ColumnsUnsorted;
     int                      Complex;
     int                          CurrentSize;
     ArrayOfElementPtrs           Diag;
     int                     *DoCmplxDirect;
     int                     *DoRealDirect;
     int                          Elements;
+    ElementPtr                  *ElementTable;
+    int                          ElementTableCount;
+    int                          ElementTableSize;
     int                          Error;
     int                          ExtSize;
     int                         *ExtToIntColMap;
@@ -776,6 +818,14 @@ struct  MatrixFrame
     int                          SingularRow;
     int                          Singletons;
     int                          Size;
+    int                         *SupernodeEnd;
+    RealVector                   SupernodeMults;
+    int                         *SupernodeRows;
+    int                         *SupernodeRowStart;
+    int                      SupernodesFound;
+    int                         *SupernodeStart;
+    RealVector                   SupernodeValues;
+    long                        *SupernodeValueStart;
     struct MatrixElement         TrashCan;
 
     AllocationListPtr            TopOfAllocationList;
@@ -791,6 +841,40 @@ struct  MatrixFrame
 };
 
 
+
+
+/*
+ *  SYMBOLIC FACTORIZATION STRUCTURE
+ *
+ *  The pivot order and the structure, including fill-ins, of an ordered
+ *  matrix.  It is filled in by spGetSymbolic() and imposed on another
+ *  matrix of the same structure by spOrderAndFactorGiven().
+ *
+ *  >>> Structure fields:
+ *  Size  (int)
+ *      Number of rows and columns of the matrix.
+ *  RowOrder  (int [])
+ *      External row of the pivot of each step, indexed from 1 to Size.
+ *  ColOrder  (int [])
+ *      External column of the pivot of each step, indexed from 1 to Size.
+ *  ColStart  (int [])
+ *      Index into Rows of the first element of each internal column,
+ *      indexed from 1 to Size+1.
+ *  Rows  (int [])
+ *      Internal rows of the elements of each column, in ascending order.
+ */
+
+/* Begin `SymbolicFrame'. */
+struct  SymbolicFrame
+{
+    int                          Size;
+    int                         *RowOrder;
+    int                         *ColOrder;
+    int                         *ColStart;
+    int                         *Rows;
+};
+
+
 /*
  *  Function declarations
  */
@@ -799,6 +883,8 @@ extern ElementPtr spcGetElement( MatrixPtr );
 extern ElementPtr spcGetFillin( MatrixPtr );
 extern ElementPtr spcFindElementInCol( MatrixPtr, ElementPtr*, int, int, int );
 extern ElementPtr spcCreateElement( MatrixPtr, int, int, ElementPtr*, int );
+extern void spcSortColumns( MatrixPtr );
+extern void spcFreeElementTable( MatrixPtr );
 extern void spcCreateInternalVectors( MatrixPtr );
 extern void spcLinkRows( MatrixPtr );
 extern void spcColExchange( MatrixPtr, int, int );
@@ -9,7 +9,12 @@
  *
  *  >>> User accessible functions contained in this file:
  *  spOrderAndFactor
+ *  spOrderAndFactorGiven
+ *  spGetSymbolic
+ *  spFreeSymbolic
+ *  spFactorSharedOrder
  *  spFactor
+ *  spFactorKeepOrder
  *  spPartition
  *
  *  >>> Other functions contained in this file:
@@ -56,6 +61,8 @@
  *    Matrix type and macro definitions for the sparse matrix routines.
  */
 #include <assert.h>
+#include <stdlib.h>
+#include <string.h>
 #define spINSIDE_SPARSE
 #include "spconfig.h"
 #include "ngspice/spmatrix.h"
@@ -80,6 +87,9 @@ do { \
  */
 
 static int  FactorComplexMatrix( MatrixPtr );
+static void FindSupernodes( MatrixPtr );
+static void GatherSupernode( MatrixPtr, int );
+static ElementPtr UpdateFromSupernode( MatrixPtr, ElementPtr, RealVector );
 static void CountMarkowitz( MatrixPtr, RealVector, int );
 static void MarkowitzProducts( MatrixPtr, int );
 static ElementPtr SearchForPivot( MatrixPtr, int, int );
@@ -269,6 +279,9 @@ spOrderAndFactor(MatrixPtr Matrix, RealNumber RHS[], RealNumber RelThreshold,
             return Matrix->Error;
     }
 
+    /* The fill-ins created below change the supernodes. */
+    Matrix->SupernodesFound = NO;
+
     /* Form initial Markowitz products. */
     CountMarkowitz( Matrix, RHS, Step );
     MarkowitzProducts( Matrix, Step );
@@ -310,6 +323,443 @@ Done:
 
 
 
+
+/*
+ *  ORDER AND FACTOR MATRIX WITH A GIVEN SYMBOLIC FACTORIZATION
+ *
+ *  This routine performs the initial factorization of a matrix like
+ *  spOrderAndFactor(), except that the pivot order and the fill-ins are
+ *  taken from a symbolic factorization obtained with spGetSymbolic() from
+ *  a matrix with the same structure.  The matrix is permuted and its
+ *  fill-ins are created in one pass, which avoids the pivot search and
+ *  the element by element creation of fill-ins that dominate the first
+ *  factorization of large matrices.  The factorization itself is then
+ *  done by spOrderAndFactor(), so a pivot that fails the threshold test
+ *  still causes a partial reordering.  If the structure of the matrix
+ *  does not match the symbolic factorization, the matrix is ordered and
+ *  factored as usual.  If it has been ordered before, spFactor() is
+ *  called instead.
+ *
+ *  >>> Returned:
+ *  The error code is returned.  Possible errors are listed below.
+ *
+ *  >>> Arguments:
+ *  Matrix  <input>  (char *)
+ *      Pointer to matrix.
+ *  Symbolic  <input>  (SymbolicPtr)
+ *      Symbolic factorization to impose on the matrix.
+ *
+ *  >>> Local variables:
+ *  NewRow, NewCol  (int [])
+ *      Step at which each current internal row and column is pivoted.
+ *  OldFirstInCol  (ArrayOfElementPtrs)
+ *      The columns of the matrix before it is permuted.
+ *  Slot  (ArrayOfElementPtrs)
+ *      The elements of the current column, indexed by their new row.
+ *
+ *  >>> Possible errors:
+ *  spNO_MEMORY
+ *  spSINGULAR
+ *  spSMALL_PIVOT
+ *  Error is cleared in this function.
+ */
+
+int
+spOrderAndFactorGiven(MatrixPtr Matrix, SymbolicPtr Symbolic)
+{
+    ElementPtr  pElement, pNext, *ppLast;
+    ArrayOfElementPtrs OldFirstInCol = NULL, Slot = NULL;
+    int  *NewRow = NULL, *NewCol = NULL, *OldCol = NULL, *Mark = NULL;
+    int  Step, Size, I, J, Row, Col, Odd;
+
+    /* Begin `spOrderAndFactorGiven'. */
+    assert( IS_VALID(Matrix) && !Matrix->Factored);
+
+    if (!Matrix->NeedsOrdering)
+        return spFactor( Matrix );
+
+    Size = Matrix->Size;
+    if (Symbolic == NULL || Symbolic->Size != Size)
+        goto Factor;
+
+    NewRow = SP_MALLOC(int, Size + 1);
+    NewCol = SP_MALLOC(int, Size + 1);
+    OldCol = SP_MALLOC(int, Size + 1);
+    Mark = SP_MALLOC(int, Size + 1);
+    OldFirstInCol = SP_MALLOC(ElementPtr, Size + 1);
+    Slot = SP_MALLOC(ElementPtr, Size + 1);
+    if (!NewRow || !NewCol || !OldCol || !Mark || !OldFirstInCol || !Slot)
+        goto Factor;
+    for (I = 1; I <= Size; I++) {
+        NewRow[I] = NewCol[I] = Mark[I] = 0;
+        Slot[I] = NULL;
+    }
+
+    /* Locate the given pivots among the current rows and columns. */
+    for (Step = 1; Step <= Size; Step++) {
+#if TRANSLATE
+        Row = Symbolic->RowOrder[Step];
+        Row = (Row >= 1 && Row <= Matrix->ExtSize) ?
+              Matrix->ExtToIntRowMap[Row] : -1;
+        Col = Symbolic->ColOrder[Step];
+        Col = (Col >= 1 && Col <= Matrix->ExtSize) ?
+              Matrix->ExtToIntColMap[Col] : -1;
+#else
+        Row = Symbolic->RowOrder[Step];
+        Col = Symbolic->ColOrder[Step];
+#endif
+        if (Row < 1 || Row > Size || Col < 1 || Col > Size ||
+            NewRow[Row] || NewCol[Col])
+            goto Factor;
+        NewRow[Row] = Step;
+        NewCol[Col] = Step;
+        OldCol[Step] = Col;
+    }
+
+    /* Check that every element has a place in the symbolic structure. */
+    for (Step = 1; Step <= Size; Step++) {
+        for (I = Symbolic->ColStart[Step]; I < Symbolic->ColStart[Step+1]; I++)
+            Mark[Symbolic->Rows[I]] = Step;
+        if (Mark[Step] != Step)
+            goto Factor;
+        pElement = Matrix->FirstInCol[OldCol[Step]];
+        for (; pElement != NULL; pElement = pElement->NextInCol)
+            if (Mark[NewRow[pElement->Row]] != Step)
+                goto Factor;
+    }
+
+    /* Parity of the row and column permutations, for spDeterminant(). */
+    Odd = NO;
+    for (I = 1; I <= Size; I++)
+        Mark[I] = 0;
+    for (I = 1; I <= Size; I++) {
+        if (Mark[I]) continue;
+        for (J = NewRow[I]; J != I; J = NewRow[J]) {
+            Mark[J] = 1;
+            Odd = !Odd;
+        }
+        Mark[I] = 1;
+    }
+    for (I = 1; I <= Size; I++)
+        Mark[I] = 0;
+    for (I = 1; I <= Size; I++) {
+        if (Mark[I]) continue;
+        for (J = NewCol[I]; J != I; J = NewCol[J]) {
+            Mark[J] = 1;
+            Odd = !Odd;
+        }
+        Mark[I] = 1;
+    }
+
+    /* Rebuild the columns in pivot order, creating the fill-ins. */
+    spcFreeElementTable( Matrix );
+    for (I = 1; I <= Size; I++) {
+        OldFirstInCol[I] = Matrix->FirstInCol[I];
+        Matrix->Diag[I] = NULL;
+    }
+    for (Step = 1; Step <= Size; Step++) {
+        for (pElement = OldFirstInCol[OldCol[Step]]; pElement; pElement = pNext) {
+            pNext = pElement->NextInCol;
+            Slot[NewRow[pElement->Row]] = pElement;
+        }
+        ppLast = &Matrix->FirstInCol[Step];
+        for (I = Symbolic->ColStart[Step]; I < Symbolic->ColStart[Step+1]; I++) {
+            Row = Symbolic->Rows[I];
+            if ((pElement = Slot[Row]) == NULL) {
+                pElement = spcGetFillin( Matrix );
+                if (pElement == NULL) {
+                    *ppLast = NULL;
+                    Matrix->Error = spNO_MEMORY;
+                    goto Done;
+                }
+                pElement->Real = 0.0;
+                pElement->Imag = 0.0;
+#if INITIALIZE
+                pElement->pInitInfo = NULL;
+#endif
+                Matrix->Fillins++;
+                Matrix->Elements++;
+            }
+            Slot[Row] = NULL;
+            pElement->Row = Row;
+            pElement->Col = Step;
+            if (Row == Step) Matrix->Diag[Step] = pElement;
+            *ppLast = pElement;
+            ppLast = &pElement->NextInCol;
+        }
+        *ppLast = NULL;
+    }
+    Matrix->ColumnsUnsorted = NO;
+
+    /* Link the rows, each in ascending column order. */
+    for (I = 1; I <= Size; I++)
+        Matrix->FirstInRow[I] = NULL;
+    for (Step = Size; Step >= 1; Step--) {
+        for (pElement = Matrix->FirstInCol[Step]; pElement; pElement = pElement->NextInCol) {
+            pElement->NextInRow = Matrix->FirstInRow[pElement->Row];
+            Matrix->FirstInRow[pElement->Row] = pElement;
+        }
+    }
+    Matrix->RowsLinked = YES;
+
+    for (Step = 1; Step <= Size; Step++) {
+        Matrix->IntToExtRowMap[Step] = Symbolic->RowOrder[Step];
+        Matrix->IntToExtColMap[Step] = Symbolic->ColOrder[Step];
+#if TRANSLATE
+        Matrix->ExtToIntRowMap[Symbolic->RowOrder[Step]] = Step;
+        Matrix->ExtToIntColMap[Symbolic->ColOrder[Step]] = Step;
+#endif
+    }
+    Matrix->NumberOfInterchangesIsOdd = Odd;
+
+    if (!Matrix->InternalVectorsAllocated)
+        spcCreateInternalVectors( Matrix );
+    Matrix->NeedsOrdering = NO;
+    Matrix->Partitioned = NO;
+    Matrix->SupernodesFound = NO;
+
+Factor:
+    /* Orders the matrix as usual if the symbolic factorization did not fit. */
+    SP_FREE( NewRow );
+    SP_FREE( NewCol );
+    SP_FREE( OldCol );
+    SP_FREE( Mark );
+    SP_FREE( OldFirstInCol );
+    SP_FREE( Slot );
+    return spOrderAndFactor( Matrix, NULL, 0.0, 0.0, DIAG_PIVOTING_AS_DEFAULT );
+
+Done:
+    SP_FREE( NewRow );
+    SP_FREE( NewCol );
+    SP_FREE( OldCol );
+    SP_FREE( Mark );
+    SP_FREE( OldFirstInCol );
+    SP_FREE( Slot );
+    return Matrix->Error;
+}
+
+
+
+
+
+
+
+/*
+ *  GET SYMBOLIC FACTORIZATION
+ *
+ *  Records the pivot order and the structure, including fill-ins, of an
+ *  ordered matrix so that they can be given to spOrderAndFactorGiven().
+ *  The result does not refer to the matrix and is freed with
+ *  spFreeSymbolic().
+ *
+ *  >>> Returned:
+ *  The symbolic factorization, or NULL if the matrix has not been
+ *  ordered or memory is exhausted.
+ *
+ *  >>> Arguments:
+ *  Matrix  <input>  (char *)
+ *      Pointer to matrix.
+ */
+
+SymbolicPtr
+spGetSymbolic(MatrixPtr Matrix)
+{
+    SymbolicPtr  Symbolic;
+    ElementPtr  pElement;
+    int  Step, Size, Count;
+
+    /* Begin `spGetSymbolic'. */
+    assert( IS_VALID(Matrix) );
+
+    if (Matrix->NeedsOrdering)
+        return NULL;
+
+    Size = Matrix->Size;
+    Count = 0;
+    for (Step = 1; Step <= Size; Step++)
+        for (pElement = Matrix->FirstInCol[Step]; pElement; pElement = pElement->NextInCol)
+            Count++;
+
+    SP_CALLOC( Symbolic, struct SymbolicFrame, 1 );
+    if (Symbolic == NULL)
+        return NULL;
+    Symbolic->Size = Size;
+    Symbolic->RowOrder = SP_MALLOC(int, Size + 1);
+    Symbolic->ColOrder = SP_MALLOC(int, Size + 1);
+    Symbolic->ColStart = SP_MALLOC(int, Size + 2);
+    Symbolic->Rows = SP_MALLOC(int, Count + 1);
+    if (!Symbolic->RowOrder || !Symbolic->ColOrder ||
+        !Symbolic->ColStart || !Symbolic->Rows) {
+        spFreeSymbolic( Symbolic );
+        return NULL;
+    }
+
+    Count = 0;
+    for (Step = 1; Step <= Size; Step++) {
+        Symbolic->RowOrder[Step] = Matrix->IntToExtRowMap[Step];
+        Symbolic->ColOrder[Step] = Matrix->IntToExtColMap[Step];
+        Symbolic->ColStart[Step] = Count;
+        for (pElement = Matrix->FirstInCol[Step]; pElement; pElement = pElement->NextInCol)
+            Symbolic->Rows[Count++] = pElement->Row;
+    }
+    Symbolic->ColStart[Size+1] = Count;
+
+    return Symbolic;
+}
+
+
+
+
+
+
+
+/*
+ *  FREE SYMBOLIC FACTORIZATION
+ *
+ *  Frees a symbolic factorization returned by spGetSymbolic().
+ *
+ *  >>> Arguments:
+ *  Symbolic  <input>  (SymbolicPtr)
+ *      Symbolic factorization to free.
+ */
+
+void
+spFreeSymbolic(SymbolicPtr Symbolic)
+{
+    /* Begin `spFreeSymbolic'. */
+    if (Symbolic == NULL)
+        return;
+    SP_FREE( Symbolic->RowOrder );
+    SP_FREE( Symbolic->ColOrder );
+    SP_FREE( Symbolic->ColStart );
+    SP_FREE( Symbolic->Rows );
+    SP_FREE( Symbolic );
+}
+
+
+
+
+
+
+
+/*
+ *  FACTOR MATRIX SHARING THE SYMBOLIC FACTORIZATION
+ *
+ *  Matrices with an identical structure, such as those of CIDER devices
+ *  built from the same mesh and doping, need the same pivot order and
+ *  fill-ins.  The first time such a matrix is ordered, this routine
+ *  factors it with spFactor() and remembers its symbolic factorization.
+ *  It then imposes that factorization on the next matrices of the same
+ *  structure with spOrderAndFactorGiven(), so they skip the Markowitz
+ *  search and the creation of fill-ins.  The structures of the
+ *  SHARED_ORDER_MAX most recently ordered matrices are kept.  A matrix
+ *  that is already ordered is just factored with spFactor().
+ *
+ *  >>> Returned:
+ *  The error code is returned.  Possible errors are those of spFactor().
+ *
+ *  >>> Arguments:
+ *  Matrix  <input>  (char *)
+ *      Pointer to matrix.
+ */
+
+#define SHARED_ORDER_MAX 16
+
+struct SharedOrder {
+    struct SharedOrder *Next;
+    int Size;
+    int PatternSize;
+    int *Pattern;       /* external column, its external rows, 0 per column */
+    SymbolicPtr Symbolic;
+};
+
+static struct SharedOrder *SharedOrderList = NULL;
+
+static void
+FreeSharedOrder( struct SharedOrder *Shared )
+{
+    SP_FREE( Shared->Pattern );
+    spFreeSymbolic( Shared->Symbolic );
+    SP_FREE( Shared );
+}
+
+int
+spFactorSharedOrder(MatrixPtr Matrix)
+{
+    struct SharedOrder *Shared, **ppPrev;
+    ElementPtr pElement;
+    int *Pattern, PatternSize, Col, I, Error;
+
+    /* Begin `spFactorSharedOrder'. */
+    if (!Matrix->NeedsOrdering)
+        return spFactor( Matrix );
+
+    spcSortColumns( Matrix );
+    PatternSize = Matrix->Elements + 2 * Matrix->Size;
+    Pattern = SP_MALLOC(int, PatternSize);
+    if (Pattern == NULL)
+        return spFactor( Matrix );
+    I = 0;
+    for (Col = 1; Col <= Matrix->Size; Col++) {
+        Pattern[I++] = Matrix->IntToExtColMap[Col];
+        for (pElement = Matrix->FirstInCol[Col]; pElement;
+             pElement = pElement->NextInCol)
+            Pattern[I++] = Matrix->IntToExtRowMap[pElement->Row];
+        Pattern[I++] = 0;
+    }
+
+    for (Shared = SharedOrderList; Shared; Shared = Shared->Next) {
+        if (Shared->Size == Matrix->Size &&
+            Shared->PatternSize == PatternSize &&
+            memcmp( Shared->Pattern, Pattern,
+                    (size_t) PatternSize * sizeof(int) ) == 0) {
+            SP_FREE( Pattern );
+            return spOrderAndFactorGiven( Matrix, Shared->Symbolic );
+        }
+    }
+
+    Error = spFactor( Matrix );
+    if (Error >= spFATAL) {
+        SP_FREE( Pattern );
+        return Error;
+    }
+
+    SP_CALLOC( Shared, struct SharedOrder, 1 );
+    if (Shared == NULL) {
+        SP_FREE( Pattern );
+        return Error;
+    }
+    Shared->Size = Matrix->Size;
+    Shared->PatternSize = PatternSize;
+    Shared->Pattern = Pattern;
+    Shared->Symbolic = spGetSymbolic( Matrix );
+    if (Shared->Symbolic == NULL) {
+        FreeSharedOrder( Shared );
+        return Error;
+    }
+    Shared->Next = SharedOrderList;
+    SharedOrderList = Shared;
+
+    /* Forget the least recently added structures. */
+    for (I = 0, ppPrev = &SharedOrderList; *ppPrev; I++) {
+        Shared = *ppPrev;
+        if (I >= SHARED_ORDER_MAX) {
+            *ppPrev = Shared->Next;
+            FreeSharedOrder( Shared );
+        } else {
+            ppPrev = &Shared->Next;
+        }
+    }
+
+    return Error;
+}
+
+
+
+
+
+
+
 
 /*
  *  FACTOR MATRIX
@@ -347,6 +797,7 @@ spFactor(MatrixPtr Matrix)
     ElementPtr  pElement;
     ElementPtr  pColumn;
     int  Step, Size;
+    int  *SupernodeStart, *SupernodeEnd;
     RealNumber Mult;
 
     /* Begin `spFactor'. */
@@ -367,6 +818,13 @@ spFactor(MatrixPtr Matrix)
         return (Matrix->Error = spOKAY);
     }
 
+    if (!Matrix->SupernodesFound) {
+        FindSupernodes( Matrix );
+        if (Matrix->Error == spNO_MEMORY) return spNO_MEMORY;
+    }
+    SupernodeStart = Matrix->SupernodeStart;
+    SupernodeEnd = Matrix->SupernodeEnd;
+
     if (Matrix->Diag[1]->Real == 0.0) return ZeroPivot( Matrix, 1 );
     Matrix->Diag[1]->Real = 1.0 / Matrix->Diag[1]->Real;
 
@@ -386,6 +844,12 @@ spFactor(MatrixPtr Matrix)
             /* Update column. */
             pColumn = Matrix->FirstInCol[Step];
             while (pColumn->Row < Step) {
+                if (SupernodeEnd[pColumn->Row] < Step &&
+                    SupernodeStart[pColumn->Row] != SupernodeEnd[pColumn->Row]) {
+                    /* Columns of a finished supernode, use its dense block. */
+                    pColumn = UpdateFromSupernode( Matrix, pColumn, Dest );
+                    continue;
+                }
                 pElement = Matrix->Diag[pColumn->Row];
                 pColumn->Real = Dest[pColumn->Row] * pElement->Real;
                 while ((pElement = pElement->NextInCol) != NULL)
@@ -429,6 +893,10 @@ spFactor(MatrixPtr Matrix)
                 return ZeroPivot( Matrix, Step );
             Matrix->Diag[Step]->Real = 1.0 / Matrix->Diag[Step]->Real;
         }
+
+        /* Copy a supernode to its dense block once its last column is done. */
+        if (SupernodeEnd[Step] == Step && SupernodeStart[Step] != Step)
+            GatherSupernode( Matrix, SupernodeStart[Step] );
     }
 
     Matrix->Factored = YES;
@@ -437,6 +905,74 @@ spFactor(MatrixPtr Matrix)
 
 
 
+/*
+ *  FACTOR MATRIX KEEPING THE PIVOT ORDER
+ *
+ *  This routine factors a real matrix with spFactor(), so with the
+ *  pivot order of the last call to spOrderAndFactor(), and then checks
+ *  every pivot against the relative threshold used by
+ *  spOrderAndFactor().  spFactor() leaves the reduced column below each
+ *  pivot in the lower triangular matrix, so the test is the same as the
+ *  one spOrderAndFactor() makes before it accepts a kept pivot.  If a
+ *  pivot is zero or fails the test, the matrix holds partially factored
+ *  values and has to be loaded again before it is reordered.
+ *
+ *  >>> Returned:
+ *  The error code is returned.  Possible errors are listed below.
+ *
+ *  >>> Arguments:
+ *  Matrix  <input>  (char *)
+ *      Pointer to matrix, which must have been ordered before.
+ *  RelThreshold  <input>  (RealNumber)
+ *      Minimum ratio of a pivot to the largest element below it in its
+ *      reduced column.  If not in (0, 1], the threshold of the last
+ *      ordering is used.
+ *
+ *  >>> Possible errors:
+ *  spNO_MEMORY
+ *  spSINGULAR
+ *  spZERO_DIAG
+ *  Error is cleared in this function.  */
+
+int
+spFactorKeepOrder(MatrixPtr Matrix, RealNumber RelThreshold)
+{
+    ElementPtr  pPivot, pElement;
+    int  Step, Error;
+    RealNumber Largest;
+
+    /* Begin `spFactorKeepOrder'. */
+    assert( IS_VALID(Matrix) && !Matrix->Factored && !Matrix->Complex &&
+            !Matrix->NeedsOrdering );
+
+    if (RelThreshold <= 0.0 || RelThreshold > 1.0)
+        RelThreshold = Matrix->RelThreshold;
+
+    Error = spFactor( Matrix );
+    if (Error != spOKAY)
+        return Error;
+
+    /* Diag holds the reciprocal pivots. */
+    for (Step = 1; Step <= Matrix->Size; Step++) {
+        pPivot = Matrix->Diag[Step];
+        Largest = 0.0;
+        for (pElement = pPivot->NextInCol; pElement != NULL;
+             pElement = pElement->NextInCol) {
+            if (ABS(pElement->Real) > Largest)
+                Largest = ABS(pElement->Real);
+        }
+        if (Largest * RelThreshold * ABS(pPivot->Real) >= 1.0) {
+            Matrix->Factored = NO;
+            return MatrixIsSingular( Matrix, Step );
+        }
+    }
+
+    return spOKAY;
+}
+
+
+
+
 
 
 
@@ -561,6 +1097,274 @@ FactorComplexMatrix( MatrixPtr Matrix )
 
 
 
+
+/*
+ *  FIND SUPERNODES
+ *
+ *  This routine finds the supernodes of the factored matrix: the runs
+ *  of consecutive steps where column Step of L holds the row Step+1 and
+ *  otherwise exactly the rows of column Step+1.  The diagonal block of
+ *  such a run is a full lower triangle and all of its columns have the
+ *  same rows below the run, so the run is stored as a dense block.  Runs
+ *  shorter than SUPERNODE_MIN_SIZE are not worth the copy; their steps
+ *  are made supernodes of their own and are eliminated as usual.
+ *
+ *  The dense block of a supernode of Width columns starting at First
+ *  holds the diagonal block, Width by Width stored by columns, followed
+ *  by the rows below the supernode, Width values each, stored by rows.
+ *  The pivots in the diagonal block are the reciprocals kept in Diag.
+ *
+ *  >>> Arguments:
+ *  Matrix  <input>  (MatrixPtr)
+ *      Pointer to matrix.
+ *
+ *  >>> Possible errors:
+ *  spNO_MEMORY
+ */
+
+static void
+FindSupernodes( MatrixPtr Matrix )
+{
+    ElementPtr  pElement, pNext;
+    int  Step, First, Size, Width, MaxWidth, NumRows, Row;
+    int  *Start, *End, *RowStart;
+    long  Values;
+
+    /* Begin `FindSupernodes'. */
+    Size = Matrix->Size;
+
+    SP_FREE( Matrix->SupernodeStart );
+    SP_FREE( Matrix->SupernodeEnd );
+    SP_FREE( Matrix->SupernodeMults );
+    SP_FREE( Matrix->SupernodeRowStart );
+    SP_FREE( Matrix->SupernodeRows );
+    SP_FREE( Matrix->SupernodeValueStart );
+    SP_FREE( Matrix->SupernodeValues );
+
+    Start = Matrix->SupernodeStart = SP_MALLOC( int, Size+1 );
+    End = Matrix->SupernodeEnd = SP_MALLOC( int, Size+1 );
+    RowStart = Matrix->SupernodeRowStart = SP_MALLOC( int, Size+2 );
+    Matrix->SupernodeValueStart = SP_MALLOC( long, Size+1 );
+    if (!Start || !End || !RowStart || !Matrix->SupernodeValueStart) {
+        Matrix->Error = spNO_MEMORY;
+        return;
+    }
+
+    /* Split the steps into supernodes and count the rows below them. */
+    NumRows = 0;
+    MaxWidth = 1;
+    Values = 0;
+    First = 1;
+    for (Step = 1; Step <= Size; Step++) {
+        if (Step < Size) {
+            /* Does Step+1 continue the run? */
+            pElement = Matrix->Diag[Step]->NextInCol;
+            if (pElement != NULL && pElement->Row == Step + 1) {
+                pElement = pElement->NextInCol;
+                pNext = Matrix->Diag[Step+1]->NextInCol;
+                while (pElement != NULL && pNext != NULL &&
+                       pElement->Row == pNext->Row) {
+                    pElement = pElement->NextInCol;
+                    pNext = pNext->NextInCol;
+                }
+                if (pElement == NULL && pNext == NULL)
+                    continue;
+            }
+        }
+
+        /* Step is the last step of the run starting at First. */
+        Width = Step - First + 1;
+        if (Width < SUPERNODE_MIN_SIZE) {
+            for (; First <= Step; First++) {
+                Start[First] = End[First] = First;
+                RowStart[First] = NumRows;
+            }
+            continue;
+        }
+
+        Matrix->SupernodeValueStart[First] = Values;
+        for (Row = First; Row <= Step; Row++) {
+            Start[Row] = First;
+            End[Row] = Step;
+            RowStart[Row] = NumRows;
+        }
+        for (pElement = Matrix->Diag[Step]->NextInCol; pElement != NULL;
+             pElement = pElement->NextInCol)
+            NumRows++;
+        Values += (long)Width * (Width + NumRows - RowStart[First]);
+        if (Width > MaxWidth)
+            MaxWidth = Width;
+        First = Step + 1;
+    }
+    RowStart[Size+1] = NumRows;
+
+    Matrix->SupernodeMults = SP_MALLOC( RealNumber, MaxWidth );
+    Matrix->SupernodeRows = SP_MALLOC( int, NumRows + 1 );
+    Matrix->SupernodeValues = SP_MALLOC( RealNumber, Values + 1 );
+    if (!Matrix->SupernodeMults || !Matrix->SupernodeRows ||
+        !Matrix->SupernodeValues) {
+        Matrix->Error = spNO_MEMORY;
+        return;
+    }
+
+    /* Record the rows below each supernode. */
+    for (Step = 1; Step <= Size; Step++) {
+        if (End[Step] != Step || Start[Step] == Step)
+            continue;
+        NumRows = RowStart[Step];
+        for (pElement = Matrix->Diag[Step]->NextInCol; pElement != NULL;
+             pElement = pElement->NextInCol)
+            Matrix->SupernodeRows[NumRows++] = pElement->Row;
+    }
+
+    Matrix->SupernodesFound = YES;
+}
+
+
+
+
+
+
+
+/*
+ *  GATHER SUPERNODE
+ *
+ *  Copies the factored columns of L of a supernode into its dense block.
+ *
+ *  >>> Arguments:
+ *  Matrix  <input>  (MatrixPtr)
+ *      Pointer to matrix.
+ *  First  <input>  (int)
+ *      First step of the supernode.
+ */
+
+static void
+GatherSupernode( MatrixPtr Matrix, int First )
+{
+    ElementPtr  pElement;
+    int  Col, Row, Width;
+    RealVector  pDiag, pBelow;
+
+    /* Begin `GatherSupernode'. */
+    Width = Matrix->SupernodeEnd[First] - First + 1;
+    pDiag = Matrix->SupernodeValues + Matrix->SupernodeValueStart[First];
+
+    for (Col = 0; Col < Width; Col++) {
+        pElement = Matrix->Diag[First + Col];
+        for (Row = Col; Row < Width; Row++) {
+            pDiag[Col*Width + Row] = pElement->Real;
+            pElement = pElement->NextInCol;
+        }
+        pBelow = pDiag + Width*Width + Col;
+        while (pElement != NULL) {
+            *pBelow = pElement->Real;
+            pBelow += Width;
+            pElement = pElement->NextInCol;
+        }
+    }
+}
+
+
+
+
+
+
+
+/*
+ *  UPDATE COLUMN FROM SUPERNODE
+ *
+ *  Performs the part of the update of a column in spFactor() that is due
+ *  to the columns of a factored supernode.  The multipliers are found by
+ *  forward substitution in the diagonal block, then the rows below the
+ *  supernode are updated from the dense block, four rows at a time.
+ *  Each entry of the column receives the same operations in the same
+ *  order as with the element by element update.
+ *
+ *  Because the structure is closed under fill-in, a column that holds
+ *  the row of one step of a supernode also holds the rows of all of its
+ *  later steps and all of the rows below it.
+ *
+ *  >>> Returned:
+ *  The element of the column following the rows of the supernode.
+ *
+ *  >>> Arguments:
+ *  Matrix  <input>  (MatrixPtr)
+ *      Pointer to matrix.
+ *  pColumn  <input>  (ElementPtr)
+ *      The first element of the column in a row of the supernode.
+ *  Dest  <input/output>  (RealVector)
+ *      The column being updated, scattered by row.
+ */
+
+static ElementPtr
+UpdateFromSupernode( MatrixPtr Matrix, ElementPtr pColumn, RealVector Dest )
+{
+    int  First, Width, Col, Row, NumRows, I;
+    int  *pRows;
+    RealVector  pDiag, pBelow, Mults;
+    RealVector  pBelow0, pBelow1, pBelow2, pBelow3;
+    RealNumber  Mult, Dest0, Dest1, Dest2, Dest3;
+
+    /* Begin `UpdateFromSupernode'. */
+    First = Matrix->SupernodeStart[pColumn->Row];
+    Width = Matrix->SupernodeEnd[First] - First + 1;
+    pDiag = Matrix->SupernodeValues + Matrix->SupernodeValueStart[First];
+    pBelow = pDiag + Width*Width;
+    pRows = Matrix->SupernodeRows + Matrix->SupernodeRowStart[First];
+    NumRows = Matrix->SupernodeRowStart[First + Width] -
+        Matrix->SupernodeRowStart[First];
+    Mults = Matrix->SupernodeMults;
+
+    /* Forward substitution in the diagonal block. */
+    I = pColumn->Row - First;
+    for (Col = I; Col < Width; Col++) {
+        assert( pColumn->Row == First + Col );
+        Mult = Dest[First + Col] * pDiag[Col*Width + Col];
+        pColumn->Real = Mults[Col] = Mult;
+        for (Row = Col + 1; Row < Width; Row++)
+            Dest[First + Row] -= Mult * pDiag[Col*Width + Row];
+        pColumn = pColumn->NextInCol;
+    }
+
+    /* Update the rows below the supernode. */
+    for (Row = 0; Row + 4 <= NumRows; Row += 4) {
+        pBelow0 = pBelow + Row*Width;
+        pBelow1 = pBelow0 + Width;
+        pBelow2 = pBelow1 + Width;
+        pBelow3 = pBelow2 + Width;
+        Dest0 = Dest[pRows[Row]];
+        Dest1 = Dest[pRows[Row+1]];
+        Dest2 = Dest[pRows[Row+2]];
+        Dest3 = Dest[pRows[Row+3]];
+        for (Col = I; Col < Width; Col++) {
+            Mult = Mults[Col];
+            Dest0 -= Mult * pBelow0[Col];
+            Dest1 -= Mult * pBelow1[Col];
+            Dest2 -= Mult * pBelow2[Col];
+            Dest3 -= Mult * pBelow3[Col];
+        }
+        Dest[pRows[Row]] = Dest0;
+        Dest[pRows[Row+1]] = Dest1;
+        Dest[pRows[Row+2]] = Dest2;
+        Dest[pRows[Row+3]] = Dest3;
+    }
+    for (; Row < NumRows; Row++) {
+        pBelow0 = pBelow + Row*Width;
+        Dest0 = Dest[pRows[Row]];
+        for (Col = I; Col < Width; Col++)
+            Dest0 -= Mults[Col] * pBelow0[Col];
+        Dest[pRows[Row]] = Dest0;
+    }
+
+    return pColumn;
+}
+
+
+
+
+
+
+
 
 /*
  *  PARTITION MATRIX
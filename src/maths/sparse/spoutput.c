@@ -149,6 +149,7 @@ spPrint(MatrixPtr Matrix, int PrintReordered, int Data, int Header)
 
     /* Begin `spPrint'. */
     assert( IS_SPARSE( Matrix ) );
+    spcSortColumns( Matrix );
     Size = Matrix->Size;
     SP_CALLOC(pImagElements, ElementPtr, Printer_Width / 10 + 1);
     if ( pImagElements == NULL)
@@ -447,6 +448,7 @@ spFileMatrix(MatrixPtr Matrix, char *File, char *Label, int Reordered,
 
     /* Begin `spFileMatrix'. */
     assert( IS_SPARSE( Matrix ) );
+    spcSortColumns( Matrix );
 
     /* Open file matrix file in write mode. */
     if ((pMatrixFile = fopen(File, "w")) == NULL)
@@ -19,6 +19,7 @@
  *  SMPluFac
  *  SMPcReorder
  *  SMPreorder
+ *  SMPreuseOrder
  *  SMPcaSolve
  *  SMPcSolve
  *  SMPsolve
@@ -178,7 +179,7 @@ SMPluFac(SMPmatrix *Matrix, double PivTol, double Gmin)
 int
 SMPluFacForCIDER (SMPmatrix *Matrix)
 {
-    return spFactor (Matrix->SPmatrix) ;
+    return spFactorSharedOrder (Matrix->SPmatrix) ;
 }
 #endif
 
@@ -207,6 +208,28 @@ SMPreorder(SMPmatrix *Matrix, double PivTol, double PivRel, double Gmin)
                              PivRel, PivTol, YES );
 }
 
+/*
+ * SMPreuseOrder()
+ *
+ * Factor the matrix keeping the pivot order of the last reordering.
+ * Returns E_BADMATRIX, with the matrix untouched, if there is no
+ * order to reuse.  Returns E_SINGULAR if a kept pivot is zero or
+ * fails the relative threshold, the matrix then has to be loaded
+ * again and reordered.
+ */
+int
+SMPreuseOrder(SMPmatrix *Matrix, double PivTol, double PivRel, double Gmin)
+{
+    NG_IGNORE(PivTol);
+
+    if (Matrix->SPmatrix->NeedsOrdering)
+        return E_BADMATRIX;
+
+    spSetReal( Matrix->SPmatrix );
+    LoadGmin( Matrix, Gmin );
+    return spFactorKeepOrder( Matrix->SPmatrix, PivRel );
+}
+
 /*
  * SMPcaSolve()
  */
@@ -504,8 +527,8 @@ SMPfindElt(SMPmatrix *eMatrix, int Row, int Col, int CreateIfMissing)
     /* No element available */
         return NULL;
 
-    Element = Matrix->FirstInCol[Col];
-    Element = spcFindElementInCol(Matrix, &Element, Row, Col, CreateIfMissing);
+    Element = spcFindElementInCol(Matrix, &Matrix->FirstInCol[Col],
+                                  Row, Col, CreateIfMissing);
     return (SMPelement *)Element;
 }
 
@@ -545,6 +568,8 @@ SMPcAddCol(SMPmatrix *eMatrix, int Accum_Col, int Addend_Col)
     Accum_Col = Matrix->ExtToIntColMap[Accum_Col];
     Addend_Col = Matrix->ExtToIntColMap[Addend_Col];
 
+    spcSortColumns(Matrix);
+
     Addend = Matrix->FirstInCol[Addend_Col];
     Prev = &Matrix->FirstInCol[Accum_Col];
     Accum = *Prev;
@@ -188,6 +188,10 @@ spMNA_Preorder(MatrixPtr Matrix)
     Size = Matrix->Size;
     Matrix->Reordered = YES;
 
+    /* Twins are searched in row order, columns are exchanged below. */
+    spcSortColumns( Matrix );
+    spcFreeElementTable( Matrix );
+
     do
     {
 	AnotherPassNeeded = Swapped = NO;
@@ -1108,6 +1112,8 @@ spStripMatrix(MatrixPtr Matrix)
     /* Begin `spStripMatrix'. */
     assert( IS_SPARSE( Matrix ) );
     if (Matrix->Elements == 0) return;
+    spcFreeElementTable( Matrix );
+    Matrix->ColumnsUnsorted = NO;
     Matrix->RowsLinked = NO;
     Matrix->NeedsOrdering = YES;
     Matrix->Elements = 0;
@@ -0,0 +1,504 @@
+/*************
+ * Reading of compressed input files.
+ *
+ * ngzfopen() is a drop-in replacement for fopen() for input files.
+ * Files starting with the gzip or zstd magic number are decompressed
+ * while they are read, so netlists, libraries and code model data
+ * files may be stored compressed.  All other files, and files opened
+ * for writing, are returned as opened by fopen(), input files with a
+ * larger stdio buffer.  Pipes and terminals cannot seek back after
+ * the magic number has been read, the bytes read are put in front of
+ * the rest of the input by a wrapper stream.
+ ************/
+
+#include "ngspice/ngspice.h"
+#include "zfile.h"
+
+#include <errno.h>
+#include <limits.h>
+
+#ifdef HAVE_LIBZ
+#include <zlib.h>
+#endif
+#ifdef HAVE_LIBZSTD
+#include <zstd.h>
+#endif
+
+#if defined(HAVE_LIBZ) || defined(HAVE_LIBZSTD)
+#define ZF_HAVE_DECOMPRESSION
+#endif
+
+/* Size of the stdio buffer of a decompressing stream, and of the
+   compressed data read in one go */
+#define ZF_BUFSIZE (1 << 16)
+
+/* Length of the longest magic number */
+#define ZF_MAGICLEN 4
+
+enum zf_format { ZF_PLAIN, ZF_GZIP, ZF_ZSTD };
+
+
+static enum zf_format
+zf_probe(const unsigned char *magic, size_t n)
+{
+    if (n >= 2 && magic[0] == 0x1f && magic[1] == 0x8b)
+        return ZF_GZIP;
+    if (n == 4 && magic[0] == 0x28 && magic[1] == 0xb5 &&
+            magic[2] == 0x2f && magic[3] == 0xfd)
+        return ZF_ZSTD;
+    return ZF_PLAIN;
+}
+
+
+#ifdef ZF_HAVE_DECOMPRESSION
+
+/* State of one decompressing stream.  read() returns the number of
+   bytes stored into buf, 0 at the end of the data, -1 on error.
+   rewind() restarts decompression at the beginning of the file. */
+typedef struct zfile {
+    long (*read)(struct zfile *zf, char *buf, size_t size);
+    bool (*rewind)(struct zfile *zf);
+    void (*close)(struct zfile *zf);
+    long pos;                   /* decompressed bytes read so far */
+    FILE *fp;                   /* compressed input */
+    char *inbuf;
+    bool eof;
+#ifdef HAVE_LIBZ
+    z_stream zs;
+    bool ended;                 /* at the end of a gzip member */
+#endif
+#ifdef HAVE_LIBZSTD
+    ZSTD_DStream *ds;
+    ZSTD_inBuffer in;
+#endif
+} zfile;
+
+
+#ifdef HAVE_LIBZ
+
+/* zlib's gzopen() needs a path, inflate() reads from the open stream,
+   which may be a pipe */
+static long
+zf_gz_read(zfile *zf, char *buf, size_t size)
+{
+    z_stream *zs = &zf->zs;
+
+    zs->next_out = (Bytef *) buf;
+    zs->avail_out = (uInt) MIN(size, (size_t) UINT_MAX);
+
+    while (zs->avail_out > 0) {
+        int rc;
+        if (zs->avail_in == 0 && !zf->eof) {
+            zs->avail_in = (uInt) fread(zf->inbuf, 1, ZF_BUFSIZE, zf->fp);
+            zs->next_in = (Bytef *) zf->inbuf;
+            if (zs->avail_in == 0) {
+                if (ferror(zf->fp))
+                    return -1;
+                zf->eof = TRUE;
+            }
+        }
+        if (zs->avail_in == 0 && zf->eof) {
+            if (!zf->ended) {
+                fprintf(stderr, "Error: gzip: unexpected end of file\n");
+                return -1;
+            }
+            break;
+        }
+        /* another member of a concatenated file */
+        if (zf->ended) {
+            inflateReset(zs);
+            zf->ended = FALSE;
+        }
+        rc = inflate(zs, Z_NO_FLUSH);
+        if (rc == Z_STREAM_END) {
+            zf->ended = TRUE;
+        } else if (rc != Z_OK && rc != Z_BUF_ERROR) {
+            fprintf(stderr, "Error: gzip: %s\n",
+                    zs->msg ? zs->msg : "corrupt data");
+            return -1;
+        }
+    }
+
+    return (long) ((char *) zs->next_out - buf);
+}
+
+
+static bool
+zf_gz_rewind(zfile *zf)
+{
+    if (inflateReset(&zf->zs) != Z_OK || fseek(zf->fp, 0L, SEEK_SET))
+        return FALSE;
+    zf->zs.avail_in = 0;
+    zf->eof = FALSE;
+    zf->ended = FALSE;
+    return TRUE;
+}
+
+
+static void
+zf_gz_close(zfile *zf)
+{
+    inflateEnd(&zf->zs);
+    fclose(zf->fp);
+    txfree(zf->inbuf);
+}
+
+
+static bool
+zf_gz_open(zfile *zf, FILE *fp)
+{
+    memset(&zf->zs, 0, sizeof zf->zs);
+    /* 16: gzip header and trailer */
+    if (inflateInit2(&zf->zs, 16 + MAX_WBITS) != Z_OK)
+        return FALSE;
+    zf->fp = fp;
+    zf->inbuf = TMALLOC(char, ZF_BUFSIZE);
+    zf->eof = FALSE;
+    zf->ended = FALSE;
+    zf->read = zf_gz_read;
+    zf->rewind = zf_gz_rewind;
+    zf->close = zf_gz_close;
+    return TRUE;
+}
+
+#endif
+
+
+#ifdef HAVE_LIBZSTD
+
+static long
+zf_zstd_read(zfile *zf, char *buf, size_t size)
+{
+    ZSTD_outBuffer out = { buf, size, 0 };
+
+    for (;;) {
+        size_t rc = ZSTD_decompressStream(zf->ds, &out, &zf->in);
+        if (ZSTD_isError(rc)) {
+            fprintf(stderr, "Error: zstd: %s\n", ZSTD_getErrorName(rc));
+            return -1;
+        }
+        if (out.pos == out.size)
+            break;
+        if (zf->in.pos < zf->in.size)
+            continue;
+        if (out.pos > 0 || zf->eof)
+            break;
+        /* decompressor is drained, fetch more input */
+        zf->in.size = fread(zf->inbuf, 1, ZF_BUFSIZE, zf->fp);
+        zf->in.pos = 0;
+        if (zf->in.size == 0) {
+            if (ferror(zf->fp))
+                return -1;
+            zf->eof = TRUE;
+        }
+    }
+
+    return (long) out.pos;
+}
+
+
+static bool
+zf_zstd_rewind(zfile *zf)
+{
+    if (ZSTD_isError(ZSTD_initDStream(zf->ds)) || fseek(zf->fp, 0L, SEEK_SET))
+        return FALSE;
+    zf->in.size = 0;
+    zf->in.pos = 0;
+    zf->eof = FALSE;
+    return TRUE;
+}
+
+
+static void
+zf_zstd_close(zfile *zf)
+{
+    ZSTD_freeDStream(zf->ds);
+    fclose(zf->fp);
+    txfree(zf->inbuf);
+}
+
+
+static bool
+zf_zstd_open(zfile *zf, FILE *fp)
+{
+    zf->ds = ZSTD_createDStream();
+    if (!zf->ds)
+        return FALSE;
+    if (ZSTD_isError(ZSTD_initDStream(zf->ds))) {
+        ZSTD_freeDStream(zf->ds);
+        return FALSE;
+    }
+    zf->fp = fp;
+    zf->inbuf = TMALLOC(char, ZF_BUFSIZE);
+    zf->in.src = zf->inbuf;
+    zf->in.size = 0;
+    zf->in.pos = 0;
+    zf->eof = FALSE;
+    zf->read = zf_zstd_read;
+    zf->rewind = zf_zstd_rewind;
+    zf->close = zf_zstd_close;
+    return TRUE;
+}
+
+#endif
+
+
+#ifdef HAVE_FOPENCOOKIE
+
+static ssize_t
+zf_cookie_read(void *cookie, char *buf, size_t size)
+{
+    zfile *zf = (zfile *) cookie;
+    long n = zf->read(zf, buf, size);
+
+    if (n > 0)
+        zf->pos += n;
+    return (ssize_t) n;
+}
+
+
+/* Only ftell() and a rewind to the start of the data are supported */
+static int
+zf_cookie_seek(void *cookie, off64_t *offset, int whence)
+{
+    zfile *zf = (zfile *) cookie;
+
+    if (whence == SEEK_CUR && *offset == 0) {
+        *offset = zf->pos;
+        return 0;
+    }
+    if (whence == SEEK_SET && *offset == 0 && zf->rewind(zf)) {
+        zf->pos = 0;
+        return 0;
+    }
+    return -1;
+}
+
+
+static int
+zf_cookie_close(void *cookie)
+{
+    zfile *zf = (zfile *) cookie;
+    zf->close(zf);
+    txfree(zf);
+    return 0;
+}
+
+
+/* Wrap the decompressor into a stdio stream, the data is decompressed
+   as the caller reads it. */
+static FILE *
+zf_stream(zfile *zf)
+{
+    static cookie_io_functions_t io = {
+        zf_cookie_read, NULL, zf_cookie_seek, zf_cookie_close
+    };
+    FILE *fp = fopencookie(zf, "r", io);
+
+    if (!fp) {
+        zf_cookie_close(zf);
+        return NULL;
+    }
+    setvbuf(fp, NULL, _IOFBF, ZF_BUFSIZE);
+    return fp;
+}
+
+#else
+
+/* No custom streams available: decompress into a temporary file. */
+static FILE *
+zf_stream(zfile *zf)
+{
+    FILE *fp = tmpfile();
+    char *buf = TMALLOC(char, ZF_BUFSIZE);
+    long n;
+
+    while (fp && (n = zf->read(zf, buf, ZF_BUFSIZE)) != 0) {
+        if (n < 0 || fwrite(buf, 1, (size_t) n, fp) != (size_t) n) {
+            fclose(fp);
+            fp = NULL;
+        }
+    }
+    if (fp)
+        rewind(fp);
+
+    txfree(buf);
+    zf->close(zf);
+    txfree(zf);
+    return fp;
+}
+
+#endif
+
+#endif /* ZF_HAVE_DECOMPRESSION */
+
+
+#ifdef HAVE_FOPENCOOKIE
+
+/* Bytes already read from a stream which cannot seek back */
+typedef struct zf_unread {
+    FILE *fp;
+    unsigned char buf[ZF_MAGICLEN];
+    size_t n, next;
+    long pos;
+} zf_unread;
+
+
+static ssize_t
+zf_unread_read(void *cookie, char *buf, size_t size)
+{
+    zf_unread *u = (zf_unread *) cookie;
+    size_t n = MIN(size, u->n - u->next);
+
+    memcpy(buf, u->buf + u->next, n);
+    u->next += n;
+    if (n < size) {
+        n += fread(buf + n, 1, size - n, u->fp);
+        if (n == 0 && ferror(u->fp))
+            return -1;
+    }
+    u->pos += (long) n;
+    return (ssize_t) n;
+}
+
+
+/* Only ftell() is supported */
+static int
+zf_unread_seek(void *cookie, off64_t *offset, int whence)
+{
+    zf_unread *u = (zf_unread *) cookie;
+
+    if (whence == SEEK_CUR && *offset == 0) {
+        *offset = u->pos;
+        return 0;
+    }
+    return -1;
+}
+
+
+static int
+zf_unread_close(void *cookie)
+{
+    zf_unread *u = (zf_unread *) cookie;
+    int rc = fclose(u->fp);
+    txfree(u);
+    return rc;
+}
+
+
+/* A stream returning the n bytes 'buf' read from 'fp' before the rest
+   of 'fp' */
+static FILE *
+zf_unread_stream(FILE *fp, const unsigned char *buf, size_t n)
+{
+    static cookie_io_functions_t io = {
+        zf_unread_read, NULL, zf_unread_seek, zf_unread_close
+    };
+    zf_unread *u = TMALLOC(zf_unread, 1);
+    FILE *ufp;
+
+    u->fp = fp;
+    memcpy(u->buf, buf, n);
+    u->n = n;
+    ufp = fopencookie(u, "r", io);
+    if (!ufp) {
+        zf_unread_close(u);
+        return NULL;
+    }
+    setvbuf(ufp, NULL, _IOFBF, ZF_BUFSIZE);
+    return ufp;
+}
+
+#else
+
+/* No custom streams available: copy all input into a temporary file. */
+static FILE *
+zf_unread_stream(FILE *fp, const unsigned char *buf, size_t n)
+{
+    FILE *tfp = tmpfile();
+    char *tbuf = TMALLOC(char, ZF_BUFSIZE);
+
+    if (tfp && fwrite(buf, 1, n, tfp) != n) {
+        fclose(tfp);
+        tfp = NULL;
+    }
+    while (tfp && (n = fread(tbuf, 1, ZF_BUFSIZE, fp)) > 0) {
+        if (fwrite(tbuf, 1, n, tfp) != n) {
+            fclose(tfp);
+            tfp = NULL;
+        }
+    }
+    if (tfp && ferror(fp)) {
+        fclose(tfp);
+        tfp = NULL;
+    }
+    if (tfp)
+        rewind(tfp);
+
+    txfree(tbuf);
+    fclose(fp);
+    return tfp;
+}
+
+#endif
+
+
+FILE *
+ngzfopen(const char *path, const char *mode)
+{
+    FILE *fp = fopen(path, mode);
+    unsigned char magic[ZF_MAGICLEN];
+    enum zf_format format;
+    size_t n;
+
+    /* only plain reading is supported for compressed files */
+    if (!fp || mode[0] != 'r' || strchr(mode, '+'))
+        return fp;
+
+    /* netlists may be huge, read them in large blocks */
+    setvbuf(fp, NULL, _IOFBF, ZF_BUFSIZE);
+
+    n = fread(magic, 1, sizeof magic, fp);
+    format = zf_probe(magic, n);
+
+    /* back to the start, or a pipe: keep what has been read */
+    if (fseek(fp, 0L, SEEK_SET) != 0) {
+        clearerr(fp);
+        fp = zf_unread_stream(fp, magic, n);
+        if (!fp)
+            return NULL;
+    }
+
+    if (format == ZF_PLAIN)
+        return fp;
+
+#ifdef HAVE_LIBZ
+    if (format == ZF_GZIP) {
+        zfile *zf = TMALLOC(zfile, 1);
+        if (zf_gz_open(zf, fp))
+            return zf_stream(zf);
+        txfree(zf);
+        fclose(fp);
+        return NULL;
+    }
+#endif
+
+#ifdef HAVE_LIBZSTD
+    if (format == ZF_ZSTD) {
+        zfile *zf = TMALLOC(zfile, 1);
+        if (zf_zstd_open(zf, fp))
+            return zf_stream(zf);
+        txfree(zf);
+        fclose(fp);
+        return NULL;
+    }
+#endif
+
+    fprintf(stderr, "Error: %s is %s compressed, "
+            "but ngspice has been built without %s support\n",
+            path, format == ZF_GZIP ? "gzip" : "zstd",
+            format == ZF_GZIP ? "zlib" : "zstd");
+    fclose(fp);
+    errno = EINVAL;
+    return NULL;
+}
@@ -0,0 +1,10 @@
+/*************
+ * Header file for zfile.c
+ ************/
+
+#ifndef ngspice_ZFILE_H
+#define ngspice_ZFILE_H
+
+FILE *ngzfopen(const char *path, const char *mode);
+
+#endif
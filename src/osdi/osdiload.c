@@ -179,7 +179,10 @@ extern int OSDIload(GENmodel *inModel, CKTcircuit *ckt) {
 #ifdef USE_OMP
   int ret = OK;
 
-  /* use openmp 3.0 tasks to parallelize linked list transveral */
+  /* use openmp 3.0 tasks to parallelize linked list transveral
+   * eval() only writes the data and states of its own instance, the
+   * matrix and rhs are loaded and the eval flags are merged serially
+   * below, so the result does not depend on the number of threads */
 #pragma omp parallel
 #pragma omp single
   {
@@ -804,6 +804,44 @@ ngSpice_running (void)
 }
 #endif
 
+/* Alter parameters of many devices or models, see if_setparam_bulk() */
+IMPEXP
+int
+ngSpice_AlterBulk(int n, char** devs, char** params, double* values, NG_BOOL model)
+{
+    char **names, **parms;
+    int i, failed;
+
+    if (!ft_curckt || !ft_curckt->ci_ckt) {
+        fprintf(cp_err, "Error: no circuit loaded.\n");
+        return -1;
+    }
+    if (n <= 0)
+        return 0;
+
+    /* names are stored in lower case */
+    names = TMALLOC(char *, n);
+    parms = TMALLOC(char *, n);
+    for (i = 0; i < n; i++) {
+        names[i] = copy(devs[i]);
+        strtolower(names[i]);
+        parms[i] = copy(params[i]);
+        strtolower(parms[i]);
+    }
+
+    failed = if_setparam_bulk(ft_curckt->ci_ckt, n, names, parms, values,
+                              model ? 1 : 0);
+
+    for (i = 0; i < n; i++) {
+        tfree(names[i]);
+        tfree(parms[i]);
+    }
+    tfree(names);
+    tfree(parms);
+
+    return failed;
+}
+
 /* Set variable no_spinit, if reading 'spinit' is not wanted. */
 IMPEXP
 int
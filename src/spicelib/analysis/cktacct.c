@@ -109,6 +109,18 @@ CKTacct(CKTcircuit *ckt, JOB *anal, int which, IFvalue *val)
     case OPT_TRANACCPT:
         val->iValue = ckt->CKTstat->STATaccepted;
         break;
+    case OPT_REORDERS:
+        val->iValue = ckt->CKTstat->STATreorders;
+        break;
+    case OPT_REUSEDORDERS:
+        val->iValue = ckt->CKTstat->STATreusedOrders;
+        break;
+    case OPT_MEMOLOOKUPS:
+        val->iValue = ckt->CKTstat->STATmemoLookups;
+        break;
+    case OPT_MEMOHITS:
+        val->iValue = ckt->CKTstat->STATmemoHits;
+        break;
     case OPT_TRANRJCT:
         val->iValue = ckt->CKTstat->STATrejected;
         break;
@@ -102,6 +102,9 @@ CKTdoJob(CKTcircuit* ckt, int reset, TSKtask* task)
     ckt->CKTkeepOpInfo = task->TSKkeepOpInfo;
     ckt->CKTcopyNodesets = task->TSKcopyNodesets;
     ckt->CKTnodeDamping = task->TSKnodeDamping;
+    ckt->CKTreuseOrder = task->TSKreuseOrder;
+    ckt->CKTbiasMemo = task->TSKbiasMemo;
+    ckt->CKTfastMath = task->TSKfastMath;
     ckt->CKTabsDv = task->TSKabsDv;
     ckt->CKTrelDv = task->TSKrelDv;
     ckt->CKTtroubleNode = 0;
@@ -115,6 +115,8 @@ CKTnoise(CKTcircuit* ckt, int mode, int operation, Ndata* data)
                 outData.v.vec.rVec = data->outpVector; /* vector of outputs */
                 SPfrontEnd->OUTpData(data->NplotPtr, &refVal, &outData);
             }
+            /* the devices have cached their bias dependent parameters */
+            data->biasValid = TRUE;
             break;
 
         case INT_NOIZ:
@@ -72,6 +72,9 @@ CKTnewTask(CKTcircuit *ckt, TSKtask **taskPtr, IFuid taskName, TSKtask **defPtr)
         tsk->TSKkeepOpInfo      = def->TSKkeepOpInfo;
         tsk->TSKcopyNodesets    = def->TSKcopyNodesets;
         tsk->TSKnodeDamping     = def->TSKnodeDamping;
+        tsk->TSKreuseOrder      = def->TSKreuseOrder;
+        tsk->TSKbiasMemo        = def->TSKbiasMemo;
+        tsk->TSKfastMath        = def->TSKfastMath;
         tsk->TSKabsDv           = def->TSKabsDv;
         tsk->TSKrelDv           = def->TSKrelDv;
         tsk->TSKnoopac          = def->TSKnoopac;
@@ -136,6 +139,9 @@ CKTnewTask(CKTcircuit *ckt, TSKtask **taskPtr, IFuid taskName, TSKtask **defPtr)
         tsk->TSKkeepOpInfo      = 0;
         tsk->TSKcopyNodesets    = 0;
         tsk->TSKnodeDamping     = 0;
+        tsk->TSKreuseOrder      = 0;
+        tsk->TSKbiasMemo        = 0;
+        tsk->TSKfastMath        = 0;
         tsk->TSKabsDv           = 0.5;
         tsk->TSKrelDv           = 2.0;
         tsk->TSKepsmin          = 1e-28;
@@ -160,6 +160,15 @@ CKTsetOpt(CKTcircuit *ckt, JOB *anal, int opt, IFvalue *val)
     case OPT_NODEDAMPING:
         task->TSKnodeDamping = (val->iValue != 0);
         break;
+    case OPT_REUSEORDER:
+        task->TSKreuseOrder = (val->iValue != 0);
+        break;
+    case OPT_BIASMEMO:
+        task->TSKbiasMemo = (val->iValue != 0);
+        break;
+    case OPT_FASTMATH:
+        task->TSKfastMath = (val->iValue != 0);
+        break;
     case OPT_ABSDV:
         task->TSKabsDv = val->rValue;
         break;
@@ -224,6 +233,10 @@ CKTsetOpt(CKTcircuit *ckt, JOB *anal, int opt, IFvalue *val)
         g_mif_info.auto_partial.global = MIF_TRUE;
         break;
 
+    case OPT_MIF_PARALLEL:
+        g_mif_info.parallel = MIF_TRUE;
+        break;
+
     case OPT_ENH_RSHUNT:
         if(val->rValue > 1.0e-30) {
           ckt->enh->rshunt_data.enabled = MIF_TRUE;
@@ -251,6 +264,7 @@ static IFparm OPTtbl[] = {
  { "convstep", OPT_ENH_CONV_STEP, IF_SET|IF_REAL, "Fractional step allowed by code model inputs between iterations" },
  { "convabsstep", OPT_ENH_CONV_ABS_STEP, IF_SET|IF_REAL, "Absolute step allowed by code model inputs between iterations" },
  { "autopartial", OPT_MIF_AUTO_PARTIAL, IF_SET|IF_FLAG, "Use auto-partial computation for all models" },
+ { "cmparallel", OPT_MIF_PARALLEL, IF_SET|IF_FLAG, "Evaluate code models on several threads" },
  { "rshunt", OPT_ENH_RSHUNT, IF_SET|IF_REAL, "Shunt resistance from analog nodes to ground" },
 /* gtri - end   - wbk - add new options */
 #endif
@@ -313,6 +327,13 @@ static IFparm OPTtbl[] = {
  { "loadtime", OPT_LOADTIME, IF_ASK|IF_REAL,"Matrix load time" },
  { "synctime", OPT_SYNCTIME, IF_ASK|IF_REAL,"Matrix synchronize time" },
  { "reordertime", OPT_REORDTIME, IF_ASK|IF_REAL,"Matrix reorder time" },
+ { "reorders", OPT_REORDERS, IF_ASK|IF_INTEGER,"Matrix reorderings" },
+ { "reusedorders", OPT_REUSEDORDERS, IF_ASK|IF_INTEGER,
+        "Matrix reorderings avoided by reusing the pivot order" },
+ { "memolookups", OPT_MEMOLOOKUPS, IF_ASK|IF_INTEGER,
+        "Device evaluations looked up for an identical bias" },
+ { "memohits", OPT_MEMOHITS, IF_ASK|IF_INTEGER,
+        "Device evaluations copied from an identically biased instance" },
  { "factortime", OPT_DECOMP, IF_ASK|IF_REAL,"Matrix factor time" },
  { "solvetime", OPT_SOLVE, IF_ASK|IF_REAL,"Matrix solve time" },
  { "trantime", OPT_TRANTIME, IF_ASK|IF_REAL,"Transient analysis time" },
@@ -338,6 +359,12 @@ static IFparm OPTtbl[] = {
         "Copy nodesets from device terminals to internal nodes" },
  { "nodedamping", OPT_NODEDAMPING, IF_SET|IF_FLAG,
         "Limit iteration to iteration node voltage change" },
+ { "reuseorder", OPT_REUSEORDER, IF_SET|IF_FLAG,
+        "Keep the matrix pivot order while it is numerically stable" },
+ { "biasmemo", OPT_BIASMEMO, IF_SET|IF_FLAG,
+        "Evaluate identically biased BSIM3/BSIM4 instances only once" },
+ { "fastmath", OPT_FASTMATH, IF_SET|IF_FLAG,
+        "Fast exp, log and pow in the diode, BJT and BSIM4 models" },
  { "absdv", OPT_ABSDV, IF_SET|IF_REAL,
         "Maximum absolute iter-iter node voltage change" },
  { "reldv", OPT_RELDV, IF_SET|IF_REAL,
@@ -8,6 +8,7 @@ Author: 1988 Jaijeet S Roychowdhury
 #include "ngspice/distodef.h"
 #include "ngspice/sperror.h"
 
+#define DIS_NOT_FACTORED HUGE_VAL
 
 static void
 DISswap(double **a, double **b)
@@ -30,6 +31,44 @@ DstorAlloc(double ***header, int size)
 }
 
 
+/* Solve for the kernel of the given mode at omega.  The matrix is loaded
+ * and factored only if it is not already factored at omega, which is
+ * kept in *factored.
+ */
+
+static int
+DISsolve(CKTcircuit *ckt, double omega, int mode, double *factored)
+{
+    int error;
+#ifdef D_DBG_SMALLTIMES
+    double time = SPfrontEnd->IFseconds();
+#endif
+
+    ckt->CKTomega = omega;
+    if (omega != *factored) {
+        *factored = DIS_NOT_FACTORED;
+        error = CKTacLoad(ckt);
+        if (error) return(error);
+    }
+
+    error = CKTdisto(ckt, mode);
+    if (error) return(error);
+
+    if (omega == *factored) {
+        error = NIdSolve(ckt);
+    } else {
+        error = NIdIter(ckt);
+        if (!error)
+            *factored = omega;
+    }
+#ifdef D_DBG_SMALLTIMES
+time = SPfrontEnd->IFseconds() - time;
+printf("Time for kernel %d: %g seconds \n", mode, time);
+#endif
+    return(error);
+}
+
+
 
 int
 DISTOan(CKTcircuit *ckt, int restart)
@@ -48,6 +87,8 @@ DISTOan(CKTcircuit *ckt, int restart)
     runDesc *acPlot = NULL;
     DISTOAN *job = (DISTOAN *) ckt->CKTcurJob;
     static char *nof2src = "No source with f2 distortion input";
+    double factored = DIS_NOT_FACTORED;	/* omega of the LU factors */
+    double *r1H2 = NULL, *i1H2 = NULL;	/* f2 response, constant in f1 */
 #ifdef DISTODEBUG
     double time,time1;
 #endif
@@ -92,14 +133,14 @@ time1 = SPfrontEnd->IFseconds();
 		(ckt->CKTmode & MODEUIC) | MODEDCOP | MODEINITJCT,
 		(ckt->CKTmode & MODEUIC) | MODEDCOP | MODEINITFLOAT,
 		ckt->CKTdcMaxIter);
-	if(error) return(error);
+	if(error) goto cleanup;
 
 	ckt->CKTmode = (ckt->CKTmode & MODEUIC) | MODEDCOP | MODEINITSMSIG;
 	error = CKTload(ckt);
-	if(error) return(error);
+	if(error) goto cleanup;
 
 	error = CKTnames(ckt,&numNames,&nameList);
-	if(error) return(error);
+	if(error) goto cleanup;
 
 	if (ckt->CKTkeepOpInfo) {
 	    /* Dump operating point. */
@@ -108,7 +149,7 @@ time1 = SPfrontEnd->IFseconds();
                                                NULL, IF_REAL,
                                                numNames, nameList, IF_REAL,
                                                &acPlot);
-	    if(error) return(error);
+	    if(error) goto cleanup;
 	    CKTdump(ckt, 0.0, acPlot);
 	    SPfrontEnd->OUTendPlot (acPlot);
 	    acPlot = NULL;
@@ -127,7 +168,7 @@ time1 = SPfrontEnd->IFseconds();
 time1 = SPfrontEnd->IFseconds() - time1;
 printf("Time outside D_SETUP: %g seconds \n", time1);
 #endif
-	if (error) return(error);
+	if (error) goto cleanup;
 
 	displacement = 0;
 
@@ -259,175 +300,70 @@ time1 = SPfrontEnd->IFseconds();
             return(E_PAUSE);
         }
 	*/
-        ckt->CKTomega = 2.0 * M_PI *freq;
-	job->Domega1 = ckt->CKTomega;
+	job->Domega1 = 2.0 * M_PI *freq;
         ckt->CKTmode = (ckt->CKTmode&MODEUIC) | MODEAC;
-#ifdef D_DBG_SMALLTIMES
-time = SPfrontEnd->IFseconds();
-#endif
-	error = CKTacLoad(ckt);
-#ifdef D_DBG_SMALLTIMES
-time = SPfrontEnd->IFseconds() - time;
-printf("Time for CKTacLoad: %g seconds \n", time);
-#endif
-	if (error) return(error);
-#ifdef D_DBG_SMALLTIMES
-time = SPfrontEnd->IFseconds();
-#endif
-	error = CKTdisto(ckt,D_RHSF1); /* sets up the RHS vector
-			for all inputs corresponding to F1 */
-#ifdef D_DBG_SMALLTIMES
-time = SPfrontEnd->IFseconds() - time;
-printf("Time outside DISTO_RHSFIX: %g seconds \n", time);
-#endif
-	if (error) return(error);
-#ifdef D_DBG_SMALLTIMES
-time = SPfrontEnd->IFseconds();
-#endif
-	error = NIdIter(ckt);
-#ifdef D_DBG_SMALLTIMES
-time = SPfrontEnd->IFseconds() - time;
-printf("Time for NIdIter: %g seconds \n", time);
-#endif
-	if (error) return(error);
+
+	/* D_RHSF1 sets up the RHS vector for all inputs corresponding to F1 */
+	error = DISsolve(ckt, job->Domega1, D_RHSF1, &factored);
+	if (error) goto cleanup;
 	DISswap(&(ckt->CKTrhsOld),&(job->r1H1ptr));
 	DISswap(&(ckt->CKTirhsOld),&(job->i1H1ptr));
 
-	ckt->CKTomega *= 2;
-	error = CKTacLoad(ckt);
-	if (error) return(error);
-#ifdef D_DBG_SMALLTIMES
-time = SPfrontEnd->IFseconds();
-#endif
-	error = CKTdisto(ckt,D_TWOF1);
-#ifdef D_DBG_SMALLTIMES
-time = SPfrontEnd->IFseconds() - time;
-printf("Time outside D_TWOF1: %g seconds \n", time);
-#endif
-	if (error) return(error);
-	error = NIdIter(ckt);
-	if (error) return(error);
+	error = DISsolve(ckt, 2 * job->Domega1, D_TWOF1, &factored);
+	if (error) goto cleanup;
 	DISswap(&(ckt->CKTrhsOld),&(job->r2H11ptr));
 	DISswap(&(ckt->CKTirhsOld),&(job->i2H11ptr));
 
 	if (! (job->Df2wanted )) 
 		{
-
-
-		ckt->CKTomega = 3 * job->Domega1;
-		error = CKTacLoad(ckt);
-		if (error) return(error);
-#ifdef D_DBG_SMALLTIMES
-time = SPfrontEnd->IFseconds();
-#endif
-		error = CKTdisto(ckt,D_THRF1);
-#ifdef D_DBG_SMALLTIMES
-time = SPfrontEnd->IFseconds() - time;
-printf("Time outside D_THRF1: %g seconds \n", time);
-#endif
-		if (error) return(error);
-		error = NIdIter(ckt);
-		if (error) return(error);
+		error = DISsolve(ckt, 3 * job->Domega1, D_THRF1, &factored);
+		if (error) goto cleanup;
 		DISswap(&(ckt->CKTrhsOld),&(job->r3H11ptr));
 		DISswap(&(ckt->CKTirhsOld),&(job->i3H11ptr));
-
-
 		}
 		else if (job->Df2given)
 		{
+		/* f2 is kept constant during the sweep, so the first
+		 * order response at f2 is solved at the first point only */
+		if (displacement == 0) {
+			error = DISsolve(ckt, job->Domega2, D_RHSF2, &factored);
+			if (error) goto cleanup;
+			DISswap(&(ckt->CKTrhsOld),&(job->r1H2ptr));
+			DISswap(&(ckt->CKTirhsOld),&(job->i1H2ptr));
+			DmemAlloc(&r1H2, size);
+			DmemAlloc(&i1H2, size);
+			memcpy(r1H2, job->r1H2ptr, (size_t) (size + 1) * sizeof(double));
+			memcpy(i1H2, job->i1H2ptr, (size_t) (size + 1) * sizeof(double));
+		} else {
+			memcpy(job->r1H2ptr, r1H2, (size_t) (size + 1) * sizeof(double));
+			memcpy(job->i1H2ptr, i1H2, (size_t) (size + 1) * sizeof(double));
+		}
 
-
-		/*
-		ckt->CKTomega = job->Domega1 - omegadelta;
-		job->Domega2 = ckt->CKTomega;
-		*/
-		ckt->CKTomega = job->Domega2;
-		error = CKTacLoad(ckt);
-		if (error) return(error);
-#ifdef D_DBG_SMALLTIMES
-time = SPfrontEnd->IFseconds();
-#endif
-		error = CKTdisto(ckt,D_RHSF2);
-#ifdef D_DBG_SMALLTIMES
-time = SPfrontEnd->IFseconds() - time;
-printf("Time outside DISTO_RHSFIX: %g seconds \n", time);
-#endif
-		if (error) return(error);
-		error = NIdIter(ckt);
-		if (error) return(error);
-		DISswap(&(ckt->CKTrhsOld),&(job->r1H2ptr));
-		DISswap(&(ckt->CKTirhsOld),&(job->i1H2ptr));
-
-
-		ckt->CKTomega = job->Domega1 +
-					job->Domega2;
-		error = CKTacLoad(ckt);
-		if (error) return(error);
-#ifdef D_DBG_SMALLTIMES
-time = SPfrontEnd->IFseconds();
-#endif
-		error = CKTdisto(ckt,D_F1PF2);
-#ifdef D_DBG_SMALLTIMES
-time = SPfrontEnd->IFseconds() - time;
-printf("Time outside D_F1PF2: %g seconds \n", time);
-#endif
-		if (error) return(error);
-		error = NIdIter(ckt);
-		if (error) return(error);
+		error = DISsolve(ckt, job->Domega1 + job->Domega2, D_F1PF2,
+				&factored);
+		if (error) goto cleanup;
 		DISswap(&(ckt->CKTrhsOld),&(job->r2H12ptr));
 		DISswap(&(ckt->CKTirhsOld),&(job->i2H12ptr));
 
-
-
-		ckt->CKTomega = job->Domega1 -
-					    job->Domega2;
-		error = CKTacLoad(ckt);
-		if (error) return(error);
-#ifdef D_DBG_SMALLTIMES
-time = SPfrontEnd->IFseconds();
-#endif
-		error = CKTdisto(ckt,D_F1MF2);
-#ifdef D_DBG_SMALLTIMES
-time = SPfrontEnd->IFseconds() - time;
-printf("Time outside D_F1MF2: %g seconds \n", time);
-#endif
-		if (error) return(error);
-		error = NIdIter(ckt);
-		if (error) return(error);
+		error = DISsolve(ckt, job->Domega1 - job->Domega2, D_F1MF2,
+				&factored);
+		if (error) goto cleanup;
 		DISswap(&(ckt->CKTrhsOld),&(job->r2H1m2ptr));
 		DISswap(&(ckt->CKTirhsOld),&(job->i2H1m2ptr));
 
-
-		ckt->CKTomega = 2*job->Domega1 -
-						job->Domega2;
-		error = CKTacLoad(ckt);
-		if (error) return(error);
-#ifdef D_DBG_SMALLTIMES
-time = SPfrontEnd->IFseconds();
-#endif
-		error = CKTdisto(ckt,D_2F1MF2);
-#ifdef D_DBG_SMALLTIMES
-time = SPfrontEnd->IFseconds() - time;
-printf("Time outside D_2F1MF2: %g seconds \n", time);
-#endif
-		if (error) return(error);
-		error = NIdIter(ckt);
-		if (error) return(error);
+		error = DISsolve(ckt, 2 * job->Domega1 - job->Domega2, D_2F1MF2,
+				&factored);
+		if (error) goto cleanup;
 		DISswap(&(ckt->CKTrhsOld),&(job->r3H1m2ptr));
 		DISswap(&(ckt->CKTirhsOld),&(job->i3H1m2ptr));
-
-
 		}
 	else 
 	{
         errMsg = TMALLOC(char, strlen(nof2src) + 1);
         strcpy(errMsg,nof2src);
-	return(E_NOF2SRC);
+	error = E_NOF2SRC;
+	goto cleanup;
 	}
-
-
-
-
 		DmemAlloc( &(job->r1H1stor[displacement]),size);
 		DISswap(&(job->r1H1stor[displacement]),&(job->r1H1ptr));
 		job->r1H1stor[displacement][0]=freq;
@@ -490,7 +426,8 @@ printf("Time outside D_2F1MF2: %g seconds \n", time);
             if(job->DfreqDelta==0) goto endsweep;
             break;
         default:
-            return(E_INTERN);
+            error = E_INTERN;
+            goto cleanup;
         }
 	}
 #ifdef D_DBG_BLOCKTIMES
@@ -511,7 +448,7 @@ time1 = SPfrontEnd->IFseconds();
 
 	if (! job->Df2wanted) {
 	error = CKTnames(ckt,&numNames,&nameList);
-	if(error) return(error);
+	if(error) goto cleanup;
 	SPfrontEnd->IFnewUid (ckt, &freqUid, NULL, "frequency", UID_OTHER, NULL);
         SPfrontEnd->OUTpBeginPlot (ckt, ckt->CKTcurJob,
                                    "DISTORTION - 2nd harmonic",
@@ -529,13 +466,13 @@ time1 = SPfrontEnd->IFseconds();
 	ckt->CKTrhsOld = job->r2H11stor[i];
 	ckt->CKTirhsOld = job->i2H11stor[i];
 	error = CKTacDump(ckt,ckt->CKTrhsOld[0],acPlot);
-        if(error) return(error);
+        if(error) goto cleanup;
 	}
 	SPfrontEnd->OUTendPlot (acPlot);
 	acPlot = NULL;
 
 	error = CKTnames(ckt,&numNames,&nameList);
-	if(error) return(error);
+	if(error) goto cleanup;
 	SPfrontEnd->IFnewUid (ckt, &freqUid, NULL, "frequency", UID_OTHER, NULL);
         SPfrontEnd->OUTpBeginPlot (ckt, ckt->CKTcurJob,
                                    "DISTORTION - 3rd harmonic",
@@ -558,7 +495,7 @@ time1 = SPfrontEnd->IFseconds();
 
 
 	error = CKTnames(ckt,&numNames,&nameList);
-	if(error) return(error);
+	if(error) goto cleanup;
 	SPfrontEnd->IFnewUid (ckt, &freqUid, NULL, "frequency", UID_OTHER, NULL);
         SPfrontEnd->OUTpBeginPlot (ckt, ckt->CKTcurJob,
                                    "DISTORTION - IM: f1+f2",
@@ -573,13 +510,13 @@ time1 = SPfrontEnd->IFseconds();
 	ckt->CKTrhsOld = job->r2H12stor[i];
 	ckt->CKTirhsOld = job->i2H12stor[i];
 	error = CKTacDump(ckt,ckt->CKTrhsOld[0],acPlot);
-	    if(error) return(error);
+	    if(error) goto cleanup;
 	    }
 	SPfrontEnd->OUTendPlot (acPlot);
 	acPlot = NULL;
 
 	error = CKTnames(ckt,&numNames,&nameList);
-	if(error) return(error);
+	if(error) goto cleanup;
 	SPfrontEnd->IFnewUid (ckt, &freqUid, NULL, "frequency", UID_OTHER, NULL);
         SPfrontEnd->OUTpBeginPlot (ckt, ckt->CKTcurJob,
                                    "DISTORTION - IM: f1-f2",
@@ -595,13 +532,13 @@ time1 = SPfrontEnd->IFseconds();
 	ckt->CKTrhsOld = job->r2H1m2stor[i];
 	ckt->CKTirhsOld = job->i2H1m2stor[i];
 	error = CKTacDump(ckt,ckt->CKTrhsOld[0],acPlot);
-	    if(error) return(error);
+	    if(error) goto cleanup;
 	    }
 	SPfrontEnd->OUTendPlot (acPlot);
 	acPlot = NULL;
 
 	error = CKTnames(ckt,&numNames,&nameList);
-	if(error) return(error);
+	if(error) goto cleanup;
 	SPfrontEnd->IFnewUid (ckt, &freqUid, NULL, "frequency", UID_OTHER, NULL);
         SPfrontEnd->OUTpBeginPlot (ckt, ckt->CKTcurJob,
                                    "DISTORTION - IM: 2f1-f2",
@@ -617,7 +554,7 @@ time1 = SPfrontEnd->IFseconds();
 	ckt->CKTrhsOld = job->r3H1m2stor[i];
 	ckt->CKTirhsOld = job->i3H1m2stor[i];
 	error = CKTacDump(ckt,ckt->CKTrhsOld[0],acPlot);
-	    if(error) return(error);
+	    if(error) goto cleanup;
 	    }
 	SPfrontEnd->OUTendPlot (acPlot);
 	acPlot = NULL;
@@ -665,5 +602,10 @@ FREE(job->i3H1m2stor);
 time1 = SPfrontEnd->IFseconds() - time1;
 printf("Time for output and deallocation: %g seconds \n", time1);
 #endif
-    return(OK);
+    error = OK;
+
+cleanup:
+    FREE(r1H2);
+    FREE(i1H2);
+    return(error);
 }
@@ -284,6 +284,7 @@ NOISEan(CKTcircuit* ckt, int restart)
         data->outNoiz = 0.0;
         data->inNoise = 0.0;
         data->squared = cp_getvar("sqrnoise", CP_BOOL, NULL, 0) ? 1 : 0;
+        data->biasValid = FALSE;
 
         /* the current front-end needs the namelist to be fully
            declared before an OUTpBeginplot */
@@ -144,6 +144,9 @@ CKTspnoise(CKTcircuit* ckt, int mode, int operation, Ndata* data, NOISEAN* noise
         }
 
         freecmat(tempCy);
+
+        /* the devices have cached their bias dependent noise parameters */
+        data->biasValid = TRUE;
     }
 
     break;
@@ -738,6 +741,8 @@ SPan(CKTcircuit* ckt, int restart)
             if (error) {
                 tfree(data);  return(error);
             }
+            if (job->SPdoNoise)
+                data->biasValid = FALSE;
         }
 #ifdef KLU
         if (ckt->CKTmatrix->CKTkluMODE)
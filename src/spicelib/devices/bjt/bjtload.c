@@ -11,6 +11,7 @@ Modified: 2000 AlansFixes
 
 #include "ngspice/ngspice.h"
 #include "ngspice/cktdefs.h"
+#include "ngspice/fastmath.h"
 #include "bjtdefs.h"
 #include "ngspice/const.h"
 #include "ngspice/trandefs.h"
@@ -428,7 +429,7 @@ BJTload(GENmodel *inModel, CKTcircuit *ckt)
 next1:      vtn=vt*here->BJTtemissionCoeffF;
 
             if(vbe >= -3*vtn){
-                evbe=exp(vbe/vtn);
+                evbe=DEVexp(ckt, vbe/vtn);
                 cbe=here->BJTBEtSatCur*(evbe-1);
                 gbe=here->BJTBEtSatCur*evbe/vtn;
             } else {
@@ -442,7 +443,7 @@ next1:      vtn=vt*here->BJTtemissionCoeffF;
                 gben=0;
             } else {
                 if(vbe >= -3*vte){
-                    evben=exp(vbe/vte);
+                    evben=DEVexp(ckt, vbe/vte);
                     cben=here->BJTtBEleakCur*(evben-1);
                     gben=here->BJTtBEleakCur*evben/vte;
                 } else {
@@ -458,7 +459,7 @@ next1:      vtn=vt*here->BJTtemissionCoeffF;
             vtn=vt*here->BJTtemissionCoeffR;
 
             if(vbc >= -3*vtn) {
-                evbc=exp(vbc/vtn);
+                evbc=DEVexp(ckt, vbc/vtn);
                 cbc=here->BJTBCtSatCur*(evbc-1);
                 gbc=here->BJTBCtSatCur*evbc/vtn;
             } else {
@@ -472,7 +473,7 @@ next1:      vtn=vt*here->BJTtemissionCoeffF;
                 gbcn=0;
             } else {
                 if(vbc >= -3*vtc) {
-                    evbcn=exp(vbc/vtc);
+                    evbcn=DEVexp(ckt, vbc/vtc);
                     cbcn=here->BJTtBCleakCur*(evbcn-1);
                     gbcn=here->BJTtBCleakCur*evbcn/vtc;
                 } else {
@@ -493,7 +494,7 @@ next1:      vtn=vt*here->BJTtemissionCoeffF;
                     gdsub = here->BJTtSubSatCur*3*arg/vsub+ckt->CKTgmin;
                     cdsub = -here->BJTtSubSatCur*(1+arg)+ckt->CKTgmin*vsub;
                 } else {
-                    evsub = exp(MIN(MAX_EXP_ARG,vsub/vts));
+                    evsub = DEVexp(ckt, MIN(MAX_EXP_ARG,vsub/vts));
                     gdsub = here->BJTtSubSatCur*evsub/vts + ckt->CKTgmin;
                     cdsub = here->BJTtSubSatCur*(evsub-1) + ckt->CKTgmin*vsub;
                 }
@@ -510,15 +511,15 @@ next1:      vtn=vt*here->BJTtemissionCoeffF;
                     double rKp1,rKp1_Vbci,rKp1_Vbcx,xvar1,xvar1_Vbci,xvar1_Vbcx;
                     double Vcorr,Vcorr_Vbci,Vcorr_Vbcx,Iohm,Iohm_Vrci,Iohm_Vbci,Iohm_Vbcx;
                     double quot,quot_Vrci;
-                    Kbci = sqrt(1+here->BJTtepiDoping*exp(vbc/vt));
-                    Kbci_Vbci = here->BJTtepiDoping*exp(vbc/vt)/(2*vt*Kbci);
-                    Kbcx = sqrt(1+here->BJTtepiDoping*exp(vbcx/vt));
-                    Kbcx_Vbcx = here->BJTtepiDoping*exp(vbcx/vt)/(2*vt*Kbcx);
+                    Kbci = sqrt(1+here->BJTtepiDoping*DEVexp(ckt, vbc/vt));
+                    Kbci_Vbci = here->BJTtepiDoping*DEVexp(ckt, vbc/vt)/(2*vt*Kbci);
+                    Kbcx = sqrt(1+here->BJTtepiDoping*DEVexp(ckt, vbcx/vt));
+                    Kbcx_Vbcx = here->BJTtepiDoping*DEVexp(ckt, vbcx/vt)/(2*vt*Kbcx);
 
                     rKp1 = (1+Kbci)/(1+Kbcx);
                     rKp1_Vbci = Kbci_Vbci/(1+Kbci);
                     rKp1_Vbcx = -(1+Kbci)*Kbcx_Vbcx/((Kbcx+1)*(Kbcx+1));
-                    xvar1 = log(rKp1);
+                    xvar1 = DEVlog(ckt, rKp1);
                     xvar1_Vbci = rKp1_Vbci/rKp1;
                     xvar1_Vbcx = rKp1_Vbcx/rKp1;
 
@@ -574,7 +575,7 @@ next1:      vtn=vt*here->BJTtemissionCoeffF;
                 if(!model->BJTnkfGiven) {
                     if(arg != 0) sqarg=sqrt(arg);
                 } else {
-                    if(arg != 0) sqarg=pow(arg,model->BJTnkf);
+                    if(arg != 0) sqarg=DEVpow(ckt, arg,model->BJTnkf);
                 }
                 qb=q1*(1+sqarg)/2;
                 if(!model->BJTnkfGiven) {
@@ -659,7 +660,7 @@ next1:      vtn=vt*here->BJTtemissionCoeffF;
                     if(xtf != 0){
                         argtf=xtf;
                         if(ovtf != 0) {
-                            argtf=argtf*exp(vbc*ovtf);
+                            argtf=argtf*DEVexp(ckt, vbc*ovtf);
                         }
                         arg2=argtf;
                         if(xjtf != 0) {
@@ -675,7 +676,7 @@ next1:      vtn=vt*here->BJTtemissionCoeffF;
                 }
                 if (vbe < fcpe) {
                     arg=1-vbe/pe;
-                    sarg=exp(-xme*log(arg));
+                    sarg=DEVexp(ckt, -xme*DEVlog(ckt, arg));
                     *(ckt->CKTstate0 + here->BJTqbe)=tf*cbe+pe*czbe*
                             (1-arg*sarg)/(1-xme);
                     capbe=tf*gbe+czbe*sarg;
@@ -694,7 +695,7 @@ next1:      vtn=vt*here->BJTtemissionCoeffF;
                 f3=here->BJTtf7;
                 if (vbc < fcpc) {
                     arg=1-vbc/pc;
-                    sarg=exp(-xmc*log(arg));
+                    sarg=DEVexp(ckt, -xmc*DEVlog(ckt, arg));
                     *(ckt->CKTstate0 + here->BJTqbc) = tr*cbc+pc*czbc*(
                             1-arg*sarg)/(1-xmc);
                     capbc=tr*gbc+czbc*sarg;
@@ -706,7 +707,7 @@ next1:      vtn=vt*here->BJTtemissionCoeffF;
                 }
                 if(vbx < fcpc) {
                     arg=1-vbx/pc;
-                    sarg=exp(-xmc*log(arg));
+                    sarg=DEVexp(ckt, -xmc*DEVlog(ckt, arg));
                     *(ckt->CKTstate0 + here->BJTqbx)=
                         pc*czbx* (1-arg*sarg)/(1-xmc);
                     capbx=czbx*sarg;
@@ -718,7 +719,7 @@ next1:      vtn=vt*here->BJTtemissionCoeffF;
                 }
                 if(vsub < 0){
                     arg=1-vsub/ps;
-                    sarg=exp(-xms*log(arg));
+                    sarg=DEVexp(ckt, -xms*DEVlog(ckt, arg));
                     *(ckt->CKTstate0 + here->BJTqsub) = ps*czsub*(1-arg*sarg)/
                             (1-xms);
                     capsub=czsub*sarg;
@@ -35,6 +35,8 @@
 #ifdef USE_OMP
 int BSIM3LoadOMP(BSIM3instance *here, CKTcircuit *ckt);
 void BSIM3LoadRhsMat(GENmodel *inModel, CKTcircuit *ckt);
+static void BSIM3memoFind(BSIM3model *model, CKTcircuit *ckt);
+static void BSIM3memoCopy(BSIM3instance *here, BSIM3instance *leader, CKTcircuit *ckt);
 #endif
 
 
@@ -47,15 +49,36 @@ CKTcircuit *ckt)
     int idx;
     BSIM3model *model = (BSIM3model*)inModel;
     int error = 0;
+    int error_idx = model->BSIM3InstCount;
     BSIM3instance **InstArray;
     InstArray = model->BSIM3InstanceArray;
 
+    if (ckt->CKTbiasMemo)
+        BSIM3memoFind(model, ckt);
+
 #pragma omp parallel for
     for (idx = 0; idx < model->BSIM3InstCount; idx++) {
         BSIM3instance *here = InstArray[idx];
-        int local_error = BSIM3LoadOMP(here, ckt);
-        if (local_error)
-            error = local_error;
+        int local_error;
+        if (ckt->CKTbiasMemo && here->BSIM3memoLeader)
+            continue;
+        local_error = BSIM3LoadOMP(here, ckt);
+        if (local_error) {
+#pragma omp critical
+            if (idx < error_idx) {
+                error_idx = idx;
+                error = local_error;
+            }
+        }
+    }
+
+    if (ckt->CKTbiasMemo) {
+#pragma omp parallel for
+        for (idx = 0; idx < model->BSIM3InstCount; idx++) {
+            BSIM3instance *here = InstArray[idx];
+            if (here->BSIM3memoLeader)
+                BSIM3memoCopy(here, here->BSIM3memoLeader, ckt);
+        }
     }
 
     BSIM3LoadRhsMat(inModel, ckt);
@@ -2435,7 +2458,11 @@ finished:
            */
           if ((here->BSIM3off == 0) || (!(ckt->CKTmode & MODEINITFIX)))
           {   if (Check == 1)
-              {   ckt->CKTnoncon++;
+              {
+#ifdef USE_OMP
+#pragma omp atomic
+#endif
+                  ckt->CKTnoncon++;
 #ifndef NEWCONV
               }
               else
@@ -2448,14 +2475,22 @@ finished:
                   tol = ckt->CKTreltol * MAX(fabs(cdhat), fabs(Idtot))
                       + ckt->CKTabstol;
                   if (fabs(cdhat - Idtot) >= tol)
-                  {   ckt->CKTnoncon++;
+                  {
+#ifdef USE_OMP
+#pragma omp atomic
+#endif
+                      ckt->CKTnoncon++;
                   }
                   else
                   {   Ibtot = here->BSIM3cbs + here->BSIM3cbd - here->BSIM3csub;
                       tol = ckt->CKTreltol * MAX(fabs(cbhat), fabs(Ibtot))
                           + ckt->CKTabstol;
                       if (fabs(cbhat - Ibtot) > tol)
-                      {   ckt->CKTnoncon++;
+                      {
+#ifdef USE_OMP
+#pragma omp atomic
+#endif
+                          ckt->CKTnoncon++;
                       }
                   }
 #endif /* NEWCONV */
@@ -3132,7 +3167,7 @@ void BSIM3LoadRhsMat(GENmodel *inModel, CKTcircuit *ckt)
 {
     int InstCount, idx;
     BSIM3instance **InstArray;
-    BSIM3instance *here;
+    BSIM3instance *here, *res;
     BSIM3model *model = (BSIM3model*)inModel;
 
     InstArray = model->BSIM3InstanceArray;
@@ -3141,51 +3176,136 @@ void BSIM3LoadRhsMat(GENmodel *inModel, CKTcircuit *ckt)
     for(idx = 0; idx < InstCount; idx++) {
        here = InstArray[idx];
        model = BSIM3modPtr(here);
+       /* an instance memoized by biasmemo loads the results of its leader */
+       res = (ckt->CKTbiasMemo && here->BSIM3memoLeader) ? here->BSIM3memoLeader : here;
         /* Update b for Ax = b */
-       (*(ckt->CKTrhs + here->BSIM3gNode) -= here->BSIM3rhsG);
-       (*(ckt->CKTrhs + here->BSIM3bNode) -= here->BSIM3rhsB);
-       (*(ckt->CKTrhs + here->BSIM3dNodePrime) += here->BSIM3rhsD);
-       (*(ckt->CKTrhs + here->BSIM3sNodePrime) += here->BSIM3rhsS);
+       (*(ckt->CKTrhs + here->BSIM3gNode) -= res->BSIM3rhsG);
+       (*(ckt->CKTrhs + here->BSIM3bNode) -= res->BSIM3rhsB);
+       (*(ckt->CKTrhs + here->BSIM3dNodePrime) += res->BSIM3rhsD);
+       (*(ckt->CKTrhs + here->BSIM3sNodePrime) += res->BSIM3rhsS);
        if (here->BSIM3nqsMod)
-           (*(ckt->CKTrhs + here->BSIM3qNode) += here->BSIM3rhsQ);
+           (*(ckt->CKTrhs + here->BSIM3qNode) += res->BSIM3rhsQ);
 
         /* Update A for Ax = b */
-       (*(here->BSIM3DdPtr) += here->BSIM3DdPt);
-       (*(here->BSIM3GgPtr) += here->BSIM3GgPt);
-       (*(here->BSIM3SsPtr) += here->BSIM3SsPt);
-       (*(here->BSIM3BbPtr) += here->BSIM3BbPt);
-       (*(here->BSIM3DPdpPtr) += here->BSIM3DPdpPt);
-       (*(here->BSIM3SPspPtr) += here->BSIM3SPspPt);
-       (*(here->BSIM3DdpPtr) -= here->BSIM3DdpPt);
-       (*(here->BSIM3GbPtr) -= here->BSIM3GbPt);
-       (*(here->BSIM3GdpPtr) += here->BSIM3GdpPt);
-       (*(here->BSIM3GspPtr) += here->BSIM3GspPt);
-       (*(here->BSIM3SspPtr) -= here->BSIM3SspPt);
-       (*(here->BSIM3BgPtr) += here->BSIM3BgPt);
-       (*(here->BSIM3BdpPtr) += here->BSIM3BdpPt);
-       (*(here->BSIM3BspPtr) += here->BSIM3BspPt);
-       (*(here->BSIM3DPdPtr) -= here->BSIM3DPdPt);
-       (*(here->BSIM3DPgPtr) += here->BSIM3DPgPt);
-       (*(here->BSIM3DPbPtr) -= here->BSIM3DPbPt);
-       (*(here->BSIM3DPspPtr) -= here->BSIM3DPspPt);
-       (*(here->BSIM3SPgPtr) += here->BSIM3SPgPt);
-       (*(here->BSIM3SPsPtr) -= here->BSIM3SPsPt);
-       (*(here->BSIM3SPbPtr) -= here->BSIM3SPbPt);
-       (*(here->BSIM3SPdpPtr) -= here->BSIM3SPdpPt);
+       (*(here->BSIM3DdPtr) += res->BSIM3DdPt);
+       (*(here->BSIM3GgPtr) += res->BSIM3GgPt);
+       (*(here->BSIM3SsPtr) += res->BSIM3SsPt);
+       (*(here->BSIM3BbPtr) += res->BSIM3BbPt);
+       (*(here->BSIM3DPdpPtr) += res->BSIM3DPdpPt);
+       (*(here->BSIM3SPspPtr) += res->BSIM3SPspPt);
+       (*(here->BSIM3DdpPtr) -= res->BSIM3DdpPt);
+       (*(here->BSIM3GbPtr) -= res->BSIM3GbPt);
+       (*(here->BSIM3GdpPtr) += res->BSIM3GdpPt);
+       (*(here->BSIM3GspPtr) += res->BSIM3GspPt);
+       (*(here->BSIM3SspPtr) -= res->BSIM3SspPt);
+       (*(here->BSIM3BgPtr) += res->BSIM3BgPt);
+       (*(here->BSIM3BdpPtr) += res->BSIM3BdpPt);
+       (*(here->BSIM3BspPtr) += res->BSIM3BspPt);
+       (*(here->BSIM3DPdPtr) -= res->BSIM3DPdPt);
+       (*(here->BSIM3DPgPtr) += res->BSIM3DPgPt);
+       (*(here->BSIM3DPbPtr) -= res->BSIM3DPbPt);
+       (*(here->BSIM3DPspPtr) -= res->BSIM3DPspPt);
+       (*(here->BSIM3SPgPtr) += res->BSIM3SPgPt);
+       (*(here->BSIM3SPsPtr) -= res->BSIM3SPsPt);
+       (*(here->BSIM3SPbPtr) -= res->BSIM3SPbPt);
+       (*(here->BSIM3SPdpPtr) -= res->BSIM3SPdpPt);
 
        if (here->BSIM3nqsMod)
-       {   *(here->BSIM3QqPtr) += here->BSIM3QqPt;
+       {   *(here->BSIM3QqPtr) += res->BSIM3QqPt;
 
-           *(here->BSIM3DPqPtr) += here->BSIM3DPqPt;
-           *(here->BSIM3SPqPtr) += here->BSIM3SPqPt;
-           *(here->BSIM3GqPtr) -= here->BSIM3GqPt;
+           *(here->BSIM3DPqPtr) += res->BSIM3DPqPt;
+           *(here->BSIM3SPqPtr) += res->BSIM3SPqPt;
+           *(here->BSIM3GqPtr) -= res->BSIM3GqPt;
 
-           *(here->BSIM3QgPtr) += here->BSIM3QgPt;
-           *(here->BSIM3QdpPtr) += here->BSIM3QdpPt;
-           *(here->BSIM3QspPtr) += here->BSIM3QspPt;
-           *(here->BSIM3QbPtr) += here->BSIM3QbPt;
+           *(here->BSIM3QgPtr) += res->BSIM3QgPt;
+           *(here->BSIM3QdpPtr) += res->BSIM3QdpPt;
+           *(here->BSIM3QspPtr) += res->BSIM3QspPt;
+           *(here->BSIM3QbPtr) += res->BSIM3QbPt;
        }
 
     }
 }
+
+
+/* Bias memoization (option biasmemo).  Instances sharing the model, the
+ * size dependent parameters, the instance parameters, the results of the
+ * previous evaluation, the state history and the terminal voltages give
+ * bitwise identical results.  Only the first of such a group (the leader)
+ * is evaluated.  The others copy its results kept in the instance (from
+ * BSIM3ueff to pParam) and in the states, and BSIM3LoadRhsMat() loads the
+ * matrix and rhs values stored in the leader. */
+
+#define BSIM3memoKeySize(here) DEVmemoSpan(here, BSIM3ueff, pParam)
+
+/* The padding after BSIM3geo has no defined contents, so the range from
+ * BSIM3ueff to pParam is compared in two pieces, split at this int
+ * member. */
+static int
+BSIM3memoEqual(BSIM3instance *a, BSIM3instance *b)
+{
+    return !memcmp(&a->BSIM3ueff, &b->BSIM3ueff, DEVmemoSpan(a, BSIM3ueff, BSIM3geo)) &&
+           !memcmp(&a->BSIM3qinv, &b->BSIM3qinv, DEVmemoSpan(a, BSIM3qinv, pParam));
+}
+
+static void
+BSIM3memoFind(BSIM3model *model, CKTcircuit *ckt)
+{
+    BSIM3instance **InstArray = model->BSIM3InstanceArray;
+    BSIM3instance *here, *other;
+    double *rhs = ckt->CKTrhsOld;
+    unsigned int hash;
+    int idx, size;
+
+    for (size = 16; size < 2 * model->BSIM3InstCount; size *= 2)
+        ;
+    if (size != model->BSIM3memoSize) {
+        tfree(model->BSIM3memoTable);
+        model->BSIM3memoTable = TMALLOC(BSIM3instance *, size);
+        model->BSIM3memoSize = size;
+    }
+    memset(model->BSIM3memoTable, 0, (size_t) size * sizeof(BSIM3instance *));
+
+    for (idx = 0; idx < model->BSIM3InstCount; idx++) {
+        here = InstArray[idx];
+        here->BSIM3memoLeader = NULL;
+
+        /* the terminal voltages as read by BSIM3LoadOMP() */
+        here->BSIM3memoV[0] = rhs[here->BSIM3bNode] - rhs[here->BSIM3sNodePrime];
+        here->BSIM3memoV[1] = rhs[here->BSIM3gNode] - rhs[here->BSIM3sNodePrime];
+        here->BSIM3memoV[2] = rhs[here->BSIM3dNodePrime] - rhs[here->BSIM3sNodePrime];
+        here->BSIM3memoV[3] = rhs[here->BSIM3qNode];
+
+        hash = DEVmemoHash(here->BSIM3memoV, 4, 2166136261u);
+        hash = DEVmemoHash(ckt->CKTstate0 + here->BSIM3states, BSIM3numStates, hash);
+        here->BSIM3memoHash = hash;
+
+        for (other = model->BSIM3memoTable[hash & (unsigned int) (size - 1)];
+             other; other = other->BSIM3memoNext)
+            if (other->BSIM3memoHash == hash &&
+                BSIM3modPtr(other) == BSIM3modPtr(here) &&
+                !memcmp(other->BSIM3memoV, here->BSIM3memoV, sizeof(here->BSIM3memoV)) &&
+                BSIM3memoEqual(other, here) &&
+                DEVmemoStatesEqual(ckt, other->BSIM3states, here->BSIM3states,
+                                   BSIM3numStates))
+                break;
+
+        ckt->CKTstat->STATmemoLookups++;
+        if (other) {
+            here->BSIM3memoLeader = other;
+            ckt->CKTstat->STATmemoHits++;
+        } else {
+            here->BSIM3memoNext = model->BSIM3memoTable[hash & (unsigned int) (size - 1)];
+            model->BSIM3memoTable[hash & (unsigned int) (size - 1)] = here;
+        }
+    }
+}
+
+
+static void
+BSIM3memoCopy(BSIM3instance *here, BSIM3instance *leader, CKTcircuit *ckt)
+{
+    memcpy(&here->BSIM3ueff, &leader->BSIM3ueff, BSIM3memoKeySize(here));
+    DEVmemoCopyStates(ckt, here->BSIM3states, leader->BSIM3states, BSIM3numStates);
+}
+
 #endif
@@ -21,6 +21,7 @@ BSIM3mDelete(GENmodel *gen_model)
 
 #ifdef USE_OMP
     FREE(model->BSIM3InstanceArray);
+    FREE(model->BSIM3memoTable);
 #endif
 
     struct bsim3SizeDependParam *p = model->pSizeDependParamKnot;
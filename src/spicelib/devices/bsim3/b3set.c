@@ -1139,6 +1139,8 @@ do { if((here->ptr = SMPmakeElt(matrix, here->first, here->second)) == NULL){\
         }
         model->BSIM3InstCount = 0;
         model->BSIM3InstanceArray = NULL;
+        model->BSIM3memoTable = NULL;
+        model->BSIM3memoSize = 0;
     }
     InstArray = TMALLOC(BSIM3instance*, InstCount);
     model = (BSIM3model*)inModel;
@@ -1172,6 +1174,7 @@ BSIM3unsetup(
 #ifdef USE_OMP
     model = (BSIM3model*)inModel;
     tfree(model->BSIM3InstanceArray);
+    tfree(model->BSIM3memoTable);
 #endif
 
     for (model = (BSIM3model *)inModel; model != NULL;
@@ -218,6 +218,12 @@ typedef struct sBSIM3instance
     double BSIM3GqPt;
     double BSIM3SPqPt;
     double BSIM3BqPt;
+
+    /* bias memoization, see BSIM3memoFind() */
+    double BSIM3memoV[4];
+    unsigned int BSIM3memoHash;
+    struct sBSIM3instance *BSIM3memoNext;
+    struct sBSIM3instance *BSIM3memoLeader;
 #endif
 
 #define BSIM3vbd BSIM3states+ 0
@@ -921,6 +927,8 @@ typedef struct sBSIM3model
 #ifdef USE_OMP
     int BSIM3InstCount;
     struct sBSIM3instance **BSIM3InstanceArray;
+    struct sBSIM3instance **BSIM3memoTable;
+    int BSIM3memoSize;
 #endif
 
     /* Flags */
@@ -43,6 +43,7 @@ BSIM3v32load (GENmodel *inModel, CKTcircuit *ckt)
     int idx;
     BSIM3v32model *model = (BSIM3v32model*)inModel;
     int error = 0;
+    int error_idx = model->BSIM3v32InstCount;
     BSIM3v32instance **InstArray;
     InstArray = model->BSIM3v32InstanceArray;
 
@@ -50,8 +51,13 @@ BSIM3v32load (GENmodel *inModel, CKTcircuit *ckt)
     for (idx = 0; idx < model->BSIM3v32InstCount; idx++) {
         BSIM3v32instance *here = InstArray[idx];
         int local_error = BSIM3v32LoadOMP(here, ckt);
-        if (local_error)
-            error = local_error;
+        if (local_error) {
+#pragma omp critical
+            if (idx < error_idx) {
+                error_idx = idx;
+                error = local_error;
+            }
+        }
     }
 
     BSIM3v32LoadRhsMat(inModel, ckt);
@@ -2749,7 +2755,11 @@ finished:
            */
           if ((here->BSIM3v32off == 0) || (!(ckt->CKTmode & MODEINITFIX)))
           {   if (Check == 1)
-              {   ckt->CKTnoncon++;
+              {
+#ifdef USE_OMP
+#pragma omp atomic
+#endif
+                  ckt->CKTnoncon++;
 #ifndef NEWCONV
               }
               else
@@ -2762,14 +2772,22 @@ finished:
                   tol = ckt->CKTreltol * MAX(fabs(cdhat), fabs(Idtot))
                       + ckt->CKTabstol;
                   if (fabs(cdhat - Idtot) >= tol)
-                  {   ckt->CKTnoncon++;
+                  {
+#ifdef USE_OMP
+#pragma omp atomic
+#endif
+                      ckt->CKTnoncon++;
                   }
                   else
                   {   Ibtot = here->BSIM3v32cbs + here->BSIM3v32cbd - here->BSIM3v32csub;
                       tol = ckt->CKTreltol * MAX(fabs(cbhat), fabs(Ibtot))
                           + ckt->CKTabstol;
                       if (fabs(cbhat - Ibtot) > tol)
-                      {   ckt->CKTnoncon++;
+                      {
+#ifdef USE_OMP
+#pragma omp atomic
+#endif
+                          ckt->CKTnoncon++;
                       }
                   }
 #endif /* NEWCONV */
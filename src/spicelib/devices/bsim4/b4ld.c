@@ -30,6 +30,7 @@ under the License.
 
 #include "ngspice/ngspice.h"
 #include "ngspice/cktdefs.h"
+#include "ngspice/fastmath.h"
 #include "bsim4def.h"
 #include "ngspice/trandefs.h"
 #include "ngspice/const.h"
@@ -60,7 +61,7 @@ under the License.
             B = MIN_EXP;                                                      \
             C = 0;                                                            \
         } else   {                                                            \
-            B = exp(A);                                                       \
+            B = DEVexp(ckt, A);                                                       \
             C = B;                                                            \
         }                                                                     \
     }
@@ -68,6 +69,8 @@ under the License.
 #ifdef USE_OMP
 int BSIM4LoadOMP(BSIM4instance *here, CKTcircuit *ckt);
 void BSIM4LoadRhsMat(GENmodel *inModel, CKTcircuit *ckt);
+static void BSIM4memoFind(BSIM4model *model, CKTcircuit *ckt);
+static void BSIM4memoCopy(BSIM4instance *here, BSIM4instance *leader, CKTcircuit *ckt);
 #endif
 
 int BSIM4polyDepletion(double phi, double ngate,double epsgate, double coxe, double Vgs, double *Vgs_eff, double *dVgs_eff_dVg);
@@ -81,15 +84,37 @@ CKTcircuit *ckt)
     int idx;
     BSIM4model *model = (BSIM4model*)inModel;
     int error = 0;
+    int error_idx = model->BSIM4InstCount;
     BSIM4instance **InstArray;
     InstArray = model->BSIM4InstanceArray;
 
+    if (ckt->CKTbiasMemo)
+        BSIM4memoFind(model, ckt);
+
 #pragma omp parallel for
     for (idx = 0; idx < model->BSIM4InstCount; idx++) {
         BSIM4instance *here = InstArray[idx];
-        int local_error = BSIM4LoadOMP(here, ckt);
-        if (local_error)
-            error = local_error;
+        int local_error;
+        if (ckt->CKTbiasMemo && here->BSIM4memoLeader)
+            continue;
+        local_error = BSIM4LoadOMP(here, ckt);
+        if (local_error) {
+            /* Report the first failing instance, whatever the thread count */
+#pragma omp critical
+            if (idx < error_idx) {
+                error_idx = idx;
+                error = local_error;
+            }
+        }
+    }
+
+    if (ckt->CKTbiasMemo) {
+#pragma omp parallel for
+        for (idx = 0; idx < model->BSIM4InstCount; idx++) {
+            BSIM4instance *here = InstArray[idx];
+            if (here->BSIM4memoLeader)
+                BSIM4memoCopy(here, here->BSIM4memoLeader, ckt);
+        }
     }
 
     BSIM4LoadRhsMat(inModel, ckt);
@@ -725,8 +750,8 @@ for (; model != NULL; model = BSIM4nextModel(model))
           else
           {   switch(model->BSIM4dioMod)
               {   case 0:
-                      evbs = exp(vbs_jct / Nvtms);
-                      T1 = model->BSIM4xjbvs * exp(-(model->BSIM4bvs + vbs_jct) / Nvtms);
+                      evbs = DEVexp(ckt, vbs_jct / Nvtms);
+                      T1 = model->BSIM4xjbvs * DEVexp(ckt, -(model->BSIM4bvs + vbs_jct) / Nvtms);
                       /* WDLiu: Magic T1 in this form; different from BSIM4 beta. */
                       here->BSIM4gbs = SourceSatCurrent * (evbs + T1) / Nvtms + ckt->CKTgmin;
                       here->BSIM4cbs = SourceSatCurrent * (evbs + here->BSIM4XExpBVS
@@ -740,7 +765,7 @@ for (; model != NULL; model = BSIM4nextModel(model))
                                          + ckt->CKTgmin * vbs_jct;
                       }
                       else if (vbs_jct <= here->BSIM4vjsmFwd)
-                      {   evbs = exp(T2);
+                      {   evbs = DEVexp(ckt, T2);
                           here->BSIM4gbs = SourceSatCurrent * evbs / Nvtms + ckt->CKTgmin;
                           here->BSIM4cbs = SourceSatCurrent * (evbs - 1.0)
                                          + ckt->CKTgmin * vbs_jct;
@@ -760,7 +785,7 @@ for (; model != NULL; model = BSIM4nextModel(model))
                                devbs_dvb = 0.0;
                           }
                           else
-                          {    evbs = exp(T0);
+                          {    evbs = DEVexp(ckt, T0);
                                devbs_dvb = evbs / Nvtms;
                           }
 
@@ -777,7 +802,7 @@ for (; model != NULL; model = BSIM4nextModel(model))
                                devbs_dvb = 0.0;
                           }
                           else
-                          {    evbs = exp(T0);
+                          {    evbs = DEVexp(ckt, T0);
                                devbs_dvb = evbs / Nvtms;
                           }
 
@@ -787,7 +812,7 @@ for (; model != NULL; model = BSIM4nextModel(model))
                               T3 = 0.0;
                           }
                           else
-                          {   T2 = exp(-T1);
+                          {   T2 = DEVexp(ckt, -T1);
                               T3 = -T2 /Nvtms;
                           }
                           here->BSIM4gbs = SourceSatCurrent * (devbs_dvb - model->BSIM4xjbvs * T3)
@@ -826,8 +851,8 @@ for (; model != NULL; model = BSIM4nextModel(model))
           else
           {   switch(model->BSIM4dioMod)
               {   case 0:
-                      evbd = exp(vbd_jct / Nvtmd);
-                      T1 = model->BSIM4xjbvd * exp(-(model->BSIM4bvd + vbd_jct) / Nvtmd);
+                      evbd = DEVexp(ckt, vbd_jct / Nvtmd);
+                      T1 = model->BSIM4xjbvd * DEVexp(ckt, -(model->BSIM4bvd + vbd_jct) / Nvtmd);
                       /* WDLiu: Magic T1 in this form; different from BSIM4 beta. */
                       here->BSIM4gbd = DrainSatCurrent * (evbd + T1) / Nvtmd + ckt->CKTgmin;
                       here->BSIM4cbd = DrainSatCurrent * (evbd + here->BSIM4XExpBVD
@@ -841,7 +866,7 @@ for (; model != NULL; model = BSIM4nextModel(model))
                                          + ckt->CKTgmin * vbd_jct;
                       }
                       else if (vbd_jct <= here->BSIM4vjdmFwd)
-                      {   evbd = exp(T2);
+                      {   evbd = DEVexp(ckt, T2);
                           here->BSIM4gbd = DrainSatCurrent * evbd / Nvtmd + ckt->CKTgmin;
                           here->BSIM4cbd = DrainSatCurrent * (evbd - 1.0)
                                          + ckt->CKTgmin * vbd_jct;
@@ -861,7 +886,7 @@ for (; model != NULL; model = BSIM4nextModel(model))
                                devbd_dvb = 0.0;
                           }
                           else
-                          {    evbd = exp(T0);
+                          {    evbd = DEVexp(ckt, T0);
                                devbd_dvb = evbd / Nvtmd;
                           }
 
@@ -878,7 +903,7 @@ for (; model != NULL; model = BSIM4nextModel(model))
                                devbd_dvb = 0.0;
                           }
                           else
-                          {    evbd = exp(T0);
+                          {    evbd = DEVexp(ckt, T0);
                                devbd_dvb = evbd / Nvtmd;
                           }
 
@@ -888,7 +913,7 @@ for (; model != NULL; model = BSIM4nextModel(model))
                               T3 = 0.0;
                           }
                           else
-                          {   T2 = exp(-T1);
+                          {   T2 = DEVexp(ckt, -T1);
                               T3 = -T2 /Nvtmd;
                           }     
                           here->BSIM4gbd = DrainSatCurrent * (devbd_dvb - model->BSIM4xjbvd * T3)
@@ -1102,7 +1127,7 @@ for (; model != NULL; model = BSIM4nextModel(model))
 
           T0 = pParam->BSIM4dvt1 * Leff / lt1;
           if (T0 < EXP_THRESHOLD)
-          {   T1 = exp(T0);
+          {   T1 = DEVexp(ckt, T0);
               T2 = T1 - 1.0;
               T3 = T2 * T2;
               T4 = T3 + 2.0 * T1 * MIN_EXP;
@@ -1120,7 +1145,7 @@ for (; model != NULL; model = BSIM4nextModel(model))
 
           T0 = pParam->BSIM4dvt1w * pParam->BSIM4weff * Leff / ltw;
           if (T0 < EXP_THRESHOLD)
-          {   T1 = exp(T0);
+          {   T1 = DEVexp(ckt, T0);
               T2 = T1 - 1.0;
               T3 = T2 * T2;
               T4 = T3 + 2.0 * T1 * MIN_EXP;
@@ -1202,7 +1227,7 @@ for (; model != NULL; model = BSIM4nextModel(model))
                   dT2_dVd = 0.0;
               }
               else
-              {   T2 = exp(T0);
+              {   T2 = DEVexp(ckt, T0);
                   dT2_dVd = -pParam->BSIM4dvtp1 * T2;
               }
 
@@ -1210,12 +1235,12 @@ for (; model != NULL; model = BSIM4nextModel(model))
               dT3_dVd = pParam->BSIM4dvtp0 * dT2_dVd;
               if (model->BSIM4tempMod < 2)
               {
-                T4 = Vtm * log(Leff / T3);
+                T4 = Vtm * DEVlog(ckt, Leff / T3);
                 dT4_dVd = -Vtm * dT3_dVd / T3;
               }
               else
               {
-                T4 = model->BSIM4vtm0 * log(Leff / T3);
+                T4 = model->BSIM4vtm0 * DEVlog(ckt, Leff / T3);
                 dT4_dVd = -model->BSIM4vtm0 * dT3_dVd / T3;
               }
               dDITS_Sft_dVd = dn_dVd * T4 + n * dT4_dVd;
@@ -1286,15 +1311,15 @@ for (; model != NULL; model = BSIM4nextModel(model))
               dT10_dVb = -dVth_dVb * pParam->BSIM4mstar;
           }
           else if (T2 < -EXP_THRESHOLD)
-          {   T10 = Vtm * log(1.0 + MIN_EXP);
+          {   T10 = Vtm * DEVlog(ckt, 1.0 + MIN_EXP);
               dT10_dVg = 0.0;
               dT10_dVd = T10 * dn_dVd;
               dT10_dVb = T10 * dn_dVb;
               T10 *= n;
           }
           else
-          {   ExpVgst = exp(T2);
-              T3 = Vtm * log(1.0 + ExpVgst);
+          {   ExpVgst = DEVexp(ckt, T2);
+              T3 = Vtm * DEVlog(ckt, 1.0 + ExpVgst);
               T10 = n * T3;
               dT10_dVg = pParam->BSIM4mstar * ExpVgst / (1.0 + ExpVgst);
               dT10_dVb = T3 * dn_dVb - dT10_dVg * (dVth_dVb + Vgst * dn_dVb / n);
@@ -1319,7 +1344,7 @@ for (; model != NULL; model = BSIM4nextModel(model))
               dT9_dVb = dn_dVb * T3;
           }
           else
-          {   ExpVgst = exp(T2);
+          {   ExpVgst = DEVexp(ckt, T2);
               T3 = model->BSIM4coxe / pParam->BSIM4cdep0;
               T4 = T3 * ExpVgst;
               T5 = T1 * T4 / T0;
@@ -1476,7 +1501,7 @@ for (; model != NULL; model = BSIM4nextModel(model))
           }
           else if (model->BSIM4mobMod == 2)
           {   T0 = (Vgsteff + here->BSIM4vtfbphi1) / toxe;
-              T1 = exp(pParam->BSIM4eu * log(T0));
+              T1 = DEVexp(ckt, pParam->BSIM4eu * DEVlog(ckt, T0));
               dT1_dVg = T1 * pParam->BSIM4eu / T0 / toxe;
               T2 = pParam->BSIM4ua + pParam->BSIM4uc * Vbseff;
 
@@ -1531,7 +1556,7 @@ for (; model != NULL; model = BSIM4nextModel(model))
           }
           else if (model->BSIM4mobMod == 6) /* Synopsys 08/30/2013 modify */
           {   T0 = (Vgsteff + here->BSIM4vtfbphi1) / toxe;
-              T1 = exp(pParam->BSIM4eu * log(T0));
+              T1 = DEVexp(ckt, pParam->BSIM4eu * DEVlog(ckt, T0));
               dT1_dVg = T1 * pParam->BSIM4eu / T0 / toxe;
               T2 = pParam->BSIM4ua + pParam->BSIM4uc * Vbseff;
 
@@ -1554,14 +1579,14 @@ for (; model != NULL; model = BSIM4nextModel(model))
                              
                    /*univsersal mobility*/
                  T0 = (Vgsteff + here->BSIM4vtfbphi1)* 1.0e-8 / toxe/6.0;
-             T1 = exp(pParam->BSIM4eu * log(T0)); 
+             T1 = DEVexp(ckt, pParam->BSIM4eu * DEVlog(ckt, T0)); 
                  dT1_dVg = T1 * pParam->BSIM4eu * 1.0e-8/ T0 / toxe/6.0;
              T2 = pParam->BSIM4ua + pParam->BSIM4uc * Vbseff;
                  
                   /*Coulombic*/
                  VgsteffVth = pParam->BSIM4VgsteffVth;
                  
-                 T10 = exp(pParam->BSIM4ucs * log(0.5 + 0.5 * Vgsteff/VgsteffVth));
+                 T10 = DEVexp(ckt, pParam->BSIM4ucs * DEVlog(ckt, 0.5 + 0.5 * Vgsteff/VgsteffVth));
                           T11 =  pParam->BSIM4ud/T10;
                  dT11_dVg = - 0.5 * pParam->BSIM4ucs * T11 /(0.5 + 0.5*Vgsteff/VgsteffVth)/VgsteffVth;
                  
@@ -1812,7 +1837,7 @@ for (; model != NULL; model = BSIM4nextModel(model))
           dT0_dVg = 1.0 / tmp2;
           T0 = (Vgsteff + tmp1) * dT0_dVg;
 
-          tmp3 = exp(model->BSIM4bdos * 0.7 * log(T0));
+          tmp3 = DEVexp(ckt, model->BSIM4bdos * 0.7 * DEVlog(ckt, T0));
           T1 = 1.0 + tmp3;
           T2 = model->BSIM4bdos * 0.7 * tmp3 / T0;
           Tcen = model->BSIM4ados * 1.9e-9 / T1;
@@ -1991,7 +2016,7 @@ for (; model != NULL; model = BSIM4nextModel(model))
               dT1_dVd = 0;
           }
           else
-          {   T1 = exp(T0);
+          {   T1 = DEVexp(ckt, T0);
               dT1_dVd = T1 * pParam->BSIM4pditsd;
           }
 
@@ -2012,7 +2037,7 @@ for (; model != NULL; model = BSIM4nextModel(model))
           {   if (diffVds > pParam->BSIM4pscbe1 * pParam->BSIM4litl
                   / EXP_THRESHOLD)
               {   T0 =  pParam->BSIM4pscbe1 * pParam->BSIM4litl / diffVds;
-                  VASCBE = Leff * exp(T0) / pParam->BSIM4pscbe2;
+                  VASCBE = Leff * DEVexp(ckt, T0) / pParam->BSIM4pscbe2;
                   T1 = T0 * VASCBE / diffVds;
                   dVASCBE_dVg = T1 * dVdseff_dVg;
                   dVASCBE_dVd = -T1 * (1.0 - dVdseff_dVd);
@@ -2047,7 +2072,7 @@ for (; model != NULL; model = BSIM4nextModel(model))
           Idsa *= T0;
 
           /* Add CLM to Ids */
-          T0 = log(Va / Vasat);
+          T0 = DEVlog(ckt, Va / Vasat);
           dT0_dVg = dVa_dVg / Va - dVasat_dVg / Vasat;
           dT0_dVb = dVa_dVb / Va - dVasat_dVb / Vasat;
           dT0_dVd = dVa_dVd / Va - dVasat_dVd / Vasat;
@@ -2071,7 +2096,7 @@ for (; model != NULL; model = BSIM4nextModel(model))
           {   T2 = tmp / Leff;
               if (diffVds > pParam->BSIM4beta0 / EXP_THRESHOLD)
               {   T0 = -pParam->BSIM4beta0 / diffVds;
-                  T1 = T2 * diffVds * exp(T0);
+                  T1 = T2 * diffVds * DEVexp(ckt, T0);
                   T3 = T1 / diffVds * (T0 - 1.0);
                   dT1_dVg = T3 * dVdseff_dVg;
                   dT1_dVd = T3 * (dVdseff_dVd - 1.0);
@@ -2140,9 +2165,9 @@ for (; model != NULL; model = BSIM4nextModel(model))
           T0 = 2 * MM;
           T1 = vs / (pParam->BSIM4vtl * pParam->BSIM4tfactor);
           if(T1 > 0.0)  
-          {        T2 = 1.0 + exp(T0 * log(T1));
+          {        T2 = 1.0 + DEVexp(ckt, T0 * DEVlog(ckt, T1));
                   T3 = (T2 - 1.0) * T0 / vs; 
-                  Fsevl = 1.0 / exp(log(T2)/ T0);
+                  Fsevl = 1.0 / DEVexp(ckt, DEVlog(ckt, T2)/ T0);
                   dT2_dVg = T3 * dvs_dVg;
                   dT2_dVd = T3 * dvs_dVd;
                   dT2_dVb = T3 * dvs_dVb;
@@ -2318,7 +2343,7 @@ for (; model != NULL; model = BSIM4nextModel(model))
               dT1_dVg = -dvgs_eff_dvg * dT1_dVd;
               T2 = pParam->BSIM4bgidl / T1;
               if (T2 < 100.0)
-              {   Igidl = pParam->BSIM4agidl * pParam->BSIM4weffCJ * T1 * exp(-T2);
+              {   Igidl = pParam->BSIM4agidl * pParam->BSIM4weffCJ * T1 * DEVexp(ckt, -T2);
                   T3 = Igidl * (1.0 + T2) / T1;
                   Ggidld = T3 * dT1_dVd;
                   Ggidlg = T3 * dT1_dVg;
@@ -2359,7 +2384,7 @@ for (; model != NULL; model = BSIM4nextModel(model))
               dT1_dVg = -dvgd_eff_dvg * dT1_dVd;
               T2 = pParam->BSIM4bgisl / T1;
               if (T2 < 100.0) 
-              {   Igisl = pParam->BSIM4agisl * pParam->BSIM4weffCJ * T1 * exp(-T2);
+              {   Igisl = pParam->BSIM4agisl * pParam->BSIM4weffCJ * T1 * DEVexp(ckt, -T2);
                   T3 = Igisl * (1.0 + T2) / T1;
                   Ggisls = T3 * dT1_dVd;
                   Ggislg = T3 * dT1_dVg;
@@ -2406,7 +2431,7 @@ for (; model != NULL; model = BSIM4nextModel(model))
                         T2 = pParam->BSIM4bgisl / T1;
                         if (T2 < EXPL_THRESHOLD)
                         {
-                            Igisl = pParam->BSIM4weffCJ * pParam->BSIM4agisl * T1 * exp(-T2);
+                            Igisl = pParam->BSIM4weffCJ * pParam->BSIM4agisl * T1 * DEVexp(ckt, -T2);
                             T3 = Igisl / T1 * (T2 + 1);
                             Ggisls = T3 * dT1_dVd;
                             Ggislg = T3 * dT1_dVg;
@@ -2429,7 +2454,7 @@ for (; model != NULL; model = BSIM4nextModel(model))
                         else
                             T5 = pParam->BSIM4kgisl / T4;
                         if (T5<EXPL_THRESHOLD)
-                        {T6 = exp(T5);
+                        {T6 = DEVexp(ckt, T5);
                             Ggislb = -Igisl * T6 * T5 / T4;
                         }
                         else
@@ -2466,7 +2491,7 @@ for (; model != NULL; model = BSIM4nextModel(model))
                         T2 = pParam->BSIM4bgidl / T1;
                         if (T2 < EXPL_THRESHOLD)
                         {
-                            Igidl = pParam->BSIM4weffCJ * pParam->BSIM4agidl * T1 * exp(-T2);
+                            Igidl = pParam->BSIM4weffCJ * pParam->BSIM4agidl * T1 * DEVexp(ckt, -T2);
                             T3 = Igidl / T1 * (T2 + 1);
                             Ggidld = T3 * dT1_dVd;
                             Ggidlg = T3 * dT1_dVg;
@@ -2487,7 +2512,7 @@ for (; model != NULL; model = BSIM4nextModel(model))
                         else
                             T5 = pParam->BSIM4kgidl / T4;
                         if (T5<EXPL_THRESHOLD)
-                        {T6 = exp(T5);
+                        {T6 = DEVexp(ckt, T5);
                             Ggidlb = -Igidl * T6 * T5 / T4;
                         }
                         else
@@ -2579,12 +2604,12 @@ for (; model != NULL; model = BSIM4nextModel(model))
                 }
               } 
               if (VxNVt < -EXP_THRESHOLD)
-              {   Vaux = T0 * log(1.0 + MIN_EXP);
+              {   Vaux = T0 * DEVlog(ckt, 1.0 + MIN_EXP);
                   dVaux_dVg = dVaux_dVd = dVaux_dVb = 0.0;
               }
               else if ((VxNVt >= -EXP_THRESHOLD) && (VxNVt <= EXP_THRESHOLD))
-              {   ExpVxNVt = exp(VxNVt);
-                  Vaux = T0 * log(1.0 + ExpVxNVt);
+              {   ExpVxNVt = DEVexp(ckt, VxNVt);
+                  Vaux = T0 * DEVlog(ckt, 1.0 + ExpVxNVt);
                   dVaux_dVg = ExpVxNVt / (1.0 + ExpVxNVt);
                   if(model->BSIM4igcMod == 1) {
                         dVaux_dVd = 0.0;
@@ -2618,7 +2643,7 @@ for (; model != NULL; model = BSIM4nextModel(model))
                   dT6_dVg = dT6_dVd = dT6_dVb = 0.0;
               }
               else
-              {   T6 = exp(T5);
+              {   T6 = DEVexp(ckt, T5);
                   dT6_dVg = T6 * T12 * (T3 - 2.0 * T4 * Voxdepinv);
                   dT6_dVd = dT6_dVg * dVoxdepinv_dVd;
                   dT6_dVb = dT6_dVg * dVoxdepinv_dVb;
@@ -2668,7 +2693,7 @@ for (; model != NULL; model = BSIM4nextModel(model))
                   dT9_dVg = dT9_dVd = dT9_dVb = 0.0;
               }
               else
-              {   T9 = exp(T7);
+              {   T9 = DEVexp(ckt, T7);
                   dT9_dVg = T9 * dT7_dVg;
                   dT9_dVd = T9 * dT7_dVd;
                   dT9_dVb = T9 * dT7_dVb;
@@ -2730,7 +2755,7 @@ for (; model != NULL; model = BSIM4nextModel(model))
                   dT6_dVg = 0.0;
               }
               else
-              {   T6 = exp(T5);
+              {   T6 = DEVexp(ckt, T5);
                   dT6_dVg = T6 * T12 * (T3 - 2.0 * T4 * vgs_eff)
                           * dvgs_eff_dvg;
               }
@@ -2760,7 +2785,7 @@ for (; model != NULL; model = BSIM4nextModel(model))
                   dT6_dVg = 0.0;
               }
               else
-              {   T6 = exp(T5);
+              {   T6 = DEVexp(ckt, T5);
                   dT6_dVg = T6 * T12 * (T3 - 2.0 * T4 * vgd_eff)
                           * dvgd_eff_dvg;
               }
@@ -2794,12 +2819,12 @@ for (; model != NULL; model = BSIM4nextModel(model))
                   dVaux_dVb = 1.0;
               }
               else if (VxNVt < -EXP_THRESHOLD)
-              {   Vaux = T0 * log(1.0 + MIN_EXP);
+              {   Vaux = T0 * DEVlog(ckt, 1.0 + MIN_EXP);
                   dVaux_dVg = dVaux_dVb = 0.0;
               }
               else
-              {   ExpVxNVt = exp(VxNVt);
-                  Vaux = T0 * log(1.0 + ExpVxNVt);
+              {   ExpVxNVt = DEVexp(ckt, VxNVt);
+                  Vaux = T0 * DEVlog(ckt, 1.0 + ExpVxNVt);
                   dVaux_dVb = ExpVxNVt / (1.0 + ExpVxNVt); 
                   dVaux_dVg = -dVaux_dVb * dVgs_eff_dVg;
               }
@@ -2826,7 +2851,7 @@ for (; model != NULL; model = BSIM4nextModel(model))
                   dT6_dVg = dT6_dVb = 0.0;
               }
               else
-              {   T6 = exp(T5);
+              {   T6 = DEVexp(ckt, T5);
                   dT6_dVg = T6 * T12 * (T3 - 2.0 * T4 * Voxacc);
                   dT6_dVb = dT6_dVg * dVoxacc_dVb;
                   dT6_dVg *= dVoxacc_dVg;
@@ -2847,12 +2872,12 @@ for (; model != NULL; model = BSIM4nextModel(model))
                   dVaux_dVb = dVoxdepinv_dVb;
               }
               else if (VxNVt < -EXP_THRESHOLD)
-              {   Vaux = T0 * log(1.0 + MIN_EXP);
+              {   Vaux = T0 * DEVlog(ckt, 1.0 + MIN_EXP);
                   dVaux_dVg = dVaux_dVd = dVaux_dVb = 0.0;
               }
               else
-              {   ExpVxNVt = exp(VxNVt);
-                  Vaux = T0 * log(1.0 + ExpVxNVt);
+              {   ExpVxNVt = DEVexp(ckt, VxNVt);
+                  Vaux = T0 * DEVlog(ckt, 1.0 + ExpVxNVt);
                   dVaux_dVg = ExpVxNVt / (1.0 + ExpVxNVt);
                   dVaux_dVd = dVaux_dVg * dVoxdepinv_dVd;
                   dVaux_dVb = dVaux_dVg * dVoxdepinv_dVb;
@@ -2881,7 +2906,7 @@ for (; model != NULL; model = BSIM4nextModel(model))
                   dT6_dVg = dT6_dVd = dT6_dVb = 0.0;
               }
               else
-              {   T6 = exp(T5);
+              {   T6 = DEVexp(ckt, T5);
                   dT6_dVg = T6 * T12 * (T3 - 2.0 * T4 * Voxdepinv);
                   dT6_dVd = dT6_dVg * dVoxdepinv_dVd;
                   dT6_dVb = dT6_dVg * dVoxdepinv_dVb;
@@ -3351,7 +3376,7 @@ for (; model != NULL; model = BSIM4nextModel(model))
                     }
                   else if (VgstNVt < -EXP_THRESHOLD)
                     {   
-                      Vgsteff = T0 * log(1.0 + MIN_EXP);
+                      Vgsteff = T0 * DEVlog(ckt, 1.0 + MIN_EXP);
                       dVgsteff_dVg = 0.0;
                       dVgsteff_dVd = Vgsteff / noff;
                       dVgsteff_dVb = dVgsteff_dVd * dnoff_dVb;
@@ -3359,8 +3384,8 @@ for (; model != NULL; model = BSIM4nextModel(model))
                     }
                   else
                     {   
-                      ExpVgst = exp(VgstNVt);
-                      Vgsteff = T0 * log(1.0 + ExpVgst);
+                      ExpVgst = DEVexp(ckt, VgstNVt);
+                      Vgsteff = T0 * DEVlog(ckt, 1.0 + ExpVgst);
                       dVgsteff_dVg = ExpVgst / (1.0 + ExpVgst);
                       dVgsteff_dVd = -dVgsteff_dVg * (dVth_dVd + (Vgst - voffcv)
                                    / noff * dnoff_dVd) + Vgsteff / noff * dnoff_dVd;
@@ -3384,7 +3409,7 @@ for (; model != NULL; model = BSIM4nextModel(model))
                     }
                   else if (T2 < -EXP_THRESHOLD)
                     {   
-                      T10 = Vtm * log(1.0 + MIN_EXP);
+                      T10 = Vtm * DEVlog(ckt, 1.0 + MIN_EXP);
                       dT10_dVg = 0.0;
                       dT10_dVd = T10 * dn_dVd;
                       dT10_dVb = T10 * dn_dVb;
@@ -3392,8 +3417,8 @@ for (; model != NULL; model = BSIM4nextModel(model))
                     }
                   else
                     {   
-                      ExpVgst = exp(T2);
-                      T3 = Vtm * log(1.0 + ExpVgst);
+                      ExpVgst = DEVexp(ckt, T2);
+                      T3 = Vtm * DEVlog(ckt, 1.0 + ExpVgst);
                       T10 = n * T3;
                       dT10_dVg = pParam->BSIM4mstarcv * ExpVgst / (1.0 + ExpVgst);
                       dT10_dVb = T3 * dn_dVb - dT10_dVg * (dVth_dVb + Vgst * dn_dVb / n);
@@ -3421,7 +3446,7 @@ for (; model != NULL; model = BSIM4nextModel(model))
                     }
                   else
                     {   
-                      ExpVgst = exp(T2);
+                      ExpVgst = DEVexp(ckt, T2);
                       T3 = model->BSIM4coxe / pParam->BSIM4cdep0;
                       T4 = T3 * ExpVgst;
                       T5 = T1 * T4 / T0;
@@ -3633,7 +3658,7 @@ for (; model != NULL; model = BSIM4nextModel(model))
 
                   tmp = T0 * pParam->BSIM4acde;
                   if ((-EXP_THRESHOLD < tmp) && (tmp < EXP_THRESHOLD))
-                  {   Tcen = pParam->BSIM4ldeb * exp(tmp);
+                  {   Tcen = pParam->BSIM4ldeb * DEVexp(ckt, tmp);
                       dTcen_dVg = pParam->BSIM4acde * Tcen;
                       dTcen_dVb = dTcen_dVg * dT0_dVb;
                       dTcen_dVg *= dT0_dVg;
@@ -3706,7 +3731,7 @@ for (; model != NULL; model = BSIM4nextModel(model))
                   }
                   T1 = 2.0 * T0 + Vgsteff;
 
-                  DeltaPhi = Vtm * log(1.0 + T1 * Vgsteff / Denomi);
+                  DeltaPhi = Vtm * DEVlog(ckt, 1.0 + T1 * Vgsteff / Denomi);
                   dDeltaPhi_dVg = 2.0 * Vtm * (T1 -T0) / (Denomi + T1 * Vgsteff);
                   /* End of delta Phis */
 
@@ -3719,7 +3744,7 @@ for (; model != NULL; model = BSIM4nextModel(model))
                   
                   Tox += Tox; /* WDLiu: Tcen reevaluated below due to different Vgsteff */
                   T0 = (Vgsteff + here->BSIM4vtfbphi2) / Tox;
-                  tmp = exp(model->BSIM4bdos * 0.7 * log(T0));
+                  tmp = DEVexp(ckt, model->BSIM4bdos * 0.7 * DEVlog(ckt, T0));
                   T1 = 1.0 + tmp;
                   T2 = model->BSIM4bdos * 0.7 * tmp / (T0 * Tox);
                   Tcen = model->BSIM4ados * 1.9e-9 / T1;
@@ -3957,7 +3982,7 @@ finished:
                       if (MJS == 0.5)
                           sarg = 1.0 / sqrt(arg);
                       else
-                          sarg = exp(-MJS * log(arg));
+                          sarg = DEVexp(ckt, -MJS * DEVlog(ckt, arg));
                       *(ckt->CKTstate0 + here->BSIM4qbs) = model->BSIM4PhiBS * czbs 
                                        * (1.0 - arg * sarg) / (1.0 - MJS);
                       here->BSIM4capbs = czbs * sarg;
@@ -3971,7 +3996,7 @@ finished:
                       if (MJSWS == 0.5)
                           sarg = 1.0 / sqrt(arg);
                       else
-                          sarg = exp(-MJSWS * log(arg));
+                          sarg = DEVexp(ckt, -MJSWS * DEVlog(ckt, arg));
                       *(ckt->CKTstate0 + here->BSIM4qbs) += model->BSIM4PhiBSWS * czbssw
                                        * (1.0 - arg * sarg) / (1.0 - MJSWS);
                       here->BSIM4capbs += czbssw * sarg;
@@ -3981,7 +4006,7 @@ finished:
                       if (MJSWGS == 0.5)
                           sarg = 1.0 / sqrt(arg);
                       else
-                          sarg = exp(-MJSWGS * log(arg));
+                          sarg = DEVexp(ckt, -MJSWGS * DEVlog(ckt, arg));
                       *(ckt->CKTstate0 + here->BSIM4qbs) += model->BSIM4PhiBSWGS * czbsswg
                                        * (1.0 - arg * sarg) / (1.0 - MJSWGS);
                       here->BSIM4capbs += czbsswg * sarg;
@@ -4007,7 +4032,7 @@ finished:
                       if (MJD == 0.5)
                           sarg = 1.0 / sqrt(arg);
                       else
-                          sarg = exp(-MJD * log(arg));
+                          sarg = DEVexp(ckt, -MJD * DEVlog(ckt, arg));
                       *(ckt->CKTstate0 + here->BSIM4qbd) = model->BSIM4PhiBD* czbd 
                                        * (1.0 - arg * sarg) / (1.0 - MJD);
                       here->BSIM4capbd = czbd * sarg;
@@ -4021,7 +4046,7 @@ finished:
                       if (MJSWD == 0.5)
                           sarg = 1.0 / sqrt(arg);
                       else
-                          sarg = exp(-MJSWD * log(arg));
+                          sarg = DEVexp(ckt, -MJSWD * DEVlog(ckt, arg));
                       *(ckt->CKTstate0 + here->BSIM4qbd) += model->BSIM4PhiBSWD * czbdsw 
                                        * (1.0 - arg * sarg) / (1.0 - MJSWD);
                       here->BSIM4capbd += czbdsw * sarg;
@@ -4031,7 +4056,7 @@ finished:
                       if (MJSWGD == 0.5)
                           sarg = 1.0 / sqrt(arg);
                       else
-                          sarg = exp(-MJSWGD * log(arg));
+                          sarg = DEVexp(ckt, -MJSWGD * DEVlog(ckt, arg));
                       *(ckt->CKTstate0 + here->BSIM4qbd) += model->BSIM4PhiBSWGD * czbdswg
                                        * (1.0 - arg * sarg) / (1.0 - MJSWGD);
                       here->BSIM4capbd += czbdswg * sarg;
@@ -4053,7 +4078,11 @@ finished:
 
           if ((here->BSIM4off == 0) || (!(ckt->CKTmode & MODEINITFIX)))
           {   if (Check == 1)
-              {   ckt->CKTnoncon++;
+              {
+#ifdef USE_OMP
+#pragma omp atomic
+#endif
+                  ckt->CKTnoncon++;
 #ifndef NEWCONV
               } 
               else
@@ -4078,11 +4107,19 @@ finished:
                        + ckt->CKTabstol;
                   if ((fabs(cdhat - Idtot) >= tol0) || (fabs(cseshat - Isestot) >= tol1)
                       || (fabs(cdedhat - Idedtot) >= tol2))
-                  {   ckt->CKTnoncon++;
+                  {
+#ifdef USE_OMP
+#pragma omp atomic
+#endif
+                      ckt->CKTnoncon++;
                   }
                   else if ((fabs(cgshat - Igstot) >= tol3) || (fabs(cgdhat - Igdtot) >= tol4)
                       || (fabs(cgbhat - Igbtot) >= tol5))
-                  {   ckt->CKTnoncon++;
+                  {
+#ifdef USE_OMP
+#pragma omp atomic
+#endif
+                      ckt->CKTnoncon++;
                   }
                   else
                   {   Ibtot = here->BSIM4cbs + here->BSIM4cbd
@@ -4090,7 +4127,11 @@ finished:
                       tol6 = ckt->CKTreltol * MAX(fabs(cbhat), fabs(Ibtot))
                           + ckt->CKTabstol;
                       if (fabs(cbhat - Ibtot) > tol6)
-                      {   ckt->CKTnoncon++;
+                      {
+#ifdef USE_OMP
+#pragma omp atomic
+#endif
+                          ckt->CKTnoncon++;
                       }
                   }
 #endif /* NEWCONV */
@@ -5426,7 +5467,7 @@ void BSIM4LoadRhsMat(GENmodel *inModel, CKTcircuit *ckt)
 {
     int InstCount, idx;
     BSIM4instance **InstArray;
-    BSIM4instance *here;
+    BSIM4instance *here, *res;
     BSIM4model *model = (BSIM4model*)inModel;
 
     InstArray = model->BSIM4InstanceArray;
@@ -5435,178 +5476,270 @@ void BSIM4LoadRhsMat(GENmodel *inModel, CKTcircuit *ckt)
     for(idx = 0; idx < InstCount; idx++) {
        here = InstArray[idx];
        model = BSIM4modPtr(here);
+       /* an instance memoized by biasmemo loads the results of its leader */
+       res = (ckt->CKTbiasMemo && here->BSIM4memoLeader) ? here->BSIM4memoLeader : here;
         /* Update b for Ax = b */
-           (*(ckt->CKTrhs + here->BSIM4dNodePrime) += here->BSIM4rhsdPrime);
-           (*(ckt->CKTrhs + here->BSIM4gNodePrime) -= here->BSIM4rhsgPrime);
+           (*(ckt->CKTrhs + here->BSIM4dNodePrime) += res->BSIM4rhsdPrime);
+           (*(ckt->CKTrhs + here->BSIM4gNodePrime) -= res->BSIM4rhsgPrime);
 
            if (here->BSIM4rgateMod == 2)
-               (*(ckt->CKTrhs + here->BSIM4gNodeExt) -= here->BSIM4rhsgExt);
+               (*(ckt->CKTrhs + here->BSIM4gNodeExt) -= res->BSIM4rhsgExt);
            else if (here->BSIM4rgateMod == 3)
-               (*(ckt->CKTrhs + here->BSIM4gNodeMid) -= here->BSIM4grhsMid);
+               (*(ckt->CKTrhs + here->BSIM4gNodeMid) -= res->BSIM4grhsMid);
 
            if (!here->BSIM4rbodyMod)
-           {   (*(ckt->CKTrhs + here->BSIM4bNodePrime) += here->BSIM4rhsbPrime);
-               (*(ckt->CKTrhs + here->BSIM4sNodePrime) += here->BSIM4rhssPrime);
+           {   (*(ckt->CKTrhs + here->BSIM4bNodePrime) += res->BSIM4rhsbPrime);
+               (*(ckt->CKTrhs + here->BSIM4sNodePrime) += res->BSIM4rhssPrime);
            }
            else
-           {   (*(ckt->CKTrhs + here->BSIM4dbNode) -= here->BSIM4rhsdb);
-               (*(ckt->CKTrhs + here->BSIM4bNodePrime) += here->BSIM4rhsbPrime);
-               (*(ckt->CKTrhs + here->BSIM4sbNode) -= here->BSIM4rhssb);
-               (*(ckt->CKTrhs + here->BSIM4sNodePrime) += here->BSIM4rhssPrime);
+           {   (*(ckt->CKTrhs + here->BSIM4dbNode) -= res->BSIM4rhsdb);
+               (*(ckt->CKTrhs + here->BSIM4bNodePrime) += res->BSIM4rhsbPrime);
+               (*(ckt->CKTrhs + here->BSIM4sbNode) -= res->BSIM4rhssb);
+               (*(ckt->CKTrhs + here->BSIM4sNodePrime) += res->BSIM4rhssPrime);
            }
 
            if (model->BSIM4rdsMod)
-           {   (*(ckt->CKTrhs + here->BSIM4dNode) -= here->BSIM4rhsd); 
-               (*(ckt->CKTrhs + here->BSIM4sNode) += here->BSIM4rhss);
+           {   (*(ckt->CKTrhs + here->BSIM4dNode) -= res->BSIM4rhsd); 
+               (*(ckt->CKTrhs + here->BSIM4sNode) += res->BSIM4rhss);
            }
 
            if (here->BSIM4trnqsMod)
-               *(ckt->CKTrhs + here->BSIM4qNode) += here->BSIM4rhsq;
+               *(ckt->CKTrhs + here->BSIM4qNode) += res->BSIM4rhsq;
 
 
         /* Update A for Ax = b */
            if (here->BSIM4rgateMod == 1)
-           {   (*(here->BSIM4GEgePtr) += here->BSIM4_1);
-               (*(here->BSIM4GPgePtr) -= here->BSIM4_2);
-               (*(here->BSIM4GEgpPtr) -= here->BSIM4_3);
-               (*(here->BSIM4GPgpPtr) += here->BSIM4_4);
-               (*(here->BSIM4GPdpPtr) += here->BSIM4_5);
-               (*(here->BSIM4GPspPtr) += here->BSIM4_6);
-               (*(here->BSIM4GPbpPtr) += here->BSIM4_7);
+           {   (*(here->BSIM4GEgePtr) += res->BSIM4_1);
+               (*(here->BSIM4GPgePtr) -= res->BSIM4_2);
+               (*(here->BSIM4GEgpPtr) -= res->BSIM4_3);
+               (*(here->BSIM4GPgpPtr) += res->BSIM4_4);
+               (*(here->BSIM4GPdpPtr) += res->BSIM4_5);
+               (*(here->BSIM4GPspPtr) += res->BSIM4_6);
+               (*(here->BSIM4GPbpPtr) += res->BSIM4_7);
            }
            else if (here->BSIM4rgateMod == 2)        
-           {   (*(here->BSIM4GEgePtr) += here->BSIM4_8);
-               (*(here->BSIM4GEgpPtr) += here->BSIM4_9);
-               (*(here->BSIM4GEdpPtr) += here->BSIM4_10);
-               (*(here->BSIM4GEspPtr) += here->BSIM4_11);
-               (*(here->BSIM4GEbpPtr) += here->BSIM4_12);        
-
-               (*(here->BSIM4GPgePtr) -= here->BSIM4_13);
-               (*(here->BSIM4GPgpPtr) += here->BSIM4_14);
-               (*(here->BSIM4GPdpPtr) += here->BSIM4_15);
-               (*(here->BSIM4GPspPtr) += here->BSIM4_16);
-               (*(here->BSIM4GPbpPtr) += here->BSIM4_17);
+           {   (*(here->BSIM4GEgePtr) += res->BSIM4_8);
+               (*(here->BSIM4GEgpPtr) += res->BSIM4_9);
+               (*(here->BSIM4GEdpPtr) += res->BSIM4_10);
+               (*(here->BSIM4GEspPtr) += res->BSIM4_11);
+               (*(here->BSIM4GEbpPtr) += res->BSIM4_12);        
+
+               (*(here->BSIM4GPgePtr) -= res->BSIM4_13);
+               (*(here->BSIM4GPgpPtr) += res->BSIM4_14);
+               (*(here->BSIM4GPdpPtr) += res->BSIM4_15);
+               (*(here->BSIM4GPspPtr) += res->BSIM4_16);
+               (*(here->BSIM4GPbpPtr) += res->BSIM4_17);
            }
            else if (here->BSIM4rgateMod == 3)
-           {   (*(here->BSIM4GEgePtr) += here->BSIM4_18);
-               (*(here->BSIM4GEgmPtr) -= here->BSIM4_19);
-               (*(here->BSIM4GMgePtr) -= here->BSIM4_20);
-               (*(here->BSIM4GMgmPtr) += here->BSIM4_21);
-
-               (*(here->BSIM4GMdpPtr) += here->BSIM4_22);
-               (*(here->BSIM4GMgpPtr) += here->BSIM4_23);
-               (*(here->BSIM4GMspPtr) += here->BSIM4_24);
-               (*(here->BSIM4GMbpPtr) += here->BSIM4_25);
-
-               (*(here->BSIM4DPgmPtr) += here->BSIM4_26);
-               (*(here->BSIM4GPgmPtr) -= here->BSIM4_27);
-               (*(here->BSIM4SPgmPtr) += here->BSIM4_28);
-               (*(here->BSIM4BPgmPtr) += here->BSIM4_29);
-
-               (*(here->BSIM4GPgpPtr) += here->BSIM4_30);
-               (*(here->BSIM4GPdpPtr) += here->BSIM4_31);
-               (*(here->BSIM4GPspPtr) += here->BSIM4_32);
-               (*(here->BSIM4GPbpPtr) += here->BSIM4_33);
+           {   (*(here->BSIM4GEgePtr) += res->BSIM4_18);
+               (*(here->BSIM4GEgmPtr) -= res->BSIM4_19);
+               (*(here->BSIM4GMgePtr) -= res->BSIM4_20);
+               (*(here->BSIM4GMgmPtr) += res->BSIM4_21);
+
+               (*(here->BSIM4GMdpPtr) += res->BSIM4_22);
+               (*(here->BSIM4GMgpPtr) += res->BSIM4_23);
+               (*(here->BSIM4GMspPtr) += res->BSIM4_24);
+               (*(here->BSIM4GMbpPtr) += res->BSIM4_25);
+
+               (*(here->BSIM4DPgmPtr) += res->BSIM4_26);
+               (*(here->BSIM4GPgmPtr) -= res->BSIM4_27);
+               (*(here->BSIM4SPgmPtr) += res->BSIM4_28);
+               (*(here->BSIM4BPgmPtr) += res->BSIM4_29);
+
+               (*(here->BSIM4GPgpPtr) += res->BSIM4_30);
+               (*(here->BSIM4GPdpPtr) += res->BSIM4_31);
+               (*(here->BSIM4GPspPtr) += res->BSIM4_32);
+               (*(here->BSIM4GPbpPtr) += res->BSIM4_33);
            }
 
 
             else
-           {   (*(here->BSIM4GPgpPtr) += here->BSIM4_34);
-               (*(here->BSIM4GPdpPtr) += here->BSIM4_35);
-               (*(here->BSIM4GPspPtr) += here->BSIM4_36);
-               (*(here->BSIM4GPbpPtr) += here->BSIM4_37);
+           {   (*(here->BSIM4GPgpPtr) += res->BSIM4_34);
+               (*(here->BSIM4GPdpPtr) += res->BSIM4_35);
+               (*(here->BSIM4GPspPtr) += res->BSIM4_36);
+               (*(here->BSIM4GPbpPtr) += res->BSIM4_37);
            }
 
 
            if (model->BSIM4rdsMod)
-           {   (*(here->BSIM4DgpPtr) += here->BSIM4_38);
-               (*(here->BSIM4DspPtr) += here->BSIM4_39);
-               (*(here->BSIM4DbpPtr) += here->BSIM4_40);
-               (*(here->BSIM4SdpPtr) += here->BSIM4_41);
-               (*(here->BSIM4SgpPtr) += here->BSIM4_42);
-               (*(here->BSIM4SbpPtr) += here->BSIM4_43);
+           {   (*(here->BSIM4DgpPtr) += res->BSIM4_38);
+               (*(here->BSIM4DspPtr) += res->BSIM4_39);
+               (*(here->BSIM4DbpPtr) += res->BSIM4_40);
+               (*(here->BSIM4SdpPtr) += res->BSIM4_41);
+               (*(here->BSIM4SgpPtr) += res->BSIM4_42);
+               (*(here->BSIM4SbpPtr) += res->BSIM4_43);
            }
 
-           (*(here->BSIM4DPdpPtr) += here->BSIM4_44);
-           (*(here->BSIM4DPdPtr) -= here->BSIM4_45);
-           (*(here->BSIM4DPgpPtr) += here->BSIM4_46);
-           (*(here->BSIM4DPspPtr) -= here->BSIM4_47);
-           (*(here->BSIM4DPbpPtr) -= here->BSIM4_48);
+           (*(here->BSIM4DPdpPtr) += res->BSIM4_44);
+           (*(here->BSIM4DPdPtr) -= res->BSIM4_45);
+           (*(here->BSIM4DPgpPtr) += res->BSIM4_46);
+           (*(here->BSIM4DPspPtr) -= res->BSIM4_47);
+           (*(here->BSIM4DPbpPtr) -= res->BSIM4_48);
 
-           (*(here->BSIM4DdpPtr) -= here->BSIM4_49);
-           (*(here->BSIM4DdPtr) += here->BSIM4_50);
+           (*(here->BSIM4DdpPtr) -= res->BSIM4_49);
+           (*(here->BSIM4DdPtr) += res->BSIM4_50);
 
-           (*(here->BSIM4SPdpPtr) -= here->BSIM4_51);
-           (*(here->BSIM4SPgpPtr) += here->BSIM4_52);
-           (*(here->BSIM4SPspPtr) += here->BSIM4_53);
-           (*(here->BSIM4SPsPtr) -= here->BSIM4_54);
-           (*(here->BSIM4SPbpPtr) -= here->BSIM4_55);
+           (*(here->BSIM4SPdpPtr) -= res->BSIM4_51);
+           (*(here->BSIM4SPgpPtr) += res->BSIM4_52);
+           (*(here->BSIM4SPspPtr) += res->BSIM4_53);
+           (*(here->BSIM4SPsPtr) -= res->BSIM4_54);
+           (*(here->BSIM4SPbpPtr) -= res->BSIM4_55);
 
-           (*(here->BSIM4SspPtr) -= here->BSIM4_56);
-           (*(here->BSIM4SsPtr) += here->BSIM4_57);
+           (*(here->BSIM4SspPtr) -= res->BSIM4_56);
+           (*(here->BSIM4SsPtr) += res->BSIM4_57);
 
-           (*(here->BSIM4BPdpPtr) += here->BSIM4_58);
-           (*(here->BSIM4BPgpPtr) += here->BSIM4_59);
-           (*(here->BSIM4BPspPtr) += here->BSIM4_60);
-           (*(here->BSIM4BPbpPtr) += here->BSIM4_61);
+           (*(here->BSIM4BPdpPtr) += res->BSIM4_58);
+           (*(here->BSIM4BPgpPtr) += res->BSIM4_59);
+           (*(here->BSIM4BPspPtr) += res->BSIM4_60);
+           (*(here->BSIM4BPbpPtr) += res->BSIM4_61);
 
            /* stamp gidl */
-           (*(here->BSIM4DPdpPtr) += here->BSIM4_62);
-           (*(here->BSIM4DPgpPtr) += here->BSIM4_63);
-           (*(here->BSIM4DPspPtr) -= here->BSIM4_64);
-           (*(here->BSIM4DPbpPtr) += here->BSIM4_65);
-           (*(here->BSIM4BPdpPtr) -= here->BSIM4_66);
-           (*(here->BSIM4BPgpPtr) -= here->BSIM4_67);
-           (*(here->BSIM4BPspPtr) += here->BSIM4_68);
-           (*(here->BSIM4BPbpPtr) -= here->BSIM4_69);
+           (*(here->BSIM4DPdpPtr) += res->BSIM4_62);
+           (*(here->BSIM4DPgpPtr) += res->BSIM4_63);
+           (*(here->BSIM4DPspPtr) -= res->BSIM4_64);
+           (*(here->BSIM4DPbpPtr) += res->BSIM4_65);
+           (*(here->BSIM4BPdpPtr) -= res->BSIM4_66);
+           (*(here->BSIM4BPgpPtr) -= res->BSIM4_67);
+           (*(here->BSIM4BPspPtr) += res->BSIM4_68);
+           (*(here->BSIM4BPbpPtr) -= res->BSIM4_69);
             /* stamp gisl */
-           (*(here->BSIM4SPdpPtr) -= here->BSIM4_70);
-           (*(here->BSIM4SPgpPtr) += here->BSIM4_71);
-           (*(here->BSIM4SPspPtr) += here->BSIM4_72);
-           (*(here->BSIM4SPbpPtr) += here->BSIM4_73);
-           (*(here->BSIM4BPdpPtr) += here->BSIM4_74);
-           (*(here->BSIM4BPgpPtr) -= here->BSIM4_75);
-           (*(here->BSIM4BPspPtr) -= here->BSIM4_76);
-           (*(here->BSIM4BPbpPtr) -= here->BSIM4_77);
+           (*(here->BSIM4SPdpPtr) -= res->BSIM4_70);
+           (*(here->BSIM4SPgpPtr) += res->BSIM4_71);
+           (*(here->BSIM4SPspPtr) += res->BSIM4_72);
+           (*(here->BSIM4SPbpPtr) += res->BSIM4_73);
+           (*(here->BSIM4BPdpPtr) += res->BSIM4_74);
+           (*(here->BSIM4BPgpPtr) -= res->BSIM4_75);
+           (*(here->BSIM4BPspPtr) -= res->BSIM4_76);
+           (*(here->BSIM4BPbpPtr) -= res->BSIM4_77);
 
 
            if (here->BSIM4rbodyMod)
-           {   (*(here->BSIM4DPdbPtr) += here->BSIM4_78);
-               (*(here->BSIM4SPsbPtr) -= here->BSIM4_79);
-
-               (*(here->BSIM4DBdpPtr) += here->BSIM4_80);
-               (*(here->BSIM4DBdbPtr) += here->BSIM4_81);
-               (*(here->BSIM4DBbpPtr) -= here->BSIM4_82);
-               (*(here->BSIM4DBbPtr) -= here->BSIM4_83);
-
-               (*(here->BSIM4BPdbPtr) -= here->BSIM4_84);
-               (*(here->BSIM4BPbPtr) -= here->BSIM4_85);
-               (*(here->BSIM4BPsbPtr) -= here->BSIM4_86);
-               (*(here->BSIM4BPbpPtr) += here->BSIM4_87);
-
-               (*(here->BSIM4SBspPtr) += here->BSIM4_88);
-               (*(here->BSIM4SBbpPtr) -= here->BSIM4_89);
-               (*(here->BSIM4SBbPtr) -= here->BSIM4_90);
-               (*(here->BSIM4SBsbPtr) += here->BSIM4_91);
-
-               (*(here->BSIM4BdbPtr) -= here->BSIM4_92);
-               (*(here->BSIM4BbpPtr) -= here->BSIM4_93);
-               (*(here->BSIM4BsbPtr) -= here->BSIM4_94);
-               (*(here->BSIM4BbPtr) += here->BSIM4_95);
+           {   (*(here->BSIM4DPdbPtr) += res->BSIM4_78);
+               (*(here->BSIM4SPsbPtr) -= res->BSIM4_79);
+
+               (*(here->BSIM4DBdpPtr) += res->BSIM4_80);
+               (*(here->BSIM4DBdbPtr) += res->BSIM4_81);
+               (*(here->BSIM4DBbpPtr) -= res->BSIM4_82);
+               (*(here->BSIM4DBbPtr) -= res->BSIM4_83);
+
+               (*(here->BSIM4BPdbPtr) -= res->BSIM4_84);
+               (*(here->BSIM4BPbPtr) -= res->BSIM4_85);
+               (*(here->BSIM4BPsbPtr) -= res->BSIM4_86);
+               (*(here->BSIM4BPbpPtr) += res->BSIM4_87);
+
+               (*(here->BSIM4SBspPtr) += res->BSIM4_88);
+               (*(here->BSIM4SBbpPtr) -= res->BSIM4_89);
+               (*(here->BSIM4SBbPtr) -= res->BSIM4_90);
+               (*(here->BSIM4SBsbPtr) += res->BSIM4_91);
+
+               (*(here->BSIM4BdbPtr) -= res->BSIM4_92);
+               (*(here->BSIM4BbpPtr) -= res->BSIM4_93);
+               (*(here->BSIM4BsbPtr) -= res->BSIM4_94);
+               (*(here->BSIM4BbPtr) += res->BSIM4_95);
            }
 
            if (here->BSIM4trnqsMod)
-           {   (*(here->BSIM4QqPtr) += here->BSIM4_96);
-               (*(here->BSIM4QgpPtr) += here->BSIM4_97);
-               (*(here->BSIM4QdpPtr) += here->BSIM4_98);
-               (*(here->BSIM4QspPtr) += here->BSIM4_99);
-               (*(here->BSIM4QbpPtr) += here->BSIM4_100);
-
-               (*(here->BSIM4DPqPtr) += here->BSIM4_101);
-               (*(here->BSIM4SPqPtr) += here->BSIM4_102);
-               (*(here->BSIM4GPqPtr) -= here->BSIM4_103);
+           {   (*(here->BSIM4QqPtr) += res->BSIM4_96);
+               (*(here->BSIM4QgpPtr) += res->BSIM4_97);
+               (*(here->BSIM4QdpPtr) += res->BSIM4_98);
+               (*(here->BSIM4QspPtr) += res->BSIM4_99);
+               (*(here->BSIM4QbpPtr) += res->BSIM4_100);
+
+               (*(here->BSIM4DPqPtr) += res->BSIM4_101);
+               (*(here->BSIM4SPqPtr) += res->BSIM4_102);
+               (*(here->BSIM4GPqPtr) -= res->BSIM4_103);
            }
     }
 }
 
+
+
+/* Bias memoization (option biasmemo).  Instances sharing the model, the
+ * size dependent parameters, the instance parameters, the results of the
+ * previous evaluation, the state history and the terminal voltages give
+ * bitwise identical results.  Only the first of such a group (the leader)
+ * is evaluated.  The others copy its results kept in the instance (from
+ * BSIM4ueff to pParam) and in the states, and BSIM4LoadRhsMat() loads the
+ * matrix and rhs values stored in the leader. */
+
+#define BSIM4memoKeySize(here) DEVmemoSpan(here, BSIM4ueff, pParam)
+
+/* The padding after BSIM4wnflag and BSIM4min has no defined contents, so
+ * the range from BSIM4ueff to pParam is compared in pieces ending at these
+ * int members. */
+static int
+BSIM4memoEqual(BSIM4instance *a, BSIM4instance *b)
+{
+    return !memcmp(&a->BSIM4ueff, &b->BSIM4ueff, DEVmemoSpan(a, BSIM4ueff, BSIM4wnflag)) &&
+           !memcmp(&a->BSIM4xgw, &b->BSIM4xgw, DEVmemoSpan(a, BSIM4xgw, BSIM4min)) &&
+           !memcmp(&a->BSIM4Vgsteff, &b->BSIM4Vgsteff, DEVmemoSpan(a, BSIM4Vgsteff, pParam));
+}
+
+static void
+BSIM4memoFind(BSIM4model *model, CKTcircuit *ckt)
+{
+    BSIM4instance **InstArray = model->BSIM4InstanceArray;
+    BSIM4instance *here, *other;
+    double *rhs = ckt->CKTrhsOld;
+    unsigned int hash;
+    int idx, size;
+
+    for (size = 16; size < 2 * model->BSIM4InstCount; size *= 2)
+        ;
+    if (size != model->BSIM4memoSize) {
+        tfree(model->BSIM4memoTable);
+        model->BSIM4memoTable = TMALLOC(BSIM4instance *, size);
+        model->BSIM4memoSize = size;
+    }
+    memset(model->BSIM4memoTable, 0, (size_t) size * sizeof(BSIM4instance *));
+
+    for (idx = 0; idx < model->BSIM4InstCount; idx++) {
+        here = InstArray[idx];
+        here->BSIM4memoLeader = NULL;
+
+        /* the terminal voltages as read by BSIM4LoadOMP() */
+        here->BSIM4memoV[0] = rhs[here->BSIM4dNodePrime] - rhs[here->BSIM4sNodePrime];
+        here->BSIM4memoV[1] = rhs[here->BSIM4gNodePrime] - rhs[here->BSIM4sNodePrime];
+        here->BSIM4memoV[2] = rhs[here->BSIM4bNodePrime] - rhs[here->BSIM4sNodePrime];
+        here->BSIM4memoV[3] = rhs[here->BSIM4gNodeExt] - rhs[here->BSIM4sNodePrime];
+        here->BSIM4memoV[4] = rhs[here->BSIM4gNodeMid] - rhs[here->BSIM4sNodePrime];
+        here->BSIM4memoV[5] = rhs[here->BSIM4dbNode] - rhs[here->BSIM4sNodePrime];
+        here->BSIM4memoV[6] = rhs[here->BSIM4sbNode] - rhs[here->BSIM4sNodePrime];
+        here->BSIM4memoV[7] = rhs[here->BSIM4sNode] - rhs[here->BSIM4sNodePrime];
+        here->BSIM4memoV[8] = rhs[here->BSIM4dNode] - rhs[here->BSIM4sNodePrime];
+        here->BSIM4memoV[9] = rhs[here->BSIM4qNode];
+
+        hash = DEVmemoHash(here->BSIM4memoV, 10, 2166136261u);
+        hash = DEVmemoHash(ckt->CKTstate0 + here->BSIM4states, BSIM4numStates, hash);
+        here->BSIM4memoHash = hash;
+
+        for (other = model->BSIM4memoTable[hash & (unsigned int) (size - 1)];
+             other; other = other->BSIM4memoNext)
+            if (other->BSIM4memoHash == hash &&
+                BSIM4modPtr(other) == BSIM4modPtr(here) &&
+                !memcmp(other->BSIM4memoV, here->BSIM4memoV, sizeof(here->BSIM4memoV)) &&
+                BSIM4memoEqual(other, here) &&
+                DEVmemoStatesEqual(ckt, other->BSIM4states, here->BSIM4states,
+                                   BSIM4numStates))
+                break;
+
+        ckt->CKTstat->STATmemoLookups++;
+        if (other) {
+            here->BSIM4memoLeader = other;
+            ckt->CKTstat->STATmemoHits++;
+        } else {
+            here->BSIM4memoNext = model->BSIM4memoTable[hash & (unsigned int) (size - 1)];
+            model->BSIM4memoTable[hash & (unsigned int) (size - 1)] = here;
+        }
+    }
+}
+
+
+static void
+BSIM4memoCopy(BSIM4instance *here, BSIM4instance *leader, CKTcircuit *ckt)
+{
+    memcpy(&here->BSIM4ueff, &leader->BSIM4ueff, BSIM4memoKeySize(here));
+    DEVmemoCopyStates(ckt, here->BSIM4states, leader->BSIM4states, BSIM4numStates);
+}
+
 #endif
@@ -39,6 +39,7 @@ BSIM4mDelete(GENmodel *gen_model)
 
 #ifdef USE_OMP
     FREE(model->BSIM4InstanceArray);
+    FREE(model->BSIM4memoTable);
 #endif
 
     struct bsim4SizeDependParam *p = model->pSizeDependParamKnot;
@@ -86,6 +86,226 @@ double T0=0.0, T1, T2, T3, T4, T5, T6, T7, T8, T9, Ssi;
 }
 
 
+/*
+ * Compute the noise parameters of an instance that depend on the
+ * operating point only.  They are kept in the instance and reused at
+ * every frequency until the bias changes (data->biasValid is reset).
+ */
+
+static void
+BSIM4noiseBias(
+BSIM4model *model,
+BSIM4instance *here,
+CKTcircuit *ckt)
+{
+struct bsim4SizeDependParam *pParam;
+double T0, T1, T2, T3, T4, T5, T6, T7, T8, T9, T10, T11;
+double Vds, igsquare;
+double tmp=0.0, gdpr, gspr, npart_theta=0.0, npart_beta=0.0;
+double m;
+
+/* tnoiMod=2 (v4.7) */
+double eta, Leff, Lvsat, gamma, delta, epsilon, GammaGd0=0.0;
+double npart_c, sigrat=0.0, C0, ctnoi=0.0;
+
+    pParam = here->pParam;
+    m = here->BSIM4m;
+
+    if (model->BSIM4tnoiMod == 0)
+    {   if (model->BSIM4rdsMod == 0)
+        {   gspr = here->BSIM4sourceConductance;
+            gdpr = here->BSIM4drainConductance;
+            if (here->BSIM4grdsw > 0.0)
+                tmp = 1.0 / here->BSIM4grdsw; /* tmp used below */
+            else
+                tmp = 0.0;
+        }
+        else
+        {   gspr = here->BSIM4gstot;
+            gdpr = here->BSIM4gdtot;
+            tmp = 0.0;
+        }
+    }
+    else if(model->BSIM4tnoiMod == 1)
+    {   T5 = here->BSIM4Vgsteff / here->BSIM4EsatL;
+        T5 *= T5;
+        npart_beta = model->BSIM4rnoia * (1.0 + T5
+                   * model->BSIM4tnoia * pParam->BSIM4leff);
+        npart_theta = model->BSIM4rnoib * (1.0 + T5
+                    * model->BSIM4tnoib * pParam->BSIM4leff);
+        if(npart_theta > 0.9)
+           npart_theta = 0.9;
+        if(npart_theta > 0.9 * npart_beta)
+           npart_theta = 0.9 * npart_beta; //4.6.2
+
+        if (model->BSIM4rdsMod == 0)
+        {   gspr = here->BSIM4sourceConductance;
+            gdpr = here->BSIM4drainConductance;
+        }
+        else
+        {   gspr = here->BSIM4gstot;
+            gdpr = here->BSIM4gdtot;
+        }
+
+        if ((*(ckt->CKTstates[0] + here->BSIM4vds)) >= 0.0)
+            gspr = gspr * (1.0 + npart_theta * npart_theta * gspr
+                 / here->BSIM4IdovVds);
+        else
+            gdpr = gdpr * (1.0 + npart_theta * npart_theta * gdpr
+                 / here->BSIM4IdovVds);
+    }
+    else
+    {   /* tnoiMod=2 (v4.7) */
+
+        if (model->BSIM4rdsMod == 0)
+        {   gspr = here->BSIM4sourceConductance;
+            gdpr = here->BSIM4drainConductance;
+        }
+        else
+        {   gspr = here->BSIM4gstot;
+            gdpr = here->BSIM4gdtot;
+        }
+
+    }
+
+    here->BSIM4noiGdpr = gdpr * m;
+    here->BSIM4noiGspr = gspr * m;
+
+    if (here->BSIM4rgateMod == 2)
+    {   T0 = 1.0 + here->BSIM4grgeltd/here->BSIM4gcrg;
+        T1 = T0 * T0;
+        here->BSIM4noiGrg = here->BSIM4grgeltd * m / T1;
+    }
+    else
+        here->BSIM4noiGrg = here->BSIM4grgeltd * m;
+
+    if(model->BSIM4tnoiMod == 2)
+    {
+        eta = 1.0 - here->BSIM4Vdseff * here->BSIM4AbovVgst2Vtm;
+        T0 = 1.0 - eta;
+        T1 = 1.0 + eta;
+        T2 = T1 + 2.0 * here->BSIM4Abulk * model->BSIM4vtm / here->BSIM4Vgsteff;
+        Leff = pParam->BSIM4leff;
+        Lvsat = Leff * (1.0 + here->BSIM4Vdseff / here->BSIM4EsatL);
+        T6 = Leff / Lvsat;
+        /*Unwanted code for T5 commented*/
+        /*T5 = here->BSIM4Vgsteff / here->BSIM4EsatL;
+        T5 = T5 * T5;
+        */
+        gamma = T6 * (0.5 * T1 + T0 * T0 / (6.0 * T2));
+        T3 = T2 * T2;
+        T4 = T0 * T0;
+        T5 = T3 * T3;
+        delta = (T1 / T3 - (5.0 * T1 + T2) * T4 / (15.0 * T5) + T4 * T4 / (9.0 * T5 * T2)) / (6.0 * T6 * T6 * T6);
+        T7 = T0 / T2;
+        epsilon = (T7 - T7 * T7 * T7 / 3.0) / (6.0 * T6);
+
+        T8 = here->BSIM4Vgsteff / here->BSIM4EsatL;
+        T8 *= T8;
+        if ((strcmp(model->BSIM4version, "4.8.1")) && (strncmp(model->BSIM4version, "4.81", 4))) {
+            npart_c = model->BSIM4rnoic * (1.0 + T8
+                    * model->BSIM4tnoic * Leff);
+            ctnoi = epsilon / sqrt(gamma * delta)
+                * (2.5316 * npart_c);
+
+            npart_beta = model->BSIM4rnoia * (1.0 + T8
+                * model->BSIM4tnoia * Leff);
+            npart_theta = model->BSIM4rnoib * (1.0 + T8
+                * model->BSIM4tnoib * Leff);
+            gamma = gamma * (3.0 * npart_beta * npart_beta);
+            delta = delta * (3.75 * npart_theta * npart_theta);
+
+            GammaGd0 = gamma * here->BSIM4noiGd0;
+            C0 = here->BSIM4Coxeff * pParam->BSIM4weffCV * here->BSIM4nf * pParam->BSIM4leffCV;
+            T0 = C0 / here->BSIM4noiGd0;
+            sigrat = T0 * sqrt(delta / gamma);
+        }
+        else
+        {
+            npart_c = model->BSIM4rnoic * (1.0 + T8
+                   * model->BSIM4tnoic * Leff);
+            /* Limits added for rnoia, rnoib, rnoic, tnoia, tnoib and tnoic in BSIM4.8.1 */
+            T9 = gamma * delta ;
+            if (T9 > 0)
+                ctnoi   = epsilon / sqrt( gamma * delta) * (2.5316 * npart_c);
+            else
+                ctnoi   = 1.0 ;
+            if (ctnoi > 1)
+                ctnoi=1;
+            if (ctnoi < 0)
+                ctnoi=0;
+
+            npart_beta = model->BSIM4rnoia * (1.0 + T8
+                * model->BSIM4tnoia * Leff);
+            npart_theta = model->BSIM4rnoib * (1.0 + T8
+                * model->BSIM4tnoib * Leff);
+            gamma = gamma * (3.0 * npart_beta * npart_beta);
+            delta = delta * (3.75 * npart_theta * npart_theta);
+
+            GammaGd0 = gamma * here->BSIM4noiGd0;
+                C0 = here->BSIM4Coxeff * pParam->BSIM4weffCV * here->BSIM4nf * pParam->BSIM4leffCV;
+            T0 = C0 / here->BSIM4noiGd0;
+
+            if (gamma > 0 && delta > 0)
+                sigrat = T0 * sqrt(delta / gamma);
+            else
+                sigrat = 0.0;
+        }
+    }
+
+    switch(model->BSIM4tnoiMod)
+    {  case 0:
+            T0 = here->BSIM4ueff * fabs(here->BSIM4qinv);
+            T1 = T0 * tmp + pParam->BSIM4leff
+               * pParam->BSIM4leff;
+            here->BSIM4noiGid = (T0 / T1) * model->BSIM4ntnoi * m;
+            break;
+       case 1:
+            T0 = here->BSIM4gm + here->BSIM4gmbs + here->BSIM4gds;
+            T0 *= T0;
+            igsquare = npart_theta * npart_theta * T0 / here->BSIM4IdovVds;
+            T1 = npart_beta * (here->BSIM4gm
+               + here->BSIM4gmbs) + here->BSIM4gds;
+            T2 = T1 * T1 / here->BSIM4IdovVds;
+            here->BSIM4noiGid = (T2 - igsquare) * m;
+            break;
+       case 2:
+            T2 = GammaGd0;
+            T3 = ctnoi * ctnoi;
+            T4 = 1.0 - T3;
+            here->BSIM4noiGid = T2 * T4 * m;
+            break;
+    }
+    here->BSIM4noiGammaGd0 = GammaGd0;
+    here->BSIM4noiCtnoi = ctnoi;
+    here->BSIM4noiSigrat = sigrat;
+
+    /* 1/f noise, evaluated at 1 Hz */
+    switch(model->BSIM4fnoiMod)
+    {  case 0:
+            here->BSIM4noiFlicker = m * model->BSIM4kf
+                  * exp(model->BSIM4af
+                  * log(MAX(fabs(here->BSIM4cd),
+                  N_MINLOG)));
+            break;
+       case 1:
+            Vds = *(ckt->CKTstates[0] + here->BSIM4vds);
+            if (Vds < 0.0)
+                Vds = -Vds;
+
+            here->BSIM4noiSsi = Eval1ovFNoise(Vds, model, here,
+                1.0, ckt->CKTtemp);
+            T10 = model->BSIM4oxideTrapDensityA
+                * CONSTboltz * ckt->CKTtemp;
+            T11 = pParam->BSIM4weff * here->BSIM4nf * pParam->BSIM4leff
+                * 1.0e10 * here->BSIM4nstar * here->BSIM4nstar;
+            here->BSIM4noiSwi = T10 / T11 * here->BSIM4cd
+                * here->BSIM4cd;
+            break;
+    }
+}
+
+
 int
 BSIM4noise (
 int mode, int operation,
@@ -104,13 +324,10 @@ double tempInoise;
 double noizDens[BSIM4NSRCS];
 double lnNdens[BSIM4NSRCS];
 
-double T0, T1, T2, T3, T4, T5, T6, T7, T8, T9, T10, T11;
-double Vds, Ssi, Swi;
-double tmp=0.0, gdpr, gspr, npart_theta=0.0, npart_beta=0.0, igsquare, bodymode;
-
-/* tnoiMod=2 (v4.7) */
-double eta, Leff, Lvsat, gamma, delta, epsilon, GammaGd0=0.0;
-double npart_c, sigrat=0.0, C0, omega, ctnoi=0.0;
+double T0, T1, T2, T3, T5, T6, T7;
+double Ssi, Swi;
+double bodymode;
+double omega;
 
 int i;
 
@@ -170,94 +387,31 @@ double m;
                       m = here->BSIM4m;
                       switch (mode)
                       {  case N_DENS:
-                              if (model->BSIM4tnoiMod == 0)
-                              {   if (model->BSIM4rdsMod == 0)
-                                  {   gspr = here->BSIM4sourceConductance;
-                                      gdpr = here->BSIM4drainConductance;
-                                      if (here->BSIM4grdsw > 0.0)
-                                          tmp = 1.0 / here->BSIM4grdsw; /* tmp used below */
-                                      else
-                                          tmp = 0.0;
-                                  }
-                                  else
-                                  {   gspr = here->BSIM4gstot;
-                                      gdpr = here->BSIM4gdtot;
-                                      tmp = 0.0;
-                                  }
-                              }
-                              else if(model->BSIM4tnoiMod == 1)
-                              {   T5 = here->BSIM4Vgsteff / here->BSIM4EsatL;
-                                  T5 *= T5;
-                                  npart_beta = model->BSIM4rnoia * (1.0 + T5
-                                             * model->BSIM4tnoia * pParam->BSIM4leff);
-                                  npart_theta = model->BSIM4rnoib * (1.0 + T5
-                                              * model->BSIM4tnoib * pParam->BSIM4leff);
-                                  if(npart_theta > 0.9)
-                                     npart_theta = 0.9;
-                                  if(npart_theta > 0.9 * npart_beta)
-                                     npart_theta = 0.9 * npart_beta; //4.6.2
-
-                                  if (model->BSIM4rdsMod == 0)
-                                  {   gspr = here->BSIM4sourceConductance;
-                                      gdpr = here->BSIM4drainConductance;
-                                  }
-                                  else
-                                  {   gspr = here->BSIM4gstot;
-                                      gdpr = here->BSIM4gdtot;
-                                  }
-
-                                  if ((*(ckt->CKTstates[0] + here->BSIM4vds)) >= 0.0)
-                                      gspr = gspr * (1.0 + npart_theta * npart_theta * gspr
-                                           / here->BSIM4IdovVds);
-                                  else
-                                      gdpr = gdpr * (1.0 + npart_theta * npart_theta * gdpr
-                                           / here->BSIM4IdovVds);
-                              }
-                              else
-                              {   /* tnoiMod=2 (v4.7) */
-
-                                  if (model->BSIM4rdsMod == 0)
-                                  {   gspr = here->BSIM4sourceConductance;
-                                      gdpr = here->BSIM4drainConductance;
-                                  }
-                                  else
-                                  {   gspr = here->BSIM4gstot;
-                                      gdpr = here->BSIM4gdtot;
-                                  }
-
-                              }
+                              if (!data->biasValid)
+                                  BSIM4noiseBias(model, here, ckt);
 
                               NevalSrc(&noizDens[BSIM4RDNOIZ],
                                        &lnNdens[BSIM4RDNOIZ], ckt, THERMNOISE,
                                        here->BSIM4dNodePrime, here->BSIM4dNode,
-                                       gdpr * m);
+                                       here->BSIM4noiGdpr);
 
                               NevalSrc(&noizDens[BSIM4RSNOIZ],
                                        &lnNdens[BSIM4RSNOIZ], ckt, THERMNOISE,
                                        here->BSIM4sNodePrime, here->BSIM4sNode,
-                                       gspr * m);
+                                       here->BSIM4noiGspr);
 
 
-                              if (here->BSIM4rgateMod == 1)
+                              if ((here->BSIM4rgateMod == 1) || (here->BSIM4rgateMod == 2))
                               {   NevalSrc(&noizDens[BSIM4RGNOIZ],
                                        &lnNdens[BSIM4RGNOIZ], ckt, THERMNOISE,
                                        here->BSIM4gNodePrime, here->BSIM4gNodeExt,
-                                       here->BSIM4grgeltd * m);
-                              }
-                              else if (here->BSIM4rgateMod == 2)
-                              {
-                                T0 = 1.0 + here->BSIM4grgeltd/here->BSIM4gcrg;
-                                T1 = T0 * T0;
-                                  NevalSrc(&noizDens[BSIM4RGNOIZ],
-                                       &lnNdens[BSIM4RGNOIZ], ckt, THERMNOISE,
-                                       here->BSIM4gNodePrime, here->BSIM4gNodeExt,
-                                       here->BSIM4grgeltd * m / T1);
+                                       here->BSIM4noiGrg);
                               }
                               else if (here->BSIM4rgateMod == 3)
                               {   NevalSrc(&noizDens[BSIM4RGNOIZ],
                                        &lnNdens[BSIM4RGNOIZ], ckt, THERMNOISE,
                                        here->BSIM4gNodeMid, here->BSIM4gNodeExt,
-                                       here->BSIM4grgeltd * m);
+                                       here->BSIM4noiGrg);
                               }
                               else
                               {    noizDens[BSIM4RGNOIZ] = 0.0;
@@ -355,203 +509,58 @@ double m;
                                           log(MAX(noizDens[BSIM4RBDBNOIZ], N_MINLOG));
                               }
 
-                              if(model->BSIM4tnoiMod == 2)
-                              {
-                                  eta = 1.0 - here->BSIM4Vdseff * here->BSIM4AbovVgst2Vtm;
-                                  T0 = 1.0 - eta;
-                                  T1 = 1.0 + eta;
-                                  T2 = T1 + 2.0 * here->BSIM4Abulk * model->BSIM4vtm / here->BSIM4Vgsteff;
-                                  Leff = pParam->BSIM4leff;
-                                  Lvsat = Leff * (1.0 + here->BSIM4Vdseff / here->BSIM4EsatL);
-                                  T6 = Leff / Lvsat;
-                                  /*Unwanted code for T5 commented*/
-                                  /*T5 = here->BSIM4Vgsteff / here->BSIM4EsatL;
-                                  T5 = T5 * T5;
-                                  */
-                                  gamma = T6 * (0.5 * T1 + T0 * T0 / (6.0 * T2));
-                                  T3 = T2 * T2;
-                                  T4 = T0 * T0;
-                                  T5 = T3 * T3;
-                                  delta = (T1 / T3 - (5.0 * T1 + T2) * T4 / (15.0 * T5) + T4 * T4 / (9.0 * T5 * T2)) / (6.0 * T6 * T6 * T6);
-                                  T7 = T0 / T2;
-                                  epsilon = (T7 - T7 * T7 * T7 / 3.0) / (6.0 * T6);
-
-                                  T8 = here->BSIM4Vgsteff / here->BSIM4EsatL;
-                                  T8 *= T8;
-                                  if ((strcmp(model->BSIM4version, "4.8.1")) && (strncmp(model->BSIM4version, "4.81", 4))) {
-                                      npart_c = model->BSIM4rnoic * (1.0 + T8
-                                              * model->BSIM4tnoic * Leff);
-                                      ctnoi = epsilon / sqrt(gamma * delta)
-                                          * (2.5316 * npart_c);
-
-                                      npart_beta = model->BSIM4rnoia * (1.0 + T8
-                                          * model->BSIM4tnoia * Leff);
-                                      npart_theta = model->BSIM4rnoib * (1.0 + T8
-                                          * model->BSIM4tnoib * Leff);
-                                      gamma = gamma * (3.0 * npart_beta * npart_beta);
-                                      delta = delta * (3.75 * npart_theta * npart_theta);
-
-                                      GammaGd0 = gamma * here->BSIM4noiGd0;
-                                      C0 = here->BSIM4Coxeff * pParam->BSIM4weffCV * here->BSIM4nf * pParam->BSIM4leffCV;
-                                      T0 = C0 / here->BSIM4noiGd0;
-                                      sigrat = T0 * sqrt(delta / gamma);
+                              NevalSrc(&noizDens[BSIM4IDNOIZ],
+                                       &lnNdens[BSIM4IDNOIZ], ckt,
+                                       THERMNOISE, here->BSIM4dNodePrime,
+                                       here->BSIM4sNodePrime, here->BSIM4noiGid);
+
+                              if (model->BSIM4tnoiMod == 2)
+                              {   /* Evaluate output noise due to two correlated noise sources */
+                                  T2 = here->BSIM4noiGammaGd0;
+                                  T3 = here->BSIM4noiCtnoi * here->BSIM4noiCtnoi;
+                                  omega = 2.0 * M_PI * data->freq;
+                                  T5 = omega * here->BSIM4noiSigrat;
+                                  T6 = T5 * T5;
+                                  T7 = T6 / (1.0 + T6);
+
+                                  if (here->BSIM4mode >= 0)  {
+                                      NevalSrc2(&noizDens[BSIM4CORLNOIZ],
+                                            &lnNdens[BSIM4CORLNOIZ], ckt,
+                                            THERMNOISE, here->BSIM4dNodePrime,
+                                            here->BSIM4sNodePrime, T2 * T3 * m,
+                                            here->BSIM4gNodePrime,
+                                            here->BSIM4sNodePrime,
+                                            T2 * T7 * m, 0.5 * M_PI);
                                   }
                                   else
                                   {
-                                      npart_c = model->BSIM4rnoic * (1.0 + T8
-                                             * model->BSIM4tnoic * Leff);
-                                      /* Limits added for rnoia, rnoib, rnoic, tnoia, tnoib and tnoic in BSIM4.8.1 */
-                                      T9 = gamma * delta ;
-                                      if (T9 > 0)
-                                          ctnoi   = epsilon / sqrt( gamma * delta) * (2.5316 * npart_c);
-                                      else
-                                          ctnoi   = 1.0 ;
-                                      if (ctnoi > 1)
-                                          ctnoi=1;
-                                      if (ctnoi < 0)
-                                          ctnoi=0;
-
-                                      npart_beta = model->BSIM4rnoia * (1.0 + T8
-                                          * model->BSIM4tnoia * Leff);
-                                      npart_theta = model->BSIM4rnoib * (1.0 + T8
-                                          * model->BSIM4tnoib * Leff);
-                                      gamma = gamma * (3.0 * npart_beta * npart_beta);
-                                      delta = delta * (3.75 * npart_theta * npart_theta);
-
-                                      GammaGd0 = gamma * here->BSIM4noiGd0;
-                                          C0 = here->BSIM4Coxeff * pParam->BSIM4weffCV * here->BSIM4nf * pParam->BSIM4leffCV;
-                                      T0 = C0 / here->BSIM4noiGd0;
-
-                                      if (gamma > 0 && delta > 0)
-                                          sigrat = T0 * sqrt(delta / gamma);
-                                      else
-                                          sigrat = 0.0;
+                                      NevalSrc2(&noizDens[BSIM4CORLNOIZ],
+                                            &lnNdens[BSIM4CORLNOIZ], ckt,
+                                            THERMNOISE, here->BSIM4sNodePrime,
+                                            here->BSIM4dNodePrime, T2 * T3 * m,
+                                            here->BSIM4gNodePrime,
+                                            here->BSIM4dNodePrime,
+                                            T2 * T7 * m, 0.5 * M_PI);
                                   }
                               }
 
-                              switch(model->BSIM4tnoiMod)
-                              {  case 0:
-                                      if ((strcmp(model->BSIM4version, "4.8.1")) && (strncmp(model->BSIM4version, "4.81", 4))) {
-                                          T0 = here->BSIM4ueff * fabs(here->BSIM4qinv);
-                                          T1 = T0 * tmp + pParam->BSIM4leff
-                                             * pParam->BSIM4leff;
-                                          NevalSrc(&noizDens[BSIM4IDNOIZ],
-                                                   &lnNdens[BSIM4IDNOIZ], ckt,
-                                                   THERMNOISE, here->BSIM4dNodePrime,
-                                                   here->BSIM4sNodePrime,
-                                                   (T0 / T1) * model->BSIM4ntnoi * m);
-                                      }
-                                      else
-                                      {
-                                          T0 = here->BSIM4ueff * fabs(here->BSIM4qinv);
-                                          T1 = T0 * tmp + pParam->BSIM4leff
-                                                  * pParam->BSIM4leff;
-                                          NevalSrc(&noizDens[BSIM4IDNOIZ],
-                                                  &lnNdens[BSIM4IDNOIZ], ckt,
-                                                  THERMNOISE, here->BSIM4dNodePrime,
-                                                  here->BSIM4sNodePrime,
-                                                  (T0 / T1) * model->BSIM4ntnoi * m);
-
-                                          noizDens[BSIM4CORLNOIZ] = 0.0;
-                                          lnNdens[BSIM4CORLNOIZ] = log(MAX(noizDens[BSIM4CORLNOIZ], N_MINLOG));
-                                      }
-                                      break;
-                                 case 1:
-                                      if ((strcmp(model->BSIM4version, "4.8.1")) && (strncmp(model->BSIM4version, "4.81", 4))) {
-                                          T0 = here->BSIM4gm + here->BSIM4gmbs + here->BSIM4gds;
-                                          T0 *= T0;
-                                          igsquare = npart_theta * npart_theta * T0 / here->BSIM4IdovVds;
-                                          T1 = npart_beta * (here->BSIM4gm
-                                             + here->BSIM4gmbs) + here->BSIM4gds;
-                                          T2 = T1 * T1 / here->BSIM4IdovVds;
-                                          NevalSrc(&noizDens[BSIM4IDNOIZ],
-                                                   &lnNdens[BSIM4IDNOIZ], ckt,
-                                                   THERMNOISE, here->BSIM4dNodePrime,
-                                                   here->BSIM4sNodePrime, (T2 - igsquare) * m);
-                                      }
-                                      else
-                                      {
-                                          T0 = here->BSIM4gm + here->BSIM4gmbs + here->BSIM4gds;
-                                          T0 *= T0;
-                                          igsquare = npart_theta * npart_theta * T0 / here->BSIM4IdovVds;
-                                          T1 = npart_beta * (here->BSIM4gm
-                                          + here->BSIM4gmbs) + here->BSIM4gds;
-                                          T2 = T1 * T1 / here->BSIM4IdovVds;
-                                          NevalSrc(&noizDens[BSIM4IDNOIZ],
-                                                  &lnNdens[BSIM4IDNOIZ], ckt,
-                                                  THERMNOISE, here->BSIM4dNodePrime,
-                                                  here->BSIM4sNodePrime, (T2 - igsquare) * m);
-
-                                          noizDens[BSIM4CORLNOIZ] = 0.0;
-                                          lnNdens[BSIM4CORLNOIZ] = log(MAX(noizDens[BSIM4CORLNOIZ], N_MINLOG));
-                                      }
-                                      break;
-                                  case 2:
-                                      T2 = GammaGd0;
-                                      T3 = ctnoi * ctnoi;
-                                      T4 = 1.0 - T3;
-                                      NevalSrc(&noizDens[BSIM4IDNOIZ],
-                                               &lnNdens[BSIM4IDNOIZ], ckt,
-                                               THERMNOISE, here->BSIM4dNodePrime,
-                                               here->BSIM4sNodePrime, T2 * T4 * m);
-
-                                     /* Evaluate output noise due to two correlated noise sources */
-                                     omega = 2.0 * M_PI * data->freq;
-                                     T5 = omega * sigrat;
-                                     T6 = T5 * T5;
-                                     T7 = T6 / (1.0 + T6);
-
-                                     if (here->BSIM4mode >= 0)  {
-                                         NevalSrc2(&noizDens[BSIM4CORLNOIZ],
-                                               &lnNdens[BSIM4CORLNOIZ], ckt,
-                                               THERMNOISE, here->BSIM4dNodePrime,
-                                               here->BSIM4sNodePrime, T2 * T3 * m,
-                                               here->BSIM4gNodePrime,
-                                               here->BSIM4sNodePrime,
-                                               T2 * T7 * m, 0.5 * M_PI);
-                                     }
-                                     else
-                                     {
-                                         NevalSrc2(&noizDens[BSIM4CORLNOIZ],
-                                               &lnNdens[BSIM4CORLNOIZ], ckt,
-                                               THERMNOISE, here->BSIM4sNodePrime,
-                                               here->BSIM4dNodePrime, T2 * T3 * m,
-                                               here->BSIM4gNodePrime,
-                                               here->BSIM4dNodePrime,
-                                               T2 * T7 * m, 0.5 * M_PI);
-                                     }
-                                     break;
-                              }
-
                               NevalSrc(&noizDens[BSIM4FLNOIZ], (double*) NULL,
                                        ckt, N_GAIN, here->BSIM4dNodePrime,
                                        here->BSIM4sNodePrime, (double) 0.0);
 
+                              /* only the 1/f^ef term changes with frequency */
                               switch(model->BSIM4fnoiMod)
                               {  case 0:
-                                      noizDens[BSIM4FLNOIZ] *= m * model->BSIM4kf
-                                            * exp(model->BSIM4af
-                                            * log(MAX(fabs(here->BSIM4cd),
-                                            N_MINLOG)))
+                                      noizDens[BSIM4FLNOIZ] *= here->BSIM4noiFlicker
                                             / (pow(data->freq, model->BSIM4ef)
                                             * pParam->BSIM4leff
                                             * pParam->BSIM4leff
                                             * model->BSIM4coxe);
                                       break;
                                  case 1:
-                                      Vds = *(ckt->CKTstates[0] + here->BSIM4vds);
-                                      if (Vds < 0.0)
-                                          Vds = -Vds;
-
-                                      Ssi = Eval1ovFNoise(Vds, model, here,
-                                          data->freq, ckt->CKTtemp);
-                                      T10 = model->BSIM4oxideTrapDensityA
-                                          * CONSTboltz * ckt->CKTtemp;
-                                      T11 = pParam->BSIM4weff * here->BSIM4nf * pParam->BSIM4leff
-                                          * pow(data->freq, model->BSIM4ef) * 1.0e10
-                                          * here->BSIM4nstar * here->BSIM4nstar;
-                                      Swi = T10 / T11 * here->BSIM4cd
-                                          * here->BSIM4cd;
+                                      T0 = pow(data->freq, model->BSIM4ef);
+                                      Ssi = here->BSIM4noiSsi / T0;
+                                      Swi = here->BSIM4noiSwi / T0;
                                       T1 = Swi + Ssi;
                                       if (T1 > 0.0)
                                           noizDens[BSIM4FLNOIZ] *= m * (Ssi * Swi) / T1;
@@ -2698,6 +2698,8 @@ do { if((here->ptr = SMPmakeElt(matrix,here->first,here->second))==(double *)NUL
         }
         model->BSIM4InstCount = 0;
         model->BSIM4InstanceArray = NULL;
+        model->BSIM4memoTable = NULL;
+        model->BSIM4memoSize = 0;
     }
     InstArray = TMALLOC(BSIM4instance*, InstCount);
     model = (BSIM4model*)inModel;
@@ -2732,6 +2734,7 @@ CKTcircuit *ckt)
 #ifdef USE_OMP
     model = (BSIM4model*)inModel;
     tfree(model->BSIM4InstanceArray);
+    tfree(model->BSIM4memoTable);
 #endif
 
     for (model = (BSIM4model *)inModel; model != NULL;
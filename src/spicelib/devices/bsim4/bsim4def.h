@@ -181,6 +181,18 @@ typedef struct sBSIM4instance
     double BSIM4noiGd0;   /* tnoiMod=2 (v4.7) */
     double BSIM4Coxeff;
 
+    /* bias dependent noise parameters, kept by BSIM4noise */
+    double BSIM4noiGdpr;
+    double BSIM4noiGspr;
+    double BSIM4noiGrg;
+    double BSIM4noiGid;
+    double BSIM4noiGammaGd0;
+    double BSIM4noiCtnoi;
+    double BSIM4noiSigrat;
+    double BSIM4noiFlicker;   /* fnoiMod=0, at 1 Hz */
+    double BSIM4noiSsi;       /* fnoiMod=1, at 1 Hz */
+    double BSIM4noiSwi;
+
     double BSIM4gbbs;
     double BSIM4gbgs;
     double BSIM4gbds;
@@ -522,6 +534,12 @@ typedef struct sBSIM4instance
     double BSIM4_101;
     double BSIM4_102;
     double BSIM4_103;
+
+    /* bias memoization, see BSIM4memoFind() */
+    double BSIM4memoV[10];
+    unsigned int BSIM4memoHash;
+    struct sBSIM4instance *BSIM4memoNext;
+    struct sBSIM4instance *BSIM4memoLeader;
 #endif
 
 #define BSIM4vbd BSIM4states+ 0
@@ -1879,6 +1897,8 @@ typedef struct sBSIM4model
 #ifdef USE_OMP
     int BSIM4InstCount;
     struct sBSIM4instance **BSIM4InstanceArray;
+    struct sBSIM4instance **BSIM4memoTable;
+    int BSIM4memoSize;
 #endif
 
     /* Flags */
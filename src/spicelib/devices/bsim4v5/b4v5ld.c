@@ -66,6 +66,7 @@ CKTcircuit *ckt)
     int idx;
     BSIM4v5model *model = (BSIM4v5model*)inModel;
     int error = 0;
+    int error_idx = model->BSIM4v5InstCount;
     BSIM4v5instance **InstArray;
     InstArray = model->BSIM4v5InstanceArray;
 
@@ -73,8 +74,13 @@ CKTcircuit *ckt)
     for (idx = 0; idx < model->BSIM4v5InstCount; idx++) {
         BSIM4v5instance *here = InstArray[idx];
         int local_error = BSIM4v5LoadOMP(here, ckt);
-        if (local_error)
-            error = local_error;
+        if (local_error) {
+#pragma omp critical
+            if (idx < error_idx) {
+                error_idx = idx;
+                error = local_error;
+            }
+        }
     }
 
     BSIM4v5LoadRhsMat(inModel, ckt);
@@ -3652,7 +3658,11 @@ finished:
 
           if ((here->BSIM4v5off == 0) || (!(ckt->CKTmode & MODEINITFIX)))
 	  {   if (Check == 1)
-	      {   ckt->CKTnoncon++;
+	      {
+#ifdef USE_OMP
+#pragma omp atomic
+#endif
+	          ckt->CKTnoncon++;
 #ifndef NEWCONV
               } 
 	      else
@@ -3677,11 +3687,19 @@ finished:
                        + ckt->CKTabstol;
                   if ((fabs(cdhat - Idtot) >= tol0) || (fabs(cseshat - Isestot) >= tol1)
 		      || (fabs(cdedhat - Idedtot) >= tol2))
-                  {   ckt->CKTnoncon++;
+                  {
+#ifdef USE_OMP
+#pragma omp atomic
+#endif
+                      ckt->CKTnoncon++;
                   }
 		  else if ((fabs(cgshat - Igstot) >= tol3) || (fabs(cgdhat - Igdtot) >= tol4)
 		      || (fabs(cgbhat - Igbtot) >= tol5))
-                  {   ckt->CKTnoncon++;
+                  {
+#ifdef USE_OMP
+#pragma omp atomic
+#endif
+                      ckt->CKTnoncon++;
                   }
                   else
                   {   Ibtot = here->BSIM4v5cbs + here->BSIM4v5cbd
@@ -3689,7 +3707,11 @@ finished:
                       tol6 = ckt->CKTreltol * MAX(fabs(cbhat), fabs(Ibtot))
                           + ckt->CKTabstol;
                       if (fabs(cbhat - Ibtot) > tol6)
-		      {   ckt->CKTnoncon++;
+		      {
+#ifdef USE_OMP
+#pragma omp atomic
+#endif
+		          ckt->CKTnoncon++;
                       }
                   }
 #endif /* NEWCONV */
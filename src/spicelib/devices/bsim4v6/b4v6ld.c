@@ -77,6 +77,7 @@ CKTcircuit *ckt)
     int idx;
     BSIM4v6model *model = (BSIM4v6model*)inModel;
     int error = 0;
+    int error_idx = model->BSIM4v6InstCount;
     BSIM4v6instance **InstArray;
     InstArray = model->BSIM4v6InstanceArray;
 
@@ -84,8 +85,13 @@ CKTcircuit *ckt)
     for (idx = 0; idx < model->BSIM4v6InstCount; idx++) {
         BSIM4v6instance *here = InstArray[idx];
         int local_error = BSIM4v6LoadOMP(here, ckt);
-        if (local_error)
-            error = local_error;
+        if (local_error) {
+#pragma omp critical
+            if (idx < error_idx) {
+                error_idx = idx;
+                error = local_error;
+            }
+        }
     }
 
     BSIM4v6LoadRhsMat(inModel, ckt);
@@ -3833,7 +3839,11 @@ finished:
 
           if ((here->BSIM4v6off == 0) || (!(ckt->CKTmode & MODEINITFIX)))
           {   if (Check == 1)
-              {   ckt->CKTnoncon++;
+              {
+#ifdef USE_OMP
+#pragma omp atomic
+#endif
+                  ckt->CKTnoncon++;
 #ifndef NEWCONV
               } 
               else
@@ -3858,11 +3868,19 @@ finished:
                        + ckt->CKTabstol;
                   if ((fabs(cdhat - Idtot) >= tol0) || (fabs(cseshat - Isestot) >= tol1)
                       || (fabs(cdedhat - Idedtot) >= tol2))
-                  {   ckt->CKTnoncon++;
+                  {
+#ifdef USE_OMP
+#pragma omp atomic
+#endif
+                      ckt->CKTnoncon++;
                   }
                   else if ((fabs(cgshat - Igstot) >= tol3) || (fabs(cgdhat - Igdtot) >= tol4)
                       || (fabs(cgbhat - Igbtot) >= tol5))
-                  {   ckt->CKTnoncon++;
+                  {
+#ifdef USE_OMP
+#pragma omp atomic
+#endif
+                      ckt->CKTnoncon++;
                   }
                   else
                   {   Ibtot = here->BSIM4v6cbs + here->BSIM4v6cbd
@@ -3870,7 +3888,11 @@ finished:
                       tol6 = ckt->CKTreltol * MAX(fabs(cbhat), fabs(Ibtot))
                           + ckt->CKTabstol;
                       if (fabs(cbhat - Ibtot) > tol6)
-                      {   ckt->CKTnoncon++;
+                      {
+#ifdef USE_OMP
+#pragma omp atomic
+#endif
+                          ckt->CKTnoncon++;
                       }
                   }
 #endif /* NEWCONV */
@@ -75,6 +75,7 @@ CKTcircuit *ckt)
     int idx;
     BSIM4v7model *model = (BSIM4v7model*)inModel;
     int error = 0;
+    int error_idx = model->BSIM4v7InstCount;
     BSIM4v7instance **InstArray;
     InstArray = model->BSIM4v7InstanceArray;
 
@@ -82,8 +83,13 @@ CKTcircuit *ckt)
     for (idx = 0; idx < model->BSIM4v7InstCount; idx++) {
         BSIM4v7instance *here = InstArray[idx];
         int local_error = BSIM4v7LoadOMP(here, ckt);
-        if (local_error)
-            error = local_error;
+        if (local_error) {
+#pragma omp critical
+            if (idx < error_idx) {
+                error_idx = idx;
+                error = local_error;
+            }
+        }
     }
 
     BSIM4v7LoadRhsMat(inModel, ckt);
@@ -3988,7 +3994,11 @@ finished:
 
           if ((here->BSIM4v7off == 0) || (!(ckt->CKTmode & MODEINITFIX)))
           {   if (Check == 1)
-              {   ckt->CKTnoncon++;
+              {
+#ifdef USE_OMP
+#pragma omp atomic
+#endif
+                  ckt->CKTnoncon++;
 #ifndef NEWCONV
               } 
               else
@@ -4013,11 +4023,19 @@ finished:
                        + ckt->CKTabstol;
                   if ((fabs(cdhat - Idtot) >= tol0) || (fabs(cseshat - Isestot) >= tol1)
                       || (fabs(cdedhat - Idedtot) >= tol2))
-                  {   ckt->CKTnoncon++;
+                  {
+#ifdef USE_OMP
+#pragma omp atomic
+#endif
+                      ckt->CKTnoncon++;
                   }
                   else if ((fabs(cgshat - Igstot) >= tol3) || (fabs(cgdhat - Igdtot) >= tol4)
                       || (fabs(cgbhat - Igbtot) >= tol5))
-                  {   ckt->CKTnoncon++;
+                  {
+#ifdef USE_OMP
+#pragma omp atomic
+#endif
+                      ckt->CKTnoncon++;
                   }
                   else
                   {   Ibtot = here->BSIM4v7cbs + here->BSIM4v7cbd
@@ -4025,7 +4043,11 @@ finished:
                       tol6 = ckt->CKTreltol * MAX(fabs(cbhat), fabs(Ibtot))
                           + ckt->CKTabstol;
                       if (fabs(cbhat - Ibtot) > tol6)
-                      {   ckt->CKTnoncon++;
+                      {
+#ifdef USE_OMP
+#pragma omp atomic
+#endif
+                          ckt->CKTnoncon++;
                       }
                   }
 #endif /* NEWCONV */
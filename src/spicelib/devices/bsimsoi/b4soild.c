@@ -110,6 +110,7 @@ B4SOIload(
     int idx;
     B4SOImodel *model = (B4SOImodel*)inModel;
     int error = 0;
+    int error_idx = model->B4SOIInstCount;
     B4SOIinstance **InstArray;
     InstArray = model->B4SOIInstanceArray;
 
@@ -117,8 +118,13 @@ B4SOIload(
     for (idx = 0; idx < model->B4SOIInstCount; idx++) {
         B4SOIinstance *here = InstArray[idx];
         int local_error = B4SOILoadOMP(here, ckt);
-        if (local_error)
-            error = local_error;
+        if (local_error) {
+#pragma omp critical
+            if (idx < error_idx) {
+                error_idx = idx;
+                error = local_error;
+            }
+        }
     }
 
     B4SOILoadRhsMat(inModel, ckt);
@@ -9343,14 +9349,22 @@ finished: /* returning Values to Calling Routine */
              */
             if ((here->B4SOIoff == 0) || (!(ckt->CKTmode & MODEINITFIX)))
             {   if (Check == 1)
-                {   ckt->CKTnoncon++;
+                {
+#ifdef USE_OMP
+#pragma omp atomic
+#endif
+                    ckt->CKTnoncon++;
 #ifndef NEWCONV
                 }
                 else
                 {   tol = ckt->CKTreltol * MAX(fabs(cdhat), fabs(here->B4SOIcd))
                     + ckt->CKTabstol;
                     if (fabs(cdhat - here->B4SOIcd) >= tol)
-                    {   ckt->CKTnoncon++;
+                    {
+#ifdef USE_OMP
+#pragma omp atomic
+#endif
+                        ckt->CKTnoncon++;
                     }
                     else
                     {   tol = ckt->CKTreltol * MAX(fabs(cbhat),
@@ -9358,7 +9372,11 @@ finished: /* returning Values to Calling Routine */
                         + ckt->CKTabstol;
                     if (fabs(cbhat - (here->B4SOIcbs + here->B4SOIcbd))
                             > tol)
-                    {   ckt->CKTnoncon++;
+                    {
+#ifdef USE_OMP
+#pragma omp atomic
+#endif
+                        ckt->CKTnoncon++;
                     }
                     }
 #endif /* NEWCONV */
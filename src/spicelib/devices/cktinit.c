@@ -129,6 +129,7 @@ CKTinit(CKTcircuit **ckt)		/* new circuit to create */
     g_mif_info.errmsg            = NULL;
     g_mif_info.auto_partial.global = MIF_FALSE;
     g_mif_info.auto_partial.local = MIF_FALSE;
+    g_mif_info.parallel = MIF_FALSE;
 /* gtri - end - wbk - 01/12/91 */
 #endif
 
@@ -12,6 +12,7 @@ Modified: 2000 AlansFixes
 #include "ngspice/suffix.h"
 
 #include <stdarg.h>
+#include <stdint.h>
 
 
 /* 
@@ -824,6 +825,52 @@ DEVpred(CKTcircuit *ckt, int loct)
 }
 
 
+/* Bias memoization: a load routine may evaluate only one of several
+ * instances which have the same model, size, parameters, terminal
+ * voltages and state history, and copy the results to the others.
+ * These helpers hash and compare the inputs and copy the states. */
+
+/* FNV-1a like hash of the bit patterns of n doubles, continuing from hash */
+unsigned int
+DEVmemoHash(const double *v, int n, unsigned int hash)
+{
+    uint64_t h = hash, x;
+
+    while (n--) {
+        memcpy(&x, v++, sizeof(x));
+        h = (h ^ x) * 1099511628211u;
+    }
+
+    return (unsigned int) (h ^ (h >> 32));
+}
+
+
+/* Are the num states at s1 and s2 bitwise identical in all state vectors? */
+int
+DEVmemoStatesEqual(CKTcircuit *ckt, int s1, int s2, int num)
+{
+    int i;
+
+    for (i = 0; i <= MAX(2, ckt->CKTmaxOrder) + 1; i++)
+        if (memcmp(ckt->CKTstates[i] + s1, ckt->CKTstates[i] + s2,
+                   (size_t) num * sizeof(double)))
+            return 0;
+
+    return 1;
+}
+
+
+/* Copy the num states written by a load from src to dst */
+void
+DEVmemoCopyStates(CKTcircuit *ckt, int dst, int src, int num)
+{
+    memcpy(ckt->CKTstate0 + dst, ckt->CKTstate0 + src,
+           (size_t) num * sizeof(double));
+    memcpy(ckt->CKTstate1 + dst, ckt->CKTstate1 + src,
+           (size_t) num * sizeof(double));
+}
+
+
 /* SOA check printout used in DEVsoaCheck functions */
 extern FILE *slogp;  /* soa log file ('--soa-log file' command line option) */
 
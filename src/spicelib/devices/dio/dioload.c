@@ -8,6 +8,7 @@ Modified by Paolo Nenzi 2003 and Dietmar Warning 2012
 #include "ngspice/ngspice.h"
 #include "ngspice/devdefs.h"
 #include "ngspice/cktdefs.h"
+#include "ngspice/fastmath.h"
 #include "diodefs.h"
 #include "ngspice/const.h"
 #include "ngspice/trandefs.h"
@@ -262,7 +263,7 @@ next1:
 
                     if (vd >= -3*vtesw) {               /* forward */
 
-                        evd = exp(vd/vtesw);
+                        evd = DEVexp(ckt, vd/vtesw);
                         cdsw = csatsw*(evd-1);
                         gdsw = csatsw*evd/vtesw;
                         cdsw_dT = csatsw_dT * (evd - 1) - csatsw * vd * evd / (vtesw * Temp);
@@ -280,7 +281,7 @@ next1:
                     } else {                            /* breakdown */
                         double evrev_dT;
 
-                        evrev = exp(-(here->DIOtBrkdwnV+vd)/vtebrk);
+                        evrev = DEVexp(ckt, -(here->DIOtBrkdwnV+vd)/vtebrk);
                         evrev_dT = (here->DIOtBrkdwnV+vd)*evrev/(vtebrk*Temp);
                         cdsw = -csatsw*evrev;
                         gdsw = csatsw*evrev/vtebrk;
@@ -304,21 +305,21 @@ next1:
 
             if (vd >= -3*vte) {                 /* bottom current forward */
 
-                evd = exp(vd/vte);
+                evd = DEVexp(ckt, vd/vte);
                 cdb = csat*(evd-1);
                 gdb = csat*evd/vte;
                 cdb_dT = csat_dT * (evd - 1) - csat * vd * evd / (vte * Temp);
                 if (model->DIOrecSatCurGiven) { /* recombination current */
                     double vterec = model->DIOrecEmissionCoeff*vt;
-                    evd_rec = exp(vd/(vterec));
+                    evd_rec = DEVexp(ckt, vd/(vterec));
                     cdb_rec = here->DIOtRecSatCur*(evd_rec-1);
                     gdb_rec = here->DIOtRecSatCur*evd_rec/vterec;
                     cdb_rec_dT = here->DIOtRecSatCur_dT * (evd_rec - 1)
                                 -here->DIOtRecSatCur * vd * evd_rec / (vterec*Temp);
-                    t1 = pow((1-vd/here->DIOtJctPot), 2) + 0.005;
-                    gen_fac = pow(t1, here->DIOtGradingCoeff/2);
+                    t1 = DEVpow(ckt, (1-vd/here->DIOtJctPot), 2) + 0.005;
+                    gen_fac = DEVpow(ckt, t1, here->DIOtGradingCoeff/2);
                     gen_fac_vd = -here->DIOtGradingCoeff * (1-vd/here->DIOtJctPot)
-                                                         * pow(t1, (here->DIOtGradingCoeff/2-1));
+                                                         * DEVpow(ckt, t1, (here->DIOtGradingCoeff/2-1));
                     cdb_rec = cdb_rec * gen_fac;
                     gdb_rec = gdb_rec * gen_fac + cdb_rec * gen_fac_vd;
                     cdb = cdb + cdb_rec;
@@ -341,7 +342,7 @@ next1:
             } else {                            /* breakdown */
                 double evrev_dT;
 
-                evrev = exp(-(here->DIOtBrkdwnV+vd)/vtebrk);
+                evrev = DEVexp(ckt, -(here->DIOtBrkdwnV+vd)/vtebrk);
                 evrev_dT = (here->DIOtBrkdwnV+vd)*evrev/(vtebrk*Temp);
                 cdb = -csat*evrev;
                 gdb = csat*evrev/vtebrk;
@@ -352,7 +353,7 @@ next1:
             if (model->DIOtunSatSWCurGiven) {    /* tunnel sidewall current */
 
                 vtetun = model->DIOtunEmissionCoeff * vt;
-                evd = exp(-vd/vtetun);
+                evd = DEVexp(ckt, -vd/vtetun);
 
                 cdsw = cdsw - here->DIOtTunSatSWCur * (evd - 1);
                 gdsw = gdsw + here->DIOtTunSatSWCur * evd / vtetun;
@@ -364,7 +365,7 @@ next1:
             if (model->DIOtunSatCurGiven) {      /* tunnel bottom current */
 
                 vtetun = model->DIOtunEmissionCoeff * vt;
-                evd = exp(-vd/vtetun);
+                evd = DEVexp(ckt, -vd/vtetun);
 
                 cdb = cdb - here->DIOtTunSatCur * (evd - 1);
                 gdb = gdb + here->DIOtTunSatCur * evd / vtetun;
@@ -411,7 +412,7 @@ next1:
                 czero=here->DIOtJctCap;
                 if (vd < here->DIOtDepCap){
                     arg=1-vd/here->DIOtJctPot;
-                    sarg=exp(-here->DIOtGradingCoeff*log(arg));
+                    sarg=DEVexp(ckt, -here->DIOtGradingCoeff*DEVlog(ckt, arg));
                     deplcharge = here->DIOtJctPot*czero*(1-arg*sarg)/(1-here->DIOtGradingCoeff);
                     deplcap = czero*sarg;
                 } else {
@@ -423,7 +424,7 @@ next1:
                 czeroSW=here->DIOtJctSWCap;
                 if (vd < here->DIOtDepSWCap){
                     argSW=1-vd/here->DIOtJctSWPot;
-                    sargSW=exp(-model->DIOgradingSWCoeff*log(argSW));
+                    sargSW=DEVexp(ckt, -model->DIOgradingSWCoeff*DEVlog(ckt, argSW));
                     deplchargeSW = here->DIOtJctSWPot*czeroSW*(1-argSW*sargSW)/(1-model->DIOgradingSWCoeff);
                     deplcapSW = czeroSW*sargSW;
                 } else {
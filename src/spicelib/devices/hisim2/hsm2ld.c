@@ -229,6 +229,7 @@ int HSM2load(
     int idx;
     HSM2model *model = (HSM2model*)inModel;
     int error = 0;
+    int error_idx = model->HSM2InstCount;
     HSM2instance **InstArray;
     InstArray = model->HSM2InstanceArray;
 
@@ -236,8 +237,13 @@ int HSM2load(
     for (idx = 0; idx < model->HSM2InstCount; idx++) {
         HSM2instance *here = InstArray[idx];
         int local_error = HSM2LoadOMP(here, ckt);
-        if (local_error)
-            error = local_error;
+        if (local_error) {
+#pragma omp critical
+            if (idx < error_idx) {
+                error_idx = idx;
+                error = local_error;
+            }
+        }
     }
 
     HSM2LoadRhsMat(inModel, ckt);
@@ -821,6 +827,9 @@ tm0 = gtodsecld() ;
       isConv = 1;
       if ( (here->HSM2_off == 0) || !(ckt->CKTmode & MODEINITFIX) ) {
 	if (Check == 1) {
+#ifdef USE_OMP
+#pragma omp atomic
+#endif
 	  ckt->CKTnoncon++;
 	  isConv = 0;
 #ifndef NEWCONV
@@ -835,12 +844,18 @@ tm0 = gtodsecld() ;
 	  tol3 = ckt->CKTreltol * MAX(fabs(cgshat), fabs(Igstot)) + ckt->CKTabstol;
 	  tol4 = ckt->CKTreltol * MAX(fabs(cgdhat), fabs(Igdtot)) + ckt->CKTabstol;
 	  if (fabs(cdhat - Idtot) >= tol) {
+#ifdef USE_OMP
+#pragma omp atomic
+#endif
 	    ckt->CKTnoncon++;
 	    isConv = 0;
 	  }
 	  else if (fabs(cgbhat - Igbtot) >= tol2 || 
 		   fabs(cgshat - Igstot) >= tol3 ||
 		   fabs(cgdhat - Igdtot) >= tol4) {
+#ifdef USE_OMP
+#pragma omp atomic
+#endif
 	    ckt->CKTnoncon++;
 	    isConv = 0;
 	  }
@@ -849,6 +864,9 @@ tm0 = gtodsecld() ;
 	      - here->HSM2_isub - here->HSM2_igidl - here->HSM2_igisl;
 	    tol = ckt->CKTreltol * MAX(fabs(cbhat), fabs(Ibtot)) + ckt->CKTabstol;
 	    if (fabs(cbhat - Ibtot) > tol) {
+#ifdef USE_OMP
+#pragma omp atomic
+#endif
 	      ckt->CKTnoncon++;
 	      isConv = 0;
 	    }
@@ -80,6 +80,9 @@ NBJTsetup(SMPmatrix *matrix, GENmodel *inModel, CKTcircuit *ckt, int *states)
     if (!methods->METHvoltPredGiven) {
       methods->METHvoltPred = FALSE;
     }
+    if (!methods->METHjacReuseGiven) {
+      methods->METHjacReuse = FALSE;
+    }
     if (!methods->METHmobDerivGiven) {
       methods->METHmobDeriv = TRUE;
     }
@@ -184,6 +187,7 @@ NBJTsetup(SMPmatrix *matrix, GENmodel *inModel, CKTcircuit *ckt, int *states)
 	pDevice->numNodes = xMeshSize;
 	pDevice->abstol = methods->METHdabstol;
 	pDevice->reltol = methods->METHdreltol;
+	pDevice->jacReuse = methods->METHjacReuse;
 	pDevice->rhsImag = NULL;
 	TSCALLOC(pDevice->elemArray, pDevice->numNodes, ONEelem *);
 
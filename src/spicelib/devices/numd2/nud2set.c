@@ -83,6 +83,9 @@ NUMD2setup(SMPmatrix *matrix, GENmodel *inModel, CKTcircuit *ckt, int *states)
     if (!methods->METHvoltPredGiven) {
       methods->METHvoltPred = FALSE;
     }
+    if (!methods->METHjacReuseGiven) {
+      methods->METHjacReuse = FALSE;
+    }
     if (!methods->METHmobDerivGiven) {
       methods->METHmobDeriv = TRUE;
     }
@@ -202,6 +205,7 @@ NUMD2setup(SMPmatrix *matrix, GENmodel *inModel, CKTcircuit *ckt, int *states)
 	pDevice->yScale = MESHmkArray(yCoordList, yMeshSize);
 	pDevice->abstol = methods->METHdabstol;
 	pDevice->reltol = methods->METHdreltol;
+	pDevice->jacReuse = methods->METHjacReuse;
 	TSCALLOC(pDevice->elemArray, pDevice->numXNodes, TWOelem **);
 	for (xIndex = 1; xIndex < pDevice->numXNodes; xIndex++) {
 	  TSCALLOC(pDevice->elemArray[xIndex], pDevice->numYNodes, TWOelem *);
@@ -19,8 +19,16 @@ Author: 1985 Thomas L. Quarles
 
 extern double PTfudge_factor;
 
+/* The arguments of a call of a .func, each evaluated when first used */
+struct PTframe {
+    struct PTframe *up;         /* Frame the arguments are evaluated in */
+    INPparseNode *args[PT_MAXARGS];
+    double vals[PT_MAXARGS];
+    bool done[PT_MAXARGS];
+};
+
 static int PTeval(INPparseNode * tree, double gmin, double *res,
-		  double *vals);
+		  double *vals, struct PTframe *frame);
 
 
 
@@ -43,7 +51,7 @@ IFeval(IFparseTree * tree, double gmin, double *result, double *vals,
 	printf("\tvar%d = %lg\n", i, vals[i]);
 #endif
 
-    if ((err = PTeval(myTree->tree, gmin, result, vals)) != OK) {
+    if ((err = PTeval(myTree->tree, gmin, result, vals, NULL)) != OK) {
         if (ft_ngdebug) {
             INPptPrint("calling PTeval, tree = ", tree);
             printf("values:");
@@ -56,7 +64,7 @@ IFeval(IFparseTree * tree, double gmin, double *result, double *vals,
     }
 
     for (i = 0; i < myTree->p.numVars; i++)
-        if ((err = PTeval(myTree->derivs[i], gmin, &derivs[i], vals)) != OK) {
+        if ((err = PTeval(myTree->derivs[i], gmin, &derivs[i], vals, NULL)) != OK) {
             if (ft_ngdebug) {
                 INPptPrint("calling PTeval, tree = ", tree);
                 printf("results: function = %lg\n", *result);
@@ -78,7 +86,8 @@ IFeval(IFparseTree * tree, double gmin, double *result, double *vals,
 }
 
 static int
-PTeval(INPparseNode * tree, double gmin, double *res, double *vals)
+PTeval(INPparseNode * tree, double gmin, double *res, double *vals,
+       struct PTframe *frame)
 {
     double r1, r2;
     int err;
@@ -100,10 +109,10 @@ PTeval(INPparseNode * tree, double gmin, double *res, double *vals)
         case PTF_PWR:
         case PTF_MIN:
         case PTF_MAX:
-            err = PTeval(tree->left->left, gmin, &r1, vals);
+            err = PTeval(tree->left->left, gmin, &r1, vals, frame);
             if (err != OK)
                 return (err);
-            err = PTeval(tree->left->right, gmin, &r2, vals);
+            err = PTeval(tree->left->right, gmin, &r2, vals, frame);
             if (err != OK)
                 return (err);
             *res = PTbinary(tree -> function) (r1, r2);
@@ -115,7 +124,7 @@ PTeval(INPparseNode * tree, double gmin, double *res, double *vals)
         break;
         /* fcns with single argument */
         default:
-            err = PTeval(tree->left, gmin, &r1, vals);
+            err = PTeval(tree->left, gmin, &r1, vals, frame);
             if (err != OK)
                 return (err);
             if(tree->data == NULL)
@@ -137,12 +146,12 @@ PTeval(INPparseNode * tree, double gmin, double *res, double *vals)
         INPparseNode *arg2 = tree->right->left;
         INPparseNode *arg3 = tree->right->right;
 
-        err = PTeval(arg1, gmin, &r1, vals);
+        err = PTeval(arg1, gmin, &r1, vals, frame);
         if (err != OK)
           return (err);
 
         /*FIXME > 0.0, >= 0.5, != 0.0 or what ? */
-        err = PTeval((r1 != 0.0) ? arg2 : arg3, gmin, &r2, vals);
+        err = PTeval((r1 != 0.0) ? arg2 : arg3, gmin, &r2, vals, frame);
         if (err != OK)
            return (err);
 
@@ -155,10 +164,10 @@ PTeval(INPparseNode * tree, double gmin, double *res, double *vals)
     case PT_TIMES:
     case PT_DIVIDE:
     case PT_POWER:
-	err = PTeval(tree->left, gmin, &r1, vals);
+	err = PTeval(tree->left, gmin, &r1, vals, frame);
 	if (err != OK)
 	    return (err);
-	err = PTeval(tree->right, gmin, &r2, vals);
+	err = PTeval(tree->right, gmin, &r2, vals, frame);
 	if (err != OK)
 	    return (err);
 	*res = PTbinary(tree -> function) (r1, r2);
@@ -169,6 +178,37 @@ PTeval(INPparseNode * tree, double gmin, double *res, double *vals)
 	}
 	break;
 
+    case PT_ARG:
+        if (!frame->done[tree->valueIndex]) {
+            err = PTeval(frame->args[tree->valueIndex], gmin,
+                         &frame->vals[tree->valueIndex], vals, frame->up);
+            if (err != OK)
+                return (err);
+            frame->done[tree->valueIndex] = TRUE;
+        }
+        *res = frame->vals[tree->valueIndex];
+        break;
+
+    case PT_CALL:
+      {
+        INPfunction *f = (INPfunction *) tree->data;
+        INPparseNode *w = tree->left;
+        struct PTframe callee;
+        int i;
+
+        for (i = f->numParams; --i > 0; w = w->left)
+            callee.args[i] = w->right;
+        callee.args[0] = w;
+        for (i = 0; i < f->numParams; i++)
+            callee.done[i] = FALSE;
+        callee.up = frame;
+
+        err = PTeval(f->tree, gmin, res, vals, &callee);
+        if (err != OK)
+            return (err);
+        break;
+      }
+
     case PT_TIME:
         *res = ((CKTcircuit*) tree->data) -> CKTtime;
 	break;
@@ -885,6 +885,11 @@ INP2dot(CKTcircuit *ckt, INPtables *tab, struct card *current, TSKtask *task, CK
         LITERR(" Warning: .global not yet implemented - ignored \n");
         goto quit;
     }
+    /* .func lines were done in pass 1 */
+    else if (strcmp(token, ".func") == 0) {
+        rtn = 0;
+        goto quit;
+    }
     /* ignore .meas statements -- these will be handled after analysis */
     /* also ignore .param statements */
     /* ignore .prot, .unprot */
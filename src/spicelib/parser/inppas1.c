@@ -8,7 +8,8 @@ Author: 1985 Thomas L. Quarles
 #include "inppas1.h"
 
 /*
- * The first pass of the circuit parser just looks for '.model' lines
+ * The first pass of the circuit parser just looks for '.model' lines,
+ * and for the '.func' lines which are kept for the B source parser
  */
 
 void INPpas1(CKTcircuit *ckt, struct card *deck, INPtables * tab)
@@ -36,6 +37,9 @@ void INPpas1(CKTcircuit *ckt, struct card *deck, INPtables * tab)
 	      /* Now invoke INPdomodel to stick model into model table. */
 		temp = INPdomodel(ckt, current, tab);
 		current->error = INPerrCat(current->error, temp);
+	    } else if (strncmp(thisline, ".func", 5) == 0) {
+		temp = INPdefineFunction(ckt, thisline, tab);
+		current->error = INPerrCat(current->error, temp);
 	    }
 	}
 
@@ -98,7 +98,7 @@ exp:
   | '-' exp  %prec NEG                { $$ = PT_mkfnode("-",$2); }
   | '+' exp  %prec NEG                { $$ = $2; }
 
-  | TOK_STR '(' nonempty_arglist ')'  { $$ = PT_mkfnode($1, $3);
+  | TOK_STR '(' nonempty_arglist ')'  { $$ = PT_mkcnode($1, $3);
                                         if (!$$)
                                             YYERROR;
                                         txfree($1); }
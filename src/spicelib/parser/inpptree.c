@@ -13,6 +13,7 @@ Author: 1987 Wayne A. Christopher, U. C. Berkeley CAD Group
 #include "ngspice/inpdefs.h"
 #include "ngspice/inpptree.h"
 #include "ngspice/randnumb.h"
+#include "ngspice/stringskip.h"
 #include "inpxx.h"
 
 #include "inpptree-parser.h"
@@ -31,6 +32,10 @@ static INPparseNode *mkf(int type, INPparseNode * arg);
 static int PTcheck(INPparseNode * p, char* tline);
 static INPparseNode *mkvnode(char *name);
 static INPparseNode *mkinode(char *name);
+static INPparseNode *mkcall(INPfunction *f, INPparseNode *args);
+static INPparseNode *mkdcall(INPfunction *f, int k, INPparseNode *args);
+static void parse_function(INPfunction *f);
+static void release_function(INPfunction *f);
 
 static INPparseNode *PTdifferentiate(INPparseNode * p, int varnum);
 
@@ -110,6 +115,7 @@ static int *types;
 static int numvalues;
 static CKTcircuit *circuit;
 static INPtables *tables;
+static INPfunction *function;   /* .func whose body is being parsed */
 
 extern IFsimulator *ft_sim;        /* XXX */
 
@@ -269,6 +275,7 @@ static INPparseNode *PTdifferentiate(INPparseNode * p, int varnum)
         break;
 
     case PT_VAR:
+    case PT_ARG:
         /* Is this the variable we're differentiating wrt? */
         if (p->valueIndex == varnum)
             newp = mkcon(1.0);
@@ -276,6 +283,30 @@ static INPparseNode *PTdifferentiate(INPparseNode * p, int varnum)
             newp = mkcon(0.0);
         break;
 
+    case PT_CALL:
+        /* d f(u1, ..., un) = sum of (d f / d uk)(u1, ..., un) * d(uk) */
+        {
+            INPfunction *f = (INPfunction *) p->data;
+            INPparseNode *args[PT_MAXARGS], *w = p->left;
+            int k;
+
+            for (k = f->numParams; --k > 0; w = w->left)
+                args[k] = w->right;
+            args[0] = w;
+
+            newp = mkcon(0.0);
+            for (k = 0; k < f->numParams; k++) {
+                arg2 = PTdifferentiate(args[k], varnum);
+                if (arg2->type == PT_CONSTANT && arg2->constant == 0.0) {
+                    release_tree(arg2);
+                    continue;
+                }
+                arg1 = mkdcall(f, k, p->left);
+                newp = mkb(PT_PLUS, newp, mkb(PT_TIMES, arg1, arg2));
+            }
+        }
+        break;
+
     case PT_PLUS:
     case PT_MINUS:
         arg1 = PTdifferentiate(p->left, varnum);
@@ -351,7 +382,18 @@ static INPparseNode *PTdifferentiate(INPparseNode * p, int varnum)
                     arg1);
             }
         }
-        else if (a->type == PT_CONSTANT){
+        else if (b->type == PT_ARG && b->valueIndex != varnum) {
+            /* another .func parameter, constant wrt varnum as well */
+            arg1 = PTdifferentiate(a, varnum);
+            newp = mkb(PT_TIMES,
+                mkb(PT_TIMES,
+                    b,
+                    mkf((newcompat.hs || newcompat.lt) ? PTF_POW : PTF_PWR,
+                        mkb(PT_COMMA, a, mkb(PT_MINUS, b, mkcon(1.0))))),
+                arg1);
+        }
+        else if (a->type == PT_CONSTANT ||
+                 (a->type == PT_ARG && a->valueIndex != varnum)) {
             arg2 = PTdifferentiate(b, varnum);
             newp = mkb(PT_TIMES,
                        mkf(PTF_POW, mkb(PT_COMMA, a, b)),
@@ -652,7 +694,17 @@ static INPparseNode *PTdifferentiate(INPparseNode * p, int varnum)
                                mkf(PTF_PWR,
                                    mkb(PT_COMMA, a, mkcon(b->constant - 1)))),
                            arg1);
-            } else if (a->type == PT_CONSTANT) {
+            } else if (b->type == PT_ARG && b->valueIndex != varnum) {
+                arg1 = PTdifferentiate(a, varnum);
+                newp = mkb(PT_TIMES,
+                           mkb(PT_TIMES,
+                               b,
+                               mkf(PTF_PWR,
+                                   mkb(PT_COMMA, a,
+                                       mkb(PT_MINUS, b, mkcon(1.0))))),
+                           arg1);
+            } else if (a->type == PT_CONSTANT ||
+                       (a->type == PT_ARG && a->valueIndex != varnum)) {
                 arg2 = PTdifferentiate(b, varnum);
                 newp = mkb(PT_TIMES,
                     mkf(PTF_POW, mkb(PT_COMMA, a, b)),
@@ -721,6 +773,17 @@ static INPparseNode *PTdifferentiate(INPparseNode * p, int varnum)
                                    mkb(PT_COMMA, a, mkcon(b->constant - 1.0)))),
                            arg1);
 
+            } else if (b->type == PT_ARG && b->valueIndex != varnum) {
+                arg1 = PTdifferentiate(a, varnum);
+
+                newp = mkb(PT_TIMES,
+                           mkb(PT_TIMES,
+                               b,
+                               mkf(PTF_POW,
+                                   mkb(PT_COMMA, a,
+                                       mkb(PT_MINUS, b, mkcon(1.0))))),
+                           arg1);
+
             } else {
                 arg1 = PTdifferentiate(a, varnum);
                 arg2 = PTdifferentiate(b, varnum);
@@ -942,9 +1005,11 @@ static int PTcheck(INPparseNode * p, char *tline)
     case PT_FREQUENCY:
     case PT_CONSTANT:
     case PT_VAR:
+    case PT_ARG:
         return (1);
 
     case PT_FUNCTION:
+    case PT_CALL:
         ret = (PTcheck(p->left, tline));
         if (ret == 0 && !msgsent) {
             fprintf(stderr, "\nError: The internal check of parse tree \n%s\nfailed\n", tline);
@@ -1246,6 +1311,223 @@ INPparseNode *PT_mkfnode(const char *fname, INPparseNode * arg)
     return (p);
 }
 
+/* Call of a .func kept for the B source parser, or of a built-in function */
+
+INPparseNode *PT_mkcnode(const char *fname, INPparseNode * arg)
+{
+    INPfunction *f = NULL;
+    INPparseNode *w;
+    int n;
+
+    if (fname && arg && tables)
+        for (f = tables->INPfunctions; f; f = f->next)
+            if (cieq(f->name, fname))
+                break;
+
+    if (!f)
+        return PT_mkfnode(fname, arg);
+
+    for (n = 1, w = arg; w->type == PT_COMMA; w = w->left)
+        n++;
+
+    if (n != f->numParams) {
+        fprintf(stderr, "Error: function '%s' needs %d arguments at line %d\nfrom file\n  %s\n",
+            f->name, f->numParams, Current_parse_line, Sourcefile);
+        controlled_exit(EXIT_BAD);
+    }
+
+    parse_function(f);
+
+    return mkcall(f, arg);
+}
+
+static INPparseNode *mkcall(INPfunction *f, INPparseNode *args)
+{
+    INPparseNode *p = TMALLOC(INPparseNode, 1);
+
+    p->type = PT_CALL;
+    p->usecnt = 0;
+
+    p->left = inc_usage(args);
+    p->funcname = f->name;
+    p->data = f;
+    f->usecnt++;
+
+    return (p);
+}
+
+/* Call of the derivative of f wrt its k'th parameter, which is made
+ * when first needed.  Constant derivatives are folded here.
+ */
+
+static INPparseNode *mkdcall(INPfunction *f, int k, INPparseNode *args)
+{
+    INPfunction *df;
+
+    if (!f->derivs)
+        f->derivs = TMALLOC(INPfunction *, f->numParams);
+
+    df = f->derivs[k];
+
+    if (!df) {
+        df = TMALLOC(INPfunction, 1);
+        df->name = tprintf("d%s/d%s", f->name, f->params[k]);
+        df->numParams = f->numParams;
+        df->params = f->params;
+        df->ckt = f->ckt;
+        df->tree = inc_usage(PTdifferentiate(f->tree, k));
+        df->usecnt = 1;
+        f->derivs[k] = df;
+    }
+
+    if (df->tree->type == PT_CONSTANT)
+        return mkcon(df->tree->constant);
+
+    return mkcall(df, args);
+}
+
+/* Parse the body of f, once, with PT_ARG nodes for its parameters */
+
+static void parse_function(INPfunction *f)
+{
+    INPfunction *caller = function;
+    INPparseNode *p = NULL;
+    char *line = f->body;
+    int rv;
+
+    if (f->tree)
+        return;
+
+    if (f->busy) {
+        fprintf(stderr, "Error: recursive call of function '%s' at line %d\nfrom file\n  %s\n",
+            f->name, Current_parse_line, Sourcefile);
+        controlled_exit(EXIT_BAD);
+    }
+
+    f->busy = 1;
+    function = f;
+
+    rv = PTparse(&line, &p, f->ckt);
+
+    function = caller;
+    f->busy = 0;
+
+    if (rv || !p || !PTcheck(p, f->body)) {
+        fprintf(stderr, "Error: bad body of function '%s'\n", f->name);
+        controlled_exit(EXIT_BAD);
+    }
+
+    f->tree = inc_usage(p);
+}
+
+static void release_function(INPfunction *f)
+{
+    int i;
+
+    if (!f || --f->usecnt > 0)
+        return;
+
+    dec_usage(f->tree);
+
+    if (f->derivs) {
+        for (i = 0; i < f->numParams; i++)
+            release_function(f->derivs[i]);
+        txfree(f->derivs);
+    }
+
+    /* derivatives share the parameter names */
+    if (f->body) {
+        for (i = 0; i < f->numParams; i++)
+            txfree(f->params[i]);
+        txfree(f->params);
+        txfree(f->body);
+    }
+
+    txfree(f->name);
+    txfree(f);
+}
+
+/* Add the function of a `.func name(param, ...) body' line to tab.  The
+ * front end leaves only those functions here which can be called from a
+ * B source, see inp_expand_macros_in_deck().
+ */
+
+char *INPdefineFunction(CKTcircuit *ckt, char *line, INPtables *tab)
+{
+    INPfunction *f;
+    char *end;
+
+    /* skip `.func' */
+    line = skip_ws(skip_non_ws(line));
+
+    for (end = line; *end && *end != '(' && !isspace_c(*end); end++)
+        ;
+
+    if (end == line || *skip_ws(end) != '(')
+        return INPmkTemp(" Error: function name expected in .func line\n");
+
+    f = TMALLOC(INPfunction, 1);
+    f->name = copy_substring(line, end);
+    strtolower(f->name);
+    f->params = TMALLOC(char *, PT_MAXARGS);
+    f->ckt = ckt;
+    f->usecnt = 1;
+
+    for (line = skip_ws(skip_ws(end) + 1); *line && *line != ')'; ) {
+        for (end = line; *end && *end != ',' && *end != ')' && !isspace_c(*end); end++)
+            ;
+        if (end == line || f->numParams == PT_MAXARGS)
+            break;
+        f->params[f->numParams] = copy_substring(line, end);
+        strtolower(f->params[f->numParams++]);
+        line = skip_ws(end);
+        if (*line == ',')
+            line = skip_ws(line + 1);
+    }
+
+    if (*line != ')' || f->numParams == 0) {
+        f->body = copy("");
+        release_function(f);
+        return INPmkTemp(" Error: bad parameter list in .func line\n");
+    }
+
+    f->body = copy(skip_ws(line + 1));
+
+    f->next = tab->INPfunctions;
+    tab->INPfunctions = f;
+
+    return NULL;
+}
+
+void INPfreeFunctions(INPtables *tab)
+{
+    INPfunction *f, *next;
+
+    for (f = tab->INPfunctions; f; f = next) {
+        next = f->next;
+        release_function(f);
+    }
+
+    tab->INPfunctions = NULL;
+}
+
+bool INPfunctionBuiltin(const char *name)
+{
+    int i;
+
+    if (cieq(name, "ternary_fcn"))
+        return TRUE;
+
+    /* pwl() needs literal points, ddt() keeps a history per node */
+    for (i = 0; i < NUM_FUNCS; i++)
+        if (cieq(funcs[i].name, name))
+            return funcs[i].number != PTF_PWL &&
+                funcs[i].number != PTF_PWL_DERIVATIVE &&
+                funcs[i].number != PTF_DDT;
+
+    return FALSE;
+}
+
 static INPparseNode *mkvnode(char *name)
 {
     INPparseNode *p = TMALLOC(INPparseNode, 1);
@@ -1253,6 +1535,12 @@ static INPparseNode *mkvnode(char *name)
     int i;
     CKTnode *temp;
 
+    if (function) {
+        fprintf(stderr, "Error: v() or i() in the body of function '%s'\n",
+            function->name);
+        controlled_exit(EXIT_BAD);
+    }
+
     INPtermInsert(circuit, &name, tables, &temp);
     for (i = 0; i < numvalues; i++)
         if ((types[i] == IF_NODE) && (values[i].nValue == temp))
@@ -1282,6 +1570,12 @@ static INPparseNode *mkinode(char *name)
 
     int i;
 
+    if (function) {
+        fprintf(stderr, "Error: v() or i() in the body of function '%s'\n",
+            function->name);
+        controlled_exit(EXIT_BAD);
+    }
+
     INPinsert(&name, tables);
     for (i = 0; i < numvalues; i++)
         if ((types[i] == IF_INSTANCE) && (values[i].uValue == name))
@@ -1338,6 +1632,15 @@ INPparseNode *PT_mksnode(const char *string, void *ckt)
 
     p->usecnt = 0;
 
+    /* A parameter in the body of a .func */
+    if (function)
+        for (i = 0; i < function->numParams; i++)
+            if (!strcmp(function->params[i], buf)) {
+                p->type = PT_ARG;
+                p->valueIndex = i;
+                return p;
+            }
+
     if(!strcmp("time", buf)) {
         p->type = PT_TIME;
         p->data = ckt;
@@ -1649,6 +1952,12 @@ void free_tree(INPparseNode *pt)
     case PT_FREQUENCY:
     case PT_CONSTANT:
     case PT_VAR:
+    case PT_ARG:
+        break;
+
+    case PT_CALL:
+        dec_usage(pt->left);
+        release_function((INPfunction *) pt->data);
         break;
 
     case PT_PLUS:
@@ -1739,6 +2048,16 @@ void printTree(INPparseNode * pt)
         printf("v%d", pt->valueIndex);
         break;
 
+    case PT_ARG:
+        printf("arg%d", pt->valueIndex);
+        break;
+
+    case PT_CALL:
+        printf("%s (", pt->funcname);
+        printTree(pt->left);
+        printf(")");
+        break;
+
     case PT_PLUS:
         printf("(");
         printTree(pt->left);
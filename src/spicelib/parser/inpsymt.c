@@ -267,6 +267,7 @@ void INPtabEnd(INPtables * tab)
             FREE(n);		/* But not t_node ! */
         }
     FREE(tab->INPtermsymtab);
+    INPfreeFunctions(tab);
     FREE(tab);
     return;
 }
@@ -99,13 +99,13 @@ void cm_analog_alloc(
 
 
     /* Get the address of the ckt and instance structs from g_mif_info */
-    here = g_mif_info.instance;
-    ckt  = g_mif_info.ckt;
+    here = MIF_INFO->instance;
+    ckt  = MIF_INFO->ckt;
 
     /* Scan states in instance struct and see if tag has already been used */
     for(i = 0; i < here->num_state; i++) {
         if(tag == here->state[i].tag) {
-            g_mif_info.errmsg = "ERROR - cm_analog_alloc() - Tag already used in previous call\n";
+            MIF_INFO->errmsg = "ERROR - cm_analog_alloc() - Tag already used in previous call\n";
             return;
         }
     }
@@ -130,6 +130,16 @@ void cm_analog_alloc(
     state->doubles = doubles_needed;
     state->bytes = bytes;
 
+    /* Record the state index of small tags for cm_analog_get_ptr() */
+    if((tag >= 0) && (tag < MIF_TAG_TABLE_MAX)) {
+        if(tag >= here->num_state_offset) {
+            here->state_offset = TREALLOC(int, here->state_offset, tag + 1);
+            for(i = here->num_state_offset; i <= tag; i++)
+                here->state_offset[i] = -1;
+            here->num_state_offset = tag + 1;
+        }
+        here->state_offset[tag] = state->index;
+    }
 
     /* Add the states to the ckt->CKTstates vectors */
     ckt->CKTnumStates += doubles_needed;
@@ -160,40 +170,44 @@ void *cm_analog_get_ptr(
     MIFinstance *here;
     CKTcircuit  *ckt;
 
-    Mif_State_t *state=NULL;
-
-    Mif_Boolean_t  got_tag;
-
+    int         index;
     int         i;
 
 
     /* Get the address of the ckt and instance structs from g_mif_info */
-    here = g_mif_info.instance;
-    ckt  = g_mif_info.ckt;
-
-    /* Scan states in instance struct and see if tag exists */
-    for(got_tag = MIF_FALSE, i = 0; i < here->num_state; i++) {
-        if(tag == here->state[i].tag) {
-            state = &(here->state[i]);
-            got_tag = MIF_TRUE;
-            break;
+    here = MIF_INFO->instance;
+    ckt  = MIF_INFO->ckt;
+
+    /* Look up the state index of this tag in the table filled by */
+    /* cm_analog_alloc(), or scan states in instance struct for large tags */
+    index = -1;
+    if((tag >= 0) && (tag < MIF_TAG_TABLE_MAX)) {
+        if(tag < here->num_state_offset)
+            index = here->state_offset[tag];
+    }
+    else {
+        for(i = 0; i < here->num_state; i++) {
+            if(tag == here->state[i].tag) {
+                index = here->state[i].index;
+                break;
+            }
         }
     }
 
     /* Return error if tag not found */
-    if(! got_tag) {
-        g_mif_info.errmsg = "ERROR - cm_analog_get_ptr() - Bad tag\n";
+    if(index < 0) {
+        MIF_INFO->errmsg = "ERROR - cm_analog_get_ptr() - Bad tag\n";
         return(NULL);
     }
 
     /* Return error if timepoint is not 0 or 1 */
     if((timepoint < 0) || (timepoint > 1)) {
-        g_mif_info.errmsg = "ERROR - cm_analog_get_ptr() - Bad timepoint\n";
+        MIF_INFO->errmsg = "ERROR - cm_analog_get_ptr() - Bad timepoint\n";
         return(NULL);
     }
 
     /* Return address of requested state in ckt->CKTstates[timepoint] vector */
-    return( (void *) (ckt->CKTstates[timepoint] + state->index) );
+    return( (void *) (ckt->CKTstates[timepoint] + index) );
 
 }
 
@@ -232,12 +246,12 @@ int  cm_analog_integrate(
 
 
     /* Get the address of the ckt and instance structs from g_mif_info */
-    here = g_mif_info.instance;
-    ckt  = g_mif_info.ckt;
+    here = MIF_INFO->instance;
+    ckt  = MIF_INFO->ckt;
 
     /* Check to be sure we're in transient analysis */
-    if(g_mif_info.circuit.anal_type != MIF_TRAN) {
-        g_mif_info.errmsg =
+    if(MIF_INFO->circuit.anal_type != MIF_TRAN) {
+        MIF_INFO->errmsg =
         "ERROR - cm_analog_integrate() - Called in non-transient analysis\n";
         *partial  = 0.0;
         return(MIF_ERROR);
@@ -245,7 +259,7 @@ int  cm_analog_integrate(
 
     /* Preliminary check to be sure argument was allocated by cm_analog_alloc() */
     if(ckt->CKTnumStates <= 0) {
-        g_mif_info.errmsg =
+        MIF_INFO->errmsg =
         "ERROR - cm_analog_integrate() - Integral must be memory allocated by cm_analog_alloc()\n";
         *partial  = 0.0;
         return(MIF_ERROR);
@@ -259,7 +273,7 @@ int  cm_analog_integrate(
     /* Check to be sure argument address is in range of state0 vector */
     if((byte_index < 0) ||
        (byte_index > (ckt->CKTnumStates - 1) * (int) sizeof(double))) {
-        g_mif_info.errmsg =
+        MIF_INFO->errmsg =
         "ERROR - cm_analog_integrate() - Argument must be in state vector 0\n";
         *partial  = 0.0;
         return(MIF_ERROR);
@@ -273,8 +287,8 @@ int  cm_analog_integrate(
     }
 
     /* Report error if not found and this is not the first load pass in tran analysis */
-    if((! got_index) && (! g_mif_info.circuit.anal_init)) {
-        g_mif_info.errmsg =
+    if((! got_index) && (! MIF_INFO->circuit.anal_init)) {
+        MIF_INFO->errmsg =
         "ERROR - cm_analog_integrate() - New integral and not initialization pass\n";
         *partial  = 0.0;
         return(MIF_ERROR);
@@ -295,8 +309,8 @@ int  cm_analog_integrate(
         intgr = &(here->intgr[here->num_intgr - 1]);
         intgr->byte_index = byte_index;
         if(cm_analog_converge(integral)) {
-            printf("%s\n",g_mif_info.errmsg);
-            g_mif_info.errmsg = "ERROR - cm_analog_integrate() - Failure in cm_analog_converge() call\n";
+            printf("%s\n",MIF_INFO->errmsg);
+            MIF_INFO->errmsg = "ERROR - cm_analog_integrate() - Failure in cm_analog_converge() call\n";
             return(MIF_ERROR);
         }
     }
@@ -334,12 +348,12 @@ int  cm_analog_converge(
 
 
     /* Get the address of the ckt and instance structs from g_mif_info */
-    here = g_mif_info.instance;
-    ckt  = g_mif_info.ckt;
+    here = MIF_INFO->instance;
+    ckt  = MIF_INFO->ckt;
 
     /* Preliminary check to be sure argument was allocated by cm_analog_alloc() */
     if(ckt->CKTnumStates <= 0) {
-        g_mif_info.errmsg =
+        MIF_INFO->errmsg =
         "ERROR - cm_analog_converge() - Argument must be memory allocated by cm_analog_alloc()\n";
         return(MIF_ERROR);
     }
@@ -352,7 +366,7 @@ int  cm_analog_converge(
     /* Check to be sure argument address is in range of state0 vector */
     if((byte_index < 0) ||
        (byte_index > (ckt->CKTnumStates - 1) * (int) sizeof(double))) {
-        g_mif_info.errmsg =
+        MIF_INFO->errmsg =
         "ERROR - cm_analog_converge() - Argument must be in state vector 0\n";
         return(MIF_ERROR);
     }
@@ -393,7 +407,7 @@ by a call to some code model support function.
 
 char *cm_message_get_errmsg(void)
 {
-    return(g_mif_info.errmsg);
+    return(MIF_INFO->errmsg);
 }
 
 
@@ -419,29 +433,34 @@ int cm_analog_set_temp_bkpt(
     double time)              /* The time of the breakpoint to be set */
 {
     CKTcircuit  *ckt;
+    int         discard;
 
 
     /* Get the address of the ckt and instance structs from g_mif_info */
-    ckt  = g_mif_info.ckt;
+    ckt  = MIF_INFO->ckt;
 
     /* Make sure breakpoint is not prior to last accepted timepoint */
     if(time < ((ckt->CKTtime - ckt->CKTdelta) + ckt->CKTminBreak)) {
-        g_mif_info.errmsg =
+        MIF_INFO->errmsg =
         "ERROR - cm_analog_set_temp_bkpt() - Time < last accepted timepoint\n";
         return(MIF_ERROR);
     }
 
     /* If too close to a permanent breakpoint or the current time, discard it */
-    if ((ckt->CKTbreaks &&
-         (fabs(time - ckt->CKTbreaks[0]) < ckt->CKTminBreak ||
-          fabs(time - ckt->CKTbreaks[1]) < ckt->CKTminBreak)) ||
-        fabs(time - ckt->CKTtime) < ckt->CKTminBreak) {
+    /* The breakpoint list may be extended concurrently by other threads */
+#ifdef USE_OMP
+#pragma omp critical (cm_breakpoint)
+#endif
+    discard = (ckt->CKTbreaks &&
+               (fabs(time - ckt->CKTbreaks[0]) < ckt->CKTminBreak ||
+                fabs(time - ckt->CKTbreaks[1]) < ckt->CKTminBreak)) ||
+              fabs(time - ckt->CKTtime) < ckt->CKTminBreak;
+    if (discard)
         return(MIF_OK);
-    }
 
     /* If < current dynamic breakpoint, make it the current breakpoint */
-    if( time < g_mif_info.breakpoint.current)
-        g_mif_info.breakpoint.current = time;
+    if( time < MIF_INFO->breakpoint.current)
+        MIF_INFO->breakpoint.current = time;
 
     return(MIF_OK);
 }
@@ -473,13 +492,17 @@ int cm_analog_set_perm_bkpt(
 
 
     /* Get the address of the ckt and instance structs from g_mif_info */
-    ckt  = g_mif_info.ckt;
+    ckt  = MIF_INFO->ckt;
 
     /* Call cm_analog_set_temp_bkpt() to force backup if less than current time */
     if(time < (ckt->CKTtime + ckt->CKTminBreak))
         return(cm_analog_set_temp_bkpt(time));
-    else
+    else {
+#ifdef USE_OMP
+#pragma omp critical (cm_breakpoint)
+#endif
         CKTsetBreak(ckt,time);
+    }
 
     return(MIF_OK);
 }
@@ -502,7 +525,7 @@ double cm_analog_ramp_factor(void)
     CKTcircuit  *ckt;
 
     /* Get the address of the ckt and instance structs from g_mif_info */
-    ckt  = g_mif_info.ckt;
+    ckt  = MIF_INFO->ckt;
 
 
     /* if ramptime == 0.0, no ramptime option given, so return 1.0 */
@@ -554,7 +577,7 @@ static void cm_static_integrate(int    byte_index,
 
 
     /* Get the address of the ckt struct from g_mif_info */
-    ckt  = g_mif_info.ckt;
+    ckt  = MIF_INFO->ckt;
 
     /* Get integral values from current and previous timesteps */
     for(i = 0; i <= ckt->CKTorder; i++) {
@@ -649,7 +672,12 @@ its inputs to assist convergence.
 
 void cm_analog_not_converged(void)
 {
-    (g_mif_info.ckt->CKTnoncon)++;
+    CKTcircuit *ckt = MIF_INFO->ckt;
+
+#ifdef USE_OMP
+#pragma omp atomic
+#endif
+    (ckt->CKTnoncon)++;
 }
 
 
@@ -669,9 +697,12 @@ int cm_message_send(
     MIFinstance *here;
 
     /* Get the address of the instance struct from g_mif_info */
-    here = g_mif_info.instance;
+    here = MIF_INFO->instance;
 
     /* Print the name of the instance and the message */
+#ifdef USE_OMP
+#pragma omp critical (cm_message)
+#endif
     printf("\nInstance: %s   Message: %s\n", here->MIFname, msg);
 
     return(0);
@@ -697,7 +728,7 @@ calculations.
 
 void cm_analog_auto_partial(void)
 {
-    g_mif_info.auto_partial.local = MIF_TRUE;
+    MIF_INFO->auto_partial.local = MIF_TRUE;
 }
 
 /*
@@ -729,7 +760,7 @@ access to the (fundamental) ckt pointer.
 
 CKTcircuit *cm_get_circuit(void)
 {
-    return(g_mif_info.ckt);
+    return(MIF_INFO->ckt);
 }
 
 /* Set the "irreversible" flag on the current instance and shuffle it to the
@@ -756,8 +787,8 @@ void cm_irreversible(unsigned int place)
     int               old_index, i;
     unsigned int      value;
 
-    instance = g_mif_info.instance;
-    if (!g_mif_info.circuit.init) {
+    instance = MIF_INFO->instance;
+    if (!MIF_INFO->circuit.init) {
         fprintf(cp_err,
                 "%s: Ignoring call to cm_irreversible(): not in INIT\n",
                 instance->gen.GENname);
@@ -772,7 +803,7 @@ void cm_irreversible(unsigned int place)
     }
     instance->irreversible = place;
 
-    evt = g_mif_info.ckt->evt;
+    evt = MIF_INFO->ckt->evt;
     num_hybrids = evt->counts.num_hybrids;
     hybrids = evt->info.hybrids;
 
@@ -835,7 +866,7 @@ const char *cm_get_node_name(const char *port_name, unsigned int index)
     Mif_Port_Data_t  *port;
     int               i;
 
-    instance = g_mif_info.instance;
+    instance = MIF_INFO->instance;
     for (i = 0; i < instance->num_conn; ++i) {
         conn = instance->conn[i];
         if (!strcmp(port_name, conn->name)) {
@@ -846,7 +877,7 @@ const char *cm_get_node_name(const char *port_name, unsigned int index)
                 /* Event node, no name in port data. */
 
                 i = port->evt_data.node_index;
-                return g_mif_info.ckt->evt->info.node_table[i]->name;
+                return MIF_INFO->ckt->evt->info.node_table[i]->name;
             }
             return port->pos_node_str;
         }
@@ -871,7 +902,7 @@ bool cm_probe_node(unsigned int  conn_index,  // Connection index
     void             *hold;
     int               num_outputs;
 
-    instance = g_mif_info.instance;
+    instance = MIF_INFO->instance;
     if (conn_index >= (unsigned int)instance->num_conn)
         return FALSE;
     conn = instance->conn[conn_index];
@@ -881,11 +912,11 @@ bool cm_probe_node(unsigned int  conn_index,  // Connection index
     if (port->type != MIF_DIGITAL && port->type != MIF_USER_DEFINED)
         return FALSE;
     edata = &port->evt_data;
-    node_info = g_mif_info.ckt->evt->info.node_table[edata->node_index];
+    node_info = MIF_INFO->ckt->evt->info.node_table[edata->node_index];
     num_outputs = node_info->num_outputs;
     if (num_outputs <= 1)
         return num_outputs == 1;    // This should be the only output.
-    this = g_mif_info.ckt->evt->data.node->rhsold + edata->node_index;
+    this = MIF_INFO->ckt->evt->data.node->rhsold + edata->node_index;
 
     /* Replace the actual output with the test value and resolve.
      * It is assumed that the resolve function will not use its output
@@ -79,13 +79,13 @@ void cm_event_alloc(
 
 
     /* Get the address of the ckt and instance structs from g_mif_info */
-    here = g_mif_info.instance;
-    ckt  = g_mif_info.ckt;
+    here = MIF_INFO->instance;
+    ckt  = MIF_INFO->ckt;
 
 
     /* If not initialization pass, return error */
     if(here->initialized) {
-        g_mif_info.errmsg =
+        MIF_INFO->errmsg =
         "ERROR - cm_event_alloc() - Cannot alloc when not initialization pass\n";
         return;
     }
@@ -103,7 +103,7 @@ void cm_event_alloc(
     num_tags = 1;
     while(desc) {
         if(desc->tag == tag) {
-            g_mif_info.errmsg =
+            MIF_INFO->errmsg =
             "ERROR - cm_event_alloc() - Duplicate tag\n";
             return;
         }
@@ -118,8 +118,23 @@ void cm_event_alloc(
     desc = *desc_ptr;
     desc->tag = tag;
     desc->size = bytes;
-    desc->offset = state_data->total_size[inst_index];
-    state_data->total_size[inst_index] += bytes;
+    desc->index = state_data->num_desc[inst_index];
+
+    state_data->num_desc[inst_index]++;
+
+    /* Record small tags in the table used by cm_event_get_ptr() */
+    if((tag >= 0) && (tag < MIF_TAG_TABLE_MAX)) {
+        int num_table = state_data->num_desc_table[inst_index];
+        if(tag >= num_table) {
+            state_data->desc_table[inst_index] =
+                TREALLOC(Evt_State_Desc_t *, state_data->desc_table[inst_index],
+                         tag + 1);
+            for(; num_table <= tag; num_table++)
+                state_data->desc_table[inst_index][num_table] = NULL;
+            state_data->num_desc_table[inst_index] = num_table;
+        }
+        state_data->desc_table[inst_index][tag] = desc;
+    }
 
     /* Create a new state structure if list starting at head is null */
     state = state_data->head[inst_index];
@@ -128,14 +143,13 @@ void cm_event_alloc(
         state_data->head[inst_index] = state;
     }
 
-    /* Create or enlarge the block and set the time */
-    if(num_tags == 1)
-        state->block = tmalloc((size_t) state_data->total_size[inst_index]);
-    else
-        state->block = trealloc(state->block,
-                             (size_t) state_data->total_size[inst_index]);
+    /* Give the state its own memory for the tag and set the time */
+    state->data = TREALLOC(void *, state->data, num_tags);
+    state->own = TREALLOC(void *, state->own, num_tags);
+    state->own[desc->index] = tmalloc((size_t) bytes);
+    state->data[desc->index] = state->own[desc->index];
 
-    state->step = g_mif_info.circuit.evt_step;
+    state->step = MIF_INFO->circuit.evt_step;
 }
 
 
@@ -151,6 +165,11 @@ specified in its argument list is used to locate the state in
 question.  A second argument specifies whether the desired state
 is for the current timestep or from a preceding timestep.  The
 location of the state in memory is then computed and returned.
+
+A new state shares the memory of each tag with the preceding one.
+Asking for the current timestep copies the tag into memory of its own,
+so that the model may write to it, while tags that are not written
+are never copied.
 */
 
 
@@ -174,13 +193,13 @@ void *cm_event_get_ptr(
 
 
     /* Get the address of the ckt and instance structs from g_mif_info */
-    here = g_mif_info.instance;
-    ckt  = g_mif_info.ckt;
+    here = MIF_INFO->instance;
+    ckt  = MIF_INFO->ckt;
 
 
     /* If initialization pass, return error */
     if((! here->initialized) && (timepoint > 0)) {
-        g_mif_info.errmsg =
+        MIF_INFO->errmsg =
         "ERROR - cm_event_get_ptr() - Cannot get_ptr(tag,1) during initialization pass\n";
         return(NULL);
     }
@@ -189,17 +208,26 @@ void *cm_event_get_ptr(
     inst_index = here->inst_index;
     state_data = ckt->evt->data.state;
 
-    /* Scan state descriptor list to find the descriptor for this tag. */
+    /* Look up the descriptor for this tag in the table filled by */
+    /* cm_event_alloc(), or scan state descriptor list for large tags. */
     /* Report error if tag not found */
-    desc = state_data->desc[inst_index];
-    while(desc) {
-        if(desc->tag == tag)
-            break;
-        desc = desc->next;
+    if((tag >= 0) && (tag < MIF_TAG_TABLE_MAX)) {
+        if(tag < state_data->num_desc_table[inst_index])
+            desc = state_data->desc_table[inst_index][tag];
+        else
+            desc = NULL;
+    }
+    else {
+        desc = state_data->desc[inst_index];
+        while(desc) {
+            if(desc->tag == tag)
+                break;
+            desc = desc->next;
+        }
     }
 
     if(desc == NULL) {
-        g_mif_info.errmsg =
+        MIF_INFO->errmsg =
         "ERROR - cm_event_get_ptr() - Specified tag not found\n";
         return(NULL);
     }
@@ -212,8 +240,17 @@ void *cm_event_get_ptr(
         if(state->prev)
             state = state->prev;
 
+    /* Copy on first write access in this timestep */
+    if((timepoint == 0) && (state->data[desc->index] != state->own[desc->index])) {
+        if(state->own[desc->index] == NULL)
+            state->own[desc->index] = tmalloc((size_t) desc->size);
+        memcpy(state->own[desc->index], state->data[desc->index],
+               (size_t) desc->size);
+        state->data[desc->index] = state->own[desc->index];
+    }
+
     /* Return pointer */
-    ptr = ((char *) state->block) + desc->offset;
+    ptr = state->data[desc->index];
     return(ptr);
 }
 
@@ -237,18 +274,18 @@ int  cm_event_queue(
 
 
     /* Get the address of the ckt and instance structs from g_mif_info */
-    here = g_mif_info.instance;
-    ckt  = g_mif_info.ckt;
+    here = MIF_INFO->instance;
+    ckt  = MIF_INFO->ckt;
 
     /* If breakpoint time <= current event time, return error */
-    if(time <= g_mif_info.circuit.evt_step) {
-        g_mif_info.errmsg =
+    if(time <= MIF_INFO->circuit.evt_step) {
+        MIF_INFO->errmsg =
         "ERROR - cm_event_queue() - Event time cannot be <= current time\n";
         return(MIF_ERROR);
     }
 
     /* Add the event time to the inst queue */
-    EVTqueue_inst(ckt, here->inst_index, g_mif_info.circuit.evt_step,
+    EVTqueue_inst(ckt, here->inst_index, MIF_INFO->circuit.evt_step,
                   time);
 
     return(MIF_OK);
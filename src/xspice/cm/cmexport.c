@@ -2,6 +2,7 @@
 #include "ngspice/mif.h"
 #include "ngspice/cm.h"
 #include "ngspice/dllitf.h"
+#include "../../misc/zfile.h"
 
 /*how annoying!, needed for structure below*/
 static void *tcalloc(size_t a, size_t b) {
@@ -89,7 +90,8 @@ struct coreInfo_t  coreInfo =
   no_free,
   GC_malloc,
   GC_realloc,
-  no_free
+  no_free,
+  cm_cexit
 #endif
 #ifdef KLU
   ,
@@ -97,4 +99,6 @@ struct coreInfo_t  coreInfo =
   MIFbindCSCComplex,
   MIFbindCSCComplexToReal
 #endif
+  ,
+  ngzfopen
 };
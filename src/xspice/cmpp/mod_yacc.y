@@ -182,6 +182,127 @@ static void put_conn_type (FILE *fp, Port_Type_t type)
    fprintf (fp, ".%cvalue", ch);
 }
 
+/*---------------------------------------------------------------------------*/
+static char *c_type (Data_Type_t type)
+{
+   switch (type) {
+   case CMPP_BOOLEAN:
+      return "Mif_Boolean_t";
+   case CMPP_INTEGER:
+      return "int";
+   case CMPP_REAL:
+      return "double";
+   case CMPP_COMPLEX:
+      return "Mif_Complex_t";
+   case CMPP_STRING:
+      return "char *";
+   case CMPP_POINTER:
+      return "void *";
+   }
+   return "double";
+}
+
+/*---------------------------------------------------------------------------*/
+/*
+ * Write the struct read by the accessor macros and the function
+ * <c_fcn_name>_resolve() that fills it, once per instance at setup.
+ * Scalar parameters are copied with their C type, array parameters
+ * and ports are kept as pointers to their elements.  The function
+ * returns the size of the struct, and fills it if resolved is not NULL.
+ */
+void mod_write_resolved (FILE *fp)
+{
+   char *fn = mod_ifs_table->name.c_fcn_name;
+   int i;
+
+   fprintf (fp, "struct %s_resolved {\n", fn);
+   for (i = 0; i < mod_ifs_table->num_param; i++) {
+      Param_Info_t *param = &mod_ifs_table->param[i];
+      if (param->is_array) {
+	 fprintf (fp, "    Mif_Value_t *param_%s;\n", param->name);
+      } else {
+	 fprintf (fp, "    %s param_%s;\n", c_type (param->type), param->name);
+      }
+   }
+   for (i = 0; i < mod_ifs_table->num_conn; i++) {
+      Conn_Info_t *conn = &mod_ifs_table->conn[i];
+      fprintf (fp, "    Mif_Port_Data_t %sconn_%s;\n",
+	       conn->is_array ? "**" : "*", conn->name);
+   }
+   if (mod_ifs_table->num_param + mod_ifs_table->num_conn == 0) {
+      fprintf (fp, "    char unused;\n");
+   }
+   fprintf (fp, "};\n");
+
+   fprintf (fp, "extern size_t %s_resolve(Mif_Private_t *, void *);\n", fn);
+   fprintf (fp, "size_t %s_resolve(Mif_Private_t *mif_private, void *resolved)\n"
+	    "{\n"
+	    "    struct %s_resolved *r = (struct %s_resolved *) resolved;\n"
+	    "    if (r) {\n", fn, fn, fn);
+   for (i = 0; i < mod_ifs_table->num_param; i++) {
+      Param_Info_t *param = &mod_ifs_table->param[i];
+      if (param->is_array) {
+	 fprintf (fp, "        r->param_%s = mif_private->param[%d]->element;\n",
+		  param->name, i);
+      } else {
+	 fprintf (fp, "        r->param_%s = mif_private->param[%d]->element[0]",
+		  param->name, i);
+	 put_type (fp, param->type);
+	 fprintf (fp, ";\n");
+      }
+   }
+   for (i = 0; i < mod_ifs_table->num_conn; i++) {
+      Conn_Info_t *conn = &mod_ifs_table->conn[i];
+      if (conn->is_array) {
+	 fprintf (fp, "        r->conn_%s = mif_private->conn[%d]->port;\n",
+		  conn->name, i);
+      } else {
+	 fprintf (fp, "        r->conn_%s = mif_private->conn[%d]->size > 0 ?\n"
+		  "            mif_private->conn[%d]->port[0] : NULL;\n",
+		  conn->name, i, i);
+      }
+   }
+   fprintf (fp, "    }\n"
+	    "    return sizeof(struct %s_resolved);\n"
+	    "}\n", fn);
+}
+
+/*---------------------------------------------------------------------------*/
+static void put_resolved (FILE *fp)
+{
+   fprintf (fp, "((struct %s_resolved *) mif_private->resolved)",
+	    mod_ifs_table->name.c_fcn_name);
+}
+
+/*---------------------------------------------------------------------------*/
+/* Value of parameter i, element sub_id for an array */
+static void put_param (FILE *fp, int i, Sub_Id_t sub_id)
+{
+   if (i < 0) {
+      return;
+   }
+   put_resolved (fp);
+   fprintf (fp, "->param_%s", mod_ifs_table->param[i].name);
+   if (mod_ifs_table->param[i].is_array) {
+      fprintf (fp, "[%s]", subscript (sub_id));
+      put_type (fp, mod_ifs_table->param[i].type);
+   }
+}
+
+/*---------------------------------------------------------------------------*/
+/* Port data of connection i, port sub_id for an array */
+static void put_port (FILE *fp, int i, Sub_Id_t sub_id)
+{
+   if (i < 0) {
+      return;
+   }
+   put_resolved (fp);
+   fprintf (fp, "->conn_%s", mod_ifs_table->conn[i].name);
+   if (mod_ifs_table->conn[i].is_array) {
+      fprintf (fp, "[%s]", subscript (sub_id));
+   }
+}
+
 /*---------------------------------------------------------------------------*/
 static void check_dir (int conn_number, Dir_t dir, char *context)
 {
@@ -353,11 +474,13 @@ static void append (char *str)
 %token TOK_INPUT_STRENGTH
 %token TOK_INPUT_STATE
 %token TOK_INPUT_TYPE
+%token TOK_INPUT_DUAL
 %token TOK_OUTPUT
 %token TOK_OUTPUT_CHANGED
 %token TOK_OUTPUT_STRENGTH
 %token TOK_OUTPUT_STATE
 %token TOK_OUTPUT_TYPE
+%token TOK_OUTPUT_DUAL
 %token TOK_COMMA
 %token TOK_LPAREN
 %token TOK_RPAREN
@@ -421,6 +544,11 @@ c_char			: TOK_IDENTIFIER {fputs (mod_yytext, mod_yyout);}
 				{putc (')', mod_yyout);}
 			;
 
+/* PARAM and the port macros read the struct written by
+ * mod_write_resolved(), e.g. PARAM(x) becomes
+ * ((struct <c_fcn_name>_resolved *) mif_private->resolved)->param_x.
+ * The sizes, null flags and static variables are read from mif_private. */
+
 macro			: TOK_INIT
 			   {fprintf (mod_yyout, "mif_private->circuit.init");}
 			| TOK_CALLBACK
@@ -443,9 +571,7 @@ macro			: TOK_INIT
 			   {fprintf (mod_yyout, "mif_private->circuit.t[%s]", $3);}
 			| TOK_PARAM TOK_LPAREN subscriptable_id TOK_RPAREN
 			   {int i = valid_subid ($3, PARAM);
-			    fprintf (mod_yyout, "mif_private->param[%d]->element[%s]",
-				     i, subscript ($3));
-			    put_type (mod_yyout, mod_ifs_table->param[i].type);
+			    put_param (mod_yyout, i, $3);
 			   }    
 			| TOK_PARAM_SIZE TOK_LPAREN id TOK_RPAREN
 			   {int i = valid_id ($3, PARAM);
@@ -465,17 +591,18 @@ macro			: TOK_INIT
 			    int j = valid_subid ($5, CONN);
 			    check_dir (i, CMPP_OUT, "PARTIAL");
 			    check_dir (j, CMPP_IN, "PARTIAL");
-			    fprintf (mod_yyout, "mif_private->conn[%d]->port[%s]->partial[%d].port[%s]",
-				     i, subscript($3), j, subscript($5));}
+			    put_port (mod_yyout, i, $3);
+			    fprintf (mod_yyout, "->partial[%d].port[%s]", j,
+				     subscript($5));}
 			| TOK_AC_GAIN TOK_LPAREN subscriptable_id TOK_COMMA
 			  subscriptable_id TOK_RPAREN
 			   {int i = valid_subid ($3, CONN);
 			    int j = valid_subid ($5, CONN);
 			    check_dir (i, CMPP_OUT, "AC_GAIN");
 			    check_dir (j, CMPP_IN, "AC_GAIN");
-			    fprintf (mod_yyout, 
-				     "mif_private->conn[%d]->port[%s]->ac_gain[%d].port[%s]",
-				     i, subscript($3), j, subscript($5));}
+			    put_port (mod_yyout, i, $3);
+			    fprintf (mod_yyout, "->ac_gain[%d].port[%s]", j,
+				     subscript($5));}
 			| TOK_STATIC_VAR TOK_LPAREN subscriptable_id TOK_RPAREN
 			   {int i = valid_subid ($3, STATIC_VAR);
 			    fprintf (mod_yyout, 
@@ -499,99 +626,103 @@ macro			: TOK_INIT
 			| TOK_OUTPUT_DELAY TOK_LPAREN subscriptable_id TOK_RPAREN
 			   {int i = valid_subid ($3, CONN);
 			    check_dir (i, CMPP_OUT, "OUTPUT_DELAY");
-			    fprintf (mod_yyout, 
-				     "mif_private->conn[%d]->port[%s]->delay", i,
-				     subscript($3));}
+			    put_port (mod_yyout, i, $3);
+			    fprintf (mod_yyout, "->delay");}
 			| TOK_CHANGED TOK_LPAREN subscriptable_id TOK_RPAREN
 			   {int i = valid_subid ($3, CONN);
 			    check_dir (i, CMPP_OUT, "CHANGED");
-			    fprintf (mod_yyout, 
-				     "mif_private->conn[%d]->port[%s]->changed", i,
-				     subscript($3));}
+			    put_port (mod_yyout, i, $3);
+			    fprintf (mod_yyout, "->changed");}
 			| TOK_INPUT TOK_LPAREN subscriptable_id TOK_RPAREN
 			   {int i = valid_subid ($3, CONN);
  			    check_dir (i, CMPP_IN, "INPUT");
-			    fprintf (mod_yyout, 
-				     "mif_private->conn[%d]->port[%s]->input",
-				     i, subscript($3));
+			    put_port (mod_yyout, i, $3);
+			    fprintf (mod_yyout, "->input");
 			    put_conn_type (mod_yyout, 
 			       mod_ifs_table->conn[i].allowed_port_type[0]);}
-			| TOK_INPUT_TYPE TOK_LPAREN subscriptable_id TOK_RPAREN
+			| TOK_INPUT_DUAL TOK_LPAREN subscriptable_id TOK_RPAREN
 			   {int i = valid_subid ($3, CONN);
- 			    check_dir (i, CMPP_IN, "INPUT_TYPE");
+ 			    check_dir (i, CMPP_IN, "INPUT_DUAL");
 			    fprintf (mod_yyout, 
-				     "mif_private->conn[%d]->port[%s]->type_str",
+				     "cm_dual_input(mif_private, %d, %s)",
 				     i, subscript($3)); }
-			| TOK_OUTPUT_TYPE TOK_LPAREN subscriptable_id TOK_RPAREN
+			| TOK_OUTPUT_DUAL TOK_LPAREN subscriptable_id TOK_COMMA
 			   {int i = valid_subid ($3, CONN);
- 			    check_dir (i, CMPP_OUT, "OUTPUT_TYPE");
+ 			    check_dir (i, CMPP_OUT, "OUTPUT_DUAL");
 			    fprintf (mod_yyout, 
-				     "mif_private->conn[%d]->port[%s]->type_str",
+				     "cm_dual_output(mif_private, %d, %s, ",
 				     i, subscript($3)); }
+			  c_code TOK_RPAREN
+			   {putc (')', mod_yyout);}
+			| TOK_INPUT_TYPE TOK_LPAREN subscriptable_id TOK_RPAREN
+			   {int i = valid_subid ($3, CONN);
+ 			    check_dir (i, CMPP_IN, "INPUT_TYPE");
+			    put_port (mod_yyout, i, $3);
+			    fprintf (mod_yyout, "->type_str"); }
+			| TOK_OUTPUT_TYPE TOK_LPAREN subscriptable_id TOK_RPAREN
+			   {int i = valid_subid ($3, CONN);
+ 			    check_dir (i, CMPP_OUT, "OUTPUT_TYPE");
+			    put_port (mod_yyout, i, $3);
+			    fprintf (mod_yyout, "->type_str"); }
 			| TOK_INPUT_STRENGTH TOK_LPAREN subscriptable_id TOK_RPAREN
 			   {int i = valid_subid ($3, CONN);
  			    check_dir (i, CMPP_IN, "INPUT_STRENGTH");
-			    fprintf (mod_yyout, 
-				     "((Digital_t*)(mif_private->conn[%d]->port[%s]->input",
-				     i, subscript($3));
+			    fprintf (mod_yyout, "((Digital_t*)(");
+			    put_port (mod_yyout, i, $3);
+			    fprintf (mod_yyout, "->input");
 			    put_conn_type (mod_yyout, 
 			       mod_ifs_table->conn[i].allowed_port_type[0]);
 			    fprintf (mod_yyout, "))->strength");}
 			| TOK_INPUT_STATE TOK_LPAREN subscriptable_id TOK_RPAREN
 			   {int i = valid_subid ($3, CONN);
  			    check_dir (i, CMPP_IN, "INPUT_STATE");
-			    fprintf (mod_yyout, 
-				     "((Digital_t*)(mif_private->conn[%d]->port[%s]->input",
-				     i, subscript($3));
+			    fprintf (mod_yyout, "((Digital_t*)(");
+			    put_port (mod_yyout, i, $3);
+			    fprintf (mod_yyout, "->input");
 			    put_conn_type (mod_yyout, 
 			       mod_ifs_table->conn[i].allowed_port_type[0]);
 			    fprintf (mod_yyout, "))->state");}
 			| TOK_OUTPUT TOK_LPAREN subscriptable_id TOK_RPAREN
 			   {int i = valid_subid ($3, CONN);
  			    check_dir (i, CMPP_OUT, "OUTPUT");
-			    fprintf (mod_yyout, 
-				     "mif_private->conn[%d]->port[%s]->output",
-				     i, subscript($3));
+			    put_port (mod_yyout, i, $3);
+			    fprintf (mod_yyout, "->output");
 			    put_conn_type (mod_yyout, 
 			       mod_ifs_table->conn[i].allowed_port_type[0]);}
 			| TOK_OUTPUT_STRENGTH TOK_LPAREN subscriptable_id TOK_RPAREN
 			   {int i = valid_subid ($3, CONN);
  			    check_dir (i, CMPP_OUT, "OUTPUT_STRENGTH");
-			    fprintf (mod_yyout, 
-				     "((Digital_t*)(mif_private->conn[%d]->port[%s]->output",
-				     i, subscript($3));
+			    fprintf (mod_yyout, "((Digital_t*)(");
+			    put_port (mod_yyout, i, $3);
+			    fprintf (mod_yyout, "->output");
 			    put_conn_type (mod_yyout, 
 			       mod_ifs_table->conn[i].allowed_port_type[0]);
 			    fprintf (mod_yyout, "))->strength");}
 			| TOK_OUTPUT_STATE TOK_LPAREN subscriptable_id TOK_RPAREN
 			   {int i = valid_subid ($3, CONN);
  			    check_dir (i, CMPP_OUT, "OUTPUT_STATE");
-			    fprintf (mod_yyout, 
-				     "((Digital_t*)(mif_private->conn[%d]->port[%s]->output",
-				     i, subscript($3));
+			    fprintf (mod_yyout, "((Digital_t*)(");
+			    put_port (mod_yyout, i, $3);
+			    fprintf (mod_yyout, "->output");
 			    put_conn_type (mod_yyout, 
 			       mod_ifs_table->conn[i].allowed_port_type[0]);
 			    fprintf (mod_yyout, "))->state");}
 			| TOK_OUTPUT_CHANGED TOK_LPAREN subscriptable_id TOK_RPAREN
 			   {int i = valid_subid ($3, CONN);
-			    fprintf (mod_yyout, 
-				     "mif_private->conn[%d]->port[%s]->changed", i,
-				     subscript($3));}
+			    put_port (mod_yyout, i, $3);
+			    fprintf (mod_yyout, "->changed");}
 			| TOK_LOAD TOK_LPAREN subscriptable_id TOK_RPAREN
 			   {int i = valid_subid ($3, CONN);
-			    fprintf (mod_yyout, 
-				     "mif_private->conn[%d]->port[%s]->load", i,
-				     subscript($3));}
+			    put_port (mod_yyout, i, $3);
+			    fprintf (mod_yyout, "->load");}
 			| TOK_TOTAL_LOAD TOK_LPAREN subscriptable_id TOK_RPAREN
 			   {int i = valid_subid ($3, CONN);
-			    fprintf (mod_yyout, 
-				     "mif_private->conn[%d]->port[%s]->total_load", i,
-				     subscript($3));}
+			    put_port (mod_yyout, i, $3);
+			    fprintf (mod_yyout, "->total_load");}
 			| TOK_MESSAGE TOK_LPAREN subscriptable_id TOK_RPAREN
 			   {int i = valid_subid ($3, CONN);
-			    fprintf (mod_yyout, 
-				     "mif_private->conn[%d]->port[%s]->msg", i,
-				     subscript($3));}
+			    put_port (mod_yyout, i, $3);
+			    fprintf (mod_yyout, "->msg");}
 			;
 
 subscriptable_id	: id
@@ -73,6 +73,7 @@ extern char *mod_yytext;
 extern int   mod_num_errors;
 
 extern Ifs_Table_t *mod_ifs_table;
+extern void mod_write_resolved(FILE *);
 
 extern char *current_filename;
 extern char *prog_name;
@@ -183,6 +184,7 @@ void preprocess_mod_file (
    fprintf (mod_yyout, "#include \"ngspice/cm.h\"\n");
    fprintf (mod_yyout, "extern void %s(Mif_Private_t *);\n",
           ifs_table.name.c_fcn_name);
+   mod_write_resolved (mod_yyout);
 #ifdef DEBUG_WITH_MOD_FILE
    fprintf (mod_yyout, "#line 1 \"%s\"\n", current_filename);
 #endif
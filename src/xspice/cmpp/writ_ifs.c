@@ -1009,8 +1009,9 @@ static int write_SPICEdev(
     /* Extern the code model function name */
     rc |= fprintf(fp,
             "\n"
-            "extern void %s(Mif_Private_t *);\n",
-            ifs_table->name.c_fcn_name);
+            "extern void %s(Mif_Private_t *);\n"
+            "extern size_t %s_resolve(Mif_Private_t *, void *);\n",
+            ifs_table->name.c_fcn_name, ifs_table->name.c_fcn_name);
 
     /* SPICE now needs these static integers */
     rc |= fprintf(fp,
@@ -1075,6 +1076,9 @@ static int write_SPICEdev(
     else
         rc |= fprintf(fp, "        .inst_var = NULL,\n");
 
+    rc |= fprintf(fp, "        .cm_resolve = %s_resolve,\n",
+            ifs_table->name.c_fcn_name);
+
     rc |= fprintf(fp, "    },\n\n");
 
     /* Write the names of the generic code model functions */
@@ -49,6 +49,9 @@ NON-STANDARD FEATURES
 
 
 
+static void EVTown_state(Evt_State_t *state, int num_desc);
+
+
 /*
 EVTaccept()
 
@@ -211,8 +214,10 @@ void EVTaccept(
         if (!state)
             continue;
         if (state->prev) {
+            EVTown_state(state, state_data->num_desc[index]);
             state->prev->next = state_data->free[index];
             state_data->free[index] = state_data->head[index];
+            state->prev = NULL;
         }
         state_data->head[index] = state;
         state_data->last_step[index] = state_data->tail[index] =
@@ -239,3 +244,40 @@ void EVTaccept(
 } /* EVTaccept */
 
 
+
+
+
+/*
+EVTown_state()
+
+The accepted state becomes the head of the list of an instance, the
+older states are moved to the free list.  Tags that have not been
+written since the last accepted timepoint still use the memory of
+such an older state.  Swap it with the memory the accepted state owns,
+so that the head owns all of its data without copying it.
+*/
+
+
+static void EVTown_state(
+    Evt_State_t *state,     /* The accepted state */
+    int         num_desc)   /* Number of tags on the instance */
+{
+    int         i;
+
+    Evt_State_t *owner;
+    void        *spare;
+
+    for(i = 0; i < num_desc; i++) {
+        if(state->data[i] == state->own[i])
+            continue;
+
+        /* Find the state that made the copy, at latest the old head */
+        owner = state->prev;
+        while(owner->own[i] != state->data[i])
+            owner = owner->prev;
+
+        spare = state->own[i];
+        state->own[i] = owner->own[i];
+        owner->own[i] = spare;
+    }
+} /* EVTown_state */
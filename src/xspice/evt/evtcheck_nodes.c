@@ -410,16 +410,10 @@ static const char *scan_devices(Evt_Node_Info_t   *event_node,
 
     left = event_node->num_outputs;
     if (left) {
-        Evt_Node_Info_t    *node;
         Evt_Output_Info_t  *oip;
         int                 i, my_index;
 
-        /* Find the index of this node (not stored). */
-
-        for (my_index = 0, node = ckt->evt->info.node_list;
-             node != event_node;
-             ++my_index, node = node->next)
-            ;
+        my_index = event_node->index;
 
         /* Scan output connections. */
 
@@ -6,6 +6,7 @@
 
 
 static void Evt_Node_destroy(Evt_Node_Info_t *info, Evt_Node_t *node);
+static void Evt_Node_destroy_values(Evt_Node_Info_t *info, Evt_Node_t *node);
 static void Evt_Node_Data_destroy(Evt_Ckt_Data_t *evt, Evt_Node_Data_t *node_data);
 static void Evt_Msg_Data_destroy(Evt_Ckt_Data_t *evt, Evt_Msg_Data_t *msg_data);
 static void Evt_Queue_destroy(Evt_Ckt_Data_t *evt, Evt_Queue_t *queue);
@@ -112,11 +113,15 @@ Evt_Data_destroy(Evt_Ckt_Data_t *evt, Evt_Data_t *data)
 }
 */
 
-static void free_state(Evt_State_t *state)
+static void free_state(Evt_State_t *state, int num_desc)
 {
     while (state) {
         Evt_State_t *next = state->next;
-        tfree(state->block);
+        int i;
+        for (i = 0; i < num_desc; i++)
+            tfree(state->own[i]);
+        tfree(state->data);
+        tfree(state->own);
         tfree(state);
         state = next;
     }
@@ -131,8 +136,8 @@ Evt_State_Data_destroy(Evt_Ckt_Data_t *evt, Evt_State_Data_t *state_data)
         return;
 
     for (i = 0; i < evt->counts.num_insts; i++) {
-        free_state(state_data->head[i]);
-        free_state(state_data->free[i]);
+        free_state(state_data->head[i], state_data->num_desc[i]);
+        free_state(state_data->free[i], state_data->num_desc[i]);
     }
 
     tfree(state_data->head);
@@ -142,7 +147,6 @@ Evt_State_Data_destroy(Evt_Ckt_Data_t *evt, Evt_State_Data_t *state_data)
 
     tfree(state_data->modified);
     tfree(state_data->modified_index);
-    tfree(state_data->total_size);
 
     for (i = 0; i < evt->counts.num_insts; i++) {
         Evt_State_Desc_t *p = state_data->desc[i];
@@ -151,9 +155,14 @@ Evt_State_Data_destroy(Evt_Ckt_Data_t *evt, Evt_State_Data_t *state_data)
             tfree(p);
             p = next_p;
         }
+        if (state_data->desc_table)
+            tfree(state_data->desc_table[i]);
     }
 
     tfree(state_data->desc);
+    tfree(state_data->desc_table);
+    tfree(state_data->num_desc_table);
+    tfree(state_data->num_desc);
 }
 
 
@@ -165,28 +174,34 @@ Evt_Node_Data_destroy(Evt_Ckt_Data_t *evt, Evt_Node_Data_t *node_data)
     if (!node_data)
         return;
 
+    /* The list items live in slabs, only values created by the udn */
+    /* have been allocated separately */
     for (i = 0; i < evt->counts.num_nodes; i++) {
         Evt_Node_Info_t *info = evt->info.node_table[i];
         Evt_Node_t *node;
+        if (node_data->value_size[i] > 0)
+            continue;
         node = node_data->head[i];
         while (node) {
-            Evt_Node_t *next = node->next;
-            Evt_Node_destroy(info, node);
-            tfree(node);
-            node = next;
+            Evt_Node_destroy_values(info, node);
+            node = node->next;
         }
         node = node_data->free[i];
         while (node) {
-            Evt_Node_t *next = node->next;
-            Evt_Node_destroy(info, node);
-            tfree(node);
-            node = next;
+            Evt_Node_destroy_values(info, node);
+            node = node->next;
         }
     }
+    while (node_data->slabs) {
+        Evt_Node_Slab_t *next = node_data->slabs->next;
+        tfree(node_data->slabs);
+        node_data->slabs = next;
+    }
     tfree(node_data->head);
     tfree(node_data->tail);
     tfree(node_data->last_step);
     tfree(node_data->free);
+    tfree(node_data->value_size);
 
     tfree(node_data->modified);
     tfree(node_data->modified_index);
@@ -218,6 +233,21 @@ Evt_Node_destroy(Evt_Node_Info_t *info, Evt_Node_t *node)
 }
 
 
+/* Free the values of a slab item, the output_value array is part of it */
+static void
+Evt_Node_destroy_values(Evt_Node_Info_t *info, Evt_Node_t *node)
+{
+    tfree(node->node_value);
+    tfree(node->inverted_value);
+
+    if (node->output_value) {
+        int k = info->num_outputs;
+        while (--k >= 0)
+            tfree(node->output_value[k]);
+    }
+}
+
+
 static void
 Evt_Msg_Data_destroy(Evt_Ckt_Data_t *evt, Evt_Msg_Data_t *msg_data)
 {
@@ -331,4 +361,7 @@ Evt_Info_destroy(Evt_Info_t *info)
     tfree(info->output_table);
 
     tfree(info->hybrids);
+
+    if (info->node_hash)
+        nghash_free(info->node_hash, NULL, NULL);
 }
@@ -228,6 +228,8 @@ int EVTload_with_event(
     cm_data.num_inst_var = inst->num_inst_var;
     cm_data.inst_var = inst->inst_var;
     cm_data.callback = &(inst->callback);
+    cm_data.dual_partial = MIF_FALSE;
+    cm_data.resolved = inst->resolved;
 
 
     /* ******************* */
@@ -312,7 +314,9 @@ EVTcreate_state
 This function creates a new state storage area for a particular instance
 during an event-driven simulation.  New states must be created so
 that old states are saved and can be accessed by code models in the
-future.  The new state is initialized to the previous state value.
+future.  The new state is initialized to the previous state value
+by sharing its memory, cm_event_get_ptr() makes a copy of a tag when
+the code model asks for it.
 */
 
 
@@ -320,7 +324,8 @@ static void EVTcreate_state(
     CKTcircuit  *ckt,         /* The circuit structure */
     int         inst_index)   /* The instance to create state for */
 {
-    size_t              total_size;
+    int                 i;
+    int                 num_desc;
 
     Evt_State_Data_t    *state_data;
 
@@ -334,8 +339,8 @@ static void EVTcreate_state(
     if(state_data->desc[inst_index] == NULL)
         return;
 
-    /* Get size of state block to be allocated */
-    total_size = (size_t) state_data->total_size[inst_index];
+    /* Get number of tags to be shared */
+    num_desc = state_data->num_desc[inst_index];
 
     /* Allocate a new state for the instance */
     if(state_data->free[inst_index]) 
@@ -348,7 +353,8 @@ static void EVTcreate_state(
 	{
 		
         new_state = TMALLOC(Evt_State_t, 1);
-        new_state->block = tmalloc(total_size);
+        new_state->data = TMALLOC(void *, num_desc);
+        new_state->own = TMALLOC(void *, num_desc);
 
     }
 
@@ -359,8 +365,9 @@ static void EVTcreate_state(
     new_state->prev = prev_state;
     state_data->tail[inst_index] = &(prev_state->next);
 
-    /* Copy the old state to the new state and set the step */
-    memcpy(new_state->block, prev_state->block, total_size);
+    /* Share the old state with the new state and set the step */
+    for(i = 0; i < num_desc; i++)
+        new_state->data[i] = prev_state->data[i];
     new_state->step = g_mif_info.circuit.evt_step;
 
     /* Mark that the state data on the instance has been modified */
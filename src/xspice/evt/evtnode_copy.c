@@ -20,7 +20,8 @@ MODIFICATIONS
 SUMMARY
 
     This file contains function EVTnode_copy which copies the state
-    of a node structure.
+    of a node structure, and the slab allocator for the node structures
+    kept on the node lists.
 
 INTERFACES
 
@@ -49,12 +50,125 @@ NON-STANDARD FEATURES
 #include "ngspice/evtproto.h"
 #include "ngspice/cm.h"
 
+/*
+EVTnode_alloc
+
+This function allocates a slab of node structs for the lists of a
+node and places them on its free list.  Each struct is followed in
+its record by the array of output value pointers and, if the node
+values have a known fixed size, by the values themselves, so no
+further allocations are needed.  Records start on EVT_NODE_ALIGN
+byte boundaries.  Slabs are only freed when the circuit data is
+destroyed.
+*/
+
+
+static void EVTnode_alloc(
+    CKTcircuit    *ckt,        /* The circuit structure */
+    int           node_index)  /* The node to allocate structs for */
+{
+
+    int                 i;
+    int                 j;
+
+    int                 udn_index;
+    int                 num_outputs;
+    int                 num_values;
+    Mif_Boolean_t       invert;
+
+    size_t              value_size;
+    size_t              ptr_offset;
+    size_t              value_offset;
+    size_t              rec_size;
+
+    char                *rec;
+    size_t              addr;
+
+    Evt_Node_Data_t     *node_data;
+    Evt_Node_Info_t     *node_info;
+    Evt_Node_Slab_t     *slab;
+
+    Evt_Node_t          *here;
+
+
+    node_data = ckt->evt->data.node;
+    node_info = ckt->evt->info.node_table[node_index];
+
+    udn_index = node_info->udn_index;
+    num_outputs = node_info->num_outputs;
+    invert = node_info->invert;
+    value_size = node_data->value_size[node_index];
+
+    /* Compute the layout of a record */
+    num_values = 1 + (invert ? 1 : 0) + ((num_outputs > 1) ? num_outputs : 0);
+
+    ptr_offset = sizeof(Evt_Node_t);
+    value_offset = ptr_offset;
+    if(num_outputs > 1)
+        value_offset += (size_t) num_outputs * sizeof(void *);
+    value_offset = (value_offset + sizeof(double) - 1) & ~(sizeof(double) - 1);
+
+    rec_size = value_offset + (size_t) num_values * value_size;
+    rec_size = (rec_size + EVT_NODE_ALIGN - 1) & ~((size_t) EVT_NODE_ALIGN - 1);
+
+    /* Allocate the slab and link it for EVTdest */
+    slab = (Evt_Node_Slab_t *) tmalloc(sizeof(Evt_Node_Slab_t) +
+            EVT_NODE_ALIGN + EVT_NODE_SLAB_SIZE * rec_size);
+    slab->next = node_data->slabs;
+    node_data->slabs = slab;
+
+    addr = (size_t) (slab + 1);
+    addr = (addr + EVT_NODE_ALIGN - 1) & ~((size_t) EVT_NODE_ALIGN - 1);
+    rec = (char *) addr;
+
+    /* Set up the records in reverse, so the free list is in memory order */
+    for(i = EVT_NODE_SLAB_SIZE - 1; i >= 0; i--) {
+
+        char  *values;
+
+        here = (Evt_Node_t *) (rec + (size_t) i * rec_size);
+        values = (char *) here + value_offset;
+
+        if(num_outputs > 1)
+            here->output_value = (void **) ((char *) here + ptr_offset);
+        else
+            here->output_value = NULL;
+
+        if(value_size > 0) {
+            here->node_value = values;
+            values += value_size;
+            if(invert) {
+                here->inverted_value = values;
+                values += value_size;
+            }
+            for(j = 0; j < num_outputs && num_outputs > 1; j++) {
+                here->output_value[j] = values;
+                values += value_size;
+            }
+        }
+        else {
+            here->node_value = NULL;
+            here->inverted_value = NULL;
+            g_evt_udn_info[udn_index]->create ( &(here->node_value) );
+            if(invert)
+                g_evt_udn_info[udn_index]->create ( &(here->inverted_value) );
+            for(j = 0; j < num_outputs && num_outputs > 1; j++)
+                g_evt_udn_info[udn_index]->create ( &(here->output_value[j]) );
+        }
+
+        here->next = node_data->free[node_index];
+        node_data->free[node_index] = here;
+    }
+}
+
+
 /*
 EVTnode_copy
 
 This function copies the state of a node structure.
 
-If the destination is NULL, it is allocated before the copy.  This is the
+If the destination is NULL, it is taken from the free list of the node,
+which is refilled by EVTnode_alloc() when empty.  This is the
 case when EVTiter copies a node during a transient analysis to
 save the state of an element of rhsold into the node data structure
 lists.
@@ -83,10 +197,6 @@ void EVTnode_copy(
 
     Evt_Node_t          *here;
 
-    /*	Digital_t *dummy;*/
-
-    /*	char buff[128];*/
-
     /* Get data for fast access */
     node_data = ckt->evt->data.node;
     node_table = ckt->evt->info.node_table;
@@ -96,46 +206,18 @@ void EVTnode_copy(
     invert = node_table[node_index]->invert;
 
 
-    /* If destination is not allocated, allocate it */
+    /* If destination is not allocated, take it from the free list */
     /* otherwise we just copy into the node struct */
     here = *to;
 
     if(here == NULL) 
 	{
-        /* Use allocated structure on free list if available */
-        /* Otherwise, allocate a new one */
+        if(! node_data->free[node_index])
+            EVTnode_alloc(ckt, node_index);
         here = node_data->free[node_index];
-        if(here) 
-		{
-            *to = here;
-            node_data->free[node_index] = here->next;
-            here->next = NULL;
-        }
-        else 
-		{
-            here = TMALLOC(Evt_Node_t, 1);
-            *to = here;
-            /* Allocate/initialize the data in the new node struct */
-            if(num_outputs > 1) 
-			{
-                here->output_value = TMALLOC(void *, num_outputs);
-                
-				for(i = 0; i < num_outputs; i++) 
-				{
-                    g_evt_udn_info[udn_index]->create
-                            ( &(here->output_value[i]) );
-                }
-            }
- 
-			here->node_value = NULL;
-
-            g_evt_udn_info[udn_index]->create ( &(here->node_value) );
-
-            if(invert)
-                g_evt_udn_info[udn_index]->create ( &(here->inverted_value) );
-
-			
-        }
+        *to = here;
+        node_data->free[node_index] = here->next;
+        here->next = NULL;
     }
 
     /* Copy the node data */
@@ -49,6 +49,7 @@ NON-STANDARD FEATURES
 #include "ngspice/mif.h"
 #include "ngspice/evt.h"
 #include "ngspice/evtudn.h"
+#include "ngspice/cmtypes.h"
 #include "ngspice/mifproto.h"
 #include "ngspice/evtproto.h"
 
@@ -63,6 +64,8 @@ static int EVTsetup_load_ptrs(CKTcircuit *ckt);
 int EVTsetup_plot(CKTcircuit* ckt, char* plottypename);
 int EVTswitch_plot(CKTcircuit* ckt, const char* plottypename);
 
+extern Evt_Udn_Info_t idn_digital_info;
+
 
 /* Allocation macros with built-in check for out-of-memory */
 /* Adapted from SPICE 3C1 code in CKTsetup.c */
@@ -373,6 +376,7 @@ static int EVTsetup_data(
     CKALLOC(node_data->tail, num_nodes, Evt_Node_t **)
     CKALLOC(node_data->last_step, num_nodes, Evt_Node_t **)
     CKALLOC(node_data->free, num_nodes, Evt_Node_t *)
+    CKALLOC(node_data->value_size, num_nodes, size_t)
     CKALLOC(node_data->modified_index, num_nodes, int)
     CKALLOC(node_data->modified, num_nodes, Mif_Boolean_t)
     CKALLOC(node_data->rhs, num_nodes, Evt_Node_t)
@@ -421,6 +425,13 @@ static int EVTsetup_data(
             g_evt_udn_info[udn_index]->initialize (rhsold->inverted_value);
         }
 
+        /* Digital values are small and fixed in size, so they are */
+        /* stored within the node structs on the lists */
+        if(g_evt_udn_info[udn_index] == &idn_digital_info)
+            node_data->value_size[i] = sizeof(Digital_t);
+        else
+            node_data->value_size[i] = 0;
+
         /* Initialize the total load value to zero */
         node_data->total_load[i] = 0.0;
     }
@@ -437,8 +448,10 @@ static int EVTsetup_data(
     CKALLOC(state_data->free, num_insts, Evt_State_t *)
     CKALLOC(state_data->modified_index, num_insts, int)
     CKALLOC(state_data->modified, num_insts, Mif_Boolean_t)
-    CKALLOC(state_data->total_size, num_insts, int)
     CKALLOC(state_data->desc, num_insts, Evt_State_Desc_t *)
+    CKALLOC(state_data->desc_table, num_insts, Evt_State_Desc_t **)
+    CKALLOC(state_data->num_desc_table, num_insts, int)
+    CKALLOC(state_data->num_desc, num_insts, int)
 
     for(i = 0; i < num_insts; i++) {
         state_data->tail[i] = &(state_data->head[i]);
@@ -188,33 +188,30 @@ static void EVTinst_insert(
     NG_IGNORE(err_msg);
 
 
-    /* Scan list of instances in event structure to see if already there */
-    /* and get the index */
+    /* The ports of an instance are inserted while the instance is */
+    /* parsed, so if it is already there, it is the last in the list */
     found = MIF_FALSE;
     index = 0;
-    inst = ckt->evt->info.inst_list;
-    inst_ptr  = &(ckt->evt->info.inst_list);
+    inst = ckt->evt->info.inst_last;
 
-    while(inst) {
-        if(inst->inst_ptr == fast) {
-            found = MIF_TRUE;
-            break;
-        }
-        else {
-            index++;
-            inst_ptr = &(inst->next);
-            inst = inst->next;
-        }
+    if(inst && inst->inst_ptr == fast) {
+        found = MIF_TRUE;
+        index = ckt->evt->counts.num_insts - 1;
     }
 
 
     /* If not found, create a new entry in list and increment the */
     /* instance count in the event structure */
     if(! found) {
+        if(inst)
+            inst_ptr = &(inst->next);
+        else
+            inst_ptr = &(ckt->evt->info.inst_list);
         *inst_ptr = TMALLOC(Evt_Inst_Info_t, 1);
         inst = *inst_ptr;
         inst->next = NULL;
         inst->inst_ptr = fast;
+        ckt->evt->info.inst_last = inst;
         index = ckt->evt->counts.num_insts;
         (ckt->evt->counts.num_insts)++;
     }
@@ -293,23 +290,17 @@ static void EVTnode_insert(
     /* Find/create entry in event-driven node list */
     /* ******************************************* */
 
-    /* Scan list of nodes in event structure to see if already there */
+    /* Look up the node in the hash table of the event node list */
     /* and get the index */
     found = MIF_FALSE;
     index = 0;
-    node = ckt->evt->info.node_list;
-    node_ptr  = &(ckt->evt->info.node_list);
+    if(! ckt->evt->info.node_hash)
+        ckt->evt->info.node_hash = nghash_init(NGHASH_MIN_SIZE);
+    node = (Evt_Node_Info_t *) nghash_find(ckt->evt->info.node_hash, node_name);
 
-    while(node) {
-        if(strcmp(node_name, node->name) == 0) {
-            found = MIF_TRUE;
-            break;
-        }
-        else {
-            index++;
-            node_ptr = &(node->next);
-            node = node->next;
-        }
+    if(node) {
+        found = MIF_TRUE;
+        index = node->index;
     }
 
 
@@ -324,6 +315,10 @@ static void EVTnode_insert(
     /* If not found, create a new entry in list and increment the */
     /* node count in the event structure */
     if(! found) {
+        if(ckt->evt->info.node_last)
+            node_ptr = &(ckt->evt->info.node_last->next);
+        else
+            node_ptr = &(ckt->evt->info.node_list);
         *node_ptr = TMALLOC(Evt_Node_Info_t, 1);
         node = *node_ptr;
         node->next = NULL;
@@ -331,7 +326,10 @@ static void EVTnode_insert(
         node->udn_index = udn_index;
         node->save = MIF_TRUE; /* Backward compatible behaviour: save all. */
         index = ckt->evt->counts.num_nodes;
+        node->index = index;
         (ckt->evt->counts.num_nodes)++;
+        ckt->evt->info.node_last = node;
+        nghash_insert(ckt->evt->info.node_hash, node->name, node);
     }
 
 
@@ -350,30 +348,28 @@ static void EVTnode_insert(
     if(fast->conn[conn_num]->is_output)
         (node->num_outputs)++;
 
-    /* If this is an input, add instance to list if not already there */
+    /* If this is an input, add instance to list if not already there. */
+    /* Instances are inserted in the order they are parsed, so an       */
+    /* earlier port of this instance is the last entry in the list      */
     if(fast->conn[conn_num]->is_input) {
 
         found = MIF_FALSE;
-        inst = node->inst_list;
-        inst_ptr = &(node->inst_list);
-
-        while(inst) {
-            if(inst_index == inst->index) {
-                found = MIF_TRUE;
-                break;
-            }
-            else {
-                inst_ptr = &(inst->next);
-                inst = inst->next;
-            }
-        }
+        inst = node->inst_last;
+
+        if(inst && inst_index == inst->index)
+            found = MIF_TRUE;
 
         if(! found) {
+            if(inst)
+                inst_ptr = &(inst->next);
+            else
+                inst_ptr = &(node->inst_list);
             (node->num_insts)++;
             *inst_ptr = TMALLOC(Evt_Inst_Index_t, 1);
             inst = *inst_ptr;
             inst->next = NULL;
             inst->index = inst_index;
+            node->inst_last = inst;
         }
     }
 
@@ -418,15 +414,13 @@ static void EVTport_insert(
     NG_IGNORE(err_msg);
 
     /* Find the end of the port info list */
-    port = ckt->evt->info.port_list;
-    port_ptr = &(ckt->evt->info.port_list);
-
-    index = 0;
-    while(port) {
+    port = ckt->evt->info.port_last;
+    if(port)
         port_ptr = &(port->next);
-        port = port->next;
-        index++;
-    }
+    else
+        port_ptr = &(ckt->evt->info.port_list);
+
+    index = ckt->evt->counts.num_ports;
 
 
     /* Update the port count and create a new entry in the list */
@@ -435,6 +429,7 @@ static void EVTport_insert(
 
     *port_ptr = TMALLOC(Evt_Port_Info_t, 1);
     port = *port_ptr;
+    ckt->evt->info.port_last = port;
 
     /* Fill in the elements */
     port->next = NULL;
@@ -481,16 +476,14 @@ static void EVToutput_insert(
 
     NG_IGNORE(err_msg);
 
-    /* Find the end of the port info list */
-    output = ckt->evt->info.output_list;
-    output_ptr = &(ckt->evt->info.output_list);
-
-    index = 0;
-    while(output) {
+    /* Find the end of the output info list */
+    output = ckt->evt->info.output_last;
+    if(output)
         output_ptr = &(output->next);
-        output = output->next;
-        index++;
-    }
+    else
+        output_ptr = &(ckt->evt->info.output_list);
+
+    index = ckt->evt->counts.num_outputs;
 
 
     /* Update the port count and create a new entry in the list */
@@ -499,6 +492,7 @@ static void EVToutput_insert(
 
     *output_ptr = TMALLOC(Evt_Output_Info_t, 1);
     output = *output_ptr;
+    ckt->evt->info.output_last = output;
 
     /* Fill in the elements */
     output->next = NULL;
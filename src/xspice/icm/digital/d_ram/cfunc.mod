@@ -57,6 +57,12 @@ NON-STANDARD FEATURES
 
 /*=== CONSTANTS ========================*/
 
+/* The ram words are kept in event state blocks of RAM_BLOCK shorts
+   with tags RAM_TAG, RAM_TAG + 1, ...  Storing a word copies only the
+   block holding it into the state of the new event. */
+
+#define RAM_TAG     3
+#define RAM_BLOCK   256
 
 
 
@@ -293,6 +299,18 @@ static Digital_State_t cm_mask_and_retrieve(short base, int ram_offset)
 
 
 
+/* Address of ram word ram_index in the state of timepoint 0 (current)
+   or 1 (previous event) */
+
+static short *cm_ram_word(int ram_index, int timepoint)
+{
+    short *block = (short *) cm_event_get_ptr(RAM_TAG + ram_index / RAM_BLOCK,
+                                              timepoint);
+    return block + ram_index % RAM_BLOCK;
+}
+
+
+
 /*==============================================================================
 
 FUNCTION cm_initialize_ram()
@@ -345,7 +363,7 @@ NON-STANDARD FEATURES
 
 
 static void cm_initialize_ram(Digital_State_t out,int word_width,int bit_number,
-                        int word_number,short *ram)
+                        int word_number)
 {
     int       /*err,*/      /* error index value    */
              int1,      /* temp storage variable    */
@@ -357,6 +375,7 @@ static void cm_initialize_ram(Digital_State_t out,int word_width,int bit_number,
         
     short    base;      /* variable to hold current base integer for
                            comparison purposes. */
+    short   *word;      /* ram word holding the bit */
 
 
     /* obtain offset value from word_number, word_width & 
@@ -367,13 +386,14 @@ static void cm_initialize_ram(Digital_State_t out,int word_width,int bit_number,
     ram_offset = int1 & 7;
             
     /* retrieve entire base_address ram integer... */
-    base = ram[ram_index];
+    word = cm_ram_word(ram_index, 0);
+    base = *word;
                          
     /* for each offset, mask off the bits and store values */
     cm_mask_and_store(&base,ram_offset,out);
                           
     /* store modified base value */
-    ram[ram_index] = base;                   
+    *word = base;                   
 
 }
 
@@ -408,7 +428,7 @@ INTERFACES
 
 RETURNED VALUE
     
-    Returns updated ram[] value via *ram pointer.
+    Stores the updated ram word in the current event state.
 
 GLOBAL VARIABLES
     
@@ -436,8 +456,7 @@ NON-STANDARD FEATURES
 
 
 static void cm_store_ram_value(Digital_State_t out,int word_width,int bit_number,
-                        Digital_State_t *address,int address_size,
-                        short *ram)
+                        Digital_State_t *address,int address_size)
 {
     int       err,      /* error index value    */
              int1,      /* temp storage variable    */
@@ -450,6 +469,7 @@ static void cm_store_ram_value(Digital_State_t out,int word_width,int bit_number
         
     short    base;      /* variable to hold current base integer for
                            comparison purposes. */
+    short   *word;      /* ram word holding the bit */
 
     /** first obtain word_number from *address values **/
     err = cm_address_to_decimal(address,address_size,&word_number);
@@ -464,13 +484,14 @@ static void cm_store_ram_value(Digital_State_t out,int word_width,int bit_number
         ram_offset = int1 & 7;
             
         /* retrieve entire base_address ram integer... */
-        base = ram[ram_index];
+        word = cm_ram_word(ram_index, 0);
+        base = *word;
                              
         /* for each offset, mask off the bits and store values */
         cm_mask_and_store(&base,ram_offset,out);
                               
         /* store modified base value */
-        ram[ram_index] = base;                   
+        *word = base;                   
 
     }
 }
@@ -534,7 +555,7 @@ NON-STANDARD FEATURES
 ************************************************/
 
 static Digital_State_t cm_get_ram_value(int word_width,int bit_number,Digital_State_t *address,
-                 int address_size,short *ram)
+                 int address_size)
 
 {
     int       err,      /* error index value    */
@@ -563,7 +584,9 @@ static Digital_State_t cm_get_ram_value(int word_width,int bit_number,Digital_St
         ram_offset = int1 & 7;
                 
         /* retrieve entire base_address ram integer... */
-        base = ram[ram_index];
+        /* the ram is not written before it is read in one call, */
+        /* so the previous words are the current ones            */
+        base = *cm_ram_word(ram_index, 1);
                              
         /* for each offset, mask off the bits and determine values */
 
@@ -646,18 +669,14 @@ void cm_d_ram(ARGS)
              address_changed,   /* TRUE if address is different from
                                    that on the previous call...FALSE
                                    otherwise    */
-             address_unknown;   /* TRUE if currently-read address has
+             address_unknown,   /* TRUE if currently-read address has
                                    at least one line which is an unknown
                                    value.   */
-
-    short int           *ram,   /* storage words...note that the 
-                                   total ram data will be stored in the
-                                   two-bytes-per-Digital_State_t...since
-                                   we require 2 bits per ram bit (for
-                                   ZERO, ONE & UNKNOWN), we will store
-                                   8 ram bits per Digital_State_t
-                                   location   */
-                    *ram_old;   /* previous values of storage words */
+                  block_size;   /* number of storage words in one
+                                   event state block (see RAM_BLOCK)...
+                                   the ram data is stored with 2 bits
+                                   per ram bit (for ZERO, ONE & UNKNOWN),
+                                   i.e. 8 ram bits per short int */
 
                         
 
@@ -705,7 +724,13 @@ void cm_d_ram(ARGS)
 
 
         /* allocate storage for ram memory */
-        cm_event_alloc(3, num_of_ram_ints * (int) sizeof(short));
+        for (i=0; i<num_of_ram_ints; i+=RAM_BLOCK) {
+            block_size = num_of_ram_ints - i;
+            if (block_size > RAM_BLOCK)
+                block_size = RAM_BLOCK;
+            cm_event_alloc(RAM_TAG + i / RAM_BLOCK,
+                           block_size * (int) sizeof(short));
+        }
 
         /* declare load values */
         for (i=0; i<word_width; i++) {
@@ -727,9 +752,6 @@ void cm_d_ram(ARGS)
         write_en = write_en_old = (Digital_State_t *) cm_event_get_ptr(1,0);
         select = select_old = (Digital_State_t *) cm_event_get_ptr(2,0);
 
-        /* retrieve ram base addresses */
-        ram = ram_old = (short *) cm_event_get_ptr(3,0);
-
     }
     else {      /* Retrieve previous values */
                                               
@@ -741,12 +763,7 @@ void cm_d_ram(ARGS)
         select = (Digital_State_t *) cm_event_get_ptr(2,0);
         select_old = (Digital_State_t *) cm_event_get_ptr(2,1);
 
-        /* retrieve ram base addresses */
-        ram = (short *) cm_event_get_ptr(3,0);
-        ram_old = (short *) cm_event_get_ptr(3,1);
-
-        for(i=0;i<num_of_ram_ints;i++)
-          ram[i] = ram_old[i];
+        /* the ram words are fetched by cm_ram_word() when accessed */
     }
                                       
 
@@ -795,7 +812,7 @@ void cm_d_ram(ARGS)
         out = (Digital_State_t) PARAM(ic);
         for (i=0; i<word_width; i++) {
             for (j=0; j<ram_size; j++) {
-                cm_initialize_ram(out,word_width,i,j,ram);
+                cm_initialize_ram(out,word_width,i,j);
             }
         }
 
@@ -828,7 +845,7 @@ void cm_d_ram(ARGS)
                     for (i=0; i<word_width; i++) { 
                         /* for each output bit in the word, */
                         /* retrieve the state value.        */
-                        out = cm_get_ram_value(word_width,i,address,address_size,ram);
+                        out = cm_get_ram_value(word_width,i,address,address_size);
                         OUTPUT_STATE(data_out[i]) = out;                              
                         OUTPUT_STRENGTH(data_out[i]) = STRONG;                              
                         OUTPUT_DELAY(data_out[i]) = PARAM(read_delay);
@@ -839,14 +856,14 @@ void cm_d_ram(ARGS)
                         if (address_unknown) {
                             /** entire ram goes unknown!!! **/
                             for (j=0; j<ram_size; j++) {
-                                cm_initialize_ram(UNKNOWN,word_width,i,j,ram);
+                                cm_initialize_ram(UNKNOWN,word_width,i,j);
                             }
                             OUTPUT_STATE(data_out[i]) = UNKNOWN;
                         }
                         else {
                             out = INPUT_STATE(data_in[i]);
                             cm_store_ram_value(out,word_width,i,address,
-                                               address_size,ram);
+                                               address_size);
                             OUTPUT_STATE(data_out[i]) = out;
                         }
                         OUTPUT_STRENGTH(data_out[i]) = HI_IMPEDANCE;
@@ -887,14 +904,14 @@ void cm_d_ram(ARGS)
                         if (address_unknown) {
                             /** entire ram goes unknown!!! **/
                             for (j=0; j<ram_size; j++) {
-                                cm_initialize_ram(UNKNOWN,word_width,i,j,ram);
+                                cm_initialize_ram(UNKNOWN,word_width,i,j);
                             }
                             OUTPUT_STATE(data_out[i]) = UNKNOWN;
                         }
                         else {
                             out = INPUT_STATE(data_in[i]);
                             cm_store_ram_value(out,word_width,i,address,
-                                               address_size,ram);
+                                               address_size);
                             OUTPUT_STATE(data_out[i]) = out;
                         }
                         OUTPUT_STRENGTH(data_out[i]) = HI_IMPEDANCE;
@@ -920,7 +937,7 @@ void cm_d_ram(ARGS)
                             /* for each output bit in the word, */
                             /* retrieve the state value.        */
                             out = cm_get_ram_value(word_width,i,address,
-                                             address_size,ram);
+                                             address_size);
                             OUTPUT_STATE(data_out[i]) = out;
                         }
                         OUTPUT_STRENGTH(data_out[i]) = STRONG;
@@ -462,6 +462,7 @@ Then searches for (and opens) <infile> an a sequence from
 Infile_Path/<infile>
 NGSPICE_INPUT_DIR/<infile>, where the path is given by the environmental variable
 <infile>, where the path is the current directory
+gzip or zstd compressed files are decompressed while they are read.
 */
 #define DFLT_BUF_SIZE   256
 FILE *fopen_with_path(const char *path, const char *mode)
@@ -484,7 +485,8 @@ FILE *fopen_with_path(const char *path, const char *mode)
 
             /* Try opening file. If fail, try using NGSPICE_INPUT_DIR
              * env variable location */
-            if ((fp = fopen(ds_get_buf(&ds), mode)) == (FILE *) NULL) {
+            if ((fp = (coreitf->dllitf_fopen)(ds_get_buf(&ds), mode)) ==
+                    (FILE *) NULL) {
                 char *y = getenv("NGSPICE_INPUT_DIR");
                 if (y && *y) { /* have env var and not "" */
                     int rc_ds = 0;
@@ -512,7 +514,7 @@ FILE *fopen_with_path(const char *path, const char *mode)
                     }
 
                     /* Try opening file name that was built */
-                    if ((fp = fopen(ds_get_buf(&ds),
+                    if ((fp = (coreitf->dllitf_fopen)(ds_get_buf(&ds),
                             mode)) != (FILE *) NULL) {
                         ds_free(&ds);
                         return fp;
@@ -528,7 +530,7 @@ FILE *fopen_with_path(const char *path, const char *mode)
     } /* end of case that path is not absolute */
 
     /* If not opened yet, try opening exactly as given */
-    fp =  fopen(path, mode);
+    fp =  (coreitf->dllitf_fopen)(path, mode);
 
     return fp;
 } /* end of function fopen_with_path */
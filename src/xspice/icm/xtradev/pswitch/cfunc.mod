@@ -158,6 +158,9 @@ void cm_pswitch(ARGS)  /* structure holding parms,
     double r;            /* value of the resistance of the switch */
     double pi_pvout;     /* partial of the output wrt input       */
     double pi_pcntl;     /* partial of the output wrt control input */
+    Cm_Dual_t cntl;      /* control input with its partials */
+    Cm_Dual_t x;         /* normalized control input */
+    Cm_Dual_t rd;        /* resistance with its partials */
 
     Mif_Complex_t ac_gain;
 
@@ -224,6 +227,8 @@ void cm_pswitch(ARGS)  /* structure holding parms,
 
     loc = STATIC_VAR (locdata);
 
+    cntl = INPUT_DUAL(cntl_in);
+
     cntl_on = loc->cntl_on;
     cntl_off = loc->cntl_off;
     if ( PARAM(log) == MIF_TRUE ) {   /* Logarithmic Variation in 'R' */
@@ -235,34 +240,41 @@ void cm_pswitch(ARGS)  /* structure holding parms,
         double inmean;// = INPUT(cntl_in) - cntl_mean;
         int outOfLimit = 0;
         if (cntl_on > cntl_off) {
-            inmean = (INPUT(cntl_in) - cntl_off) / (cntl_on - cntl_off) - cntl_mean;
+            x = cm_dual_offset(cm_dual_scale(cntl, 1.0 / (cntl_on - cntl_off)),
+                               -cntl_off / (cntl_on - cntl_off) - cntl_mean);
+            inmean = x.val;
             if (INPUT(cntl_in) > cntl_on) {
-                r = r_on;
+                rd = cm_dual_const(r_on);
                 outOfLimit = 1;
             }
             else if (INPUT(cntl_in) < cntl_off) {
-                r = r_off;
+                rd = cm_dual_const(r_off);
                 outOfLimit = 1;
             }
             else {
-                r = exp(logmean + loc->c1 * inmean - loc->c3 * inmean * inmean * inmean);
-                if(r<r_on) r=r_on;/* minimum resistance limiter */
+                rd = cm_dual_exp(cm_dual_offset(cm_dual_sub(cm_dual_scale(x, loc->c1),
+                                 cm_dual_scale(cm_dual_mul(x, cm_dual_mul(x, x)), loc->c3)), logmean));
+                if(rd.val<r_on) rd=cm_dual_const(r_on);/* minimum resistance limiter */
             }
         } else {
-            inmean = (cntl_on - INPUT(cntl_in)) / (cntl_on - cntl_off) - cntl_mean;
+            x = cm_dual_offset(cm_dual_scale(cntl, -1.0 / (cntl_on - cntl_off)),
+                               cntl_on / (cntl_on - cntl_off) - cntl_mean);
+            inmean = x.val;
             if (INPUT(cntl_in) < cntl_on) {
-                r = r_on;
+                rd = cm_dual_const(r_on);
                 outOfLimit = 1;
             }
             else if (INPUT(cntl_in) > cntl_off) {
-                r = r_off;
+                rd = cm_dual_const(r_off);
                 outOfLimit = 1;
             }
             else {
-                r = exp(logmean + loc->c1 * inmean - loc->c3 * inmean * inmean * inmean);
-                if(r<r_on) r=r_on;/* minimum resistance limiter */
+                rd = cm_dual_exp(cm_dual_offset(cm_dual_sub(cm_dual_scale(x, loc->c1),
+                                 cm_dual_scale(cm_dual_mul(x, cm_dual_mul(x, x)), loc->c3)), logmean));
+                if(rd.val<r_on) rd=cm_dual_const(r_on);/* minimum resistance limiter */
             }
         }
+        r = rd.val;
 
         pi_pcntl = INPUT(out) / r * (loc->c2 * inmean * inmean - loc->c1);
         if(1 == outOfLimit){
@@ -276,47 +288,45 @@ void cm_pswitch(ARGS)  /* structure holding parms,
         cntl_diff = loc->cntl_diff;
         if (cntl_diff >=0) {
             if (INPUT(cntl_in) < cntl_off) {
-                r = r_off;
+                rd = cm_dual_const(r_off);
                 pi_pcntl = 0;
             }
             else if (INPUT(cntl_in) > cntl_on) {
-                r = r_on;
+                rd = cm_dual_const(r_on);
                 pi_pcntl = 0;
             }
             else {
-                r = INPUT(cntl_in) * intermediate + ((r_off*cntl_on -
-                    r_on*cntl_off) / cntl_diff);
+                rd = cm_dual_offset(cm_dual_scale(cntl, intermediate),
+                                    (r_off*cntl_on - r_on*cntl_off) / cntl_diff);
+                r = rd.val;
                 pi_pcntl = -intermediate * INPUT(out) / (r*r);
             }
         }
         else {
             if (INPUT(cntl_in) > cntl_off) {
-                r = r_off;
+                rd = cm_dual_const(r_off);
                 pi_pcntl = 0;
             }
             else if (INPUT(cntl_in) < cntl_on) {
-                r = r_on;
+                rd = cm_dual_const(r_on);
                 pi_pcntl = 0;
             }
             else {
-                r = INPUT(cntl_in) * intermediate + ((r_off*cntl_on -
-                    r_on*cntl_off) / cntl_diff);
+                rd = cm_dual_offset(cm_dual_scale(cntl, intermediate),
+                                    (r_off*cntl_on - r_on*cntl_off) / cntl_diff);
+                r = rd.val;
                 pi_pcntl = -intermediate * INPUT(out) / (r*r);
             }        
         }
-        if(r<=1.0e-9) r=1.0e-9;/* minimum resistance limiter */
+        if(rd.val<=1.0e-9) rd=cm_dual_const(1.0e-9);/* minimum resistance limiter */
+        r = rd.val;
         pi_pvout = 1.0 / r;
     }
 
     if(ANALYSIS != MIF_AC) {            /* Output DC & Transient Values  */
-        OUTPUT(out) = INPUT(out) / r;
-        OUTPUT(cntl_in) = INPUT(cntl_in) / r_cntl_in;
-//        PARTIAL(out,out) = pi_pvout;
-//        PARTIAL(out,cntl_in) = pi_pcntl;
-//        PARTIAL(cntl_in,cntl_in) = 1 / r_cntl_in;
-//        PARTIAL(cntl_in,out) = 0;           /* cntl input resistance is
-//                                              independent to out port */
-        cm_analog_auto_partial();
+        /* Value and all partials from a single evaluation over dual numbers */
+        OUTPUT_DUAL(out, cm_dual_div(INPUT_DUAL(out), rd));
+        OUTPUT_DUAL(cntl_in, cm_dual_scale(cntl, 1.0 / r_cntl_in));
 
     /* Note that the minus signs are required  because current is positive
        flowing INTO rather than OUT OF a component node.       */
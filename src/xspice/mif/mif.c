@@ -56,4 +56,11 @@ Mif_Info_t  g_mif_info = {
   NULL,
   { 0.0, 0.0,},
   { MIF_FALSE, MIF_FALSE,},
+  MIF_FALSE,
 };
+
+#ifdef USE_OMP
+/* Per-thread context used by the cm_... functions during parallel loads */
+Mif_Info_t  *g_mif_info_local = NULL;
+#pragma omp threadprivate(g_mif_info_local)
+#endif
@@ -89,9 +89,12 @@ MIFdelete(GENinstance *gen_inst)
         cm_data.num_inst_var = here->num_inst_var;
         cm_data.inst_var = here->inst_var;
         cm_data.callback = &(here->callback);
+        cm_data.dual_partial = MIF_FALSE;
+        cm_data.resolved = here->resolved;
 
         here->callback(&cm_data, MIF_CB_DESTROY);
     }
+    FREE(here->resolved);
 
     /*******************************/
     /* Free the instance structure */
@@ -189,6 +192,8 @@ MIFdelete(GENinstance *gen_inst)
 
     if (here->num_state && here->state)
         FREE(here->state);
+    if (here->num_state_offset && here->state_offset)
+        FREE(here->state_offset);
     if (here->num_intgr && here->intgr)
         FREE(here->intgr);
     if (here->num_conv && here->conv)
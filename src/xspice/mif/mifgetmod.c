@@ -53,6 +53,7 @@ NON-STANDARD FEATURES
 #include "ngspice/ifsim.h"
 #include "ngspice/cpstd.h"
 #include "ngspice/fteext.h"
+#include "ngspice/hash.h"
 
 #include "ngspice/mifproto.h"
 #include "ngspice/mifdefs.h"
@@ -62,7 +63,7 @@ NON-STANDARD FEATURES
 
 /*  This is the table of all models known to the program.  
     It is now defined in inpmkmod.c.      */
-extern INPmodel *modtab;
+extern NGHASHPTR modtabhash;
 
 /*
 MIFgetMod
@@ -124,15 +125,11 @@ char *MIFgetMod(
     }
     --------------------------*/
 
-    /* loop through modtable looking for this model (*name) */
-    for (modtmp = modtab; modtmp != NULL; modtmp = modtmp->INPnextModel) {
+    /* look up the model in the hash table, which INPmakeMod() fills
+       in parallel to the modtab list */
+    modtmp = modtabhash ? (INPmodel *) nghash_find(modtabhash, name) : NULL;
 
-#ifdef TRACE
-      /* SDB debug statement */
-      printf("In MIFgetMod, checking model against stored model = %s . . .\n", modtmp->INPmodName);
-#endif
-
-        if (strcmp(modtmp->INPmodName, name) == 0) {
+    if (modtmp) {
 
 #ifdef TRACE
 	/* SDB debug statement */
@@ -235,9 +232,7 @@ char *MIFgetMod(
             *model = modtmp;
             return(NULL);
 
-        } /* end if name matches */
-
-    } /* end for all models in modtab linked list */
+    } /* end if model found */
 
 
     /* didn't find model - ERROR  - return NULL model */
@@ -62,15 +62,35 @@ NON-STANDARD FEATURES
 #include "ngspice/enh.h"
 #include "ngspice/cm.h"
 
-/*  #include "suffix.h"  */
 
 
+static void MIFevaluate(
+    MIFinstance     *here,
+    CKTcircuit      *ckt,
+    Mif_Private_t   *cm_data,
+    Mif_Info_t      *info
+);
+
+static void MIFstamp(
+    MIFinstance     *here,
+    CKTcircuit      *ckt,
+    Mif_Analysis_t  anal_type
+);
 
 static void MIFauto_partial(
     MIFinstance     *here,
     void            (*cm_func) (Mif_Private_t *),
+    Mif_Private_t   *cm_data,
+    Mif_Info_t      *info
+);
+
+#ifdef USE_OMP
+static void MIFevaluate_parallel(
+    MIFmodel        *model,
+    CKTcircuit      *ckt,
     Mif_Private_t   *cm_data
 );
+#endif
 
 
 
@@ -88,8 +108,14 @@ the code model by filling it with the input values for that
 instance.  The code model's C function is then called, and the
 outputs and partial derivatives computed by the C function are
 used to fill the matrix for the next solution attempt.
-*/
 
+If .option cmparallel is given and OpenMP is available, the
+analog instances that have already been initialized are evaluated
+on several threads first.  The remaining instances are evaluated
+afterwards and all instances are loaded into the matrix serially
+in their original order.  Code models with static variables of
+their own are not reentrant and must not be used with this option.
+*/
 
 int
 MIFload(
@@ -101,73 +127,14 @@ MIFload(
     MIFinstance *here;
 
     Mif_Private_t   cm_data;   /* data to be passed to/from code model */
-    Mif_Port_Type_t type;
-    Mif_Port_Data_t *fast;
-
-    Mif_Smp_Ptr_t  *smp_data_out;
-
-    Mif_Port_Ptr_t  *smp_ptr;
-
-    Mif_Port_Type_t in_type;
-    Mif_Port_Type_t out_type;
-
-    Mif_Boolean_t  is_input;
-    Mif_Boolean_t  is_output;
-
-    Mif_Cntl_Src_Type_t  cntl_src_type;
 
     Mif_Analysis_t  anal_type;
 
-    Mif_Complex_t   czero;
-    Mif_Complex_t   ac_gain;
-
-    int         mod_type;
-    int         num_conn;
-    int         num_port;
-    int         num_port_k;
     int         i;
-    int         j;
-    int         k;
-    int         l;
 
-    /*int         tag;*/
-
-    double      *rhs;
-    double      *rhsOld;
-    double      partial;
-    double      temp;
-
-    double      *double_ptr0;
-    double      *double_ptr1;
-
-    /*double      *input;*/
-    /*    double      *oldinput;*/
-
-    char        *byte_ptr0;
-    char        *byte_ptr1;
-
-    double      last_input;
-    double      conv_limit;
-
-    double      cntl_input;
-
-
-    Evt_Node_Data_t     *node_data;
-
-
-    /* Prepare a zero complex number for AC gain initializations */
-    czero.real = 0.0;
-    czero.imag = 0.0;
 
     /* Setup for access into MIF specific model data */
     model = (MIFmodel *) inModel;
-    mod_type = model->MIFmodType;
-
-    /* Setup pointers for fast access to rhs and rhsOld elements of ckt struct */
-    rhs = ckt->CKTrhs;
-    rhsOld = ckt->CKTrhsOld;
-
-    node_data = ckt->evt->data.node;
 
     /* *********************************************************************** */
     /* Setup the circuit data in the structure to be passed to the code models */
@@ -214,6 +181,12 @@ MIFload(
     g_mif_info.circuit.call_type = MIF_ANALOG;
     g_mif_info.ckt = ckt;
 
+#ifdef USE_OMP
+    /* Evaluate the initialized analog instances on several threads */
+    if(g_mif_info.parallel)
+        MIFevaluate_parallel(model, ckt, &cm_data);
+#endif
+
 
     /* ***************************************************************** */
     /* loop through all models of this type */
@@ -232,449 +205,691 @@ MIFload(
             if(! here->analog)
                 continue;
 
-            /* ***************************************************************** */
-            /* Prepare the data needed by the cm_.. functions                    */
-            /* ***************************************************************** */
-            g_mif_info.instance = here;
-            g_mif_info.errmsg = "";
+            /* Call the code model, unless done in the parallel phase */
+            if(! here->evaluated)
+                MIFevaluate(here, ckt, &cm_data, &g_mif_info);
+            here->evaluated = MIF_FALSE;
+
+            /* Load outputs and partials into the matrix */
+            MIFstamp(here, ckt, anal_type);
+
+        } /* end for all instances */
+
+    } /* end for all models */
+
+    return(OK);
+}
+
+
+
+#ifdef USE_OMP
+
+/*
+MIFevaluate_parallel
+
+This function calls the code models of all analog instances that
+have already been initialized, using several threads.  Instances
+that are not yet initialized may allocate state storage or
+register with the event-driven simulator and are left to the
+serial loop in MIFload().  Each thread evaluates its models with
+a private copy of g_mif_info, so the cm_... functions see the
+correct instance.  Dynamic breakpoints and error messages set by
+the models are merged back into g_mif_info at the end.  Nothing
+protects data a code model keeps outside its instance storage, the
+models shipped with ngspice keep none.
+
+The matrix is not touched here, the outputs and partials are
+stored in the instance port data and loaded by MIFstamp().
+*/
+
+static void MIFevaluate_parallel(
+    MIFmodel        *model,     /* The head of the model list */
+    CKTcircuit      *ckt,       /* The circuit structure */
+    Mif_Private_t   *cm_data)   /* Circuit data prepared by MIFload() */
+{
+    MIFinstance **inst;
+    MIFinstance *here;
+    MIFmodel    *m;
+
+    int         num_inst;
+    int         n;
+
+    double      bkpt;
+    char        *errmsg;
+    int         errmsg_k;
+
+
+    /* Count the instances that may be evaluated concurrently */
+    num_inst = 0;
+    for(m = model; m != NULL; m = MIFnextModel(m)) {
+        if(! m->analog)
+            continue;
+        for(here = MIFinstances(m); here != NULL; here = MIFnextInstance(here))
+            if(here->analog && here->initialized && ! here->event_driven)
+                num_inst++;
+    }
+
+    /* Not worth starting threads for a single instance */
+    if(num_inst < 2)
+        return;
+
+    /* Collect them in list order */
+    inst = TMALLOC(MIFinstance *, num_inst);
+    n = 0;
+    for(m = model; m != NULL; m = MIFnextModel(m)) {
+        if(! m->analog)
+            continue;
+        for(here = MIFinstances(m); here != NULL; here = MIFnextInstance(here))
+            if(here->analog && here->initialized && ! here->event_driven)
+                inst[n++] = here;
+    }
 
-            if(here->initialized) {
-                cm_data.circuit.init = MIF_FALSE;
-                g_mif_info.circuit.init = MIF_FALSE;
+    bkpt = g_mif_info.breakpoint.current;
+    errmsg = NULL;
+    errmsg_k = -1;
+
+#pragma omp parallel
+    {
+        Mif_Info_t     info = g_mif_info;
+        Mif_Private_t  data = *cm_data;
+        int            k;
+        char           *my_errmsg = NULL;
+        int            my_errmsg_k = -1;
+
+        g_mif_info_local = &info;
+
+#pragma omp for schedule(dynamic, 16)
+        for(k = 0; k < num_inst; k++) {
+            /* MIFauto_partial() clears the init flags, restore them */
+            /* for every instance */
+            info.circuit.anal_init = g_mif_info.circuit.anal_init;
+            data.circuit.anal_init = cm_data->circuit.anal_init;
+
+            MIFevaluate(inst[k], ckt, &data, &info);
+            inst[k]->evaluated = MIF_TRUE;
+
+            if(info.errmsg && *info.errmsg) {
+                my_errmsg = info.errmsg;
+                my_errmsg_k = k;
             }
-            else {
-                cm_data.circuit.init = MIF_TRUE;
-                g_mif_info.circuit.init = MIF_TRUE;
+        }
+
+        g_mif_info_local = NULL;
+
+        /* Merge the dynamic breakpoints and messages of this thread */
+#pragma omp critical (mif_merge)
+        {
+            if(info.breakpoint.current < bkpt)
+                bkpt = info.breakpoint.current;
+            /* Keep the message of the last instance in list order */
+            /* that set one, whatever the thread schedule was      */
+            if(my_errmsg_k > errmsg_k) {
+                errmsg = my_errmsg;
+                errmsg_k = my_errmsg_k;
             }
+        }
+    }
 
+    g_mif_info.breakpoint.current = bkpt;
+    if(errmsg)
+        g_mif_info.errmsg = errmsg;
 
-            /* ***************************************************************** */
-            /* if tran analysis and anal_init is true, copy state 1 to state 0   */
-            /* Otherwise the data in state 0 would be invalid                    */
-            /* ***************************************************************** */
+    tfree(inst);
+}
 
-            if((anal_type == MIF_TRAN) && g_mif_info.circuit.anal_init) {
-                for(i = 0; i < here->num_state; i++) {
-                    double_ptr0 = ckt->CKTstate0 + here->state[i].index;
-                    double_ptr1 = ckt->CKTstate1 + here->state[i].index;
-                    byte_ptr0   = (char *) double_ptr0;
-                    byte_ptr1   = (char *) double_ptr1;
-                    for(j = 0; j < here->state[i].bytes; j++)
-                        byte_ptr0[j] = byte_ptr1[j];
-                }
-            }
+#endif
 
-            /* ***************************************************************** */
-            /* If not AC analysis, loop through all connections on this instance */
-            /* and load the input values for each input port of each connection  */
-            /* ***************************************************************** */
 
-            num_conn = here->num_conn;
-            for(i = 0; i < num_conn; i++) {
 
-                /* If AC analysis, skip getting input values.  The input values */
-                /* should stay the same as they were at the last iteration of   */
-                /* the operating point analysis */
-                if(anal_type == MIF_AC)
-                    break;
+/*
+MIFevaluate
 
-                /* if the connection is null, skip to next connection */
-                if(here->conn[i]->is_null)
-                    continue;
+This function fills in the inputs of an instance, calls the code
+model and computes automatic partials if requested.  The cm_...
+functions called by the model reach the instance through info.
+*/
 
-                /* if this connection is not an input, skip to next connection */
-                if(! here->conn[i]->is_input)
-                    continue;
+static void MIFevaluate(
+    MIFinstance     *here,      /* The instance structure */
+    CKTcircuit      *ckt,       /* The circuit structure */
+    Mif_Private_t   *cm_data,   /* The data to be passed to the code model */
+    Mif_Info_t      *info)      /* The context seen by the cm_... functions */
+{
+    Mif_Port_Type_t type;
+    Mif_Port_Data_t *fast;
+
+    Mif_Analysis_t  anal_type;
+
+    Mif_Complex_t   czero;
+
+    int         mod_type;
+    int         num_conn;
+    int         num_port;
+    int         num_port_k;
+    int         i;
+    int         j;
+    int         k;
+    int         l;
 
-                /* Get number of ports on this connection */
-                num_port = here->conn[i]->size;
+    double      *rhsOld;
+
+    double      *double_ptr0;
+    double      *double_ptr1;
 
-                /* loop through all ports on this connection */
-                for(j = 0; j < num_port; j++) {
+    char        *byte_ptr0;
+    char        *byte_ptr1;
 
-                    /*setup a pointer for fast access to port data */
-                    fast = here->conn[i]->port[j];
+    double      last_input;
+    double      conv_limit;
 
-                    /* skip if this port is null */
-                    if(fast->is_null)
-                        continue;
+    Evt_Node_Data_t     *node_data;
 
-                    /* determine the type of this port */
-                    type = fast->type;
 
-                    /* If port type is Digital or User-Defined, we only need */
-                    /* to get the total load.  The input values are pointers */
-                    /* already set by EVTsetup() */
-                    if((type == MIF_DIGITAL) || (type == MIF_USER_DEFINED)) {
-                        fast->total_load =
-                                node_data->total_load[fast->evt_data.node_index];
-                    }
-                    /* otherwise, it is an analog node and we get the input value */
-                    else {
-                        /* load the input values based on type and mode */
-                        if(ckt->CKTmode & MODEINITJCT)
-                            /* first iteration step for DC */
-                            fast->input.rvalue = 0.0;
-                        else if((ckt->CKTmode & MODEINITTRAN) ||
-                                (ckt->CKTmode & MODEINITPRED))
-                            /* first iteration step at timepoint */
-                            fast->input.rvalue = ckt->CKTstate1[fast->old_input];
-                        else {
-                            /* subsequent iterations */
-
-                            /* record last iteration's input value for convergence limiting */
-                            last_input = fast->input.rvalue;
-
-                            /* get the new input value */
-                            switch(type) {
-                            case MIF_VOLTAGE:
-                            case MIF_DIFF_VOLTAGE:
-                            case MIF_CONDUCTANCE:
-                            case MIF_DIFF_CONDUCTANCE:
-                                fast->input.rvalue = rhsOld[fast->smp_data.pos_node] -
-                                                      rhsOld[fast->smp_data.neg_node];
-                                break;
-                            case MIF_CURRENT:
-                            case MIF_DIFF_CURRENT:
-                            case MIF_VSOURCE_CURRENT:
-                            case MIF_RESISTANCE:
-                            case MIF_DIFF_RESISTANCE:
-                                fast->input.rvalue = rhsOld[fast->smp_data.ibranch];
-                                break;
+    /* Prepare a zero complex number for AC gain initializations */
+    czero.real = 0.0;
+    czero.imag = 0.0;
+
+    mod_type = MIFmodPtr(here)->MIFmodType;
+    anal_type = cm_data->circuit.anal_type;
+
+    rhsOld = ckt->CKTrhsOld;
+    node_data = ckt->evt->data.node;
+
+    /* ***************************************************************** */
+    /* Prepare the data needed by the cm_.. functions                    */
+    /* ***************************************************************** */
+    info->instance = here;
+    info->errmsg = "";
+
+    if(here->initialized) {
+        cm_data->circuit.init = MIF_FALSE;
+        info->circuit.init = MIF_FALSE;
+    }
+    else {
+        cm_data->circuit.init = MIF_TRUE;
+        info->circuit.init = MIF_TRUE;
+    }
+
+
+    /* ***************************************************************** */
+    /* if tran analysis and anal_init is true, copy state 1 to state 0   */
+    /* Otherwise the data in state 0 would be invalid                    */
+    /* ***************************************************************** */
+
+    if((anal_type == MIF_TRAN) && info->circuit.anal_init) {
+        for(i = 0; i < here->num_state; i++) {
+            double_ptr0 = ckt->CKTstate0 + here->state[i].index;
+            double_ptr1 = ckt->CKTstate1 + here->state[i].index;
+            byte_ptr0   = (char *) double_ptr0;
+            byte_ptr1   = (char *) double_ptr1;
+            for(j = 0; j < here->state[i].bytes; j++)
+                byte_ptr0[j] = byte_ptr1[j];
+        }
+    }
+
+    /* ***************************************************************** */
+    /* If not AC analysis, loop through all connections on this instance */
+    /* and load the input values for each input port of each connection  */
+    /* ***************************************************************** */
+
+    num_conn = here->num_conn;
+    for(i = 0; i < num_conn; i++) {
+
+        /* If AC analysis, skip getting input values.  The input values */
+        /* should stay the same as they were at the last iteration of   */
+        /* the operating point analysis */
+        if(anal_type == MIF_AC)
+            break;
+
+        /* if the connection is null, skip to next connection */
+        if(here->conn[i]->is_null)
+            continue;
+
+        /* if this connection is not an input, skip to next connection */
+        if(! here->conn[i]->is_input)
+            continue;
+
+        /* Get number of ports on this connection */
+        num_port = here->conn[i]->size;
+
+        /* loop through all ports on this connection */
+        for(j = 0; j < num_port; j++) {
+
+            /*setup a pointer for fast access to port data */
+            fast = here->conn[i]->port[j];
+
+            /* skip if this port is null */
+            if(fast->is_null)
+                continue;
+
+            /* determine the type of this port */
+            type = fast->type;
+
+            /* If port type is Digital or User-Defined, we only need */
+            /* to get the total load.  The input values are pointers */
+            /* already set by EVTsetup() */
+            if((type == MIF_DIGITAL) || (type == MIF_USER_DEFINED)) {
+                fast->total_load =
+                        node_data->total_load[fast->evt_data.node_index];
+            }
+            /* otherwise, it is an analog node and we get the input value */
+            else {
+                /* load the input values based on type and mode */
+                if(ckt->CKTmode & MODEINITJCT)
+                    /* first iteration step for DC */
+                    fast->input.rvalue = 0.0;
+                else if((ckt->CKTmode & MODEINITTRAN) ||
+                        (ckt->CKTmode & MODEINITPRED))
+                    /* first iteration step at timepoint */
+                    fast->input.rvalue = ckt->CKTstate1[fast->old_input];
+                else {
+                    /* subsequent iterations */
+
+                    /* record last iteration's input value for convergence limiting */
+                    last_input = fast->input.rvalue;
+
+                    /* get the new input value */
+                    switch(type) {
+                    case MIF_VOLTAGE:
+                    case MIF_DIFF_VOLTAGE:
+                    case MIF_CONDUCTANCE:
+                    case MIF_DIFF_CONDUCTANCE:
+                        fast->input.rvalue = rhsOld[fast->smp_data.pos_node] -
+                                              rhsOld[fast->smp_data.neg_node];
+                        break;
+                    case MIF_CURRENT:
+                    case MIF_DIFF_CURRENT:
+                    case MIF_VSOURCE_CURRENT:
+                    case MIF_RESISTANCE:
+                    case MIF_DIFF_RESISTANCE:
+                        fast->input.rvalue = rhsOld[fast->smp_data.ibranch];
+                        break;
 			    case MIF_DIGITAL:
 			    case MIF_USER_DEFINED:
 			      break;
-                            } /* end switch on type of port */
-
-                            /* If convergence limiting enabled, limit maximum input change */
-                            if(ckt->enh->conv_limit.enabled) {
-                                /* compute the maximum the input is allowed to change */
-                                conv_limit = fabs(last_input) * ckt->enh->conv_limit.step;
-                                if(conv_limit < ckt->enh->conv_limit.abs_step)
-                                    conv_limit = ckt->enh->conv_limit.abs_step;
-                                /* if input has changed too much, limit it and signal not converged */
-                                if(fabs(fast->input.rvalue - last_input) > conv_limit) {
-                                    if((fast->input.rvalue - last_input) > 0.0)
-                                        fast->input.rvalue = last_input + conv_limit;
-                                    else
-                                        fast->input.rvalue = last_input - conv_limit;
-                                    (ckt->CKTnoncon)++;
-                                    /* report convergence problem if last call */
-                                    if(ckt->enh->conv_debug.report_conv_probs) {
-                                        ENHreport_conv_prob(ENH_ANALOG_INSTANCE,
-                                                            here->MIFname, "");
-                                    }
-                                }
+                    } /* end switch on type of port */
+
+                    /* If convergence limiting enabled, limit maximum input change */
+                    if(ckt->enh->conv_limit.enabled) {
+                        /* compute the maximum the input is allowed to change */
+                        conv_limit = fabs(last_input) * ckt->enh->conv_limit.step;
+                        if(conv_limit < ckt->enh->conv_limit.abs_step)
+                            conv_limit = ckt->enh->conv_limit.abs_step;
+                        /* if input has changed too much, limit it and signal not converged */
+                        if(fabs(fast->input.rvalue - last_input) > conv_limit) {
+                            if((fast->input.rvalue - last_input) > 0.0)
+                                fast->input.rvalue = last_input + conv_limit;
+                            else
+                                fast->input.rvalue = last_input - conv_limit;
+#ifdef USE_OMP
+#pragma omp atomic
+#endif
+                            (ckt->CKTnoncon)++;
+                            /* report convergence problem if last call */
+                            if(ckt->enh->conv_debug.report_conv_probs) {
+#ifdef USE_OMP
+#pragma omp critical (mif_conv_prob)
+#endif
+                                ENHreport_conv_prob(ENH_ANALOG_INSTANCE,
+                                                    here->MIFname, "");
                             }
+                        }
+                    }
 
-                        } /* end else */
+                } /* end else */
 
-                        /* Save value of input for use with MODEINITTRAN */
-                        ckt->CKTstate0[fast->old_input] = fast->input.rvalue;
+                /* Save value of input for use with MODEINITTRAN */
+                ckt->CKTstate0[fast->old_input] = fast->input.rvalue;
 
-                    } /* end else analog type */
-                } /* end for number of ports */
-            } /* end for number of connections */
+            } /* end else analog type */
+        } /* end for number of ports */
+    } /* end for number of connections */
 
-            /* ***************************************************************** */
-            /* loop through all connections on this instance and zero out all    */
-            /* outputs/partials/AC gains for each output port of each connection */
-            /* ***************************************************************** */
-            num_conn = here->num_conn;
-            for(i = 0; i < num_conn; i++) {
+    /* ***************************************************************** */
+    /* loop through all connections on this instance and zero out all    */
+    /* outputs/partials/AC gains for each output port of each connection */
+    /* ***************************************************************** */
+    num_conn = here->num_conn;
+    for(i = 0; i < num_conn; i++) {
 
-                /* if the connection is null or is not an output */
-                /* skip to next connection */
-                if(here->conn[i]->is_null || (! here->conn[i]->is_output))
-                    continue;
+        /* if the connection is null or is not an output */
+        /* skip to next connection */
+        if(here->conn[i]->is_null || (! here->conn[i]->is_output))
+            continue;
 
-                /* loop through all ports on this connection */
-                num_port = here->conn[i]->size;
-                for(j = 0; j < num_port; j++) {
+        /* loop through all ports on this connection */
+        num_port = here->conn[i]->size;
+        for(j = 0; j < num_port; j++) {
 
-                    /*setup a pointer for fast access to port data */
-                    fast = here->conn[i]->port[j];
+            /*setup a pointer for fast access to port data */
+            fast = here->conn[i]->port[j];
 
-                    /* skip if this port is null */
-                    if(fast->is_null)
-                        continue;
+            /* skip if this port is null */
+            if(fast->is_null)
+                continue;
 
-                    /* determine the type of this port */
-                    type = fast->type;
+            /* determine the type of this port */
+            type = fast->type;
 
-                    /* If not an analog node, continue to next port */
-                    if((type == MIF_DIGITAL) || (type == MIF_USER_DEFINED))
-                        continue;
+            /* If not an analog node, continue to next port */
+            if((type == MIF_DIGITAL) || (type == MIF_USER_DEFINED))
+                continue;
+
+            /* initialize the output to zero */
+            fast->output.rvalue = 0.0;
 
-                    /* initialize the output to zero */
-                    fast->output.rvalue = 0.0;
-
-                    /* loop through all connections and ports that */
-                    /* could be inputs for this port and zero the partials */
-                    for(k = 0; k < num_conn; k++) {
-                        if(here->conn[k]->is_null || (! here->conn[k]->is_input))
-                            continue;
-                        num_port_k = here->conn[k]->size;
-                        for(l = 0; l < num_port_k; l++) {
-                            /* skip if this port is null */
-                            if(here->conn[k]->port[l]->is_null)
-                                continue;
-                            fast->partial[k].port[l] = 0.0;
-                            fast->ac_gain[k].port[l] = czero;
-                        } /* end for number of ports */
-                    } /* end for number of connections */
+            /* loop through all connections and ports that */
+            /* could be inputs for this port and zero the partials */
+            for(k = 0; k < num_conn; k++) {
+                if(here->conn[k]->is_null || (! here->conn[k]->is_input))
+                    continue;
+                num_port_k = here->conn[k]->size;
+                for(l = 0; l < num_port_k; l++) {
+                    /* skip if this port is null */
+                    if(here->conn[k]->port[l]->is_null)
+                        continue;
+                    fast->partial[k].port[l] = 0.0;
+                    fast->ac_gain[k].port[l] = czero;
                 } /* end for number of ports */
             } /* end for number of connections */
+        } /* end for number of ports */
+    } /* end for number of connections */
 
 
-            /* ***************************************************************** */
-            /* Prepare the structure to be passed to the code model */
-            /* ***************************************************************** */
-            cm_data.num_conn = here->num_conn;
-            cm_data.conn = here->conn;
-            cm_data.num_param = here->num_param;
-            cm_data.param = here->param;
-            cm_data.num_inst_var = here->num_inst_var;
-            cm_data.inst_var = here->inst_var;
-            cm_data.callback = &(here->callback);
-
-            /* Initialize the auto_partial flag to false */
-            g_mif_info.auto_partial.local = MIF_FALSE;
-
-            /* ******************* */
-            /* Call the code model */
-            /* ******************* */
-            DEVices[mod_type]->DEVpublic.cm_func (&cm_data);
-
-            /* Automatically compute partials if requested by .options auto_partial */
-            /* or by model through call to cm_analog_auto_partial() in DC or TRAN analysis */
-            if((anal_type != MIF_AC) &&
-               (g_mif_info.auto_partial.global || g_mif_info.auto_partial.local))
-                    MIFauto_partial(here, DEVices[mod_type]->DEVpublic.cm_func, &cm_data);
-
-            /* ***************************************************************** */
-            /* Loop through all connections on this instance and */
-            /* load the data into the matrix for each output port */
-            /* and for each V source associated with a current input. */
-            /* For AC analysis, we only load the +-1s required to satisfy */
-            /* KCL and KVL in the matrix equations.  */
-            /* ***************************************************************** */
-
-            num_conn = here->num_conn;
-            for(i = 0; i < num_conn; i++) {
-
-                /* if the connection is null, skip to next connection */
-                if(here->conn[i]->is_null)
-                    continue;
+    /* ***************************************************************** */
+    /* Prepare the structure to be passed to the code model */
+    /* ***************************************************************** */
+    cm_data->num_conn = here->num_conn;
+    cm_data->conn = here->conn;
+    cm_data->num_param = here->num_param;
+    cm_data->param = here->param;
+    cm_data->num_inst_var = here->num_inst_var;
+    cm_data->inst_var = here->inst_var;
+    cm_data->callback = &(here->callback);
+    cm_data->dual_partial = MIF_FALSE;
+    cm_data->resolved = here->resolved;
+
+    /* Initialize the auto_partial flag to false */
+    info->auto_partial.local = MIF_FALSE;
+
+    /* ******************* */
+    /* Call the code model */
+    /* ******************* */
+    DEVices[mod_type]->DEVpublic.cm_func (cm_data);
+
+    /* Automatically compute partials if requested by .options auto_partial */
+    /* or by model through call to cm_analog_auto_partial() in DC or TRAN analysis */
+    /* Models that evaluated over dual numbers already hold exact partials, */
+    /* divided differences remain a fallback for all others */
+    if((anal_type != MIF_AC) && (! cm_data->dual_partial) &&
+       (info->auto_partial.global || info->auto_partial.local))
+            MIFauto_partial(here, DEVices[mod_type]->DEVpublic.cm_func, cm_data, info);
+}
 
-                /* prepare things for convenient access later */
-                is_input = here->conn[i]->is_input;
-                is_output = here->conn[i]->is_output;
 
-                /* loop through all ports on this connection */
-                num_port = here->conn[i]->size;
-                for(j = 0; j < num_port; j++) {
 
-                    /*setup a pointer for fast access to port data */
-                    fast = here->conn[i]->port[j];
+/*
+MIFstamp
 
-                    /* skip if this port is null */
-                    if(fast->is_null)
-                        continue;
+This function loads the outputs, partials and AC gains computed by
+the code model of an instance into the matrix and right-hand side.
+*/
 
-                    /* determine the type of this port */
-                    type = fast->type;
+static void MIFstamp(
+    MIFinstance     *here,       /* The instance structure */
+    CKTcircuit      *ckt,        /* The circuit structure */
+    Mif_Analysis_t  anal_type)   /* The type of analysis being performed */
+{
+    Mif_Port_Type_t type;
+    Mif_Port_Data_t *fast;
 
-                    /* If not an analog node, continue to next port */
-                    if((type == MIF_DIGITAL) || (type == MIF_USER_DEFINED))
-                        continue;
+    Mif_Smp_Ptr_t  *smp_data_out;
 
-                    /* create a pointer to the smp data for quick access */
-                    smp_data_out = &(fast->smp_data);
-
-                    /* if it is a current input */
-                    /* load the matrix data needed for the associated zero-valued V source */
-                    if(is_input && (type == MIF_CURRENT || type == MIF_DIFF_CURRENT)) {
-                        *(smp_data_out->pos_ibranch) += 1.0;
-                        *(smp_data_out->neg_ibranch) -= 1.0;
-                        *(smp_data_out->ibranch_pos) += 1.0;
-                        *(smp_data_out->ibranch_neg) -= 1.0;
-                        /* rhs[smp_data_out->ibranch] += 0.0; */
-                    } /* end if current input */
-
-                    /* if it has a voltage source output, */
-                    /* load the matrix with the V source output data */
-                    if( (is_output && (type == MIF_VOLTAGE || type == MIF_DIFF_VOLTAGE)) ||
-                                     (type == MIF_RESISTANCE || type == MIF_DIFF_RESISTANCE) ) {
-                        *(smp_data_out->pos_branch) += 1.0;
-                        *(smp_data_out->neg_branch) -= 1.0;
-                        *(smp_data_out->branch_pos) += 1.0;
-                        *(smp_data_out->branch_neg) -= 1.0;
-                        if(anal_type != MIF_AC)
-                           rhs[smp_data_out->branch] += fast->output.rvalue;
-                    } /* end if V source output */
-
-                    /* if it has a current source output, */
-                    /* load the matrix with the V source output data */
-                    if( (is_output && (type == MIF_CURRENT || type == MIF_DIFF_CURRENT)) ||
-                                     (type == MIF_CONDUCTANCE || type == MIF_DIFF_CONDUCTANCE) ) {
-                        if(anal_type != MIF_AC) {
-                           rhs[smp_data_out->pos_node] -= fast->output.rvalue;
-                           rhs[smp_data_out->neg_node] += fast->output.rvalue;
-                        }
-                    } /* end if current output */
+    Mif_Port_Ptr_t  *smp_ptr;
 
-                } /* end for number of ports */
-            } /* end for number of connections */
+    Mif_Port_Type_t in_type;
+    Mif_Port_Type_t out_type;
 
+    Mif_Boolean_t  is_input;
+    Mif_Boolean_t  is_output;
 
-            /* ***************************************************************** */
-            /* loop through all output connections on this instance and */
-            /* load the partials/AC gains into the matrix */
-            /* ***************************************************************** */
-            for(i = 0; i < num_conn; i++) {
+    Mif_Cntl_Src_Type_t  cntl_src_type;
 
-                /* if the connection is null or is not an output */
+    Mif_Complex_t   ac_gain;
+
+    int         num_conn;
+    int         num_port;
+    int         num_port_k;
+    int         i;
+    int         j;
+    int         k;
+    int         l;
+
+    double      *rhs;
+    double      partial;
+    double      temp;
+
+    double      cntl_input;
+
+
+    rhs = ckt->CKTrhs;
+
+    /* ***************************************************************** */
+    /* Loop through all connections on this instance and */
+    /* load the data into the matrix for each output port */
+    /* and for each V source associated with a current input. */
+    /* For AC analysis, we only load the +-1s required to satisfy */
+    /* KCL and KVL in the matrix equations.  */
+    /* ***************************************************************** */
+
+    num_conn = here->num_conn;
+    for(i = 0; i < num_conn; i++) {
+
+        /* if the connection is null, skip to next connection */
+        if(here->conn[i]->is_null)
+            continue;
+
+        /* prepare things for convenient access later */
+        is_input = here->conn[i]->is_input;
+        is_output = here->conn[i]->is_output;
+
+        /* loop through all ports on this connection */
+        num_port = here->conn[i]->size;
+        for(j = 0; j < num_port; j++) {
+
+            /*setup a pointer for fast access to port data */
+            fast = here->conn[i]->port[j];
+
+            /* skip if this port is null */
+            if(fast->is_null)
+                continue;
+
+            /* determine the type of this port */
+            type = fast->type;
+
+            /* If not an analog node, continue to next port */
+            if((type == MIF_DIGITAL) || (type == MIF_USER_DEFINED))
+                continue;
+
+            /* create a pointer to the smp data for quick access */
+            smp_data_out = &(fast->smp_data);
+
+            /* if it is a current input */
+            /* load the matrix data needed for the associated zero-valued V source */
+            if(is_input && (type == MIF_CURRENT || type == MIF_DIFF_CURRENT)) {
+                *(smp_data_out->pos_ibranch) += 1.0;
+                *(smp_data_out->neg_ibranch) -= 1.0;
+                *(smp_data_out->ibranch_pos) += 1.0;
+                *(smp_data_out->ibranch_neg) -= 1.0;
+                /* rhs[smp_data_out->ibranch] += 0.0; */
+            } /* end if current input */
+
+            /* if it has a voltage source output, */
+            /* load the matrix with the V source output data */
+            if( (is_output && (type == MIF_VOLTAGE || type == MIF_DIFF_VOLTAGE)) ||
+                             (type == MIF_RESISTANCE || type == MIF_DIFF_RESISTANCE) ) {
+                *(smp_data_out->pos_branch) += 1.0;
+                *(smp_data_out->neg_branch) -= 1.0;
+                *(smp_data_out->branch_pos) += 1.0;
+                *(smp_data_out->branch_neg) -= 1.0;
+                if(anal_type != MIF_AC)
+                   rhs[smp_data_out->branch] += fast->output.rvalue;
+            } /* end if V source output */
+
+            /* if it has a current source output, */
+            /* load the matrix with the V source output data */
+            if( (is_output && (type == MIF_CURRENT || type == MIF_DIFF_CURRENT)) ||
+                             (type == MIF_CONDUCTANCE || type == MIF_DIFF_CONDUCTANCE) ) {
+                if(anal_type != MIF_AC) {
+                   rhs[smp_data_out->pos_node] -= fast->output.rvalue;
+                   rhs[smp_data_out->neg_node] += fast->output.rvalue;
+                }
+            } /* end if current output */
+
+        } /* end for number of ports */
+    } /* end for number of connections */
+
+
+    /* ***************************************************************** */
+    /* loop through all output connections on this instance and */
+    /* load the partials/AC gains into the matrix */
+    /* ***************************************************************** */
+    for(i = 0; i < num_conn; i++) {
+
+        /* if the connection is null or is not an output */
+        /* skip to next connection */
+        if((here->conn[i]->is_null) || (! here->conn[i]->is_output))
+            continue;
+
+        /* loop through all ports on this connection */
+        num_port = here->conn[i]->size;
+        for(j = 0; j < num_port; j++) {
+
+            /*setup a pointer for fast access to port data */
+            fast = here->conn[i]->port[j];
+
+            /* skip if this port is null */
+            if(fast->is_null)
+                continue;
+
+            /* determine the type of this output port */
+            out_type = fast->type;
+
+            /* If not an analog node, continue to next port */
+            if((out_type == MIF_DIGITAL) || (out_type == MIF_USER_DEFINED))
+                continue;
+
+            /* create a pointer to the smp data for quick access */
+            smp_data_out = &(fast->smp_data);
+
+            /* for this port, loop through all connections */
+            /* and all ports to touch on each possible input */
+            for(k = 0; k < num_conn; k++) {
+
+                /* if the connection is null or is not an input */
                 /* skip to next connection */
-                if((here->conn[i]->is_null) || (! here->conn[i]->is_output))
+                if((here->conn[k]->is_null) || (! here->conn[k]->is_input))
                     continue;
 
-                /* loop through all ports on this connection */
-                num_port = here->conn[i]->size;
-                for(j = 0; j < num_port; j++) {
-
-                    /*setup a pointer for fast access to port data */
-                    fast = here->conn[i]->port[j];
+                num_port_k = here->conn[k]->size;
+                /* loop through all the ports of this connection */
+                for(l = 0; l < num_port_k; l++) {
 
                     /* skip if this port is null */
-                    if(fast->is_null)
+                    if(here->conn[k]->port[l]->is_null)
                         continue;
 
-                    /* determine the type of this output port */
-                    out_type = fast->type;
+                    /* determine the type of this input port */
+                    in_type = here->conn[k]->port[l]->type;
 
                     /* If not an analog node, continue to next port */
-                    if((out_type == MIF_DIGITAL) || (out_type == MIF_USER_DEFINED))
+                    if((in_type == MIF_DIGITAL) || (in_type == MIF_USER_DEFINED))
                         continue;
 
-                    /* create a pointer to the smp data for quick access */
-                    smp_data_out = &(fast->smp_data);
-
-                    /* for this port, loop through all connections */
-                    /* and all ports to touch on each possible input */
-                    for(k = 0; k < num_conn; k++) {
-
-                        /* if the connection is null or is not an input */
-                        /* skip to next connection */
-                        if((here->conn[k]->is_null) || (! here->conn[k]->is_input))
-                            continue;
-
-                        num_port_k = here->conn[k]->size;
-                        /* loop through all the ports of this connection */
-                        for(l = 0; l < num_port_k; l++) {
-
-                            /* skip if this port is null */
-                            if(here->conn[k]->port[l]->is_null)
-                                continue;
-
-                            /* determine the type of this input port */
-                            in_type = here->conn[k]->port[l]->type;
-
-                            /* If not an analog node, continue to next port */
-                            if((in_type == MIF_DIGITAL) || (in_type == MIF_USER_DEFINED))
-                                continue;
-
-                            /* get the partial to local variable for fast access */
-                            partial = fast->partial[k].port[l];
-                            ac_gain = fast->ac_gain[k].port[l];
-
-                            /* create a pointer to the matrix pointer data for quick access */
-                            smp_ptr = &(smp_data_out->input[k].port[l]);
-
-                            /* get the input value */
-                            cntl_input = here->conn[k]->port[l]->input.rvalue;
-
-                            /* determine type of controlled source according */
-                            /* to input and output types */
-                            cntl_src_type = MIFget_cntl_src_type(in_type, out_type);
-
-                            switch(cntl_src_type) {
-                            case MIF_VCVS:
-                                if(anal_type == MIF_AC) {
-                                   smp_ptr->e.branch_poscntl[0] -= ac_gain.real;
-                                   smp_ptr->e.branch_negcntl[0] += ac_gain.real;
-                                   smp_ptr->e.branch_poscntl[1] -= ac_gain.imag;
-                                   smp_ptr->e.branch_negcntl[1] += ac_gain.imag;
-                                }
-                                else {
-                                   smp_ptr->e.branch_poscntl[0] -= partial;
-                                   smp_ptr->e.branch_negcntl[0] += partial;
-                                   rhs[smp_data_out->branch] -= partial * cntl_input;
-                                }
-                                break;
-                            case MIF_ICIS:
-                                if(anal_type == MIF_AC) {
-                                   smp_ptr->f.pos_ibranchcntl[0] += ac_gain.real;
-                                   smp_ptr->f.neg_ibranchcntl[0] -= ac_gain.real;
-                                   smp_ptr->f.pos_ibranchcntl[1] += ac_gain.imag;
-                                   smp_ptr->f.neg_ibranchcntl[1] -= ac_gain.imag;
-                                }
-                                else {
-                                   smp_ptr->f.pos_ibranchcntl[0] += partial;
-                                   smp_ptr->f.neg_ibranchcntl[0] -= partial;
-                                   temp = partial * cntl_input;
-                                   rhs[smp_data_out->pos_node] += temp;
-                                   rhs[smp_data_out->neg_node] -= temp;
-                                }
-                                break;
-                            case MIF_VCIS:
-                                if(anal_type == MIF_AC) {
-                                   smp_ptr->g.pos_poscntl[0] += ac_gain.real;
-                                   smp_ptr->g.pos_negcntl[0] -= ac_gain.real;
-                                   smp_ptr->g.neg_poscntl[0] -= ac_gain.real;
-                                   smp_ptr->g.neg_negcntl[0] += ac_gain.real;
-                                   smp_ptr->g.pos_poscntl[1] += ac_gain.imag;
-                                   smp_ptr->g.pos_negcntl[1] -= ac_gain.imag;
-                                   smp_ptr->g.neg_poscntl[1] -= ac_gain.imag;
-                                   smp_ptr->g.neg_negcntl[1] += ac_gain.imag;
-                                }
-                                else {
-                                   smp_ptr->g.pos_poscntl[0] += partial;
-                                   smp_ptr->g.pos_negcntl[0] -= partial;
-                                   smp_ptr->g.neg_poscntl[0] -= partial;
-                                   smp_ptr->g.neg_negcntl[0] += partial;
-                                   temp = partial * cntl_input;
-                                   rhs[smp_data_out->pos_node] += temp;
-                                   rhs[smp_data_out->neg_node] -= temp;
-                                }
-                                break;
-                            case MIF_ICVS:
-                                if(anal_type == MIF_AC) {
-                                   smp_ptr->h.branch_ibranchcntl[0] -= ac_gain.real;
-                                   smp_ptr->h.branch_ibranchcntl[1] -= ac_gain.imag;
-                                }
-                                else {
-                                   smp_ptr->h.branch_ibranchcntl[0] -= partial;
-                                   rhs[smp_data_out->branch] -= partial * cntl_input;
-                                }
-                                break;
-                            case MIF_minus_one:
-                                break;
-                            } /* end switch on controlled source type */
-                        } /* end for number of input ports */
-                    } /* end for number of input connections */
-                } /* end for number of output ports */
-            } /* end for number of output connections */
+                    /* get the partial to local variable for fast access */
+                    partial = fast->partial[k].port[l];
+                    ac_gain = fast->ac_gain[k].port[l];
 
-            here->initialized = MIF_TRUE;
+                    /* create a pointer to the matrix pointer data for quick access */
+                    smp_ptr = &(smp_data_out->input[k].port[l]);
 
-        } /* end for all instances */
+                    /* get the input value */
+                    cntl_input = here->conn[k]->port[l]->input.rvalue;
 
-    } /* end for all models */
+                    /* determine type of controlled source according */
+                    /* to input and output types */
+                    cntl_src_type = MIFget_cntl_src_type(in_type, out_type);
 
-    return(OK);
-}
+                    switch(cntl_src_type) {
+                    case MIF_VCVS:
+                        if(anal_type == MIF_AC) {
+                           smp_ptr->e.branch_poscntl[0] -= ac_gain.real;
+                           smp_ptr->e.branch_negcntl[0] += ac_gain.real;
+                           smp_ptr->e.branch_poscntl[1] -= ac_gain.imag;
+                           smp_ptr->e.branch_negcntl[1] += ac_gain.imag;
+                        }
+                        else {
+                           smp_ptr->e.branch_poscntl[0] -= partial;
+                           smp_ptr->e.branch_negcntl[0] += partial;
+                           rhs[smp_data_out->branch] -= partial * cntl_input;
+                        }
+                        break;
+                    case MIF_ICIS:
+                        if(anal_type == MIF_AC) {
+                           smp_ptr->f.pos_ibranchcntl[0] += ac_gain.real;
+                           smp_ptr->f.neg_ibranchcntl[0] -= ac_gain.real;
+                           smp_ptr->f.pos_ibranchcntl[1] += ac_gain.imag;
+                           smp_ptr->f.neg_ibranchcntl[1] -= ac_gain.imag;
+                        }
+                        else {
+                           smp_ptr->f.pos_ibranchcntl[0] += partial;
+                           smp_ptr->f.neg_ibranchcntl[0] -= partial;
+                           temp = partial * cntl_input;
+                           rhs[smp_data_out->pos_node] += temp;
+                           rhs[smp_data_out->neg_node] -= temp;
+                        }
+                        break;
+                    case MIF_VCIS:
+                        if(anal_type == MIF_AC) {
+                           smp_ptr->g.pos_poscntl[0] += ac_gain.real;
+                           smp_ptr->g.pos_negcntl[0] -= ac_gain.real;
+                           smp_ptr->g.neg_poscntl[0] -= ac_gain.real;
+                           smp_ptr->g.neg_negcntl[0] += ac_gain.real;
+                           smp_ptr->g.pos_poscntl[1] += ac_gain.imag;
+                           smp_ptr->g.pos_negcntl[1] -= ac_gain.imag;
+                           smp_ptr->g.neg_poscntl[1] -= ac_gain.imag;
+                           smp_ptr->g.neg_negcntl[1] += ac_gain.imag;
+                        }
+                        else {
+                           smp_ptr->g.pos_poscntl[0] += partial;
+                           smp_ptr->g.pos_negcntl[0] -= partial;
+                           smp_ptr->g.neg_poscntl[0] -= partial;
+                           smp_ptr->g.neg_negcntl[0] += partial;
+                           temp = partial * cntl_input;
+                           rhs[smp_data_out->pos_node] += temp;
+                           rhs[smp_data_out->neg_node] -= temp;
+                        }
+                        break;
+                    case MIF_ICVS:
+                        if(anal_type == MIF_AC) {
+                           smp_ptr->h.branch_ibranchcntl[0] -= ac_gain.real;
+                           smp_ptr->h.branch_ibranchcntl[1] -= ac_gain.imag;
+                        }
+                        else {
+                           smp_ptr->h.branch_ibranchcntl[0] -= partial;
+                           rhs[smp_data_out->branch] -= partial * cntl_input;
+                        }
+                        break;
+                    case MIF_minus_one:
+                        break;
+                    } /* end switch on controlled source type */
+                } /* end for number of input ports */
+            } /* end for number of input connections */
+        } /* end for number of output ports */
+    } /* end for number of output connections */
 
+    here->initialized = MIF_TRUE;
+}
 
 
 
@@ -693,7 +908,8 @@ are then computed by divided differences.
 static void MIFauto_partial(
     MIFinstance     *here,         /* The instance structure */
     void            (*cm_func) (Mif_Private_t *),  /* The code model function to be called */
-    Mif_Private_t   *cm_data)      /* The data to be passed to the code model */
+    Mif_Private_t   *cm_data,      /* The data to be passed to the code model */
+    Mif_Info_t      *info)         /* The context seen by the cm_... functions */
 {
 
     Mif_Port_Data_t *fast;
@@ -718,10 +934,10 @@ static void MIFauto_partial(
     /* Reset init and anal_init flags before making additional calls */
     /* to the model */
     cm_data->circuit.init = MIF_FALSE;
-    g_mif_info.circuit.init = MIF_FALSE;
+    info->circuit.init = MIF_FALSE;
 
     cm_data->circuit.anal_init = MIF_FALSE;
-    g_mif_info.circuit.anal_init = MIF_FALSE;
+    info->circuit.anal_init = MIF_FALSE;
 
 
     /* *************************** */
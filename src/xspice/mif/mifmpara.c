@@ -77,6 +77,7 @@ int MIFmParam(
 {
 
     MIFmodel    *model;
+    MIFinstance *here;
     int         mod_type;
     int         value_type;
     int         i;
@@ -210,5 +211,10 @@ int MIFmParam(
 
     } /* end else */
 
+    /* Refresh the parameters read by the code model if already set up */
+    for(here = MIFinstances(model); here != NULL; here = MIFnextInstance(here))
+        if(here->resolved)
+            MIFresolve(here);
+
     return(OK);
 }
@@ -29,6 +29,8 @@ SUMMARY
 INTERFACES
 
     MIFsetup()
+    MIFunsetup()
+    MIFresolve()
 
 REFERENCED FILES
 
@@ -229,12 +231,16 @@ MIFsetup(
 
             here->num_state = 0;
             here->state = NULL;
+            here->num_state_offset = 0;
+            here->state_offset = NULL;
 
             here->num_intgr = 0;
             here->intgr = NULL;
 
             here->num_conv = 0;
             here->conv = NULL;
+
+            MIFresolve(here);
         }
 
 
@@ -556,6 +562,8 @@ MIFunsetup(GENmodel *inModel,CKTcircuit *ckt)
             } /* end for number of connections */
             /* free memory allocated by cm_analog_alloc and cm_analog_converge */
             tfree(here->state);
+            tfree(here->state_offset);
+            here->num_state_offset = 0;
             tfree(here->conv);
             tfree(here->intgr);
 
@@ -570,9 +578,12 @@ MIFunsetup(GENmodel *inModel,CKTcircuit *ckt)
                 cm_data.num_inst_var = here->num_inst_var;
                 cm_data.inst_var = here->inst_var;
                 cm_data.callback = &(here->callback);
+                cm_data.dual_partial = MIF_FALSE;
+                cm_data.resolved = here->resolved;
 
                 here->callback(&cm_data, MIF_CB_DESTROY);
             }
+            tfree(here->resolved);
 
             here->initialized = MIF_FALSE;
         } /* end for all instances */
@@ -580,3 +591,36 @@ MIFunsetup(GENmodel *inModel,CKTcircuit *ckt)
     /* printf("MIFunsetup completed.\n");*/
     return OK;
 }
+
+
+
+/*
+MIFresolve
+
+This function fills the data read by the PARAM and port accessor
+macros of the code model, which cmpp generates with the model as
+<c_fcn_name>_resolve().  It is called for each instance by MIFsetup
+and again by MIFmParam when a model parameter is changed.
+*/
+
+void MIFresolve(
+    MIFinstance *here)      /* The instance to resolve */
+{
+    Mif_Private_t cm_data;
+    size_t (*cm_resolve) (Mif_Private_t *, void *);
+
+    cm_resolve = DEVices[MIFmodPtr(here)->MIFmodType]->DEVpublic.cm_resolve;
+
+    /* Nothing to fill for code models built without a resolve function */
+    if(! cm_resolve)
+        return;
+
+    cm_data.num_conn = here->num_conn;
+    cm_data.conn = here->conn;
+    cm_data.num_param = here->num_param;
+    cm_data.param = here->param;
+
+    if(! here->resolved)
+        here->resolved = tmalloc(cm_resolve(&cm_data, NULL));
+    cm_resolve(&cm_data, here->resolved);
+}